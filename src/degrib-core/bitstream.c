@@ -0,0 +1,166 @@
+/*****************************************************************************
+ * bitstream.c
+ *
+ * DESCRIPTION
+ *    This file contains a bulk bit reader, which reads runs of fixed width
+ * big endian bit fields out of memory.  It is used by the GRIB1 and TDLPack
+ * decoders in place of a loop of memBitRead() calls.
+ *
+ * HISTORY
+ * 10/2026 Arthur Taylor (MDL): Created (moved from tendian.c).
+ *
+ * NOTES
+ ****************************************************************************/
+#include <string.h>
+#include "bitstream.h"
+
+/*****************************************************************************
+ * memBitReadInit() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Sets up a bulk bit reader on an uChar buffer array of memory, so that
+ * memBitReadN() can read many values with one call.  bufLoc has the same
+ * meaning as it does for memBitRead().
+ *
+ * ARGUMENTS
+ *     bs = The bit reader to set up. (Output)
+ *    Src = The data to read the bits from. (Input)
+ * srcLen = Length in bytes of Src.  The reader won't look past this. (Input)
+ * bufLoc = In Src, which bit to start reading from.
+ *          Starts at 8 goes to 1 (0 means skip the first byte). (Input)
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ * 10/2026 Arthur Taylor (MDL): Created
+ *
+ * NOTES
+ ****************************************************************************/
+void memBitReadInit(bitStreamType *bs, const void *Src, size_t srcLen,
+                    uChar bufLoc)
+{
+   bs->start = (const uChar *)Src;
+   bs->ptr = bs->start;
+   bs->end = bs->start + srcLen;
+   bs->buff = 0;
+   bs->buffLen = 0;
+   if ((bufLoc < 8) && (bs->ptr < bs->end)) {
+      if (bufLoc != 0) {
+         bs->buff = (uInt8)*(bs->ptr) << (64 - bufLoc);
+         bs->buffLen = bufLoc;
+      }
+      bs->ptr++;
+   }
+}
+
+/*****************************************************************************
+ * memBitReadFill() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Loads as many whole bytes into the bit reader's buffer as will fit,
+ * using one 8 byte load when there are at least 8 bytes left.
+ *
+ * ARGUMENTS
+ * bs = The bit reader. (Input/Output)
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ * 10/2026 Arthur Taylor (MDL): Created
+ *
+ * NOTES
+ * 1) The 8 byte load also puts the leading bits of the next (not yet
+ *    consumed) byte below buffLen.  Those are the same bits the next load
+ *    will OR in, so it doesn't matter.
+ ****************************************************************************/
+static void memBitReadFill(bitStreamType *bs)
+{
+   const uChar *ptr = bs->ptr; /* Next byte to load. */
+   uInt8 word;          /* The next 8 bytes as a big endian number. */
+
+   if (bs->end - ptr >= 8) {
+      word = ((uInt8)ptr[0] << 56) | ((uInt8)ptr[1] << 48) |
+            ((uInt8)ptr[2] << 40) | ((uInt8)ptr[3] << 32) |
+            ((uInt8)ptr[4] << 24) | ((uInt8)ptr[5] << 16) |
+            ((uInt8)ptr[6] << 8) | (uInt8)ptr[7];
+      bs->buff |= word >> bs->buffLen;
+      bs->ptr += (63 - bs->buffLen) >> 3;
+      bs->buffLen |= 56;
+   } else {
+      while ((bs->buffLen <= 56) && (bs->ptr < bs->end)) {
+         bs->buff |= (uInt8)*(bs->ptr++) << (56 - bs->buffLen);
+         bs->buffLen += 8;
+      }
+   }
+}
+
+/*****************************************************************************
+ * memBitReadN() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Reads numVal consecutive unsigned numBits wide values from a bit reader
+ * set up by memBitReadInit().  Replaces a loop of memBitRead() calls.
+ *
+ * ARGUMENTS
+ *      bs = The bit reader. (Input/Output)
+ *     dst = Where to put the values (at least numVal long). (Output)
+ *  numVal = How many values to read. (Input)
+ * numBits = How many bits are in each value (0..32). (Input)
+ *
+ * RETURNS: int
+ *    1 on error (numBits > 32, or ran out of data), 0 if ok.
+ *
+ * HISTORY
+ * 10/2026 Arthur Taylor (MDL): Created
+ *
+ * NOTES
+ * 1) Assumes binary bit stream is "big endian" (same as memBitRead).
+ ****************************************************************************/
+int memBitReadN(bitStreamType *bs, uInt4 *dst, size_t numVal,
+                uChar numBits)
+{
+   size_t i;            /* Loop over the values. */
+
+   if (numBits > 32) {
+      return 1;
+   }
+   if (numBits == 0) {
+      memset(dst, 0, numVal * sizeof(uInt4));
+      return 0;
+   }
+   for (i = 0; i < numVal; i++) {
+      if (bs->buffLen < numBits) {
+         memBitReadFill(bs);
+         if (bs->buffLen < numBits) {
+            return 1;
+         }
+      }
+      dst[i] = (uInt4)(bs->buff >> (64 - numBits));
+      bs->buff <<= numBits;
+      bs->buffLen = (uChar)(bs->buffLen - numBits);
+   }
+   return 0;
+}
+
+/*****************************************************************************
+ * memBitReadTell() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Returns how many bits the bit reader has used, counting from the start
+ * of Src (including any bits skipped because of bufLoc).
+ *
+ * ARGUMENTS
+ * bs = The bit reader. (Input)
+ *
+ * RETURNS: size_t
+ *    Number of bits read.
+ *
+ * HISTORY
+ * 10/2026 Arthur Taylor (MDL): Created
+ *
+ * NOTES
+ ****************************************************************************/
+size_t memBitReadTell(const bitStreamType *bs)
+{
+   return (size_t)(bs->ptr - bs->start) * 8 - bs->buffLen;
+}
@@ -0,0 +1,37 @@
+/*****************************************************************************
+ * bitstream.h
+ *
+ * DESCRIPTION
+ *    This file contains a bulk bit reader, which reads runs of fixed width
+ * big endian bit fields out of memory (see memBitRead() in tendian.c for
+ * the one value at a time version).
+ *
+ * HISTORY
+ *   10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+#ifndef BITSTREAM_H
+#define BITSTREAM_H
+
+#include <stddef.h>
+#include "libaat_type.h"
+
+/* State of the bulk bit reader.  Bits are loaded 8 bytes at a time into
+ * buff, where they are left justified. */
+typedef struct {
+   const uChar *start;  /* The first byte of the stream. */
+   const uChar *ptr;    /* Next byte to load into buff. */
+   const uChar *end;    /* One past the last byte of the stream. */
+   uInt8 buff;          /* Bits loaded but not yet read. */
+   uChar buffLen;       /* Number of bits in buff. */
+} bitStreamType;
+
+void memBitReadInit(bitStreamType *bs, const void *Src, size_t srcLen,
+                    uChar bufLoc);
+int memBitReadN(bitStreamType *bs, uInt4 *dst, size_t numVal,
+                uChar numBits);
+size_t memBitReadTell(const bitStreamType *bs);
+
+#endif
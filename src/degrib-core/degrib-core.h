@@ -36,6 +36,13 @@ void unpk_g2ncep(sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
                  sInt4 *nd5, float *xmissp, float *xmisss,
                  sInt4 *inew, sInt4 *iclean, sInt4 *l3264b,
                  sInt4 *iendpk, sInt4 *jer, sInt4 *ndjer, sInt4 *kjer);
+void unpk_g2ncepRows(sInt4 y1, sInt4 y2);
+void unpk_g2ncepMetaOnly(sChar f_metaOnly);
+void unpk_g2ncepThreads(int numThreads);
+int unpk_g2ncepCells(unsigned char *c_ipack, int subgNum, sInt4 numCell,
+                     const sInt4 *cell, float *val, sInt4 *ib,
+                     sInt4 *ibitmap, float *minVal, float *maxVal);
+void pk_g2ncepThreads(int numThreads);
 int C_pkGrib2 (unsigned char *cgrib, sInt4 *sec0, sInt4 *sec1,
                unsigned char *csec2, sInt4 lcsec2,
                sInt4 *igds, sInt4 *igdstmpl, sInt4 *ideflist,
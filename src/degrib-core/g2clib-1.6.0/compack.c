@@ -19,6 +19,8 @@ void compack(g2float *fld,g2int ndpts,g2int idrsnum,g2int *idrstmpl,
 //
 // PROGRAM HISTORY LOG:
 // 2002-11-07  Gilbert
+// 2026-10     Taylor - Determine the groups with pack_gpmt, which may
+//                      split large fields among threads.
 //
 // USAGE:    void compack(g2float *fld,g2int ndpts,g2int idrsnum,
 //                g2int *idrstmpl,unsigned char *cpack,g2int *lcpack)
@@ -234,9 +236,9 @@ void compack(g2float *fld,g2int ndpts,g2int idrsnum,g2int *idrstmpl,
            jmax = calloc(maxgrps,sizeof(g2int));
            lbit = calloc(maxgrps,sizeof(g2int));
            missopt=0;
-           pack_gp(&kfildo,ifld,&ndpts,&missopt,&minpk,&inc,&miss1,&miss2,
-                        jmin,jmax,lbit,glen,&maxgrps,&ngroups,&ibit,&jbit,
-                        &kbit,&novref,&lbitref,&ier);
+           pack_gpmt(&kfildo,ifld,&ndpts,&missopt,&minpk,&inc,&miss1,&miss2,
+                      jmin,jmax,lbit,glen,&maxgrps,&ngroups,&ibit,&jbit,
+                      &kbit,&novref,&lbitref,&ier);
            //print *,'SAGier = ',ier,ibit,jbit,kbit,novref,lbitref
            for ( ng=0; ng<ngroups; ng++) glen[ng]=glen[ng]+novref;
            free(jmin);
@@ -3,6 +3,9 @@
 #include "grib2.h"
 
 
+int comunpackwin(unsigned char *,g2int,g2int,g2int *,g2int,g2int,g2int,
+                 g2float *);
+
 int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2int ndpts,g2float *fld)
 ////$$$  SUBPROGRAM DOCUMENTATION BLOCK
 //                .      .    .                                       .
@@ -20,6 +23,7 @@ int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2
 // 2004-12-16  Gilbert  -  Added test ( provided by Arthur Taylor/MDL )
 //                         to verify that group widths and lengths are
 //                         consistent with section length.
+// 2026-10     Taylor   -  Moved to comunpackwin.
 //
 // USAGE:    int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,
 //                         g2int *idrstmpl, g2int ndpts,g2float *fld)
@@ -44,6 +48,43 @@ int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2
 //   MACHINE: 
 //
 //$$$//
+{
+      return(comunpackwin(cpack,lensec,idrsnum,idrstmpl,ndpts,0,ndpts-1,
+                          fld));
+}
+
+
+int comunpackwin(unsigned char *cpack,g2int lensec,g2int idrsnum,
+                 g2int *idrstmpl,g2int ndpts,g2int first,g2int last,
+                 g2float *fld)
+////$$$  SUBPROGRAM DOCUMENTATION BLOCK
+//                .      .    .                                       .
+// SUBPROGRAM:    comunpackwin
+//
+// ABSTRACT: Same as comunpack, but only unpacks data values first..last.
+//   The group headers are all read (to check the section), but groups
+//   after the one holding value "last" are not unpacked.  For DRT 5.2
+//   without missing values, groups before value "first" are skipped as
+//   well.  (DRT 5.3 needs them to undo the spatial differencing.)
+//
+// PROGRAM HISTORY LOG:
+// 2026-10  Taylor  - Created from comunpack.
+//
+// USAGE:    int comunpackwin(unsigned char *cpack,g2int lensec,
+//                  g2int idrsnum,g2int *idrstmpl,g2int ndpts,g2int first,
+//                  g2int last,g2float *fld)
+//   INPUT ARGUMENT LIST:
+//     See comunpack, plus
+//     first    - First data value to unpack (0 based).
+//     last     - Last data value to unpack (0 based).
+//
+//   OUTPUT ARGUMENT LIST:
+//     fld      - Contains the unpacked data values (first..last).  The
+//                rest of fld is left alone.
+//
+// REMARKS: None
+//
+//$$$//
 {
 
       g2int   nbitsd=0,isign;
@@ -54,6 +95,7 @@ int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2
       g2int  msng1,msng2;
       g2float ref,bscale,dscale,rmiss1,rmiss2;
       g2int totBit, totLen;
+      g2int nstop;
 
       //printf('IDRSTMPL: ',(idrstmpl(j),j=1,16)
       rdieee(idrstmpl+0,&ref,1);
@@ -68,10 +110,16 @@ int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2
       if (idrsnum == 3)
          nbitsd=idrstmpl[17]*8;
 
+      if (first < 0) first=0;
+      if (last > ndpts-1) last=ndpts-1;
+      if (last < first) return(0);
+      //   Stop unpacking after the group holding value "last".
+      nstop=last+1;
+
       //   Constant field
 
       if (ngroups == 0) {
-         for (j=0;j<ndpts;j++) fld[j]=ref;
+         for (j=first;j<=last;j++) fld[j]=ref;
          return(0);
       }
 
@@ -211,8 +259,12 @@ int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2
 //
       if ( idrstmpl[6] == 0 ) {        // no missing values
          n=0;
-         for (j=0;j<ngroups;j++) {
-           if (gwidth[j] != 0) {
+         for (j=0;j<ngroups && n<nstop;j++) {
+           if (idrsnum == 2 && n+glen[j] <= first) {
+             // before the window, and no spatial differencing
+             n=n+glen[j];
+           }
+           else if (gwidth[j] != 0) {
              gbits(cpack,ifld+n,iofst,gwidth[j],0,glen[j]);
              for (k=0;k<glen[j];k++) {
                ifld[n]=ifld[n]+gref[j];
@@ -233,7 +285,7 @@ int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2
          for (j=0;j<ndpts;j++) ifldmiss[j]=0;
          n=0;
          non=0;
-         for (j=0;j<ngroups;j++) {
+         for (j=0;j<ngroups && n<nstop;j++) {
            //printf(" SAGNGP %d %d %d %d\n",j,gwidth[j],glen[j],gref[j]);
            if (gwidth[j] != 0) {
              msng1=(g2int)int_power(2.0,gwidth[j])-1;
@@ -286,7 +338,7 @@ int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2
       if (idrsnum == 3) {         // spatial differencing
          if (idrstmpl[16] == 1) {      // first order
             ifld[0]=ival1;
-            if ( idrstmpl[6] == 0 ) itemp=ndpts;        // no missing values
+            if ( idrstmpl[6] == 0 ) itemp=nstop;        // no missing values
             else  itemp=non;
             for (n=1;n<itemp;n++) {
                ifld[n]=ifld[n]+minsd;
@@ -296,7 +348,7 @@ int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2
          else if (idrstmpl[16] == 2) {    // second order
             ifld[0]=ival1;
             ifld[1]=ival2;
-            if ( idrstmpl[6] == 0 ) itemp=ndpts;        // no missing values
+            if ( idrstmpl[6] == 0 ) itemp=nstop;        // no missing values
             else  itemp=non;
             for (n=2;n<itemp;n++) {
                ifld[n]=ifld[n]+minsd;
@@ -309,14 +361,14 @@ int comunpack(unsigned char *cpack,g2int lensec,g2int idrsnum,g2int *idrstmpl,g2
 //
       //printf("SAGT: %f %f %f\n",ref,bscale,dscale);
       if ( idrstmpl[6] == 0 ) {        // no missing values
-         for (n=0;n<ndpts;n++) {
+         for (n=first;n<nstop;n++) {
             fld[n]=(((g2float)ifld[n]*bscale)+ref)*dscale;
          }
       }
       else if ( idrstmpl[6]==1 || idrstmpl[6]==2 ) {
          // missing values included
          non=0;
-         for (n=0;n<ndpts;n++) {
+         for (n=0;n<nstop;n++) {
             if ( ifldmiss[n] == 0 ) {
                fld[n]=(((g2float)ifld[non++]*bscale)+ref)*dscale;
                //printf(" SAG %d %f %d %f %f %f\n",n,fld[n],ifld[non-1],bscale,ref,dscale);
@@ -1,10 +1,39 @@
-#ifndef USE_JPEG2000
- void dummy(void) {}
-#else   /* USE_JPEG2000 */
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "grib2.h"
+
+// Number of threads JasPer may use to decode the code blocks of a tile.
+static int jpcNumThreads = 1;
+
+   void g2_setjpcthreads(g2int nthreads)
+/*$$$  SUBPROGRAM DOCUMENTATION BLOCK
+*                .      .    .                                       .
+* SUBPROGRAM:    g2_setjpcthreads  Sets threads used by dec_jpeg2000
+*   PRGMMR: Taylor           ORG: MDL         DATE: 2026-10-18
+*
+* ABSTRACT: This Function sets how many threads later calls to dec_jpeg2000
+*   may use to decode (tier-1) the code blocks of a JPEG2000 code stream.
+*
+* PROGRAM HISTORY LOG:
+* 2026-10  Taylor
+*
+* USAGE:     void g2_setjpcthreads(g2int nthreads)
+*
+*   INPUT ARGUMENTS:
+*      nthreads - Number of threads (values < 1 are treated as 1).
+*
+* REMARKS:
+*
+*      The setting is process wide.  A caller that already decodes several
+*      fields at a time on different threads should leave it at 1.
+*
+*$$$*/
+{
+    jpcNumThreads = (nthreads < 1) ? 1 : (int)nthreads;
+}
+
+#ifdef USE_JPEG2000
 #include "jasper/jasper.h"
 #define JAS_1_700_2
 
@@ -23,6 +52,9 @@
 *
 * PROGRAM HISTORY LOG:
 * 2002-12-02  Gilbert
+* 2026-10     Taylor - Decode code blocks on g2_setjpcthreads() threads.
+*                      Copy the image out a row at a time, instead of via a
+*                      second full grid matrix.
 *
 * USAGE:     int dec_jpeg2000(char *injpc,g2int bufsize,g2int *outfld)
 *
@@ -55,8 +87,9 @@
     jas_image_t *image=0;
     jas_stream_t *jpcstream;
     jas_image_cmpt_t *pcmpt;
-    char *opts=0;
+    char opts[40];
     jas_matrix_t *data;
+    jas_seqent_t *row;
 
 //    jas_init();
 
@@ -70,9 +103,11 @@
 //   
 //     Decode JPEG200 codestream into jas_image_t structure.
 //       
+    sprintf(opts,"numthreads=%d",jpcNumThreads);
     image=jpc_decode(jpcstream,opts);
     if ( image == 0 ) {
        printf(" jpc_decode return\n");
+       jas_stream_close(jpcstream);
        return -3;
     }
     
@@ -112,23 +147,28 @@
 //
     if (image->numcmpts_ != 1 ) {
        printf("dec_jpeg2000: Found color image.  Grayscale expected.\n");
+       jas_stream_close(jpcstream);
+       jas_image_destroy(image);
        return (-5);
     }
 
 // 
-//    Create a data matrix of grayscale image values decoded from
-//    the jpeg2000 codestream.
-//
-    data=jas_matrix_create(jas_image_height(image), jas_image_width(image));
-    jas_image_readcmpt(image,0,0,0,jas_image_width(image),
-                       jas_image_height(image),data);
-//
-//    Copy data matrix to output integer array.
+//    Read the grayscale image values decoded from the jpeg2000 codestream
+//    one row at a time, copying each row to the output integer array.
 //
+    data=jas_matrix_create(1, jas_image_width(image));
+    if ( data == 0 ) {
+       jas_stream_close(jpcstream);
+       jas_image_destroy(image);
+       return -3;
+    }
+    row=jas_matrix_getref(data,0,0);
     k=0;
-    for (i=0;i<pcmpt->height_;i++) 
+    for (i=0;i<pcmpt->height_;i++) {
+      jas_image_readcmpt(image,0,0,i,pcmpt->width_,1,data);
       for (j=0;j<pcmpt->width_;j++) 
-        outfld[k++]=data->rows_[i][j];
+        outfld[k++]=row[j];
+    }
 //
 //     Clean up JasPer work structures.
 //
@@ -141,4 +141,130 @@ int dec_png(unsigned char *pngbuf,g2int *width,g2int *height,char *cout)
 
 }
 
+int dec_pngfld(unsigned char *pngbuf,g2int nbits,g2float ref,g2float bscale,
+               g2float dscale,g2int ndpts,g2float *fld)
+/*
+        Decodes a PNG stream (GRIB2 template 5.41) a row at a time,
+        scaling each row's values straight into fld.  This avoids the full
+        image copies (libpng's rows, cout, and the integer array) that
+        dec_png + gbits need.
+
+        Returns 0 if fld was filled in, 1 if the image isn't a layout we
+        stream (interlaced, sub-byte samples, or nbits not matching the
+        bytes per pixel) so the caller should use dec_png, or < 0 on a
+        libpng error.
+
+        2026-10  Taylor
+*/
+{
+    int interlace,color,compres,filter,bit_depth;
+    g2int i,j,n,bytes,width,height;
+    png_structp png_ptr;
+    png_infop info_ptr,end_info;
+    png_bytep volatile row=NULL;
+    png_bytep ptr;
+    png_stream read_io_ptr;
+    png_uint_32 h32, w32;
+    g2int ival;
+
+/*  check if stream is a valid PNG format   */
+    if ( png_sig_cmp(pngbuf,0,8) != 0) 
+       return (-3);
+
+/* create and initialize png_structs  */
+    png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, (png_voidp)NULL, 
+                                      NULL, NULL);
+    if (!png_ptr)
+       return (-1);
+    info_ptr = png_create_info_struct(png_ptr);
+    if (!info_ptr)
+    {
+       png_destroy_read_struct(&png_ptr,(png_infopp)NULL,(png_infopp)NULL);
+       return (-2);
+    }
+    end_info = png_create_info_struct(png_ptr);
+    if (!end_info)
+    {
+       png_destroy_read_struct(&png_ptr,(png_infopp)info_ptr,(png_infopp)NULL);
+       return (-2);
+    }
+
+/*     Set Error callback   */
+    if (setjmp(png_jmpbuf(png_ptr)))
+    {
+       free(row);
+       png_destroy_read_struct(&png_ptr, &info_ptr,&end_info);
+       return (-3);
+    }
+
+/*    Initialize info for reading PNG stream from memory   */
+    read_io_ptr.stream_ptr=(png_voidp)pngbuf;
+    read_io_ptr.stream_len=0;
+    png_set_read_fn(png_ptr,(png_voidp)&read_io_ptr,(png_rw_ptr)user_read_data);
+
+/*     Read the header, and decide if we can stream this image   */
+    png_read_info(png_ptr, info_ptr);
+    (void)png_get_IHDR(png_ptr, info_ptr, &w32, &h32,
+               &bit_depth, &color, &interlace, &compres, &filter);
+    width = w32;
+    height = h32;
+    if ( color == PNG_COLOR_TYPE_GRAY && (bit_depth == 8 || bit_depth == 16) ) {
+       bytes=bit_depth/8;
+    }
+    else if ( color == PNG_COLOR_TYPE_RGB && bit_depth == 8 ) {
+       bytes=3;
+    }
+    else if ( color == PNG_COLOR_TYPE_RGB_ALPHA && bit_depth == 8 ) {
+       bytes=4;
+    }
+    else {
+       bytes=0;
+    }
+    if ( bytes == 0 || nbits != bytes*8 || interlace != PNG_INTERLACE_NONE ||
+         png_get_rowbytes(png_ptr, info_ptr) != (png_uint_32)(width*bytes) ) {
+       png_destroy_read_struct(&png_ptr, &info_ptr,&end_info);
+       return (1);
+    }
+
+/*     Unpack and scale one row at a time   */
+    row=(png_bytep)malloc(width*bytes);
+    if (row == NULL) {
+       png_destroy_read_struct(&png_ptr, &info_ptr,&end_info);
+       return (1);
+    }
+    n=0;
+    for (j=0;j<height && n<ndpts;j++) {
+      png_read_row(png_ptr, row, NULL);
+      ptr=row;
+      for (i=0;i<width && n<ndpts;i++) {
+        switch (bytes) {
+          case 1:
+            ival=ptr[0];
+            break;
+          case 2:
+            ival=((g2int)ptr[0] << 8) | ptr[1];
+            break;
+          case 3:
+            ival=((g2int)ptr[0] << 16) | ((g2int)ptr[1] << 8) | ptr[2];
+            break;
+          default:
+            ival=(g2int)(((unsigned int)ptr[0] << 24) | ((g2int)ptr[1] << 16) |
+                         ((g2int)ptr[2] << 8) | ptr[3]);
+            break;
+        }
+        ptr+=bytes;
+        fld[n++]=(((g2float)ival*bscale)+ref)*dscale;
+      }
+    }
+/*     Any points past the image are 0 (as in pngunpack's calloc)   */
+    for (;n<ndpts;n++) {
+      fld[n]=ref*dscale;
+    }
+
+/*      Clean up   */
+    free(row);
+    png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+    return 0;
+
+}
 #endif   /* USE_PNG */
@@ -10,8 +10,8 @@ g2int g2_unpack4(unsigned char *,g2int *,g2int *,g2int **,
                          g2int *,g2float **,g2int *);
 g2int g2_unpack5(unsigned char *,g2int *,g2int *,g2int *, g2int **,g2int *);
 g2int g2_unpack6(unsigned char *,g2int *,g2int ,g2int *, g2int **);
-g2int g2_unpack7(unsigned char *,g2int *,g2int ,g2int *,
-                         g2int ,g2int *,g2int ,g2float **);
+g2int g2_unpack7win(unsigned char *,g2int *,g2int ,g2int *,
+                    g2int ,g2int *,g2int ,g2int ,g2int ,g2float **);
 
 g2int g2_getfld(unsigned char *cgrib,g2int ifldnum,g2int unpack,g2int expand,
                 gribfield **gfld)
@@ -35,6 +35,7 @@ g2int g2_getfld(unsigned char *cgrib,g2int ifldnum,g2int unpack,g2int expand,
 // PROGRAM HISTORY LOG:
 // 2002-10-28  Gilbert
 // 2013-08-08  Vuong    Free up memory in array igds - free(igds)
+// 2026-10     Taylor   Moved to g2_getfldwin.
 //
 // USAGE:    #include "grib2.h"
 //           int g2_getfld(unsigned char *cgrib,g2int ifldnum,g2int unpack,
@@ -244,10 +245,45 @@ g2int g2_getfld(unsigned char *cgrib,g2int ifldnum,g2int unpack,g2int expand,
 //   MACHINE:  
 //
 //$$$
+{
+      return(g2_getfldwin(cgrib,ifldnum,unpack,expand,0,-1,gfld));
+}
+
+
+g2int g2_getfldwin(unsigned char *cgrib,g2int ifldnum,g2int unpack,
+                   g2int expand,g2int first,g2int last,gribfield **gfld)
+//$$$  SUBPROGRAM DOCUMENTATION BLOCK
+//                .      .    .                                       .
+// SUBPROGRAM:    g2_getfldwin
+//
+// ABSTRACT: Same as g2_getfld, but the caller only needs the values of
+//   grid points first..last (in the order they are stored in the message).
+//   The data values of the other grid points may not be unpacked (and are
+//   then returned as zero).  See g2_unpack7win.  The bitmap (if any) is
+//   always unpacked in full.
+//
+// PROGRAM HISTORY LOG:
+// 2026-10  Taylor  - Created from g2_getfld.
+//
+// USAGE:    #include "grib2.h"
+//           int g2_getfldwin(unsigned char *cgrib,g2int ifldnum,
+//                            g2int unpack,g2int expand,g2int first,
+//                            g2int last,gribfield **gfld)
+//   INPUT ARGUMENTS:
+//     See g2_getfld, plus
+//     first    - First grid point needed (0 based).
+//     last     - Last grid point needed (0 based).  If last < 0, the
+//                whole field is needed.
+//
+//   OUTPUT ARGUMENT:
+//     See g2_getfld.
+//
+//$$$
 {
     
       g2int have3,have4,have5,have6,have7,ierr,jerr;
       g2int numfld,j,n,istart,iofst,ipos;
+      g2int dfirst,dlast;
       g2int disc,ver,lensec0,lengrib,lensec,isecnum;
       g2int  *igds;
       g2int *bmpsave;
@@ -482,9 +518,26 @@ g2int g2_getfld(unsigned char *cgrib,g2int ifldnum,g2int unpack,g2int expand,
         //
         if (isecnum==7 && numfld==ifldnum && unpack) {
           iofst=iofst-40;       // reset offset to beginning of section
-          jerr=g2_unpack7(cgrib,&iofst,lgfld->igdtnum,lgfld->igdtmpl,
-                          lgfld->idrtnum,lgfld->idrtmpl,lgfld->ndpts,
-                          &lgfld->fld);
+          //  Convert the grid points needed to data points.
+          dfirst=0;
+          dlast=lgfld->ndpts-1;
+          if ( last >= 0 ) {
+             if ( lgfld->ibmap != 255 && lgfld->bmap != 0 ) {
+                n=0;
+                for (j=0;j<=last && j<lgfld->ngrdpts;j++) {
+                   if (j==first) dfirst=n;
+                   if (lgfld->bmap[j]==1) n++;
+                }
+                dlast=n-1;
+             }
+             else {
+                dfirst=first;
+                dlast=last;
+             }
+          }
+          jerr=g2_unpack7win(cgrib,&iofst,lgfld->igdtnum,lgfld->igdtmpl,
+                             lgfld->idrtnum,lgfld->idrtmpl,lgfld->ndpts,
+                             dfirst,dlast,&lgfld->fld);
           if (jerr == 0) {
             have7=1;
             //  If bitmap is used with this field, expand data field 
@@ -4,8 +4,11 @@
 #include <string.h>
 #include "grib2.h"
 
-g2int simunpack(unsigned char *,g2int *, g2int,g2float *);
-int comunpack(unsigned char *,g2int,g2int,g2int *,g2int,g2float *);
+g2int simunpackwin(unsigned char *,g2int *,g2int,g2int,g2int,g2float *);
+int comunpackwin(unsigned char *,g2int,g2int,g2int *,g2int,g2int,g2int,
+                 g2float *);
+g2int g2_unpack7win(unsigned char *,g2int *,g2int ,g2int *,
+                    g2int ,g2int *,g2int ,g2int ,g2int ,g2float **);
 g2int specunpack(unsigned char *,g2int *,g2int,g2int,g2int, g2int, g2float *);
 #ifdef USE_PNG
   g2int pngunpack(unsigned char *,g2int,g2int *,g2int, g2float *);
@@ -34,6 +37,7 @@ g2int g2_unpack7(unsigned char *cgrib,g2int *iofst,g2int igdsnum,g2int *igdstmpl
 //                        PNG now allowed to use WMO Template no. 5.41
 // 2004-12-16  Taylor   - Added check on comunpack return code.
 // 2008-12-23  Wesley   - Initialize Number of data points unpacked
+// 2026-10     Taylor   - Moved to g2_unpack7win.
 //
 // USAGE:    int g2_unpack7(unsigned char *cgrib,g2int *iofst,g2int igdsnum,
 //                          g2int *igdstmpl, g2int idrsnum,
@@ -77,6 +81,43 @@ g2int g2_unpack7(unsigned char *cgrib,g2int *iofst,g2int igdsnum,g2int *igdstmpl
 //   MACHINE:
 //
 //$$$//
+{
+      return(g2_unpack7win(cgrib,iofst,igdsnum,igdstmpl,idrsnum,idrstmpl,
+                           ndpts,0,ndpts-1,fld));
+}
+
+
+g2int g2_unpack7win(unsigned char *cgrib,g2int *iofst,g2int igdsnum,
+                    g2int *igdstmpl,g2int idrsnum,g2int *idrstmpl,
+                    g2int ndpts,g2int first,g2int last,g2float **fld)
+//$$$  SUBPROGRAM DOCUMENTATION BLOCK
+//                .      .    .                                       .
+// SUBPROGRAM:    g2_unpack7win
+//
+// ABSTRACT: Same as g2_unpack7, but the caller only needs data points
+//   first..last.  For simple (5.0) and complex (5.2, 5.3) packing only
+//   those points (and for 5.3 the points before them) are unpacked, and
+//   the rest of fld is zero.  Other templates unpack everything.
+//
+// PROGRAM HISTORY LOG:
+// 2026-10  Taylor  - Created from g2_unpack7.
+//
+// USAGE:    int g2_unpack7win(unsigned char *cgrib,g2int *iofst,
+//                          g2int igdsnum,g2int *igdstmpl, g2int idrsnum,
+//                          g2int *idrstmpl, g2int ndpts,g2int first,
+//                          g2int last,g2float **fld)
+//   INPUT ARGUMENTS:
+//     See g2_unpack7, plus
+//     first    - First data point needed (0 based).
+//     last     - Last data point needed (0 based).
+//
+//   OUTPUT ARGUMENTS:
+//     See g2_unpack7.
+//
+//   RETURN VALUES:
+//     See g2_unpack7.
+//
+//$$$//
 {
       g2int ierr,isecnum;
       g2int ipos,lensec;
@@ -107,14 +148,15 @@ g2int g2_unpack7(unsigned char *cgrib,g2int *iofst,g2int igdsnum,g2int *igdstmpl
       }
 
       if (idrsnum == 0) 
-        simunpack(cgrib+ipos,idrstmpl,ndpts,lfld);
+        simunpackwin(cgrib+ipos,idrstmpl,ndpts,first,last,lfld);
       else if (idrsnum == 2 || idrsnum == 3) {
-        if (comunpack(cgrib+ipos,lensec,idrsnum,idrstmpl,ndpts,lfld) != 0) {
+        if (comunpackwin(cgrib+ipos,lensec,idrsnum,idrstmpl,ndpts,first,last,
+                         lfld) != 0) {
           return 7;
         }
       }
       else if (idrsnum == 50) {            // Spectral Simple
-        simunpack(cgrib+ipos,idrstmpl,ndpts-1,lfld+1);
+        simunpackwin(cgrib+ipos,idrstmpl,ndpts-1,0,ndpts-2,lfld+1);
         rdieee(idrstmpl+4,lfld+0,1);
       }
       else if (idrsnum == 51)              //  Spectral complex
@@ -11,6 +11,87 @@ void sbit(unsigned char *out,g2int *in,g2int iskip,g2int nbyte)
 }
 
 
+static void gbits_contig(unsigned char *in,g2int *iout,g2int iskip,
+                         g2int nbyte,g2int n)
+/*          Get bits for the case of contiguous (nskip = 0) values of 1 to
+/          24 bits.  Byte aligned 8 and 16 bit values and 1 bit values
+/          (bitmaps) have their own loops.  Everything else keeps a bit
+/          buffer, so it doesn't have to find the byte and bit offset of
+/          each value, and only reads the bytes it needs.
+/           *in    = pointer to character array input
+/           *iout  = pointer to unpacked array output
+/            iskip = initial number of bits to skip
+/            nbyte = number of bits to take (1 to 24)
+/            n     = number of iterations (> 0)
+*/
+{
+      g2int i,k,ibit,index;
+      g2intu acc,mask;
+      int accbits;
+
+      index=iskip/8;
+      ibit=iskip%8;
+
+//     byte aligned 8 bit values
+      if (nbyte == 8 && ibit == 0) {
+         in += index;
+         for (i=0;i<n;i++) {
+            iout[i] = (g2int)in[i];
+         }
+         return;
+      }
+
+//     byte aligned 16 bit values
+      if (nbyte == 16 && ibit == 0) {
+         in += index;
+         for (i=0;i<n;i++) {
+            iout[i] = ((g2int)in[2*i] << 8) | (g2int)in[2*i+1];
+         }
+         return;
+      }
+
+//     1 bit values, 8 at a time once we are byte aligned
+      if (nbyte == 1) {
+         i = 0;
+         if (ibit != 0) {
+            for (k=7-ibit;k>=0 && i<n;k--) {
+               iout[i++] = (in[index] >> k) & 1;
+            }
+            index++;
+         }
+         for (;i+8<=n;i+=8) {
+            acc = in[index++];
+            iout[i]   = (acc >> 7) & 1;
+            iout[i+1] = (acc >> 6) & 1;
+            iout[i+2] = (acc >> 5) & 1;
+            iout[i+3] = (acc >> 4) & 1;
+            iout[i+4] = (acc >> 3) & 1;
+            iout[i+5] = (acc >> 2) & 1;
+            iout[i+6] = (acc >> 1) & 1;
+            iout[i+7] = acc & 1;
+         }
+         for (k=7;i<n;k--) {
+            iout[i++] = (in[index] >> k) & 1;
+         }
+         return;
+      }
+
+//     everything else: the low order accbits (< nbyte + 8 <= 32) bits of
+//     acc are the next bits of the input
+      mask = ((g2intu)1 << nbyte) - 1;
+      acc = in[index++] & (0xff >> ibit);
+      accbits = 8 - ibit;
+      for (i=0;i<n;i++) {
+         while (accbits < nbyte) {
+            acc = (acc << 8) | in[index++];
+            accbits += 8;
+         }
+         accbits -= nbyte;
+         iout[i] = (g2int)((acc >> accbits) & mask);
+      }
+}
+
+
 void gbits(unsigned char *in,g2int *iout,g2int iskip,g2int nbyte,g2int nskip,
            g2int n)
 /*          Get bits - unpack bits:  Extract arbitrary size values from a
@@ -29,6 +110,13 @@ void gbits(unsigned char *in,g2int *iout,g2int iskip,g2int nbyte,g2int nskip,
       g2int nbit,index;
       static g2int ones[]={1,3,7,15,31,63,127,255};
 
+//     Contiguous values (nskip == 0) of 1 to 24 bits are the usual case
+//     (simple and complex packing, bitmaps), so use a kernel for them
+      if (nskip == 0 && nbyte > 0 && nbyte <= 24 && n > 0) {
+         gbits_contig(in,iout,iskip,nbyte,n);
+         return;
+      }
+
 //     nbit is the start position of the field in bits
       nbit = iskip;
       for (i=0;i<n;i++) {
@@ -216,7 +216,10 @@ typedef struct gribfield gribfield;
 void seekgb(FILE *,g2int ,g2int ,g2int *,g2int *);
 g2int g2_info(unsigned char *,g2int *,g2int *,g2int *,g2int *);
 g2int g2_getfld(unsigned char *,g2int ,g2int ,g2int ,gribfield **);
+g2int g2_getfldwin(unsigned char *,g2int ,g2int ,g2int ,g2int ,g2int ,
+                   gribfield **);
 void g2_free(gribfield *);
+void g2_setjpcthreads(g2int );
 
 /*  Prototypes for packing API  */
 g2int g2_create(unsigned char *,g2int *,g2int *);
@@ -250,6 +253,12 @@ int pack_gp(g2int *, g2int *, g2int *,
             g2int *, g2int *, g2int *, g2int *,
             g2int *, g2int *, g2int *, g2int *, g2int *,
             g2int *, g2int *, g2int *);
+int pack_gpmt(g2int *, g2int *, g2int *,
+              g2int *, g2int *, g2int *, g2int *, g2int *,
+              g2int *, g2int *, g2int *, g2int *,
+              g2int *, g2int *, g2int *, g2int *, g2int *,
+              g2int *, g2int *, g2int *);
+void g2_setpackthreads(g2int );
 
 #endif  /*  _grib2_H  */
 
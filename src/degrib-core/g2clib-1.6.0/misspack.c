@@ -20,6 +20,8 @@ void misspack(g2float *fld,g2int ndpts,g2int idrsnum,g2int *idrstmpl,
 //
 // PROGRAM HISTORY LOG:
 // 2000-06-21  Gilbert
+// 2026-10     Taylor - Determine the groups with pack_gpmt, which may
+//                      split large fields among threads.
 //
 // USAGE:    misspack(g2float *fld,g2int ndpts,g2int idrsnum,g2int *idrstmpl,
 //                    unsigned char *cpack, g2int *lcpack)
@@ -302,9 +304,9 @@ void misspack(g2float *fld,g2int ndpts,g2int idrsnum,g2int *idrstmpl,
            jmin = calloc(maxgrps,sizeof(g2int));
            jmax = calloc(maxgrps,sizeof(g2int));
            lbit = calloc(maxgrps,sizeof(g2int));
-           pack_gp(&kfildo,ifld,&ndpts,&missopt,&minpk,&inc,&miss1,&miss2,
-                        jmin,jmax,lbit,glen,&maxgrps,&ngroups,&ibit,&jbit,
-                        &kbit,&novref,&lbitref,&ier);
+           pack_gpmt(&kfildo,ifld,&ndpts,&missopt,&minpk,&inc,&miss1,&miss2,
+                      jmin,jmax,lbit,glen,&maxgrps,&ngroups,&ibit,&jbit,
+                      &kbit,&novref,&lbitref,&ier);
            //printf("SAGier = %d %d %d %d %d %d\n",ier,ibit,jbit,kbit,novref,lbitref);
            for ( ng=0; ng<ngroups; ng++) glen[ng]=glen[ng]+novref;
            free(jmin);
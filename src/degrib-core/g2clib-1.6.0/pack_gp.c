@@ -28,24 +28,26 @@ typedef g2int logical;
 
     const  integer mallow = 1073741825;   /*  MALLOW=2**30+1  */
     static integer ifeed = 12;
-    static integer ifirst = 0;
+    integer ifirst = 0;
 
     /* System generated locals */
     integer i__1, i__2, i__3;
 
     /* Local variables */
-    static integer j, k, l;
-    static logical adda;
-    static integer ired, kinc, mina, maxa, minb, maxb, minc, maxc, ibxx2[31];
-    static char cfeed[1];
-    static integer nenda, nendb, ibita, ibitb, minak, minbk, maxak, maxbk, 
-	    minck, maxck, nouta, lmiss, itest, nount;
+    integer j, k, l;
+    logical adda;
+    integer ired, kinc, mina = 0, maxa = 0, minb = 0, maxb = 0, minc = 0,
+	    maxc = 0, ibxx2[31];
+    char cfeed[1];
+    integer nenda, nendb = 0, ibita, ibitb = 0, minak = 0, minbk = 0,
+	    maxak = 0, maxbk = 0, minck = 0, maxck = 0, nouta, lmiss, itest,
+	    nount;
     extern /* Subroutine */ int reduce(integer *, integer *, integer *, 
 	    integer *, integer *, integer *, integer *, integer *, integer *, 
 	    integer *, integer *, integer *, integer *);
-    static integer ibitbs, mislla, misllb, misllc, iersav, lminpk, ktotal, 
-	    kounta, kountb, kstart, mstart, mintst, maxtst, 
-	    kounts, mintstk, maxtstk;
+    integer ibitbs, mislla = 0, misllb = 0, misllc = 0, iersav, lminpk,
+	    ktotal, kounta, kountb = 0, kstart, mstart, mintst = 0, maxtst = 0,
+	    kounts, mintstk = 0, maxtstk = 0;
     integer *misslx;
 
 
@@ -110,6 +112,9 @@ typedef g2int logical;
 /*        MARCH    2002   GLAHN   ADDED NON FATAL IER = 716, 717; */
 /*                                REMOVED NENDB=NXY ABOVE 150; */
 /*                                ADDED IERSAV=0; COMMENTS */
+/*        OCTOBER  2026   TAYLOR  REMOVED THE STATIC LOCALS SO SEVERAL */
+/*                                THREADS CAN CALL PACK_GP (SEE PACK_GPMT) */
+/*                                AND STARTED THEM AT ZERO AS BEFORE */
 
 /*        PURPOSE */
 /*            DETERMINES GROUPS OF VARIABLE SIZE, BUT AT LEAST OF */
@@ -0,0 +1,312 @@
+#include <stdlib.h>
+#include "grib2.h"
+
+int reduce(g2int *, g2int *, g2int *, g2int *, g2int *, g2int *, g2int *,
+           g2int *, g2int *, g2int *, g2int *, g2int *, g2int *);
+
+// Segments of the field may be grouped on several POSIX threads.
+#if !defined(_WINDOWS_) && !defined(MS_WINDOWS) && !defined(_WIN32)
+#define PACK_GP_THREADS
+#include <pthread.h>
+#endif
+
+// Number of values in each independently grouped segment.  Fields smaller
+// than two segments are always grouped by a single call to pack_gp.
+#define PACK_GP_SEGLEN 131072
+
+// Number of threads pack_gpmt may use.
+static int packNumThreads = 1;
+
+// The work and results of pack_gp for one segment of the field.
+typedef struct {
+    g2int *ic;        // First value of the segment.
+    g2int nxy;        // Number of values in the segment.
+    g2int ndg;        // Dimension of the segment's jmin/jmax/lbit/nov.
+    g2int *jmin, *jmax, *lbit, *nov;
+    g2int lx, ibit, jbit, kbit, novref, lbitref, ier;
+} gpsegtype;
+
+// The arguments to pack_gp that are the same for every segment.
+typedef struct {
+    g2int *kfildo, *is523, *minpk, *inc, *missp, *misss;
+    gpsegtype *seg;
+    int numseg;
+    int nextseg;      // Next segment a thread should group.
+#ifdef PACK_GP_THREADS
+    pthread_mutex_t mutex;
+#endif
+} gppooltype;
+
+   void g2_setpackthreads(g2int nthreads)
+/*$$$  SUBPROGRAM DOCUMENTATION BLOCK
+*                .      .    .                                       .
+* SUBPROGRAM:    g2_setpackthreads  Sets threads used by pack_gpmt
+*   PRGMMR: Taylor           ORG: MDL         DATE: 2026-10-18
+*
+* ABSTRACT: This Function sets how many threads later calls to pack_gpmt
+*   (complex packing, DRT 5.2 and 5.3) may use to determine the groups.
+*
+* PROGRAM HISTORY LOG:
+* 2026-10  Taylor
+*
+* USAGE:     void g2_setpackthreads(g2int nthreads)
+*
+*   INPUT ARGUMENTS:
+*      nthreads - Number of threads (values < 1 are treated as 1).
+*
+* REMARKS:
+*
+*      The setting is process wide.  With 1 thread, pack_gpmt is pack_gp.
+*
+*$$$*/
+{
+    packNumThreads = (nthreads < 1) ? 1 : (int)nthreads;
+}
+
+static void gpsegment(gppooltype *pool, gpsegtype *seg)
+//
+//   Calls pack_gp for one segment, and adds the segment's references back
+//   into its group sizes and widths so the segments can be merged.
+//
+{
+    g2int k;
+
+    pack_gp(pool->kfildo,seg->ic,&seg->nxy,pool->is523,pool->minpk,
+            pool->inc,pool->missp,pool->misss,seg->jmin,seg->jmax,
+            seg->lbit,seg->nov,&seg->ndg,&seg->lx,&seg->ibit,&seg->jbit,
+            &seg->kbit,&seg->novref,&seg->lbitref,&seg->ier);
+    for (k=0;k<seg->lx;k++) {
+       seg->nov[k]+=seg->novref;
+       seg->lbit[k]+=seg->lbitref;
+    }
+}
+
+#ifdef PACK_GP_THREADS
+static void *gpworker(void *arg)
+//
+//   Thread procedure: groups segments until there are none left.
+//
+{
+    gppooltype *pool=(gppooltype *)arg;
+    int segno;
+
+    for (;;) {
+       pthread_mutex_lock(&pool->mutex);
+       segno=pool->nextseg++;
+       pthread_mutex_unlock(&pool->mutex);
+       if (segno >= pool->numseg) break;
+       gpsegment(pool,&pool->seg[segno]);
+    }
+    return 0;
+}
+#endif
+
+static int nbits(g2int val)
+//
+//   The number of bits pack_gp needs to hold val (val < 2**nbits).
+//
+{
+    int n=0;
+
+    while (n < 31 && val >= ((g2int)1 << n)) n++;
+    return n;
+}
+
+static void gprefs(g2int *lbit, g2int *nov, g2int lx, g2int *jbit,
+                   g2int *kbit, g2int *novref, g2int *lbitref)
+//
+//   Removes the references from the group widths and sizes, and finds the
+//   bits needed to pack them, as pack_gp does.
+//
+{
+    g2int l;
+    int k;
+
+    *lbitref=lbit[0];
+    *novref=nov[0];
+    for (l=1;l<lx;l++) {
+       if (lbit[l] < *lbitref) *lbitref=lbit[l];
+       if (nov[l] < *novref) *novref=nov[l];
+    }
+    *jbit=0;
+    *kbit=0;
+    for (l=0;l<lx;l++) {
+       lbit[l]-=*lbitref;
+       if (*novref > 0) nov[l]-=*novref;
+       k=nbits(lbit[l]);
+       if (k > *jbit) *jbit=k;
+       k=nbits(nov[l]);
+       if (k > *kbit) *kbit=k;
+    }
+}
+
+int pack_gpmt(g2int *kfildo, g2int *ic, g2int *nxy, g2int *is523,
+              g2int *minpk, g2int *inc, g2int *missp, g2int *misss,
+              g2int *jmin, g2int *jmax, g2int *lbit, g2int *nov,
+              g2int *ndg, g2int *lx, g2int *ibit, g2int *jbit,
+              g2int *kbit, g2int *novref, g2int *lbitref, g2int *ier)
+//$$$  SUBPROGRAM DOCUMENTATION BLOCK
+//                .      .    .                                       .
+// SUBPROGRAM:    pack_gpmt
+//   PRGMMR: Taylor           ORG: MDL         DATE: 2026-10-18
+//
+// ABSTRACT: This subroutine determines the groups for complex packing,
+//   with the same arguments and results as pack_gp.  Large fields are
+//   split into segments of PACK_GP_SEGLEN values, each segment is grouped
+//   by pack_gp on one of g2_setpackthreads() threads, and the groups are
+//   joined in order.  The bits needed to pack the group references, widths
+//   and sizes (IBIT, JBIT, KBIT, NOVREF and LBITREF) are then recomputed
+//   for the whole field, and reduce splits the largest groups, as at the
+//   end of pack_gp.
+//
+// PROGRAM HISTORY LOG:
+// 2026-10  Taylor
+//
+// USAGE:    Same as pack_gp.
+//
+// REMARKS:
+//
+//   A group never spans two segments, so the packed field may be a little
+//   larger than with pack_gp, but it is an ordinary DRT 5.2/5.3 field and
+//   it does not depend on the number of threads (only on whether it is 1).
+//   If the joined groups would not fit in NDG, or pack_gp returns a fatal
+//   error for a segment, the whole field is grouped by pack_gp instead.
+//
+//$$$
+{
+    gppooltype pool;
+    gpsegtype *seg;
+    g2int *work, total, k, l, ngroups, ier1, ier2, ibxx2[31];
+    int numseg, numthreads, i, f_fatal;
+#ifdef PACK_GP_THREADS
+    pthread_t *threads;
+#endif
+
+    numseg=(int)(*nxy/PACK_GP_SEGLEN);
+    if (packNumThreads <= 1 || numseg < 2) {
+       return pack_gp(kfildo,ic,nxy,is523,minpk,inc,missp,misss,jmin,jmax,
+                      lbit,nov,ndg,lx,ibit,jbit,kbit,novref,lbitref,ier);
+    }
+    seg=(gpsegtype *)calloc(numseg,sizeof(gpsegtype));
+    total=(*nxy/(*minpk))+numseg;
+    work=(g2int *)malloc(4*total*sizeof(g2int));
+    if (seg == 0 || work == 0) {
+       free(seg);
+       free(work);
+       return pack_gp(kfildo,ic,nxy,is523,minpk,inc,missp,misss,jmin,jmax,
+                      lbit,nov,ndg,lx,ibit,jbit,kbit,novref,lbitref,ier);
+    }
+    //
+    //  Split the field.  The last segment takes the remainder.
+    //
+    k=0;
+    for (i=0;i<numseg;i++) {
+       seg[i].ic=ic+i*PACK_GP_SEGLEN;
+       seg[i].nxy=(i == numseg-1) ? *nxy-i*PACK_GP_SEGLEN : PACK_GP_SEGLEN;
+       seg[i].ndg=(seg[i].nxy/(*minpk))+1;
+       seg[i].jmin=work+k;
+       seg[i].jmax=work+total+k;
+       seg[i].lbit=work+2*total+k;
+       seg[i].nov=work+3*total+k;
+       k+=seg[i].ndg;
+    }
+    pool.kfildo=kfildo;
+    pool.is523=is523;
+    pool.minpk=minpk;
+    pool.inc=inc;
+    pool.missp=missp;
+    pool.misss=misss;
+    pool.seg=seg;
+    pool.numseg=numseg;
+    pool.nextseg=0;
+    //
+    //  Group the segments.
+    //
+    numthreads=(packNumThreads < numseg) ? packNumThreads : numseg;
+#ifdef PACK_GP_THREADS
+    threads=(pthread_t *)malloc(numthreads*sizeof(pthread_t));
+    pthread_mutex_init(&pool.mutex,0);
+    for (i=0;(threads != 0) && (i<numthreads-1);i++) {
+       if (pthread_create(&threads[i],0,gpworker,&pool) != 0) break;
+    }
+    // The calling thread is the last worker (or the only one, if no other
+    // thread could be started).
+    gpworker(&pool);
+    while (threads != 0 && i > 0) pthread_join(threads[--i],0);
+    pthread_mutex_destroy(&pool.mutex);
+    free(threads);
+#else
+    for (i=0;i<numseg;i++) gpsegment(&pool,&seg[i]);
+#endif
+    //
+    //  Join the groups, or give up if they don't fit or a segment failed.
+    //
+    ngroups=0;
+    ier1=0;
+    f_fatal=0;
+    *ibit=0;
+    for (i=0;i<numseg;i++) {
+       ngroups+=seg[i].lx;
+       if (seg[i].ier != 0) {
+          if (seg[i].ier < 714 || seg[i].ier > 717) f_fatal=1;
+          // A segment's reduce aborting (714, 715) is redone below.
+          if (seg[i].ier > 715) ier1=seg[i].ier;
+       }
+       if (seg[i].ibit > *ibit) *ibit=seg[i].ibit;
+    }
+    if (f_fatal || ngroups > *ndg) {
+       free(seg);
+       free(work);
+       return pack_gp(kfildo,ic,nxy,is523,minpk,inc,missp,misss,jmin,jmax,
+                      lbit,nov,ndg,lx,ibit,jbit,kbit,novref,lbitref,ier);
+    }
+    *lx=0;
+    for (i=0;i<numseg;i++) {
+       k=0;
+       for (l=0;l<seg[i].lx;l++) {
+          jmin[*lx]=seg[i].jmin[l];
+          jmax[*lx]=seg[i].jmax[l];
+          lbit[*lx]=seg[i].lbit[l];
+          nov[*lx]=seg[i].nov[l];
+          // pack_gp gives groups of only primary missing values the
+          // largest reference that IBIT bits can hold.
+          if (*is523 == 1 && lbit[*lx] == 0 && seg[i].ic[k] == *missp)
+             jmin[*lx]=((g2int)1 << *ibit)-1;
+          k+=nov[*lx];
+          (*lx)++;
+       }
+    }
+    free(seg);
+    //
+    //  Each segment's large groups were only split to suit that segment's
+    //  group sizes, so let reduce split them again for the whole field.
+    //  Reduce can abort part way, so keep a copy of the groups to go back
+    //  to if it does.
+    //
+    for (l=0;l<*lx;l++) {
+       work[l]=jmin[l];
+       work[total+l]=jmax[l];
+       work[2*total+l]=lbit[l];
+       work[3*total+l]=nov[l];
+    }
+    ngroups=*lx;
+    gprefs(lbit,nov,*lx,jbit,kbit,novref,lbitref);
+    ibxx2[0]=1;
+    for (i=1;i<=30;i++) ibxx2[i]=ibxx2[i-1] << 1;
+    reduce(kfildo,jmin,jmax,lbit,nov,lx,ndg,ibit,jbit,kbit,novref,ibxx2,
+           &ier2);
+    if (ier2 == 714 || ier2 == 715) {
+       *lx=ngroups;
+       for (l=0;l<*lx;l++) {
+          jmin[l]=work[l];
+          jmax[l]=work[total+l];
+          lbit[l]=work[2*total+l];
+          nov[l]=work[3*total+l];
+       }
+       gprefs(lbit,nov,*lx,jbit,kbit,novref,lbitref);
+       ier1=ier2;
+    }
+    free(work);
+    *ier=ier1;
+    return 0;
+}
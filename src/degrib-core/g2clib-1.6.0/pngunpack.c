@@ -3,6 +3,8 @@
 #include "grib2.h"
 
 int dec_png(unsigned char *,g2int *,g2int *,char *);
+int dec_pngfld(unsigned char *,g2int ,g2float ,g2float ,g2float ,g2int ,
+               g2float *);
 
 g2int pngunpack(unsigned char *cpack,g2int len,g2int *idrstmpl,g2int ndpts,
                 g2float *fld)
@@ -17,6 +19,8 @@ g2int pngunpack(unsigned char *cpack,g2int len,g2int *idrstmpl,g2int ndpts,
 //
 // PROGRAM HISTORY LOG:
 // 2003-08-27  Gilbert
+// 2026-10     Taylor - Try dec_pngfld first, which scales the PNG rows
+//                      straight into fld.
 //
 // USAGE:    pngunpack(unsigned char *cpack,g2int len,g2int *idrstmpl,g2int ndpts,
 //                     g2float *fld)
@@ -54,6 +58,13 @@ g2int pngunpack(unsigned char *cpack,g2int len,g2int *idrstmpl,g2int ndpts,
 //
       if (nbits != 0) {
 
+//
+//  Most PNG fields can be unpacked a row at a time, without the full grid
+//  byte and integer copies below.
+//
+         if (dec_pngfld(cpack,nbits,ref,bscale,dscale,ndpts,fld) == 0) {
+            return(0);
+         }
          ifld=(g2int *)calloc(ndpts,sizeof(g2int));
          ctemp=(unsigned char *)calloc(ndpts*4,1);
          if ( ifld == 0 || ctemp == 0) {
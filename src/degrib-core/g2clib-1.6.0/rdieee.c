@@ -11,6 +11,7 @@ void rdieee(g2int *rieee,g2float *a,g2int num)
 //
 // PROGRAM HISTORY LOG:
 // 2002-10-25  Gilbert
+// 2026-10     Taylor  - two23 and two126 are constants (thread safe).
 //
 // USAGE:    void rdieee(g2int *rieee,g2float *a,g2int num)
 //   INPUT ARGUMENT LIST:
@@ -34,18 +35,14 @@ void rdieee(g2int *rieee,g2float *a,g2int num)
       g2int  isign,iexp,imant;
 
       g2float  sign,temp;
-      static g2float  two23,two126;
-      static g2int test=0;
+      // 2**-23 and 2**-126 (exact), as constants so that several threads
+      // can read values at the same time.
+      const g2float  two23=(g2float)1.1920928955078125e-07;
+      const g2float  two126=(g2float)1.1754943508222875e-38;
       g2intu msk1=0x80000000;        // 10000000000000000000000000000000 binary
       g2int msk2=0x7F800000;         // 01111111100000000000000000000000 binary
       g2int msk3=0x007FFFFF;         // 00000000011111111111111111111111 binary
 
-      if ( test == 0 ) {
-         two23=(g2float)int_power(2.0,-23);
-         two126=(g2float)int_power(2.0,-126);
-         test=1;
-      }
-
       for (j=0;j<num;j++) {
 //
 //  Extract sign bit, exponent, and mantissa
@@ -29,11 +29,11 @@ typedef g2float real;
     integer i__1, i__2;
 
     /* Local variables */
-    static integer newboxtp, j, l, m, jj, lxn, left;
-    static real pimp;
-    static integer move, novl;
-    static char cfeed[1];
-    static integer nboxj[31], lxnkp, iorigb, ibxx2m1, movmin,
+    integer newboxtp = 0, j, l, m, jj, lxn, left;
+    real pimp;
+    integer move, novl;
+    char cfeed[1];
+    integer nboxj[31], lxnkp, iorigb, ibxx2m1, movmin,
 	     ntotbt[31], ntotpr, newboxt;
     integer *newbox, *newboxp;
 
@@ -41,6 +41,8 @@ typedef g2float real;
 /*        NOVEMBER 2001   GLAHN   TDL   GRIB2 */
 /*        MARCH    2002   GLAHN   COMMENT IER = 715 */
 /*        MARCH    2002   GLAHN   MODIFIED TO ACCOMMODATE LX=1 ON ENTRY */
+/*        OCTOBER  2026   TAYLOR  REMOVED THE STATIC LOCALS SO SEVERAL */
+/*                                THREADS CAN CALL REDUCE (SEE PACK_GPMT) */
 
 /*        PURPOSE */
 /*            DETERMINES WHETHER THE NUMBER OF GROUPS SHOULD BE */
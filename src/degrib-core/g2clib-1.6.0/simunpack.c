@@ -3,6 +3,8 @@
 #include "grib2.h"
 
 
+g2int simunpackwin(unsigned char *,g2int *,g2int,g2int,g2int,g2float *);
+
 g2int simunpack(unsigned char *cpack,g2int *idrstmpl,g2int ndpts,g2float *fld)
 ////$$$  SUBPROGRAM DOCUMENTATION BLOCK
 //                .      .    .                                       .
@@ -36,10 +38,46 @@ g2int simunpack(unsigned char *cpack,g2int *idrstmpl,g2int ndpts,g2float *fld)
 //   MACHINE:  
 //
 //$$$//
+{
+
+      return(simunpackwin(cpack,idrstmpl,ndpts,0,ndpts-1,fld));
+}
+
+
+g2int simunpackwin(unsigned char *cpack,g2int *idrstmpl,g2int ndpts,
+                   g2int first,g2int last,g2float *fld)
+////$$$  SUBPROGRAM DOCUMENTATION BLOCK
+//                .      .    .                                       .
+// SUBPROGRAM:    simunpackwin
+//
+// ABSTRACT: Same as simunpack, but only unpacks data values first..last.
+//   Since every value is packed with the same number of bits, this seeks
+//   straight to the bits of value "first".
+//
+// PROGRAM HISTORY LOG:
+// 2026-10  Taylor  - Split out of simunpack.
+//
+// USAGE:    int simunpackwin(unsigned char *cpack,g2int *idrstmpl,
+//                            g2int ndpts,g2int first,g2int last,g2float *fld)
+//   INPUT ARGUMENT LIST:
+//     cpack    - pointer to the packed data field.
+//     idrstmpl - pointer to the array of values for Data Representation
+//                Template 5.0
+//     ndpts    - The number of data values in the field
+//     first    - First data value to unpack (0 based).
+//     last     - Last data value to unpack (0 based).
+//
+//   OUTPUT ARGUMENT LIST:
+//     fld      - Contains the unpacked data values (first..last).  The
+//                rest of fld is left alone.
+//
+// REMARKS: None
+//
+//$$$//
 {
 
       g2int  *ifld;
-      g2int  j,nbits,itype;
+      g2int  j,nbits,itype,n;
       g2float ref,bscale,dscale;
 
       
@@ -49,7 +87,12 @@ g2int simunpack(unsigned char *cpack,g2int *idrstmpl,g2int ndpts,g2float *fld)
       nbits = idrstmpl[3];
       itype = idrstmpl[4];
 
-      ifld=(g2int *)calloc(ndpts,sizeof(g2int));
+      if (first < 0) first=0;
+      if (last > ndpts-1) last=ndpts-1;
+      if (last < first) return(0);
+      n=last-first+1;
+
+      ifld=(g2int *)calloc(n,sizeof(g2int));
       if ( ifld == 0 ) {
          fprintf(stderr,"Could not allocate space in simunpack.\n  Data field NOT upacked.\n");
          return(1);
@@ -60,13 +103,13 @@ g2int simunpack(unsigned char *cpack,g2int *idrstmpl,g2int ndpts,g2float *fld)
 //  is the data value at each gridpoint
 //
       if (nbits != 0) {
-         gbits(cpack,ifld,0,nbits,0,ndpts);
-         for (j=0;j<ndpts;j++) {
-           fld[j]=(((g2float)ifld[j]*bscale)+ref)*dscale;
+         gbits(cpack,ifld,first*nbits,nbits,0,n);
+         for (j=0;j<n;j++) {
+           fld[first+j]=(((g2float)ifld[j]*bscale)+ref)*dscale;
          }
       }
       else {
-         for (j=0;j<ndpts;j++) {
+         for (j=first;j<=last;j++) {
            fld[j]=ref;
          }
       }
@@ -371,6 +371,8 @@ static int fillOutSectLen(unsigned char *c_ipack, int lenCpack,
  *
  * HISTORY
  *  12/2003 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Use ScanReorder rather than ScanIndex2XY for each point.
+ *          (Also fixes iclean storing xmissp at the wrong index.)
  *
  * NOTES
  *   May want to disable the scan adjustment in the future.
@@ -382,8 +384,7 @@ static int TransferInt(float *fld, sInt4 ngrdpts, sInt4 ibitmap,
                        sInt4 *iain, sInt4 nd2x3, sInt4 *ib)
 {
    int i;               /* loop counter over all grid points. */
-   sInt4 x, y;          /* Where we are in a grid of scan value 0100???? */
-   int curIndex;        /* Where in iain to store the current data. */
+   float *ain = (float *) iain; /* The floats ScanReorder put in iain. */
 
    if (nd2x3 < ngrdpts) {
 #ifdef DEBUG
@@ -414,27 +415,22 @@ static int TransferInt(float *fld, sInt4 ngrdpts, sInt4 ibitmap,
 #endif
          return 2;
       }
+      /* Rearrange fld (still as floats) into iain, and bmap into ib, so
+       * they are scan 0100(0000), then convert to integer in place. */
+      ScanReorder((sInt4 *) fld, iain, (uChar) *scan, nx, ny);
       if (ibitmap) {
+         ScanReorder(bmap, ib, (uChar) *scan, nx, ny);
          for (i = 0; i < ngrdpts; i++) {
-            ScanIndex2XY(i, &x, &y, *scan, nx, ny);
-            /* ScanIndex returns value as if scan was 0100(0000) */
-            curIndex = (x - 1) + (y - 1) * nx;
-            myAssert(curIndex < nd2x3);
-            ib[curIndex] = bmap[i];
             /* Check if we are supposed to insert xmissp into the field */
-            if ((iclean != 0) && (ib[curIndex] == 0)) {
+            if ((iclean != 0) && (ib[i] == 0)) {
                iain[i] = xmissp;
             } else {
-               iain[curIndex] = fld[i];
+               iain[i] = ain[i];
             }
          }
       } else {
          for (i = 0; i < ngrdpts; i++) {
-            ScanIndex2XY(i, &x, &y, *scan, nx, ny);
-            /* ScanIndex returns value as if scan was 0100(0000) */
-            curIndex = (x - 1) + (y - 1) * nx;
-            myAssert(curIndex < nd2x3);
-            iain[curIndex] = fld[i];
+            iain[i] = ain[i];
          }
       }
       *scan = 64 + (*scan & 0x0f);
@@ -476,6 +472,8 @@ static int TransferInt(float *fld, sInt4 ngrdpts, sInt4 ibitmap,
  *
  * HISTORY
  *  12/2003 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Use ScanReorder rather than ScanIndex2XY for each point.
+ *          (Also fixes iclean storing xmissp at the wrong index.)
  *
  * NOTES
  *   May want to disable the scan adjustment in the future.
@@ -487,8 +485,6 @@ static int TransferFloat(float *fld, sInt4 ngrdpts, sInt4 ibitmap,
                          float *ain, sInt4 nd2x3, sInt4 *ib)
 {
    int i;               /* loop counter over all grid points. */
-   sInt4 x, y;          /* Where we are in a grid of scan value 0100???? */
-   int curIndex;        /* Where in ain to store the current data. */
 
    if (nd2x3 < ngrdpts) {
 #ifdef DEBUG
@@ -519,28 +515,19 @@ static int TransferFloat(float *fld, sInt4 ngrdpts, sInt4 ibitmap,
 #endif
          return 2;
       }
+      /* Rearrange fld into ain, and bmap into ib, so they are scan
+       * 0100(0000). */
+      ScanReorder((sInt4 *) fld, (sInt4 *) ain, (uChar) *scan, nx, ny);
       if (ibitmap) {
-         for (i = 0; i < ngrdpts; i++) {
-            ScanIndex2XY(i, &x, &y, *scan, nx, ny);
-            /* ScanIndex returns value as if scan was 0100(0000) */
-            curIndex = (x - 1) + (y - 1) * nx;
-            myAssert(curIndex < nd2x3);
-            ib[curIndex] = bmap[i];
-            /* Check if we are supposed to insert xmissp into the field */
-            if ((iclean != 0) && (ib[curIndex] == 0)) {
-               ain[i] = xmissp;
-            } else {
-               ain[curIndex] = fld[i];
+         ScanReorder(bmap, ib, (uChar) *scan, nx, ny);
+         if (iclean != 0) {
+            for (i = 0; i < ngrdpts; i++) {
+               /* Check if we are supposed to insert xmissp into the field */
+               if (ib[i] == 0) {
+                  ain[i] = xmissp;
+               }
             }
          }
-      } else {
-         for (i = 0; i < ngrdpts; i++) {
-            ScanIndex2XY(i, &x, &y, *scan, nx, ny);
-            /* ScanIndex returns value as if scan was 0100(0000) */
-            curIndex = (x - 1) + (y - 1) * nx;
-            myAssert(curIndex < nd2x3);
-            ain[curIndex] = fld[i];
-         }
       }
       *scan = 64 + (*scan & 0x0f);
    }
@@ -645,6 +632,501 @@ is required for each GRIB2 message.
 }
 #endif
 
+/*****************************************************************************
+ * FillSect3Tmpl() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To copy the grid definition template from "gfld" into "is3", and find
+ * where in is3 the scan mode and the grid dimensions are stored (so the API
+ * can attempt to return the grid in scan mode 0100????).
+ *
+ * ARGUMENTS
+ *      gfld = The grid from NCEPs routines (only section 3 is used) (Input)
+ *       is3 = Section 3 data (Output)
+ * scanIndex = Where in is3 to find the scan mode, or -1. (Output)
+ *   nxIndex = Where in is3 to find the number of x values, or -1. (Output)
+ *   nyIndex = Where in is3 to find the number of y values, or -1. (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *  0 = Ok.
+ * -1 = undefined sect 3 template (see gridtemplates.h).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Moved out of unpk_g2ncep.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int FillSect3Tmpl(gribfield *gfld, sInt4 *is3, int *scanIndex,
+                         int *nxIndex, int *nyIndex)
+{
+   int i;               /* loop counter over the template. */
+   sInt4 gridIndex;     /* index in templatesgrid[] for this sect 3 templat */
+   int curIndex;        /* Where in is3 to store meta data */
+
+   gridIndex = getgridindex(gfld->igdtnum);
+   if (gridIndex == -1) {
+      return -1;
+   }
+   curIndex = 14;
+   for (i = 0; i < gfld->igdtlen; i++) {
+      is3[curIndex] = gfld->igdtmpl[i];
+      curIndex += abs(templatesgrid[gridIndex].mapgrid[i]);
+   }
+   /* API attempts to return grid in scan mode 0100????.  Find the necessary
+    * indexes into the is3 array for the attempt. */
+   switch (gfld->igdtnum) {
+      case 0:
+      case 1:
+      case 2:
+      case 3:
+      case 40:
+      case 41:
+      case 42:
+      case 43:
+         *scanIndex = 72 - 1;
+         *nxIndex = 31 - 1;
+         *nyIndex = 35 - 1;
+         break;
+      case 10:
+         *scanIndex = 60 - 1;
+         *nxIndex = 31 - 1;
+         *nyIndex = 35 - 1;
+         break;
+      case 20:
+      case 30:
+      case 31:
+         *scanIndex = 65 - 1;
+         *nxIndex = 31 - 1;
+         *nyIndex = 35 - 1;
+         break;
+      case 90:
+         *scanIndex = 64 - 1;
+         *nxIndex = 31 - 1;
+         *nyIndex = 35 - 1;
+         break;
+      case 110:
+         *scanIndex = 57 - 1;
+         *nxIndex = 31 - 1;
+         *nyIndex = 35 - 1;
+         break;
+      case 50:
+      case 51:
+      case 52:
+      case 53:
+      case 100:
+      case 120:
+      case 1000:
+      case 1200:
+      default:
+         *scanIndex = -1;
+         *nxIndex = -1;
+         *nyIndex = -1;
+   }
+   return 0;
+}
+
+/* Rows (1-based, in the scan mode 0100???? sense) of the grid that the
+ * caller wants unpk_g2ncep to unpack.  unpkRow1 < 1 means all of them. */
+static THREAD_LOCAL sInt4 unpkRow1 = 0;
+static THREAD_LOCAL sInt4 unpkRow2 = 0;
+/* 1 if unpk_g2ncep should only return the meta data (no grid). */
+static THREAD_LOCAL sChar unpkMetaOnly = 0;
+
+/*****************************************************************************
+ * unpk_g2ncepRows() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To restrict the next calls to unpk_g2ncep() to unpacking only the rows
+ * y1..y2 of the grid (as seen after the API converts it to scan mode
+ * 0100????).  Values outside those rows are left as 0.  This only has an
+ * effect on simple and complex packed (templates 5.0, 5.2, 5.3) row major
+ * grids, since those are the only ones where we can seek to a row.
+ *
+ * ARGUMENTS
+ * y1 = First row to unpack (1-based).  y1 < 1 means unpack all rows. (Input)
+ * y2 = Last row to unpack (1-based). (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) The setting is per thread, and stays until it is changed, so callers
+ *    should call unpk_g2ncepRows(0, 0) when they are done.
+ *****************************************************************************
+ */
+void unpk_g2ncepRows(sInt4 y1, sInt4 y2)
+{
+   if ((y1 < 1) || (y2 < y1)) {
+      unpkRow1 = 0;
+      unpkRow2 = 0;
+   } else {
+      unpkRow1 = y1;
+      unpkRow2 = y2;
+   }
+}
+
+/*****************************************************************************
+ * unpk_g2ncepMetaOnly() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To tell the next calls to unpk_g2ncep() to only fill in the meta data
+ * (is0 through is7, idat, rdat, ibitmap, xmissp, xmisss, iendpk) and not
+ * touch the bitmap (section 6) or data (section 7).  This lets a caller
+ * decide if it is interested in a grid before paying to unpack it.
+ *
+ * ARGUMENTS
+ * f_metaOnly = 1 means only unpack the meta data, 0 means unpack it all.
+ *              (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) The setting is per thread, and stays until it is changed.
+ *****************************************************************************
+ */
+void unpk_g2ncepMetaOnly(sChar f_metaOnly)
+{
+   unpkMetaOnly = f_metaOnly;
+}
+
+/*****************************************************************************
+ * unpk_g2ncepThreads() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To set how many threads unpk_g2ncep() may use to decode a JPEG2000
+ * (template 5.40) field.  The code blocks of the JPEG2000 image are split
+ * among the threads.
+ *
+ * ARGUMENTS
+ * numThreads = Number of threads (1 means decode on the calling thread).
+ *              (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) Unlike unpk_g2ncepRows(), the setting is for the whole process, so a
+ *    caller that unpacks several messages on different threads should leave
+ *    it at 1.
+ *****************************************************************************
+ */
+void unpk_g2ncepThreads(int numThreads)
+{
+   g2_setjpcthreads(numThreads);
+}
+
+/*****************************************************************************
+ * PopCountBytes() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To count the bits which are set in a run of bytes (such as part of a
+ * GRIB2 bitmap).  The bytes are counted 8 at a time, since the order the
+ * bytes are loaded in doesn't change the count.
+ *
+ * ARGUMENTS
+ * ptr = The bytes to count. (Input)
+ * len = The number of bytes. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: sInt4
+ *   The number of bits set.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static sInt4 PopCountBytes(const unsigned char *ptr, sInt4 len)
+{
+   sInt4 count = 0;     /* The number of bits set so far. */
+   uInt8 word;          /* The current 8 bytes. */
+   unsigned char c;     /* The current byte. */
+
+   for (; len >= 8; len -= 8, ptr += 8) {
+      memcpy(&word, ptr, 8);
+#if defined(__GNUC__)
+      count += __builtin_popcountll(word);
+#else
+      word = word - ((word >> 1) & 0x5555555555555555ULL);
+      word = (word & 0x3333333333333333ULL) +
+            ((word >> 2) & 0x3333333333333333ULL);
+      word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+      count += (sInt4) ((word * 0x0101010101010101ULL) >> 56);
+#endif
+   }
+   for (; len > 0; len--, ptr++) {
+      for (c = *ptr; c != 0; c &= (c - 1)) {
+         count++;
+      }
+   }
+   return count;
+}
+
+/*****************************************************************************
+ * unpk_g2ncepCells() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To decode only some of the grid points of a simple packed (template
+ * 5.0) grid, straight from section 7.  Each packed value is nbits wide, so
+ * the value of the n-th packed point starts at bit n * nbits.  If there is
+ * a bitmap, a grid point's packed index is the number of bits set in the
+ * bitmap before it, which is found by counting the bitmap (a popcount at a
+ * time) up to each requested point.  Since the points are in increasing
+ * order, the bitmap is only walked once.
+ *   The values are the ones unpk_g2ncep() would return for those points in
+ * ain (before any scan reordering).
+ *
+ * ARGUMENTS
+ * c_ipack = The complete GRIB2 message. (Input)
+ * subgNum = Which sub grid of the message (0 to n-1). (Input)
+ * numCell = The number of grid points to decode. (Input)
+ *    cell = The grid points to decode (0-based, in the order of the
+ *           message), in increasing order. (Input)
+ *     val = The values of the grid points (size numCell). (Output)
+ *      ib = The bitmap of the grid points (1 if the point has a value, 0 if
+ *           the bitmap says it is missing).  (size numCell) (Output)
+ * ibitmap = 1 if the grid has a bitmap, 0 if not. (Output)
+ *  minVal = No value of the grid is smaller than this. (Output)
+ *  maxVal = No value of the grid is larger than this. (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *  0 = Ok.
+ *  1 = The grid isn't simple packed, or has a bitmap (or point count) that
+ *      this can't handle, so the caller should call unpk_g2ncep() instead.
+ * -1 = The message or the points are not valid.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) minVal and maxVal are the smallest and largest values that the packing
+ *    can represent (reference value, and the largest packed integer), not
+ *    the smallest and largest values in the grid.
+ * 2) Only handles bitmaps given in this field's section 6 (code table 6.0
+ *    value 0) or in an earlier field of the message (254).
+ *****************************************************************************
+ */
+int unpk_g2ncepCells(unsigned char *c_ipack, int subgNum, sInt4 numCell,
+                     const sInt4 *cell, float *val, sInt4 *ib,
+                     sInt4 *ibitmap, float *minVal, float *maxVal)
+{
+   uInt4 gribLen;       /* Length of the GRIB2 message. */
+   uInt4 ipos;          /* Where the current section starts. */
+   sInt4 sectLen;       /* The length of the current section. */
+   int numfld = 0;      /* Number of fields (section 4's) seen so far. */
+   uInt4 sect5 = 0;     /* Where the field's section 5 starts (0 = none). */
+   uInt4 sect6 = 0;     /* Where the field's section 6 starts (0 = none). */
+   uInt4 sect7 = 0;     /* Where the field's section 7 starts (0 = none). */
+   sInt4 sect7Len = 0;  /* The length of the field's section 7. */
+   uInt4 lastBmap = 0;  /* The section 6 of the most recent bitmap. */
+   sInt4 ngrdpts = 0;   /* The number of grid points (section 3). */
+   sInt4 ndpts;         /* The number of packed points (section 5). */
+   short int tmpl;      /* The data representation template. */
+   uInt4 uref;          /* The reference value (IEEE bits). */
+   g2int iref;          /* uref as the g2clib wants it. */
+   g2int ibits;         /* The current packed integer. */
+   g2float ref;         /* The reference value. */
+   g2float bscale;      /* Binary scale factor (2^E). */
+   g2float dscale;      /* Decimal scale factor (10^-D). */
+   sInt4 E, D;          /* The binary and decimal scale factors. */
+   int nbits;           /* The number of bits per packed value. */
+   unsigned char *bmap = NULL; /* The bitmap (if there is one). */
+   unsigned char *data; /* The packed values. */
+   sInt4 count;         /* Bits set in the bitmap before bit "pos * 8". */
+   sInt4 pos;           /* How many bytes of the bitmap are counted. */
+   sInt4 rank;          /* Packed index of the current grid point. */
+   sInt4 i;             /* Loop counter over the grid points. */
+   unsigned char c;     /* The bits of the bitmap before the current point
+                         * in its byte. */
+
+   if (memcmp(c_ipack, "GRIB", 4) != 0) {
+      return -1;
+   }
+   MEMCPY_BIG(&gribLen, c_ipack + 12, 4);
+
+   /* Find sections 5, 6 and 7 of the field (and the number of grid points
+    * from the section 3 before it). */
+   ipos = 16;
+   while (sect7 == 0) {
+      if ((ipos + 5 > gribLen) || (memcmp(c_ipack + ipos, "7777", 4) == 0)) {
+         return -1;
+      }
+      MEMCPY_BIG(&sectLen, c_ipack + ipos, 4);
+      if ((sectLen < 5) || (ipos + sectLen > gribLen)) {
+         return -1;
+      }
+      switch (c_ipack[ipos + 4]) {
+         case 3:
+            if (sectLen < 10) {
+               return -1;
+            }
+            MEMCPY_BIG(&ngrdpts, c_ipack + ipos + 6, 4);
+            break;
+         case 4:
+            numfld++;
+            break;
+         case 5:
+            if (numfld == subgNum + 1) {
+               sect5 = ipos;
+            }
+            break;
+         case 6:
+            if (sectLen < 6) {
+               return -1;
+            }
+            if (c_ipack[ipos + 5] == 0) {
+               lastBmap = ipos;
+            }
+            if (numfld == subgNum + 1) {
+               sect6 = ipos;
+            }
+            break;
+         case 7:
+            if (numfld == subgNum + 1) {
+               sect7 = ipos;
+               sect7Len = sectLen;
+            }
+            break;
+      }
+      ipos += sectLen;
+   }
+   if ((sect5 == 0) || (sect6 == 0)) {
+      return -1;
+   }
+
+   /* Parse template 5.0.  E and D are stored as sign and magnitude. */
+   MEMCPY_BIG(&sectLen, c_ipack + sect5, 4);
+   MEMCPY_BIG(&tmpl, c_ipack + sect5 + 9, 2);
+   if ((tmpl != 0) || (sectLen < 21)) {
+      return 1;
+   }
+   MEMCPY_BIG(&ndpts, c_ipack + sect5 + 5, 4);
+   MEMCPY_BIG(&uref, c_ipack + sect5 + 11, 4);
+   E = ((c_ipack[sect5 + 15] & 0x7f) << 8) + c_ipack[sect5 + 16];
+   if (c_ipack[sect5 + 15] & 0x80) {
+      E = -E;
+   }
+   D = ((c_ipack[sect5 + 17] & 0x7f) << 8) + c_ipack[sect5 + 18];
+   if (c_ipack[sect5 + 17] & 0x80) {
+      D = -D;
+   }
+   nbits = c_ipack[sect5 + 19];
+   if (nbits > 31) {
+      return 1;
+   }
+   /* Same arithmetic as simunpack(). */
+   iref = (g2int) uref;
+   rdieee(&iref, &ref, 1);
+   bscale = int_power(2.0, E);
+   dscale = int_power(10.0, -D);
+   if (nbits == 0) {
+      *minVal = *maxVal = ref;
+   } else {
+      *minVal = ref * dscale;
+      *maxVal = (((g2float) ((1UL << nbits) - 1) * bscale) + ref) * dscale;
+   }
+
+   /* Find the bitmap. */
+   switch (c_ipack[sect6 + 5]) {
+      case 0:
+         bmap = c_ipack + sect6 + 6;
+         break;
+      case 254:
+         if (lastBmap == 0) {
+            return -1;
+         }
+         bmap = c_ipack + lastBmap + 6;
+         sect6 = lastBmap;
+         break;
+      case 255:
+         bmap = NULL;
+         break;
+      default:
+         /* Predefined bitmaps. */
+         return 1;
+   }
+   if (bmap != NULL) {
+      MEMCPY_BIG(&sectLen, c_ipack + sect6, 4);
+      if ((uInt8) (sectLen - 6) * 8 < (uInt8) ngrdpts) {
+         return -1;
+      }
+   } else if (ndpts != ngrdpts) {
+      return 1;
+   }
+   *ibitmap = (bmap != NULL);
+   data = c_ipack + sect7 + 5;
+
+   count = 0;
+   pos = 0;
+   for (i = 0; i < numCell; i++) {
+      if ((cell[i] < 0) || (cell[i] >= ngrdpts) ||
+          ((i > 0) && (cell[i] < cell[i - 1]))) {
+         return -1;
+      }
+      if (bmap != NULL) {
+         /* Count the bitmap up to the byte holding the point, then the bits
+          * before the point in that byte. */
+         count += PopCountBytes(bmap + pos, (cell[i] >> 3) - pos);
+         pos = cell[i] >> 3;
+         ib[i] = (bmap[pos] >> (7 - (cell[i] & 7))) & 1;
+         c = (unsigned char) (bmap[pos] >> (8 - (cell[i] & 7)));
+         rank = count + PopCountBytes(&c, 1);
+         if (!ib[i]) {
+            val[i] = 0;
+            continue;
+         }
+      } else {
+         ib[i] = 1;
+         rank = cell[i];
+      }
+      if (rank >= ndpts) {
+         return -1;
+      }
+      if (nbits == 0) {
+         val[i] = ref;
+         continue;
+      }
+      if ((uInt8) (rank + 1) * nbits > (uInt8) (sect7Len - 5) * 8) {
+         return -1;
+      }
+      gbit(data, &ibits, (g2int) rank * nbits, nbits);
+      val[i] = (((g2float) ibits * bscale) + ref) * dscale;
+   }
+   return 0;
+}
+
 /*****************************************************************************
  * unpk_g2ncep() --
  *
@@ -736,6 +1218,8 @@ is required for each GRIB2 message.
  *
  * HISTORY
  *  12/2003 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Honor unpk_g2ncepRows() and unpk_g2ncepMetaOnly().
+ *  10/2026 AAT: Bound the section length search by the message length.
  *
  * NOTES
  * MDL handles is5[12], is5[23], and is5[27] in an "interesting" manner.
@@ -771,18 +1255,22 @@ void unpk_g2ncep(sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
                  sInt4 *iendpk, sInt4 *jer, sInt4 *ndjer, sInt4 *kjer)
 {
    int i;               /* A counter used for a number of purposes. */
-   static unsigned int subgNum = 0; /* The sub grid we read most recently.
-                                     * This is primarily to help with the
-                                     * inew option. */
+   static THREAD_LOCAL unsigned int subgNum = 0; /* The sub grid we read
+                                     * most recently.  This is primarily to
+                                     * help with the inew option. */
    int ierr;            /* Holds the error code from a called routine. */
    sInt4 listsec0[3];
    sInt4 listsec1[13];
-   static sInt4 numfields = 1; /* Number of sub Grids in this message */
+   static THREAD_LOCAL sInt4 numfields = 1; /* Number of sub Grids in this
+                                              * message */
    sInt4 numlocal;      /* Number of local sections in this message. */
    int unpack;          /* Tell g2_getfld to unpack the message. */
    int expand;          /* Tell g2_getflt to attempt to expand the bitmap. */
    gribfield *gfld;     /* Holds the data after g2_getfld unpacks it. */
-   sInt4 gridIndex;     /* index in templatesgrid[] for this sect 3 templat */
+   g2int first;         /* First grid point (in message order) to unpack. */
+   g2int last;          /* Last grid point to unpack (-1 means all). */
+   sInt4 scan;          /* The scan mode of the grid (used for the rows). */
+   sInt4 r1, r2;        /* The rows to unpack (0-based, message order). */
    sInt4 pdsIndex;      /* index in templatespds[] for this sect 4 template */
    sInt4 drsIndex;      /* index in templatesdrs[] for this sect 5 template */
    int curIndex;        /* Where in is3, is4, or is5 to store meta data */
@@ -793,6 +1281,7 @@ void unpk_g2ncep(sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
    char f_ignoreScan;   /* Flag to ignore the attempt at changing the scan */
    sInt4 dummyScan;     /* Dummy place holder for call to Transfer routines
                          * if ignoring scan. */
+   sInt4 msgLen;        /* Bytes of c_ipack which are the message. */
 
    myAssert(*ndjer >= 8);
    /* Init the error handling array. */
@@ -835,10 +1324,40 @@ void unpk_g2ncep(sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
       subgNum++;
    }
 
+   /* If the caller only wants some of the rows, peek at section 3 to find
+    * which grid points (in message order) hold them.  Column major grids
+    * (GRIB2BIT_3) spread a row over the whole message, so are unpacked in
+    * full. */
+   first = 0;
+   last = -1;
+   if ((unpkRow1 > 0) && (!unpkMetaOnly)) {
+      if ((g2_getfld(c_ipack, subgNum + 1, 0, 0, &gfld) == 0) &&
+          (FillSect3Tmpl(gfld, is3, &scanIndex, &nxIndex, &nyIndex) == 0) &&
+          (scanIndex >= 0) && (nxIndex >= 0) && (nyIndex >= 0)) {
+         scan = is3[scanIndex];
+         if (!(scan & GRIB2BIT_3) && (is3[nxIndex] > 0) &&
+             (is3[nyIndex] > 0) &&
+             (is3[nxIndex] * is3[nyIndex] == gfld->ngrdpts)) {
+            r1 = (unpkRow1 > is3[nyIndex]) ? is3[nyIndex] - 1 : unpkRow1 - 1;
+            r2 = (unpkRow2 > is3[nyIndex]) ? is3[nyIndex] - 1 : unpkRow2 - 1;
+            /* Without GRIB2BIT_2 the message starts at the top row. */
+            if (!(scan & GRIB2BIT_2)) {
+               i = r1;
+               r1 = is3[nyIndex] - 1 - r2;
+               r2 = is3[nyIndex] - 1 - i;
+            }
+            first = r1 * is3[nxIndex];
+            last = (r2 + 1) * is3[nxIndex] - 1;
+         }
+      }
+      g2_free(gfld);
+   }
+
    /* Expand the desired subgrid. */
-   unpack = 1;
-   expand = 1;
-   ierr = g2_getfld(c_ipack, subgNum + 1, unpack, expand, &gfld);
+   unpack = (unpkMetaOnly) ? 0 : 1;
+   expand = unpack;
+   ierr = g2_getfldwin(c_ipack, subgNum + 1, unpack, expand, first, last,
+                       &gfld);
    if (ierr != 0) {
       switch (ierr) {
          case 1:       /* Beginning characters "GRIB" not found. */
@@ -890,7 +1409,7 @@ void unpk_g2ncep(sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
       return;
    }
    /* Check if data wasn't unpacked. */
-   if (!gfld->unpacked) {
+   if ((!gfld->unpacked) && (!unpkMetaOnly)) {
       jer[0 + *ndjer] = 2;
       *kjer = 1;
       g2_free(gfld);
@@ -930,7 +1449,13 @@ void unpk_g2ncep(sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
    /* Fill out section lengths (separate procedure because of possibility of
     * having multiple grids.  Should combine fillOutSectLen g2_info, and
     * g2_getfld into one procedure to optimize it. */
-   fillOutSectLen(c_ipack + 16 + is1[0], 4 * *nd5 - 15 - is1[0], subgNum,
+   /* nd5 is rounded up to whole words (or raised to nd2x3), so 4 * nd5 can
+    * be past the end of the message, which may be memory mapped. */
+   msgLen = 4 * *nd5;
+   if ((is0[8] > 0) && (is0[8] < msgLen)) {
+      msgLen = is0[8];
+   }
+   fillOutSectLen(c_ipack + 16 + is1[0], msgLen - 16 - is1[0], subgNum,
                   is2, is3, is4, is5, is6, is7);
 
    /* Check if there is section 2 data. */
@@ -969,69 +1494,13 @@ void unpk_g2ncep(sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
    is3[10] = gfld->numoct_opt;
    is3[11] = gfld->interp_opt;
    is3[12] = gfld->igdtnum;
-   gridIndex = getgridindex(gfld->igdtnum);
-   if (gridIndex == -1) {
+   if (FillSect3Tmpl(gfld, is3, &scanIndex, &nxIndex, &nyIndex) != 0) {
       jer[8 + *ndjer] = 2;
       jer[8] = 2003;    /* undefined sect 3 template */
       *kjer = 9;
       g2_free(gfld);
       return;
    }
-   curIndex = 14;
-   for (i = 0; i < gfld->igdtlen; i++) {
-      is3[curIndex] = gfld->igdtmpl[i];
-      curIndex += abs(templatesgrid[gridIndex].mapgrid[i]);
-   }
-   /* API attempts to return grid in scan mode 0100????.  Find the necessary
-    * indexes into the is3 array for the attempt. */
-   switch (gfld->igdtnum) {
-      case 0:
-      case 1:
-      case 2:
-      case 3:
-      case 40:
-      case 41:
-      case 42:
-      case 43:
-         scanIndex = 72 - 1;
-         nxIndex = 31 - 1;
-         nyIndex = 35 - 1;
-         break;
-      case 10:
-         scanIndex = 60 - 1;
-         nxIndex = 31 - 1;
-         nyIndex = 35 - 1;
-         break;
-      case 20:
-      case 30:
-      case 31:
-         scanIndex = 65 - 1;
-         nxIndex = 31 - 1;
-         nyIndex = 35 - 1;
-         break;
-      case 90:
-         scanIndex = 64 - 1;
-         nxIndex = 31 - 1;
-         nyIndex = 35 - 1;
-         break;
-      case 110:
-         scanIndex = 57 - 1;
-         nxIndex = 31 - 1;
-         nyIndex = 35 - 1;
-         break;
-      case 50:
-      case 51:
-      case 52:
-      case 53:
-      case 100:
-      case 120:
-      case 1000:
-      case 1200:
-      default:
-         scanIndex = -1;
-         nxIndex = -1;
-         nyIndex = -1;
-   }
 
    is4[4] = 4;
    is4[5] = gfld->num_coord;
@@ -1113,6 +1582,10 @@ void unpk_g2ncep(sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
    } else {
       *ibitmap = 0;
    }
+   if (unpkMetaOnly) {
+      g2_free(gfld);
+      return;
+   }
 
    /* Check type of original field, before transfering the memory. */
    myAssert(*ns5 > 20);
@@ -1474,6 +1947,41 @@ void unpk_grib2(sInt4 *kfildo, float *ain, sInt4 *iain, sInt4 *nd2x3,
 #endif
 }
 
+/*****************************************************************************
+ * pk_g2ncepThreads() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To set how many threads C_pkGrib2() may use to find the groups of a
+ * complex packed (template 5.2 or 5.3) field.  Large fields are split into
+ * segments which are grouped on different threads (see pack_gpmt).
+ *
+ * ARGUMENTS
+ * numThreads = Number of threads (1 means group the whole field at once on
+ *              the calling thread). (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) With more than 1 thread, groups do not span segments, so the message
+ *    may differ slightly from (but decodes the same as) the 1 thread one.
+ *    It does not otherwise depend on the number of threads.
+ * 2) Defaults to 1.  degrib doesn't change it, since splitting the grouping
+ *    made the messages slightly bigger without making them faster (see
+ *    gpbench in src/degrib).
+ *****************************************************************************
+ */
+void pk_g2ncepThreads(int numThreads)
+{
+   g2_setpackthreads(numThreads);
+}
+
 /*****************************************************************************
  * C_pkGrib2() --
  *
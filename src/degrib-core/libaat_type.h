@@ -31,4 +31,28 @@
  typedef unsigned short int uShort2;
  typedef signed short int sShort2;
 #endif
+
+/* From type.h */
+#ifndef UINT8_TYPE
+#define UINT8_TYPE
+ #if defined(_MSC_VER)
+  typedef unsigned __int64 uInt8;
+ #elif SIZEOF_LONG_INT == 8
+  typedef unsigned long int uInt8;
+ #else
+  typedef unsigned long long int uInt8;
+ #endif
+#endif
+
+/* Storage class for static variables that need a copy per thread (see the
+ * -threads option in commands.c). */
+#ifndef THREAD_LOCAL
+ #if defined(_MSC_VER)
+  #define THREAD_LOCAL __declspec(thread)
+ #elif defined(__GNUC__)
+  #define THREAD_LOCAL __thread
+ #else
+  #define THREAD_LOCAL
+ #endif
+#endif
 #endif
@@ -11,6 +11,7 @@
  * NOTES
  *****************************************************************************
  */
+#include <string.h>
 #include "scan.h"
 
 /*****************************************************************************
@@ -152,6 +153,100 @@ void XY2ScanIndex(sInt4 *Row, sInt4 x, sInt4 y, uChar scan, sInt4 Nx,
    *Row = row;
 }
 
+/*****************************************************************************
+ * ScanReorder() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To rearrange a whole grid from the order defined by the scan parameter
+ * to (scan = 0100).  This gives the same answer as calling ScanIndex2XY for
+ * every point, but works a row (or column) at a time.  If adjacent points in
+ * x are consecutive, each row is either copied (memcpy) or reversed into
+ * place.  If adjacent points in y are consecutive (GRIB2BIT_3), the grid is
+ * transposed a SCAN_BLOCK x SCAN_BLOCK tile at a time, so both the reads
+ * and the writes stay in cache.
+ *
+ * ARGUMENTS
+ *    src = The grid in the scan order of the GRIB2 message. (Input)
+ *    dst = The grid in (scan = 0100) order. (Output)
+ *   scan = The orientation of the GRIB2 grid. (Input)
+ * Nx, Ny = The Dimensions of the grid (Input).
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *   10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) The grid elements are 4 bytes, so this can be used for floats as well
+ *    as sInt4 (the values are only copied, never converted).
+ * 2) src and dst must not overlap.
+ *****************************************************************************
+ */
+#define SCAN_BLOCK 32
+void ScanReorder(const sInt4 *src, sInt4 *dst, uChar scan, sInt4 Nx,
+                 sInt4 Ny)
+{
+   sInt4 r;             /* Which row (or column) of src we are on. */
+   sInt4 x, y;          /* Where we are in a scan == 0100 world. */
+   sInt4 k;             /* Position along the current row (column) of src */
+   sInt4 r0, k0;        /* The lower left corner of the current tile. */
+   sInt4 r1, k1;        /* The upper right corner (+1) of the current tile */
+   char f_rev;          /* True if the current row (column) is reversed. */
+   const sInt4 *ptr;    /* The current row (column) of src. */
+   sInt4 *out;          /* The current row of dst. */
+
+   if (!(scan & GRIB2BIT_3)) {
+      /* Adjacent points in x are consecutive, so rows map to rows. */
+      for (r = 0; r < Ny; r++) {
+         y = (scan & GRIB2BIT_2) ? r : (Ny - 1 - r);
+         f_rev = ((scan & GRIB2BIT_1) != 0);
+         if ((scan & GRIB2BIT_4) && ((r % 2) == 1)) {
+            f_rev = !f_rev;
+         }
+         ptr = src + r * Nx;
+         out = dst + y * Nx;
+         if (!f_rev) {
+            memcpy(out, ptr, Nx * sizeof(sInt4));
+         } else {
+            for (k = 0; k < Nx; k++) {
+               out[Nx - 1 - k] = ptr[k];
+            }
+         }
+      }
+      return;
+   }
+
+   /* Adjacent points in y are consecutive, so columns map to rows, which is
+    * a transpose.  Do it a tile at a time. */
+   for (r0 = 0; r0 < Nx; r0 += SCAN_BLOCK) {
+      r1 = (r0 + SCAN_BLOCK < Nx) ? r0 + SCAN_BLOCK : Nx;
+      for (k0 = 0; k0 < Ny; k0 += SCAN_BLOCK) {
+         k1 = (k0 + SCAN_BLOCK < Ny) ? k0 + SCAN_BLOCK : Ny;
+         for (r = r0; r < r1; r++) {
+            x = (scan & GRIB2BIT_1) ? (Nx - 1 - r) : r;
+            f_rev = !(scan & GRIB2BIT_2);
+            if ((scan & GRIB2BIT_4) && ((r % 2) == 1)) {
+               f_rev = !f_rev;
+            }
+            ptr = src + r * Ny;
+            if (!f_rev) {
+               for (k = k0; k < k1; k++) {
+                  dst[k * Nx + x] = ptr[k];
+               }
+            } else {
+               for (k = k0; k < k1; k++) {
+                  dst[(Ny - 1 - k) * Nx + x] = ptr[k];
+               }
+            }
+         }
+      }
+   }
+}
+
 /*****************************************************************************
  * main() --
  *
@@ -184,6 +279,8 @@ int main(int argc, char **argv)
    int data[3][4];
    int ray1[6];
    int ray2[6];
+   sInt4 ray3[6];
+   sInt4 ray4[6];
    sInt4 Nx = 2, Ny = 3;
    sInt4 NxNy = 6;
    sInt4 row, x, y;
@@ -254,6 +351,18 @@ int main(int argc, char **argv)
          printf("%d ", ray2[x]);
       }
       printf("\n");
+
+      /* Make sure ScanReorder agrees with ScanIndex2XY. */
+      for (x = 0; x < NxNy; x++) {
+         ray4[x] = ray1[x];
+      }
+      ScanReorder(ray4, ray3, scan, Nx, Ny);
+      for (x = 0; x < NxNy; x++) {
+         if (ray3[x] != ray2[x]) {
+            printf("   ScanReorder differs at %ld (%ld != %d)\n", x,
+                   ray3[x], ray2[x]);
+         }
+      }
    }
    return 0;
 }
@@ -29,4 +29,7 @@ void XY2ScanIndex (sInt4 *Row, sInt4 x, sInt4 y, uChar scan, sInt4 Nx,
 void ScanIndex2XY (sInt4 row, sInt4 *X, sInt4 *Y, uChar scan, sInt4 Nx,
                    sInt4 Ny);
 
+void ScanReorder (const sInt4 *src, sInt4 *dst, uChar scan, sInt4 Nx,
+                  sInt4 Ny);
+
 #endif
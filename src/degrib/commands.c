@@ -23,8 +23,10 @@
 #include "meta.h"
 #include "metaname.h"
 #include "degrib2.h"
+#include "degrib-core.h"
 #include "weather.h"
 #include "inventory.h"
+#include "gidx.h"
 #include "split.h"
 #include "probe.h"
 #include "interp.h"
@@ -42,6 +44,9 @@
 #include "xmlparse.h"
 #endif
 #include "grpprobe.h"
+#ifdef USE_PTHREAD
+#include <pthread.h>
+#endif
 
 /*****************************************************************************
  * GetOutputName() --
@@ -277,8 +282,45 @@ int SimpConvert (userType *usr, grib_MetaData *meta, double *Data,
 }
 #endif
 
-int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
-                 double *Data, sInt4 DataLen, int f_unit, int f_first)
+/*****************************************************************************
+ * MainConvertCore() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   The body of MainConvert.  Writes a grid to the output formats the user
+ * asked for.  The grid is either a double grid (Data), or a float grid
+ * (fltData) from ReadGrib2RecordFlt.
+ *
+ * ARGUMENTS
+ *     usr = The user option structure to use while Degrib'ing. (Input)
+ *      is = The Un-parsed meta data for this GRIB2 message. (Input)
+ *    meta = The meta data for the grid. (Input)
+ *    Data = The double grid (or NULL). (Input)
+ * fltData = The float grid (or NULL).  Only allowed if ConvertFltUsable
+ *           says all the outputs can take a float grid. (Input)
+ * DataLen = Size of Data (or fltData). (Input)
+ *  f_unit = The unit system the grid is in. (Input)
+ * f_first = 1 if this is the first grid (so files are created rather than
+ *           appended to). (Input)
+ *
+ * FILES/DATABASES:
+ *   Creates the output files.
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ *  1 = Problems writing one of the outputs.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created (from MainConvert), adding fltData.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int MainConvertCore (userType *usr, IS_dataType *is,
+                            grib_MetaData *meta, double *Data,
+                            float *fltData, sInt4 DataLen, int f_unit,
+                            int f_first)
 {
    char *outName = NULL; /* Name of the output file */
    size_t outLen;       /* String length of outName. */
@@ -423,6 +465,14 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
             free (outName);
             return 1;
          }
+      } else if (fltData != NULL) {
+         if (gribWriteFloatFlt (outName, fltData, meta, &(meta->gridAttrib),
+                                FltScan, usr->f_MSB, usr->decimal,
+                                usr->f_GrADS, usr->f_SimpleWx,
+                                usr->f_AscGrid) != 0) {
+            free (outName);
+            return 1;
+         }
       } else {
          if (gribWriteFloat (outName, Data, meta, &(meta->gridAttrib),
                              FltScan, usr->f_MSB, usr->decimal, usr->f_GrADS,
@@ -498,8 +548,14 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
    /* Create the .nc file (NetCDF) */
    if (usr->f_NetCDF) {
       strncpy (outName + strlen (outName) - 3, "nc\0", 3);
-      if (gribWriteNetCDF (outName, Data, meta, usr->f_NetCDF,
-                           usr->decimal, usr->LatLon_Decimal) != 0) {
+      if (fltData != NULL) {
+         if (gribWriteNetCDFFlt (outName, fltData, meta, usr->f_NetCDF,
+                                 usr->decimal, usr->LatLon_Decimal) != 0) {
+            free (outName);
+            return 1;
+         }
+      } else if (gribWriteNetCDF (outName, Data, meta, usr->f_NetCDF,
+                                  usr->decimal, usr->LatLon_Decimal) != 0) {
          free (outName);
          return 1;
       }
@@ -516,7 +572,7 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
                              meta->pdsTdlp.ID1, meta->pdsTdlp.ID2,
                              meta->pdsTdlp.ID3, meta->pdsTdlp.ID4,
                              meta->pdsTdlp.project, meta->pdsTdlp.procNum,
-                             meta->pdsTdlp.seqNum);
+                             meta->pdsTdlp.seqNum, (usr->f_TdlPack == 2));
          } else if (meta->gridAttrib.f_miss == 1) {
             WriteTDLPRecord (stdout, Data, DataLen, meta->gridAttrib.DSF,
                              meta->gridAttrib.ESF, 1,
@@ -525,7 +581,7 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
                              meta->pdsTdlp.ID1, meta->pdsTdlp.ID2,
                              meta->pdsTdlp.ID3, meta->pdsTdlp.ID4,
                              meta->pdsTdlp.project, meta->pdsTdlp.procNum,
-                             meta->pdsTdlp.seqNum);
+                             meta->pdsTdlp.seqNum, (usr->f_TdlPack == 2));
          } else {
             WriteTDLPRecord (stdout, Data, DataLen, meta->gridAttrib.DSF,
                              meta->gridAttrib.ESF, 1,
@@ -535,7 +591,7 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
                              meta->pdsTdlp.ID1, meta->pdsTdlp.ID2,
                              meta->pdsTdlp.ID3, meta->pdsTdlp.ID4,
                              meta->pdsTdlp.project, meta->pdsTdlp.procNum,
-                             meta->pdsTdlp.seqNum);
+                             meta->pdsTdlp.seqNum, (usr->f_TdlPack == 2));
          }
       } else {
          strncpy (outName + strlen (outName) - 3, "tdl", 3);
@@ -549,7 +605,7 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
                                    meta->pdsTdlp.ID2, meta->pdsTdlp.ID3,
                                    meta->pdsTdlp.ID4, meta->pdsTdlp.project,
                                    meta->pdsTdlp.procNum,
-                                   meta->pdsTdlp.seqNum);
+                                   meta->pdsTdlp.seqNum, (usr->f_TdlPack == 2));
                } else if (meta->gridAttrib.f_miss == 1) {
                   WriteTDLPRecord (fp, Data, DataLen, meta->gridAttrib.DSF,
                                    meta->gridAttrib.ESF, 1,
@@ -559,7 +615,7 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
                                    meta->pdsTdlp.ID2, meta->pdsTdlp.ID3,
                                    meta->pdsTdlp.ID4, meta->pdsTdlp.project,
                                    meta->pdsTdlp.procNum,
-                                   meta->pdsTdlp.seqNum);
+                                   meta->pdsTdlp.seqNum, (usr->f_TdlPack == 2));
                } else {
                   WriteTDLPRecord (fp, Data, DataLen, meta->gridAttrib.DSF,
                                    meta->gridAttrib.ESF, 1,
@@ -570,7 +626,7 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
                                    meta->pdsTdlp.ID2, meta->pdsTdlp.ID3,
                                    meta->pdsTdlp.ID4, meta->pdsTdlp.project,
                                    meta->pdsTdlp.procNum,
-                                   meta->pdsTdlp.seqNum);
+                                   meta->pdsTdlp.seqNum, (usr->f_TdlPack == 2));
                }
                fclose (fp);
             }
@@ -584,7 +640,7 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
                                    meta->pdsTdlp.ID2, meta->pdsTdlp.ID3,
                                    meta->pdsTdlp.ID4, meta->pdsTdlp.project,
                                    meta->pdsTdlp.procNum,
-                                   meta->pdsTdlp.seqNum);
+                                   meta->pdsTdlp.seqNum, (usr->f_TdlPack == 2));
                } else if (meta->gridAttrib.f_miss == 1) {
                   WriteTDLPRecord (fp, Data, DataLen, meta->gridAttrib.DSF,
                                    meta->gridAttrib.ESF, 1,
@@ -594,7 +650,7 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
                                    meta->pdsTdlp.ID2, meta->pdsTdlp.ID3,
                                    meta->pdsTdlp.ID4, meta->pdsTdlp.project,
                                    meta->pdsTdlp.procNum,
-                                   meta->pdsTdlp.seqNum);
+                                   meta->pdsTdlp.seqNum, (usr->f_TdlPack == 2));
                } else {
                   WriteTDLPRecord (fp, Data, DataLen, meta->gridAttrib.DSF,
                                    meta->gridAttrib.ESF, 1,
@@ -605,7 +661,7 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
                                    meta->pdsTdlp.ID2, meta->pdsTdlp.ID3,
                                    meta->pdsTdlp.ID4, meta->pdsTdlp.project,
                                    meta->pdsTdlp.procNum,
-                                   meta->pdsTdlp.seqNum);
+                                   meta->pdsTdlp.seqNum, (usr->f_TdlPack == 2));
                }
                fclose (fp);
             }
@@ -664,6 +720,13 @@ int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
    return 0;
 }
 
+int MainConvert (userType *usr, IS_dataType *is, grib_MetaData *meta,
+                 double *Data, sInt4 DataLen, int f_unit, int f_first)
+{
+   return MainConvertCore (usr, is, meta, Data, NULL, DataLen, f_unit,
+                           f_first);
+}
+
 /******************************************************************************
  *StormTotal() --
  *
@@ -880,6 +943,138 @@ static int StormTotal (userType *usr, FILE *grib_fp, IS_dataType *is,
    return error;
 }
 
+/*****************************************************************************
+ * ConvertOutputCheck() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Makes sure the user chose at least one output type to convert to.
+ *
+ * ARGUMENTS
+ * usr = The user option structure to use while Degrib'ing. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ *  1 = Invalid usage.
+ *
+ * HISTORY
+ *   8/2003 Arthur Taylor (MDL/RSIS): Created (as part of Grib2Convert).
+ *  10/2026 AAT: Moved out of Grib2Convert so Grib2ConvertThreads can use it.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int ConvertOutputCheck (userType *usr)
+{
+   if ((!usr->f_Met) && (!usr->f_IS0) && (!usr->f_Flt) && (!usr->f_Shp) &&
+       (!usr->f_Csv) && (!usr->f_Grib2) && (!usr->f_NetCDF) &&
+       (!usr->f_Map) && (!usr->f_Freq)) {
+      errSprintf ("You did not choose what to convert it to.\n");
+      errSprintf ("You need one or more of:\n");
+      errSprintf ("('-Flt', '-Met', '-IS0', '-Shp', '-Csv', '-Grib2', "
+                  "'-NetCDF 1,2,3', '-Map')");
+      return 1;
+   }
+   return 0;
+}
+
+/*****************************************************************************
+ * ConvertFltUsable() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Determines if the grids can be read as floats (ReadGrib2RecordFlt)
+ * instead of doubles.  That is the case when every output the user asked
+ * for that looks at the grid is written as floats anyway (-Flt without
+ * -Interp, and -NetCDF).  It saves a double copy of each grid.
+ *
+ * ARGUMENTS
+ * usr = The user option structure to use while Degrib'ing. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *  1 = Read the grids as floats.
+ *  0 = Read the grids as doubles.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   -Met and -IS0 don't look at the grid.  -Freq, -Shp, -Kml, -Map, -Csv,
+ * -Tdl and -Grib2 need the double grid.
+ *   The float grid is rounded to -Decimal places as it is read, since that
+ * is what the writers round to (see ParseGridFlt).
+ *****************************************************************************
+ */
+static int ConvertFltUsable (userType *usr)
+{
+   if ((!usr->f_Flt) && (!usr->f_NetCDF)) {
+      return 0;
+   }
+   if ((usr->f_Flt) && (usr->f_coverageGrid)) {
+      return 0;
+   }
+   if ((usr->f_Freq) || (usr->f_Shp) || (usr->f_Kml) || (usr->f_Map) ||
+       (usr->f_Csv) || (usr->f_Tdl) || (usr->f_Grib2)) {
+      return 0;
+   }
+   return 1;
+}
+
+/*****************************************************************************
+ * ValidRangeCheck() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Checks the max / min of a grid against the -validMax / -validMin
+ * options as a "sanity check" of the data.
+ *
+ * ARGUMENTS
+ *  usr = The user option structure to use while Degrib'ing. (Input)
+ * meta = The meta data for the grid that was just read. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ *  1 = The grid is out of the valid range.
+ *
+ * HISTORY
+ *   8/2003 Arthur Taylor (MDL/RSIS): Created (as part of Grib2Convert).
+ *  10/2026 AAT: Moved out of Grib2Convert so Grib2ConvertThreads can use it.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int ValidRangeCheck (userType *usr, grib_MetaData *meta)
+{
+   if (usr->f_validRange > 0) {
+      /* valid max. */
+      if (usr->f_validRange > 1) {
+         if (meta->gridAttrib.max > usr->validMax) {
+            errSprintf ("ERROR: %f > valid Max of %f\n",
+                        meta->gridAttrib.max, usr->validMax);
+            return 1;
+         }
+      }
+      /* valid min. */
+      if (usr->f_validRange % 2) {
+         if (meta->gridAttrib.min < usr->validMin) {
+            errSprintf ("ERROR: %f < valid Min of %f\n",
+                        meta->gridAttrib.min, usr->validMin);
+            return 1;
+         }
+      }
+   }
+   return 0;
+}
+
 /*****************************************************************************
  * Grib2Convert() --
  *
@@ -904,6 +1099,8 @@ static int StormTotal (userType *usr, FILE *grib_fp, IS_dataType *is,
  *
  * HISTORY
  *   8/2003 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Read the grids as floats if all the outputs can use them
+ *          (see ConvertFltUsable).
  *
  * NOTES
  *****************************************************************************
@@ -912,7 +1109,10 @@ int Grib2Convert (userType *usr, FILE *grib_fp, IS_dataType *is,
                   grib_MetaData *meta)
 {
    double *grib_Data;   /* The read in GRIB2 grid. */
-   uInt4 grib_DataLen;  /* Size of Grib_Data. */
+   float *flt_Data;     /* The grid, if read as floats (f_flt). */
+   uInt4 grib_DataLen;  /* Size of Grib_Data (or flt_Data). */
+   int f_flt;           /* 1 if we read the grids as floats. */
+   int ans;             /* The return value from ReadGrib2Record. */
    int c;               /* Determine if end of the file without fileLen. */
    sInt4 f_endMsg = 1;  /* 1 if we read the last grid in a GRIB message, or
                          * we haven't read any messages. */
@@ -920,19 +1120,15 @@ int Grib2Convert (userType *usr, FILE *grib_fp, IS_dataType *is,
    int msgNum = 1;      /* The message number we are working on. */
    int f_first = 1;     /* Is this the first message? */
 
-   if ((!usr->f_Met) && (!usr->f_IS0) && (!usr->f_Flt) && (!usr->f_Shp) &&
-       (!usr->f_Csv) && (!usr->f_Grib2) && (!usr->f_NetCDF) &&
-       (!usr->f_Map) && (!usr->f_Freq)) {
-      errSprintf ("You did not choose what to convert it to.\n");
-      errSprintf ("You need one or more of:\n");
-      errSprintf ("('-Flt', '-Met', '-IS0', '-Shp', '-Csv', '-Grib2', "
-                  "'-NetCDF 1,2,3', '-Map')");
+   if (ConvertOutputCheck (usr) != 0) {
       return 1;
    }
 
    /* Set up inital state of data for unpacker. */
    grib_DataLen = 0;
    grib_Data = NULL;
+   flt_Data = NULL;
+   f_flt = ConvertFltUsable (usr);
    if (usr->msgNum == 0) {
       subgNum = 0;
    } else {
@@ -945,33 +1141,30 @@ int Grib2Convert (userType *usr, FILE *grib_fp, IS_dataType *is,
          ungetc (c, grib_fp);
       }
       /* Read the GRIB message. */
-      if (ReadGrib2Record (grib_fp, usr->f_unit, &grib_Data, &grib_DataLen,
-                           meta, is, subgNum, usr->majEarth, usr->minEarth,
-                           usr->f_SimpleVer, usr->f_SimpleWWA, &f_endMsg, &(usr->lwlf),
-                           &(usr->uprt)) != 0) {
+      if (f_flt) {
+         ans = ReadGrib2RecordFlt (grib_fp, usr->f_unit, &flt_Data,
+                                   &grib_DataLen, meta, is, subgNum,
+                                   usr->majEarth, usr->minEarth,
+                                   usr->f_SimpleVer, usr->f_SimpleWWA,
+                                   &f_endMsg, &(usr->lwlf), &(usr->uprt),
+                                   usr->decimal);
+      } else {
+         ans = ReadGrib2Record (grib_fp, usr->f_unit, &grib_Data,
+                                &grib_DataLen, meta, is, subgNum,
+                                usr->majEarth, usr->minEarth,
+                                usr->f_SimpleVer, usr->f_SimpleWWA,
+                                &f_endMsg, &(usr->lwlf), &(usr->uprt));
+      }
+      if (ans != 0) {
          preErrSprintf ("ERROR: In call to ReadGrib2Record.\n");
          free (grib_Data);
+         free (flt_Data);
          return 1;
       }
-      if (usr->f_validRange > 0) {
-         /* valid max. */
-         if (usr->f_validRange > 1) {
-            if (meta->gridAttrib.max > usr->validMax) {
-               errSprintf ("ERROR: %f > valid Max of %f\n",
-                           meta->gridAttrib.max, usr->validMax);
-               free (grib_Data);
-               return 1;
-            }
-         }
-         /* valid min. */
-         if (usr->f_validRange % 2) {
-            if (meta->gridAttrib.min < usr->validMin) {
-               errSprintf ("ERROR: %f < valid Min of %f\n",
-                           meta->gridAttrib.min, usr->validMin);
-               free (grib_Data);
-               return 1;
-            }
-         }
+      if (ValidRangeCheck (usr, meta) != 0) {
+         free (grib_Data);
+         free (flt_Data);
+         return 1;
       }
 /*
       if ((usr->lwlf.lt != -100) && (usr->uprt.lt != -100)) {
@@ -986,10 +1179,11 @@ int Grib2Convert (userType *usr, FILE *grib_fp, IS_dataType *is,
          }
       }
 */
-      if (MainConvert (usr, is, meta, grib_Data, grib_DataLen,
-                       usr->f_unit, f_first) != 0) {
+      if (MainConvertCore (usr, is, meta, grib_Data, flt_Data, grib_DataLen,
+                           usr->f_unit, f_first) != 0) {
          preErrSprintf ("ERROR: In call to MainConvert.\n");
          free (grib_Data);
+         free (flt_Data);
          return 1;
       }
       f_first = 0;
@@ -1016,9 +1210,379 @@ int Grib2Convert (userType *usr, FILE *grib_fp, IS_dataType *is,
 /* End loop for all messages. */
 
    free (grib_Data);
+   free (flt_Data);
    return 0;
 }
 
+#ifdef USE_PTHREAD
+/* The state of the grid a Grib2ConvertThreads worker is holding. */
+enum { CONV_BUSY, CONV_READY, CONV_ERROR };
+
+/* The data shared between Grib2ConvertThreads and its workers. */
+typedef struct {
+   userType *usr;       /* The user options to decode with. */
+   const char *fileName; /* The GRIB file (each worker opens its own copy). */
+   fpos_t *offset;      /* Where each message starts in the file. */
+   int numMsg;          /* Number of messages (length of offset). */
+   int numThreads;      /* Number of workers. */
+   int f_flt;           /* 1 if the grids are read as floats. */
+   int f_abort;         /* 1 if the workers should stop early. */
+   pthread_mutex_t mutex; /* Guards f_abort and each worker's state. */
+   pthread_cond_t cond; /* Broadcast whenever f_abort or a state changes. */
+} convPoolType;
+
+/* A worker decodes messages id, id + numThreads, id + 2 * numThreads, ...
+ * one grid at a time, and waits for the main thread to write each grid. */
+typedef struct {
+   convPoolType *pool;  /* The shared data. */
+   int id;              /* Which worker this is (0..numThreads - 1). */
+   pthread_t thread;    /* The thread running Grib2ConvertWorker. */
+   IS_dataType is;      /* Un-parsed meta data and unpacker memory. */
+   grib_MetaData meta;  /* The meta data for the grid. */
+   double *grib_Data;   /* The grid. */
+   float *flt_Data;     /* The grid, if read as floats (pool->f_flt). */
+   uInt4 grib_DataLen;  /* Size of grib_Data (or flt_Data). */
+   sInt4 f_endMsg;      /* 1 if the grid was the last one in its message. */
+   int state;           /* CONV_BUSY, CONV_READY or CONV_ERROR. */
+   char *errMsg;        /* The errSprintf() message if CONV_ERROR. */
+} convWorkType;
+
+/*****************************************************************************
+ * Grib2ConvertWorker() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   The thread procedure for Grib2ConvertThreads.  Reads each of the
+ * worker's messages from its own copy of the file, and hands the grids one
+ * at a time to the main thread (which writes them in message order).
+ *
+ * ARGUMENTS
+ * arg = The convWorkType for this worker. (Input/Output)
+ *
+ * FILES/DATABASES:
+ *   Opens pool->fileName for read.
+ *
+ * RETURNS: void *
+ *   NULL (errors are left in work->errMsg)
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void *Grib2ConvertWorker (void *arg)
+{
+   convWorkType *work = (convWorkType *) arg; /* This worker. */
+   convPoolType *pool = work->pool; /* The shared data. */
+   userType *usr = pool->usr; /* The user options. */
+   FILE *fp;            /* This worker's copy of the GRIB file. */
+   int msgNum;          /* The message we are working on (0..numMsg-1). */
+   int subgNum;         /* The subgrid in the message we are working on. */
+   LatLon lwlf;         /* Copy of usr->lwlf since ReadGrib2Record may
+                         * change it. */
+   LatLon uprt;         /* Copy of usr->uprt. */
+   int ans;             /* The return value from ReadGrib2Record. */
+
+   if ((fp = fopen (pool->fileName, "rb")) == NULL) {
+      errSprintf ("Problems opening %s for read\n", pool->fileName);
+      pthread_mutex_lock (&(pool->mutex));
+      work->errMsg = errSprintf (NULL);
+      work->state = CONV_ERROR;
+      pthread_cond_broadcast (&(pool->cond));
+      pthread_mutex_unlock (&(pool->mutex));
+      return NULL;
+   }
+   for (msgNum = work->id; msgNum < pool->numMsg;
+        msgNum += pool->numThreads) {
+      fsetpos (fp, &(pool->offset[msgNum]));
+      work->f_endMsg = 1;
+      subgNum = 0;
+      do {
+         lwlf = usr->lwlf;
+         uprt = usr->uprt;
+         if (pool->f_flt) {
+            ans = ReadGrib2RecordFlt (fp, usr->f_unit, &(work->flt_Data),
+                                      &(work->grib_DataLen), &(work->meta),
+                                      &(work->is), subgNum, usr->majEarth,
+                                      usr->minEarth, usr->f_SimpleVer,
+                                      usr->f_SimpleWWA, &(work->f_endMsg),
+                                      &lwlf, &uprt, usr->decimal);
+         } else {
+            ans = ReadGrib2Record (fp, usr->f_unit, &(work->grib_Data),
+                                   &(work->grib_DataLen), &(work->meta),
+                                   &(work->is), subgNum, usr->majEarth,
+                                   usr->minEarth, usr->f_SimpleVer,
+                                   usr->f_SimpleWWA, &(work->f_endMsg),
+                                   &lwlf, &uprt);
+         }
+         pthread_mutex_lock (&(pool->mutex));
+         if (ans != 0) {
+            work->errMsg = errSprintf (NULL);
+            work->state = CONV_ERROR;
+            pthread_cond_broadcast (&(pool->cond));
+            pthread_mutex_unlock (&(pool->mutex));
+            fclose (fp);
+            return NULL;
+         }
+         /* Hand the grid to the main thread, and wait for it to finish. */
+         work->state = CONV_READY;
+         pthread_cond_broadcast (&(pool->cond));
+         while ((work->state == CONV_READY) && (!pool->f_abort)) {
+            pthread_cond_wait (&(pool->cond), &(pool->mutex));
+         }
+         if (pool->f_abort) {
+            pthread_mutex_unlock (&(pool->mutex));
+            fclose (fp);
+            return NULL;
+         }
+         pthread_mutex_unlock (&(pool->mutex));
+         subgNum++;
+      } while (work->f_endMsg != 1);
+   }
+   fclose (fp);
+   return NULL;
+}
+#endif
+
+/*****************************************************************************
+ * Grib2ConvertThreads() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Same as Grib2Convert, except that when the user asks for all messages
+ * and "-threads N" (N > 1), the messages are decoded by N threads at the
+ * same time.  The grids are still written (via MainConvert) by the calling
+ * thread in message order, so the output files and the order of the log
+ * messages are the same as Grib2Convert.
+ *
+ * ARGUMENTS
+ *      usr = The user option structure to use while Degrib'ing. (Input)
+ * fileName = The name of the opened GRIB2 file (NULL if stdin) (Input)
+ *  grib_fp = The opened GRIB2 file to read from (Input)
+ *       is = memory for the Un-parsed meta data for this GRIB2 message.
+ *            As well as some memory used by the unpacker. (Output)
+ *     meta = memory for the meta data from last GRIB2 message read. (Output)
+ *
+ * FILES/DATABASES:
+ *   Each thread opens its own copy of fileName.
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ *  1 = Invalid usage.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *  10/2026 AAT: Keep the message offsets as fpos_t (files over 2 GB).
+ *  10/2026 AAT: Read the grids as floats if all the outputs can use them
+ *          (see ConvertFltUsable).
+ *
+ * NOTES
+ * 1) Falls back to Grib2Convert if there is only one thread, we can't
+ *    open the file by name (stdin), or the file can't be scanned for its
+ *    message offsets (pipe, bad message, etc).  In the last case
+ *    Grib2Convert will report the problem at the same message as before.
+ * 2) "is" and "meta" are only used by the fall back.  The threads have
+ *    their own, whose numSaved counts are added to is and meta.
+ * 3) Any printf()'s in the decoder (warnings about the meta data) may come
+ *    out of order, since they are printed by the thread decoding it.
+ *****************************************************************************
+ */
+int Grib2ConvertThreads (userType *usr, const char *fileName,
+                         FILE *grib_fp, IS_dataType *is,
+                         grib_MetaData *meta)
+{
+#ifdef USE_PTHREAD
+   convPoolType pool;   /* The data shared with the workers. */
+   convWorkType *work;  /* The workers. */
+   convWorkType *cur;   /* The worker holding the current message. */
+   fpos_t start;        /* Where grib_fp was when we were called. */
+   int f_start;         /* 1 if we know start (grib_fp is seekable). */
+   char *msg;           /* Used to clear the error stack on fall back. */
+   int msgNum;          /* The message we are writing (0..numMsg-1). */
+   int f_first = 1;     /* Is this the first message? */
+   sInt4 f_endMsg;      /* 1 if we wrote the last grid in the message. */
+   int state;           /* cur->state when we stopped waiting. */
+   int ans = 0;         /* The return value. */
+   int i;               /* Loop counter over the workers. */
+   int numStarted;      /* Number of workers we started. */
+
+   if ((usr->numThreads <= 1) || (usr->msgNum != 0) || (fileName == NULL)) {
+      return Grib2Convert (usr, grib_fp, is, meta);
+   }
+   if (ConvertOutputCheck (usr) != 0) {
+      return 1;
+   }
+
+   /* Find where each of the messages start. */
+   f_start = (fgetpos (grib_fp, &start) == 0);
+   if ((!f_start) ||
+       (FindGRIBOffsets (grib_fp, &(pool.offset), &(pool.numMsg)) != 0) ||
+       (pool.numMsg < 2)) {
+      if (f_start) {
+         free (pool.offset);
+      }
+      msg = errSprintf (NULL);
+      free (msg);
+      if ((!f_start) || (fsetpos (grib_fp, &start) != 0)) {
+         errSprintf ("ERROR: Couldn't rewind %s\n", fileName);
+         return 1;
+      }
+      return Grib2Convert (usr, grib_fp, is, meta);
+   }
+
+   /* Start the workers. */
+   pool.usr = usr;
+   pool.fileName = fileName;
+   pool.numThreads = (usr->numThreads < pool.numMsg) ? usr->numThreads :
+         pool.numMsg;
+   pool.f_flt = ConvertFltUsable (usr);
+   pool.f_abort = 0;
+   pthread_mutex_init (&(pool.mutex), NULL);
+   pthread_cond_init (&(pool.cond), NULL);
+   work = (convWorkType *) malloc (pool.numThreads * sizeof (convWorkType));
+   for (i = 0; i < pool.numThreads; i++) {
+      work[i].pool = &pool;
+      work[i].id = i;
+      IS_Init (&(work[i].is));
+      MetaInit (&(work[i].meta));
+      work[i].grib_Data = NULL;
+      work[i].flt_Data = NULL;
+      work[i].grib_DataLen = 0;
+      work[i].f_endMsg = 1;
+      work[i].state = CONV_BUSY;
+      work[i].errMsg = NULL;
+      if (pthread_create (&(work[i].thread), NULL, Grib2ConvertWorker,
+                          work + i) != 0) {
+         break;
+      }
+   }
+   if (i != pool.numThreads) {
+      /* Couldn't start all the workers, so stop the ones we did start, and
+       * fall back to Grib2Convert. */
+      numStarted = i;
+      pthread_mutex_lock (&(pool.mutex));
+      pool.f_abort = 1;
+      pthread_cond_broadcast (&(pool.cond));
+      pthread_mutex_unlock (&(pool.mutex));
+      for (i = 0; i <= numStarted; i++) {
+         if (i < numStarted) {
+            pthread_join (work[i].thread, NULL);
+         }
+         free (work[i].errMsg);
+         free (work[i].grib_Data);
+         free (work[i].flt_Data);
+         MetaFree (&(work[i].meta));
+         IS_Free (&(work[i].is));
+      }
+      free (work);
+      free (pool.offset);
+      pthread_cond_destroy (&(pool.cond));
+      pthread_mutex_destroy (&(pool.mutex));
+      fsetpos (grib_fp, &start);
+      return Grib2Convert (usr, grib_fp, is, meta);
+   }
+
+   /* Write the grids in message order as the workers finish them. */
+   for (msgNum = 0; (msgNum < pool.numMsg) && (ans == 0); msgNum++) {
+      cur = work + (msgNum % pool.numThreads);
+      do {
+         pthread_mutex_lock (&(pool.mutex));
+         while (cur->state == CONV_BUSY) {
+            pthread_cond_wait (&(pool.cond), &(pool.mutex));
+         }
+         state = cur->state;
+         pthread_mutex_unlock (&(pool.mutex));
+         if (state == CONV_ERROR) {
+            if (cur->errMsg != NULL) {
+               errSprintf ("%s", cur->errMsg);
+            }
+            preErrSprintf ("ERROR: In call to ReadGrib2Record.\n");
+            ans = 1;
+            break;
+         }
+         if (ValidRangeCheck (usr, &(cur->meta)) != 0) {
+            ans = 1;
+            break;
+         }
+         if (MainConvertCore (usr, &(cur->is), &(cur->meta), cur->grib_Data,
+                              cur->flt_Data, cur->grib_DataLen, usr->f_unit,
+                              f_first) != 0) {
+            preErrSprintf ("ERROR: In call to MainConvert.\n");
+            ans = 1;
+            break;
+         }
+         f_first = 0;
+         f_endMsg = cur->f_endMsg;
+         pthread_mutex_lock (&(pool.mutex));
+         cur->state = CONV_BUSY;
+         pthread_cond_broadcast (&(pool.cond));
+         pthread_mutex_unlock (&(pool.mutex));
+      } while (f_endMsg != 1);
+   }
+
+   /* Stop the workers (they may be waiting on us if we had an error). */
+   pthread_mutex_lock (&(pool.mutex));
+   pool.f_abort = 1;
+   pthread_cond_broadcast (&(pool.cond));
+   pthread_mutex_unlock (&(pool.mutex));
+   for (i = 0; i < pool.numThreads; i++) {
+      pthread_join (work[i].thread, NULL);
+      /* Report the workers' reuse along with the caller's (-stats). */
+      is->numSaved += work[i].is.numSaved;
+      meta->numSaved += work[i].meta.numSaved;
+      free (work[i].errMsg);
+      free (work[i].grib_Data);
+      free (work[i].flt_Data);
+      MetaFree (&(work[i].meta));
+      IS_Free (&(work[i].is));
+   }
+   free (work);
+   free (pool.offset);
+   pthread_cond_destroy (&(pool.cond));
+   pthread_mutex_destroy (&(pool.mutex));
+   return ans;
+#else
+   return Grib2Convert (usr, grib_fp, is, meta);
+#endif
+}
+
+/*****************************************************************************
+ * ConvertStats() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   If the user asked for -stats, reports (on stderr) how many allocations
+ * were saved by reusing the unpacker's memory while converting.
+ *
+ * ARGUMENTS
+ *  usr = The user option structure (only f_stats is used). (Input)
+ *   is = The unpacker memory used to convert. (Input)
+ * meta = The meta data used to convert. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void ConvertStats (const userType *usr, const IS_dataType *is,
+                          const grib_MetaData *meta)
+{
+   if (usr->f_stats) {
+      fprintf (stderr, "Reusing the unpacker's memory saved %lu "
+               "allocations\n",
+               (unsigned long int) (is->numSaved + meta->numSaved));
+   }
+}
+
 /*****************************************************************************
  * DegribIt() -- Review 12/2002
  *
@@ -1041,6 +1605,12 @@ int Grib2Convert (userType *usr, FILE *grib_fp, IS_dataType *is,
  *  11/2002 Arthur Taylor (MDL/RSIS): Created.
  *  12/2002 (TK,AC,TB,&MS): Code Review.
  *   7/2003 AAT: memleak by free'ing outName outside the loop.
+ *  10/2026 AAT: -I and -C -msg [N] use the .gidx index when it is fresh.
+ *  10/2026 AAT: -threads also applies to JPEG2000 code blocks.
+ *  10/2026 AAT: -threads also applies to genProbe's GRIB files.
+ *  10/2026 AAT: -C reuses the unpacker's memory for all the files, and
+ *          -stats reports the allocations that saved.
+ *  10/2026 AAT: -gidx also applies to the probes (see genProbeGidx).
  *
  * NOTES
  *   printf ("Timing info. %f\n", clock() / (double) (CLOCKS_PER_SEC));
@@ -1065,6 +1635,7 @@ int DegribIt (userType *usr)
    size_t inName;       /* Index into the input name array */
    int msgNum;          /* The messageNumber during the inventory. */
    int curMsg;          /* The current message used during the FindGRIB */
+   int ans;             /* Return value of the inventory / find calls. */
 
 #ifdef DEBUG
    if (!usr->f_stdout) {
@@ -1073,6 +1644,18 @@ int DegribIt (userType *usr)
    }
 #endif
 
+   /* Let -threads split the code blocks of JPEG2000 fields among threads,
+    * unless the threads are already decoding a message each (see
+    * Grib2ConvertThreads). */
+   if ((usr->f_Command != CMD_CONVERT) || (usr->msgNum != 0)) {
+      unpk_g2ncepThreads (usr->numThreads);
+   }
+   /* The -XML, -Graph and -MOTD probes can probe several GRIB files at once
+    * (see genProbe). */
+   genProbeThreads (usr->numThreads);
+   genProbeStats (usr->f_stats);
+   genProbeGidx (usr->f_gidx);
+
    /* Create an Inventory of this file. */
    switch (usr->f_Command) {
       case CMD_SPLIT:
@@ -1094,8 +1677,14 @@ int DegribIt (userType *usr)
          LenInv = 0;
          msgNum = 0;
          for (inName = 0; inName < usr->numInNames; inName++) {
-            if (GRIB2Inventory (usr->inNames[inName], &Inv, &LenInv, 0,
-                                &msgNum) < 0) {
+            /* Use the .gidx index if it is fresh (or -gidx made it so). */
+            ans = GidxInventory (usr->inNames[inName], usr->f_gidx, 1, &Inv,
+                                 &LenInv, &msgNum);
+            if (ans == 1) {
+               ans = GRIB2Inventory (usr->inNames[inName], &Inv, &LenInv, 0,
+                                     &msgNum);
+            }
+            if (ans < 0) {
                printf ("ERROR: with inventory, so far:\n");
                GRIB2InventoryPrint (Inv, LenInv);
                msg = errSprintf (NULL);
@@ -1142,8 +1731,12 @@ int DegribIt (userType *usr)
                   grib_fp = stdin;
                }
                offset = 0;
-               /* Find the desired GRIB message. */
-               if (FindGRIBMsg (grib_fp, usr->msgNum, &offset, &curMsg) == -1) {
+               /* Find the desired GRIB message (using the .gidx index if
+                * we can). */
+               ans = GidxSeekMsg (grib_fp, usr->inNames[inName], usr->f_gidx,
+                                  usr->msgNum, &curMsg);
+               if ((ans == 1) &&
+                   (FindGRIBMsg (grib_fp, usr->msgNum, &offset, &curMsg) == -1)) {
                   msg = errSprintf (NULL);
                   printf ("ERROR: In call to FindGRIBMsg.\n%s", msg);
                   free (msg);
@@ -1162,6 +1755,7 @@ int DegribIt (userType *usr)
                      fclose (grib_fp);
                      return 1;
                   }
+                  ConvertStats (usr, &is, &meta);
                   MetaFree (&meta);
                   IS_Free (&is);
                   fclose (grib_fp);
@@ -1185,7 +1779,8 @@ int DegribIt (userType *usr)
                } else {
                   grib_fp = stdin;
                }
-               if (Grib2Convert (usr, grib_fp, &is, &meta) != 0) {
+               if (Grib2ConvertThreads (usr, usr->inNames[inName], grib_fp,
+                                        &is, &meta) != 0) {
                   msg = errSprintf (NULL);
                   printf ("ERROR: In call to Grib2Convert.\n%s\n", msg);
                   free (msg);
@@ -1195,7 +1790,10 @@ int DegribIt (userType *usr)
                   return 1;
                }
                fclose (grib_fp);
+               /* Keep the unpacker's memory for the next file. */
+               IS_Recycle (&is);
             }
+            ConvertStats (usr, &is, &meta);
             MetaFree (&meta);
             IS_Free (&is);
          }
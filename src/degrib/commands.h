@@ -17,9 +17,18 @@
 #include "meta.h"
 #include "degrib2.h"
 
+/* Use POSIX threads for the -threads option (see Grib2ConvertThreads). */
+#if !defined(_WINDOWS_) && !defined(MS_WINDOWS)
+#define USE_PTHREAD
+#endif
+
 int Grib2Convert (userType * usr, FILE * grib_fp, IS_dataType *is,
                   grib_MetaData *meta);
 
+int Grib2ConvertThreads (userType *usr, const char *fileName,
+                         FILE *grib_fp, IS_dataType *is,
+                         grib_MetaData *meta);
+
 int GetOutputName (userType * usr, grib_MetaData * meta, char **buffer,
                    size_t *buffLen);
 
@@ -27,6 +27,8 @@
 #include "myassert.h"
 #include "clock.h"
 #include "genprobe.h"
+#include "weather.h"
+#include "hazard.h"
 #ifdef MEMWATCH
 #include "memwatch.h"
 #endif
@@ -101,6 +103,17 @@ static void Usage (char *argv0, userType *usr)
          printf ("               'm' 'metric' (use C, kg/m**2 or m, m/s)\n");
          printf ("  -Decimal [amount] = How many decimals to round to "
                  "[0..18]\n");
+         printf ("  -threads [N] = Decode N messages at a time (with "
+                 "-msg all), or use N\n");
+         printf ("                 threads per JPEG2000 field otherwise\n");
+         printf ("                 With -XML, -Graph, -MOTD probe N files "
+                 "at a time\n");
+         printf ("  -gidx = Write a [file].gidx index if it is missing or "
+                 "stale (also -I, -P)\n");
+         printf ("  -stats = Report the allocations saved by reusing the "
+                 "unpacker's memory\n");
+         printf ("  -TdlPack [1,2] = Find TDLPack groups by 1=search "
+                 "(smallest), 2=one pass (fast)\n");
          printf ("\nFLT SPECIFIC OPTIONS (need -Flt)\n");
          printf ("  -GrADS [1,2] = Create version 1 or 2 of the .ctl file\n"
                  "for use with GrADS\n");
@@ -312,6 +325,8 @@ static void Usage (char *argv0, userType *usr)
                  " files\n");
          printf ("  -Append      = Append to data cube, instead of replacing"
                  " it.\n");
+         printf ("  -Series      = Also store the grids point by point (.pts)"
+                 " for -DP\n");
          printf ("  -msg [msgNum].[subgrdNum] = Which grib message to "
                  "convert.\n");
          printf ("               If msgNum = 0 or 'all', do all messages."
@@ -758,6 +773,8 @@ int main (int argc, char **argv)
    /* Do it. */
    ans = DegribIt (&usr);
 
+   FreeUglyStringCache ();
+   FreeHazardStringCache ();
    UserFree (&usr);
    return ans;
 }
@@ -16,6 +16,300 @@
 #include "cube.h"
 #include "clock.h"
 
+/* Number of values to read from the grids of a PDS array before writing
+ * them out point by point. */
+#define SERIES_CHUNK (1024 * 1024)
+
+/*****************************************************************************
+ * Grib2SeriesCube() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Write a point major (time series) copy of the grids in an index, and
+ * point the PDS in the index at it.  For each super header, the values of
+ * every PDS for a cell are stored next to each other, so a point forecast
+ * reads one short run of the file instead of one value from every grid.
+ *
+ * ARGUMENTS
+ *   indexFile = Name of the index file (the series file is the same name
+ *               with a .pts extension). (Input)
+ *    flxArray = The index file in a char buffer. (Input/Output)
+ * flxArrayLen = The length of flxArray. (Input/Output)
+ *
+ * FILES/DATABASES:
+ *   Reads the grids (.dat or .flt files) named in the index, and rewrites
+ *   the series file.
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ * -1 = Problems writing the series file (it is removed, and so are all the
+ *      series trailers).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *  10/2026 AAT: Open each data file once per super header, check the grids
+ *          are all there before writing, and mark the index (FLX_SERIES_ID).
+ *
+ * NOTES
+ * 1) A super header is skipped (its PDS get no trailer, so probes keep using
+ *    the grids) if its grids can't be opened or are short, or don't share an
+ *    endian and a scan, or if the series file would go past 2GB.
+ * 2) The values are copied as raw 4 byte words, so they keep the endian of
+ *    the grids.
+ * 3) If any PDS has a trailer, the index starts with FLX_SERIES_ID instead
+ *    of FLX_ID.
+ *****************************************************************************
+ */
+static int Grib2SeriesCube (char *indexFile, char **flxArray,
+                            int *flxArrayLen)
+{
+   char *seriesName;    /* Name of the series file (with path). */
+   char *namePtr;       /* seriesName without the path. */
+   char *dirName;       /* A data file name (with path). */
+   char *dirPtr;        /* Where the file part of dirName starts. */
+   char *extPtr;        /* Where the extension of seriesName starts. */
+   FILE *sfp;           /* The opened series file. */
+   FILE **dfps = NULL;  /* The opened data file of each PDS. */
+   char elem[256];      /* A holder for the element of a super header. */
+   char unit[256];      /* A holder for the unit of a super header. */
+   char comment[256];   /* A holder for the comment of a super header. */
+   double refTime;      /* Reference time of a super header. */
+   uShort2 gdsNum;      /* The GDS index of a super header. */
+   uShort2 center;      /* The center of a super header. */
+   uShort2 subCenter;   /* The sub center of a super header. */
+   uShort2 numPDS;      /* Number of PDS in the current PDS array. */
+   char *pdsPtr;        /* Current PDS. */
+   sInt4 lenTotPDS;     /* Length of current super header + PDS array. */
+   double validTime;    /* Valid time of a PDS. */
+   uChar endian;        /* Endian'ness of a PDS's grid. */
+   uChar scan;          /* Scan of a PDS's grid. */
+   uChar endian1 = 0;   /* Endian'ness of the first grid. */
+   uChar scan1 = 0;     /* Scan of the first grid. */
+   uShort2 numTable;    /* Number of strings in a PDS's table. */
+   char **table;        /* Table of strings of a PDS. */
+   gdsType gds;         /* The grid of the current super header. */
+   uShort2 numGDS;      /* number of GDS Sections. */
+   uShort2 numSupPDS;   /* # of Super PDS Sections. */
+   sInt4 supStart;      /* Where the first super header is. */
+   sInt4 supOffset;     /* Where the current super header is. */
+   sInt4 pdsOffset;     /* Where the current PDS is. */
+   uShort2 lenPDS;      /* Length of current PDS. */
+   sInt4 *base;         /* Where each super header's series start (or -1) */
+   sInt4 seriesLen;     /* Bytes written to the series file so far. */
+   char *names = NULL;  /* Data file of each PDS (256 char each). */
+   sInt4 *offsets = NULL; /* Offset of each PDS's grid in its data file. */
+   uChar *grids = NULL; /* A chunk of cells from each grid. */
+   uChar *series = NULL; /* The same chunk of cells, point by point. */
+   sInt4 numCells;      /* Number of cells in the current grid. */
+   sInt4 chunk;         /* Cells read from each grid at a time. */
+   sInt4 cell;          /* First cell of the current chunk. */
+   sInt4 num;           /* Number of cells in the current chunk. */
+   sInt4 c;             /* Loop counter over cells in a chunk. */
+   int f_ok;            /* True if the current super header is usable. */
+   int f_err = 0;       /* True if we had problems writing seriesName. */
+   int i;               /* Loop counter over super headers. */
+   int t;               /* Loop counter over PDS. */
+   int k;               /* Loop counter over tables (or earlier PDS). */
+
+   /* Figure out the names of the series file and of the data files. */
+   dirName = (char *) malloc (strlen (indexFile) + 256);
+   strcpy (dirName, indexFile);
+   if ((dirPtr = strrchr (dirName, '/')) == NULL) {
+      dirPtr = strrchr (dirName, '\\');
+   }
+   dirPtr = (dirPtr == NULL) ? dirName : dirPtr + 1;
+   seriesName = (char *) malloc (strlen (indexFile) + 5);
+   strcpy (seriesName, indexFile);
+   namePtr = seriesName + (dirPtr - dirName);
+   if ((extPtr = strrchr (namePtr, '.')) == NULL) {
+      extPtr = namePtr + strlen (namePtr);
+   }
+   strcpy (extPtr, ".pts");
+   sfp = NULL;
+   if ((strlen (namePtr) > 254) ||
+       ((sfp = fopen (seriesName, "wb")) == NULL)) {
+      errSprintf ("Problems opening %s for write\n", seriesName);
+      f_err = 1;
+   }
+
+   MEMCPY_LIT (&numGDS, *flxArray + HEADLEN, sizeof (uShort2));
+   supStart = HEADLEN + 2 + numGDS * GDSLEN;
+   MEMCPY_LIT (&numSupPDS, *flxArray + supStart, sizeof (uShort2));
+   supStart += 2;
+   base = (sInt4 *) malloc ((numSupPDS + 1) * sizeof (sInt4));
+
+   /* Pass 1: Write the series file. */
+   seriesLen = 0;
+   supOffset = supStart;
+   for (i = 0; i < numSupPDS; i++) {
+      base[i] = -1;
+      ReadSupPDSBuff (*flxArray + supOffset, elem, &refTime, unit, comment,
+                      &gdsNum, &center, &subCenter, &numPDS, &pdsPtr,
+                      &lenTotPDS);
+      supOffset += lenTotPDS;
+      if (f_err || (numPDS == 0) || (gdsNum < 1) || (gdsNum > numGDS)) {
+         continue;
+      }
+      ReadGDSBuffer (*flxArray + HEADLEN + 2 + (gdsNum - 1) * GDSLEN, &gds);
+      numCells = gds.Nx * gds.Ny;
+      if ((numCells <= 0) ||
+          ((double) seriesLen + (double) numCells * numPDS * 4 >
+           2147483647.)) {
+         continue;
+      }
+      names = (char *) realloc (names, numPDS * 256);
+      offsets = (sInt4 *) realloc (offsets, numPDS * sizeof (sInt4));
+      f_ok = 1;
+      for (t = 0; t < numPDS; t++) {
+         numTable = 0;
+         table = NULL;
+         ReadPDSBuff (pdsPtr, &validTime, names + t * 256, offsets + t,
+                      &endian, &scan, &numTable, &table, &pdsPtr);
+         for (k = 0; k < numTable; k++) {
+            free (table[k]);
+         }
+         free (table);
+         if (t == 0) {
+            endian1 = endian;
+            scan1 = scan;
+         } else if ((endian != endian1) || (scan != scan1)) {
+            f_ok = 0;
+         }
+      }
+      if (!f_ok) {
+         continue;
+      }
+
+      /* Open each data file once (the PDS of a .dat cube share one), and
+       * make sure every grid is all there before writing anything. */
+      dfps = (FILE **) realloc (dfps, numPDS * sizeof (FILE *));
+      for (t = 0; t < numPDS; t++) {
+         dfps[t] = NULL;
+      }
+      for (t = 0; (t < numPDS) && f_ok; t++) {
+         for (k = 0; k < t; k++) {
+            if (strcmp (names + k * 256, names + t * 256) == 0) {
+               dfps[t] = dfps[k];
+               break;
+            }
+         }
+         if (k == t) {
+            strcpy (dirPtr, names + t * 256);
+            if ((dfps[t] = fopen (dirName, "rb")) == NULL) {
+               f_ok = 0;
+               break;
+            }
+         }
+         if ((fseek (dfps[t], 0, SEEK_END) != 0) ||
+             ((double) ftell (dfps[t]) <
+              (double) offsets[t] + (double) numCells * 4)) {
+            f_ok = 0;
+         }
+      }
+
+      /* Read a chunk of cells from each grid, and write it out point by
+       * point. */
+      chunk = SERIES_CHUNK / numPDS;
+      if (chunk < 1) {
+         chunk = 1;
+      }
+      if (chunk > numCells) {
+         chunk = numCells;
+      }
+      if (f_ok) {
+         grids = (uChar *) realloc (grids, chunk * numPDS * 4);
+         series = (uChar *) realloc (series, chunk * numPDS * 4);
+      }
+      for (cell = 0; (cell < numCells) && f_ok; cell += chunk) {
+         num = (numCells - cell < chunk) ? numCells - cell : chunk;
+         for (t = 0; t < numPDS; t++) {
+            if ((fseek (dfps[t], offsets[t] + cell * 4, SEEK_SET) != 0) ||
+                (fread (grids + t * num * 4, 4, num, dfps[t]) !=
+                 (size_t) num)) {
+               strcpy (dirPtr, names + t * 256);
+               errSprintf ("Problems reading %s\n", dirName);
+               f_err = 1;
+               f_ok = 0;
+               break;
+            }
+         }
+         if (!f_ok) {
+            break;
+         }
+         for (c = 0; c < num; c++) {
+            for (t = 0; t < numPDS; t++) {
+               memcpy (series + (c * numPDS + t) * 4,
+                       grids + (t * num + c) * 4, 4);
+            }
+         }
+         if (fwrite (series, 4, num * numPDS, sfp) != (size_t) num * numPDS) {
+            errSprintf ("Problems writing to %s\n", seriesName);
+            f_err = 1;
+            f_ok = 0;
+         }
+      }
+      for (t = 0; t < numPDS; t++) {
+         for (k = 0; k < t; k++) {
+            if (dfps[k] == dfps[t]) {
+               break;
+            }
+         }
+         if ((k == t) && (dfps[t] != NULL)) {
+            fclose (dfps[t]);
+         }
+      }
+      if (f_ok) {
+         base[i] = seriesLen;
+         seriesLen += numCells * numPDS * 4;
+      }
+   }
+   if ((sfp != NULL) && (fclose (sfp) != 0) && !f_err) {
+      errSprintf ("Problems writing to %s\n", seriesName);
+      f_err = 1;
+   }
+   /* Don't leave a partial (or empty) series file around. */
+   if ((sfp != NULL) && (f_err || (seriesLen == 0))) {
+      remove (seriesName);
+   }
+
+   /* Pass 2: Update the series trailers (removing them if there were
+    * problems, since seriesName has been removed). */
+   supOffset = supStart;
+   for (i = 0; i < numSupPDS; i++) {
+      ReadSupPDSBuff (*flxArray + supOffset, elem, &refTime, unit, comment,
+                      &gdsNum, &center, &subCenter, &numPDS, &pdsPtr,
+                      &lenTotPDS);
+      pdsOffset = pdsPtr - *flxArray;
+      for (t = 0; t < numPDS; t++) {
+         if (f_err || (base[i] == -1)) {
+            SetPDSSeries (flxArray, flxArrayLen, supOffset, pdsOffset, NULL,
+                          0, 0);
+         } else {
+            SetPDSSeries (flxArray, flxArrayLen, supOffset, pdsOffset,
+                          namePtr, base[i] + t * 4, numPDS);
+         }
+         MEMCPY_LIT (&lenPDS, *flxArray + pdsOffset, sizeof (uShort2));
+         pdsOffset += lenPDS;
+      }
+      MEMCPY_LIT (&lenTotPDS, *flxArray + supOffset, sizeof (sInt4));
+      supOffset += lenTotPDS;
+   }
+   /* Older builds don't know to skip the trailers, so mark the index. */
+   memcpy (*flxArray, ((f_err) || (seriesLen == 0)) ? FLX_ID : FLX_SERIES_ID,
+           3);
+
+   free (grids);
+   free (series);
+   free (names);
+   free (offsets);
+   free (dfps);
+   free (base);
+   free (seriesName);
+   free (dirName);
+   return (f_err) ? -1 : 0;
+}
+
 /*****************************************************************************
  * Grib2Database() --
  *
@@ -42,6 +336,7 @@
  *
  * HISTORY
  *   8/2003 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Added -Series (Grib2SeriesCube).
  *
  * NOTES
  *****************************************************************************
@@ -358,6 +653,20 @@ int Grib2Database (userType *usr, IS_dataType *is, grib_MetaData *meta)
       fclose (grib_fp);
    }
 
+   /* Add a point major copy of the grids for fast point forecasts. */
+   if (usr->f_Series) {
+      if (Grib2SeriesCube (usr->indexFile, &flxArray, &flxArrayLen) != 0) {
+         /* Update fileLen and write the index file out. */
+         flxLen = flxArrayLen;
+         MEMCPY_LIT (flxArray + 3, &flxLen, sizeof (sInt4));
+         WriteFLX (usr->indexFile, flxArray, flxArrayLen);
+         free (flxArray);
+         free (grib_Data);
+         free (outName);
+         return 3;
+      }
+   }
+
    /* Update fileLen and write the index file out. */
    flxLen = flxArrayLen;
    MEMCPY_LIT (flxArray + 3, &flxLen, sizeof (sInt4));
@@ -376,23 +685,35 @@ void NDFD_Cube2MetaWx (sect2_WxType *Wx, char **keys, int numKeys,
    int j;
    int len;             /* length of current english phrases during creation
                          * of the maxEng[] data. */
+   uInt4 buffLen;       /* Room needed in Wx->buff for all the keys. */
+   char *buffer;        /* Where the current key goes in Wx->buff. */
 
+   /* Reuse the table from the last grid (see MetaSect2Recycle). */
+   buffLen = 0;
+   for (i = 0; i < numKeys; i++) {
+      buffLen += strlen (keys[i]) + 1;
+   }
+   MetaWxReserve (Wx, numKeys, buffLen);
    Wx->dataLen = numKeys;
-   Wx->data = (char **) malloc (numKeys * sizeof (char *));
-   Wx->ugly = (UglyStringType *) malloc (numKeys * sizeof (UglyStringType));
    Wx->maxLen = 0;
    for (i = 0; i < NUM_UGLY_WORD; i++) {
       Wx->maxEng[i] = 0;
    }
 
+   buffer = Wx->buff;
    for (i = 0; i < numKeys; i++) {
       len = strlen (keys[i]);
-      Wx->data[i] = (char *) malloc ((len + 1) * sizeof (char));
+      Wx->data[i] = buffer;
       strcpy (Wx->data[i], keys[i]);
+      buffer += len + 1;
       if (Wx->maxLen < len) {
          Wx->maxLen = len;
       }
-      ParseUglyString (&(Wx->ugly[i]), Wx->data[i], simpVer);
+      if (ParseUglyString (&(Wx->ugly[i]), Wx->data[i], simpVer) == 0) {
+         Wx->f_valid[i] = 1;
+      } else {
+         Wx->f_valid[i] = 0;
+      }
       /* We want to know how many bytes we need for each english phrase
        * column, so we walk through each column calculating that value. */
       for (j = 0; j < NUM_UGLY_WORD; j++) {
@@ -1077,6 +1398,8 @@ int Grib2DataConvert (userType *usr)
    uShort2 numGDS;      /* number of GDS Sections. */
    uShort2 numSupPDS;   /* # of Super PDS Sections. */
    uShort2 numPDS;      /* number of PDS Sections. */
+   char *pdsPtr;        /* The start of the current PDS. */
+   uShort2 lenPDS;      /* Size of the current PDS. */
    int i;               /* Loop counter over super PDS. */
    int j;               /* Loop counter over PDS Array. */
    int k;               /* Loop counter over number of Keys */
@@ -1173,7 +1496,9 @@ int Grib2DataConvert (userType *usr)
       MEMCPY_LIT (&numPDS, ptr, sizeof (uShort2));
       ptr += 2;
       for (j = 0; j < numPDS; j++) {
-         ptr += 2;      /* skip size of PDS. */
+         pdsPtr = ptr;
+         MEMCPY_LIT (&lenPDS, ptr, sizeof (uShort2));
+         ptr += 2;
          MEMCPY_LIT (&valTime, ptr, sizeof (double));
          ptr += 8;
          uc_temp = *ptr;
@@ -1198,6 +1523,8 @@ int Grib2DataConvert (userType *usr)
             keys[k][keyLen] = '\0';
             ptr += keyLen;
          }
+         /* Step over anything after the table (such as a series trailer). */
+         ptr = pdsPtr + lenPDS;
 
          /* Method 1... convert to meta, call convert.. which in turn
           * converts meta to is-array...  */
@@ -1283,7 +1610,7 @@ int Grib2DataConvert (userType *usr)
             free (keys[k]);
          }
          free (keys);
-         MetaSect2Free (&meta);
+         MetaSect2Recycle (&meta);
       }
    }
    free (gribData);
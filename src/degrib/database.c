@@ -9,6 +9,8 @@
  * HISTORY
  *   7/2003 Arthur Taylor (MDL / RSIS): Started experimenting with.
  *   8/2003 AAT: Revisited.
+ *  10/2026 AAT: Added the optional time series trailer to the PDS.
+ *  10/2026 AAT: An index with a series trailer starts with "FL2".
  *
  * NOTES
  * 1) Improvements: Put a creation time in the .flx file.
@@ -37,7 +39,8 @@
  *   ...
  *
  * Header...
- *   [1..3] = "FLX"
+ *   [1..3] = "FLX" ("FL2" if any PDS has a series trailer, so that builds
+ *            that don't know to skip it refuse the index.)
  *   [4..7] = LI : File size.
  *   [8..20] = Reserved
  *
@@ -90,6 +93,15 @@
  *                      (In theory an ugly string could be > 255 char)
  *     USI = len of table entry n
  *     array char = table entry n
+ *   (Optional: present if "Size of PDS" goes past the table.)
+ *   UC : len of series filename
+ *   array char : series filename (no path info, (assumed same dir as .flx))
+ *   LI : offset into series filename of this PDS's value for the first cell
+ *   USI : # of values in each cell's series (N)
+ *     (The series file stores the grids of a PDS array point by point
+ *      instead of grid by grid.  For each cell (in the "scan" order of the
+ *      PDS) it has the N values of that cell in validTime order, so cell c
+ *      of this PDS is at offset + c * N * 4, with the "Endian'ness" above.)
  *****************************************************************************
  */
 /*
@@ -832,17 +844,13 @@ void ReadPDSBuff (char *pdsPtr, double *validTime, char *dataFile,
                   sInt4 *dataOffset, uChar *endian, uChar *scan,
                   uShort2 *numTable, char ***table, char **nextPds)
 {
-#ifdef DEBUG
-   sInt4 lenPDS;        /* Length of PDS section. */
-#endif
+   uShort2 lenPDS;      /* Length of PDS section. */
    char *ptr;           /* A pointer to where we are in the array. */
    uChar numBytes;      /* number of bytes in following string. */
    uShort2 sNumBytes;   /* number of bytes in an "ugly" string. */
    int k;               /* Loop counter over "ugly" string. */
 
-#ifdef DEBUG
    MEMCPY_LIT (&lenPDS, pdsPtr, sizeof (uShort2));
-#endif
    ptr = pdsPtr + 2;
    MEMCPY_LIT (validTime, ptr, sizeof (double));
    ptr += 8;
@@ -874,7 +882,181 @@ void ReadPDSBuff (char *pdsPtr, double *validTime, char *dataFile,
          ptr += sNumBytes;
       }
    }
-   *nextPds = ptr;
+   /* Skip by size, so we also step over the optional series trailer. */
+   *nextPds = pdsPtr + lenPDS;
+}
+
+/*****************************************************************************
+ * PDSTableEnd() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Find where the table of a PDS ends, which is where the optional series
+ * trailer starts.
+ *
+ * ARGUMENTS
+ * pdsPtr = The start of the PDS. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: char *
+ *   Pointer to the first byte after the table.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static char *PDSTableEnd (char *pdsPtr)
+{
+   char *ptr;           /* A pointer to where we are in the array. */
+   uShort2 numTable;    /* number of strings in the table. */
+   uShort2 sNumBytes;   /* number of bytes in an "ugly" string. */
+   int k;               /* Loop counter over "ugly" string. */
+
+   /* Skip size, validTime, filename, offset, endian, and scan. */
+   ptr = pdsPtr + 2 + 8;
+   ptr += 1 + (uChar) *ptr;
+   ptr += 4 + 1 + 1;
+   MEMCPY_LIT (&numTable, ptr, sizeof (uShort2));
+   ptr += 2;
+   for (k = 0; k < numTable; k++) {
+      MEMCPY_LIT (&sNumBytes, ptr, sizeof (uShort2));
+      ptr += 2 + sNumBytes;
+   }
+   return ptr;
+}
+
+/*****************************************************************************
+ * ReadPDSSeries() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Read the optional series trailer of a PDS, which says where the values
+ * of this PDS are in the point major (time series) file.
+ *
+ * ARGUMENTS
+ *       pdsPtr = The start of the PDS. (Input)
+ *   seriesFile = The series file name (no path) (char[256]). (Output)
+ * seriesOffset = Where in seriesFile this PDS's value for the first cell
+ *                is. (Output)
+ *    seriesLen = Number of values in each cell's series. (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *   1 = The PDS has a series trailer.
+ *   0 = It doesn't (outputs are not set).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Cell c of the grid is at seriesOffset + c * seriesLen * sizeof (float).
+ *****************************************************************************
+ */
+int ReadPDSSeries (char *pdsPtr, char *seriesFile, sInt4 *seriesOffset,
+                   uShort2 *seriesLen)
+{
+   uShort2 lenPDS;      /* Length of PDS section. */
+   char *ptr;           /* A pointer to where we are in the array. */
+   uChar numBytes;      /* number of bytes in following string. */
+
+   MEMCPY_LIT (&lenPDS, pdsPtr, sizeof (uShort2));
+   ptr = PDSTableEnd (pdsPtr);
+   if (ptr >= pdsPtr + lenPDS) {
+      return 0;
+   }
+   numBytes = *ptr;
+   ptr++;
+   memcpy (seriesFile, ptr, numBytes);
+   seriesFile[numBytes] = '\0';
+   ptr += numBytes;
+   MEMCPY_LIT (seriesOffset, ptr, sizeof (sInt4));
+   ptr += 4;
+   MEMCPY_LIT (seriesLen, ptr, sizeof (uShort2));
+   return 1;
+}
+
+/*****************************************************************************
+ * SetPDSSeries() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Add, replace or remove the series trailer of a PDS, updating the size of
+ * the PDS and of the super header it is in.
+ *
+ * ARGUMENTS
+ *     flxArray = The char array to update. (Input/Output)
+ *  flxArrayLen = The length of flxArray. (Input/Output)
+ *    supOffset = Where in flxArray the super header of the PDS is. (Input)
+ *    pdsOffset = Where in flxArray the PDS is. (Input)
+ *   seriesFile = The series file name (no path), or NULL to remove the
+ *                trailer. (Input)
+ * seriesOffset = Where in seriesFile this PDS's value for the first cell
+ *                is. (Input)
+ *    seriesLen = Number of values in each cell's series. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *  > 0 = The new size of the PDS.
+ *   -1 = seriesFile was too long, or the PDS would be too big.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   The caller needs to update the file size in the header.
+ *****************************************************************************
+ */
+int SetPDSSeries (char **flxArray, int *flxArrayLen, sInt4 supOffset,
+                  sInt4 pdsOffset, const char *seriesFile,
+                  sInt4 seriesOffset, uShort2 seriesLen)
+{
+   uShort2 lenPDS;      /* Length of PDS section. */
+   sInt4 sizeSuperPDS;  /* Total size of the superHeader + PDS array. */
+   sInt4 tail;          /* Where in flxArray the old trailer starts. */
+   int oldLen;          /* Length of the old trailer. */
+   int newLen;          /* Length of the new trailer. */
+   uChar numBytes;      /* Length of seriesFile. */
+   char buffer[1 + 255 + 4 + 2]; /* The new trailer. */
+
+   myAssert (sizeof (sInt4) == 4);
+   myAssert (sizeof (uShort2) == 2);
+
+   newLen = 0;
+   if (seriesFile != NULL) {
+      if (strlen (seriesFile) > 254) {
+         return -1;
+      }
+      numBytes = strlen (seriesFile);
+      buffer[0] = numBytes;
+      memcpy (buffer + 1, seriesFile, numBytes);
+      MEMCPY_LIT (buffer + 1 + numBytes, &seriesOffset, sizeof (sInt4));
+      MEMCPY_LIT (buffer + 1 + numBytes + 4, &seriesLen, sizeof (uShort2));
+      newLen = 1 + numBytes + 4 + 2;
+   }
+   MEMCPY_LIT (&lenPDS, *flxArray + pdsOffset, sizeof (uShort2));
+   tail = PDSTableEnd (*flxArray + pdsOffset) - *flxArray;
+   oldLen = pdsOffset + lenPDS - tail;
+   if (lenPDS - oldLen + newLen > 0xffff) {
+      return -1;
+   }
+   BufferRemove (*flxArray, flxArrayLen, tail, oldLen);
+   if (newLen != 0) {
+      BufferInsert (flxArray, flxArrayLen, tail, buffer, newLen);
+   }
+   lenPDS = lenPDS - oldLen + newLen;
+   MEMCPY_LIT (*flxArray + pdsOffset, &lenPDS, sizeof (uShort2));
+   MEMCPY_LIT (&sizeSuperPDS, *flxArray + supOffset, sizeof (sInt4));
+   sizeSuperPDS += newLen - oldLen;
+   MEMCPY_LIT (*flxArray + supOffset, &sizeSuperPDS, sizeof (sInt4));
+   return lenPDS;
 }
 
 /*
@@ -1000,6 +1182,7 @@ static void PrintSupPDS (char *buffer, sInt4 buffLen)
    uShort2 numTable;    /* Number of strings in the table */
    char *table = NULL;  /* Table of strings associated with this PDS. */
    int j;               /* A loop counter over the table array. */
+   char *pdsPtr;        /* The start of the current PDS. */
 
    myAssert (buffer != NULL);
    myAssert (sizeof (double) == 8);
@@ -1049,6 +1232,7 @@ static void PrintSupPDS (char *buffer, sInt4 buffLen)
    printf ("NumPDS: %d\n", numPDS);
    for (i = 0; i < numPDS; i++) {
       printf ("... PDS %d ...\n", i);
+      pdsPtr = ptr;
       MEMCPY_LIT (&si_temp, ptr, sizeof (uShort2));
       ptr += 2;
       printf ("Sizeof PDS: %d\n", si_temp);
@@ -1082,6 +1266,13 @@ static void PrintSupPDS (char *buffer, sInt4 buffLen)
          table[si_temp] = '\0';
          printf ("table entry %d: %s\n", j, table);
       }
+      if (ReadPDSSeries (pdsPtr, elem, &li_temp, &si_temp)) {
+         printf ("series filename: %s\n", elem);
+         printf ("Series Offset: %ld\n", (long int) li_temp);
+         printf ("Series Length: %d\n", si_temp);
+      }
+      MEMCPY_LIT (&si_temp, pdsPtr, sizeof (uShort2));
+      ptr = pdsPtr + si_temp;
    }
    free (table);
 }
@@ -1098,6 +1289,7 @@ static void PrintSupPDS (char *buffer, sInt4 buffLen)
  * filename = Name of the file to open. (Input)
  *       fp = FILE pointer which will point to filename (Output)
  *  f_write = True if one needs to write to the file. (Input)
+ *       id = The 3 letter identifier (FLX_ID or FLX_SERIES_ID). (Output)
  *
  * FILES/DATABASES: None
  *
@@ -1109,15 +1301,15 @@ static void PrintSupPDS (char *buffer, sInt4 buffLen)
  * HISTORY
  *   8/2003 Arthur Taylor (MDL/RSIS): Commented.
  *   9/2003 AAT: Added f_write option.
+ *  10/2026 AAT: Accept FLX_SERIES_ID, and return the identifier.
  *
  * NOTES
  *    After call, FILE *fp points to data after the 3 letter identifier.
  *****************************************************************************
  */
-static int OpenFLX (const char *filename, FILE **fp, sChar f_write)
+static int OpenFLX (const char *filename, FILE **fp, sChar f_write,
+                    char id[4])
 {
-   char header[4];      /* Used to validate the Header. */
-
    myAssert (filename != NULL);
 
    if (f_write) {
@@ -1130,9 +1322,11 @@ static int OpenFLX (const char *filename, FILE **fp, sChar f_write)
       }
    }
    /* Read the header. */
-   fread (header, sizeof (char), 3, *fp);
-   header[3] = '\0';
-   if (strcmp (header, "FLX") != 0) {
+   if (fread (id, sizeof (char), 3, *fp) != 3) {
+      id[0] = '\0';
+   }
+   id[3] = '\0';
+   if ((strcmp (id, FLX_ID) != 0) && (strcmp (id, FLX_SERIES_ID) != 0)) {
       fclose (*fp);
       return -2;
    }
@@ -1173,7 +1367,7 @@ void CreateFLX (char **flxArray, int *flxArrayLen)
    *flxArrayLen = HEADLEN + 2 + 2;
    *flxArray = (char *) malloc (*flxArrayLen);
    ptr = *flxArray;
-   memcpy (ptr, "FLX", 3);
+   memcpy (ptr, FLX_ID, 3);
    ptr += 3;
    fileLen = *flxArrayLen;
    MEMCPY_LIT (ptr, &fileLen, sizeof (sInt4));
@@ -1210,6 +1404,7 @@ void CreateFLX (char **flxArray, int *flxArrayLen)
  *
  * HISTORY
  *   8/2003 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Keep the identifier (FLX_ID or FLX_SERIES_ID) of the file.
  *
  * NOTES
  *****************************************************************************
@@ -1219,12 +1414,13 @@ int ReadFLX (const char *filename, char **flxArray, int *flxArrayLen)
    FILE *fp;            /* A open pointer to file to read from. */
    char *ptr;           /* A pointer to where we are in the array. */
    sInt4 fileLen;       /* How big the file claims to be. */
+   char id[4] = FLX_ID; /* The 3 letter identifier of the file. */
 
    myAssert (sizeof (sInt4) == 4);
    myAssert (sizeof (char) == 1);
 
    if (filename != NULL) {
-      if (OpenFLX (filename, &fp, 0) != 0) {
+      if (OpenFLX (filename, &fp, 0, id) != 0) {
          return -1;
       }
    } else {
@@ -1234,7 +1430,7 @@ int ReadFLX (const char *filename, char **flxArray, int *flxArrayLen)
    *flxArrayLen = fileLen;
    *flxArray = (char *) malloc (*flxArrayLen);
    ptr = *flxArray;
-   memcpy (ptr, "FLX", 3);
+   memcpy (ptr, id, 3);
    ptr += 3;
    MEMCPY_LIT (ptr, &fileLen, sizeof (sInt4));
    ptr += 4;
@@ -1335,6 +1531,7 @@ int WriteFLX (char *filename, char *flxArray, int flxArrayLen)
  *
  * HISTORY
  *   8/2003 Arthur Taylor (MDL/RSIS): Commented.
+ *  10/2026 AAT: Accept FLX_SERIES_ID.
  *
  * NOTES
  *****************************************************************************
@@ -1354,7 +1551,8 @@ int PrintFLXBuffer (char *flxArray, int flxArrayLen)
    myAssert (sizeof (uShort2) == 2);
 
    ptr = flxArray;
-   if (strncmp (ptr, "FLX", 3) != 0) {
+   if ((strncmp (ptr, FLX_ID, 3) != 0) &&
+       (strncmp (ptr, FLX_SERIES_ID, 3) != 0)) {
       return -1;
    }
    ptr += 3;
@@ -1750,6 +1948,7 @@ static int PrintFLX (char *filename)
 {
    FILE *fp;            /* The file pointer to read from. */
    int ans;             /* Keeps track of any errors during OpenFLX. */
+   char id[4];          /* The 3 letter identifier of the file. */
    sInt4 fileLen;       /* How big the file claims to be. */
    sInt4 offset;        /* Used to get to end of Header. */
    uShort2 numGDS;      /* number of GDS Sections. */
@@ -1764,7 +1963,7 @@ static int PrintFLX (char *filename)
    myAssert (sizeof (uShort2) == 2);
    myAssert (sizeof (char) == 1);
 
-   if ((ans = OpenFLX (filename, &fp, 0)) != 0) {
+   if ((ans = OpenFLX (filename, &fp, 0, id)) != 0) {
       if (ans == -1) {
          printf ("Couldn't open %s for reading / writing\n", filename);
       } else if (ans == -2) {
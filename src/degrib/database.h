@@ -21,6 +21,11 @@
 
 #define GDSLEN 129
 #define HEADLEN 20
+/* The first 3 bytes of an index file.  If any PDS has a time series
+ * trailer, the index uses FLX_SERIES_ID so older builds (which don't skip
+ * the trailers) refuse it. */
+#define FLX_ID "FLX"
+#define FLX_SERIES_ID "FL2"
 
 #ifdef FLXTYPE_STRUCTURE
 typedef struct {
@@ -67,6 +72,11 @@ int InsertPDS (char **flxArray, int *flxArrayLen, char *elem, time_t refTime,
 void ReadPDSBuff (char *pdsPtr, double *validTime, char *dataFile,
                   sInt4 *dataOffset, uChar *endian, uChar *scan,
                   uShort2 *numTable, char ***table, char **nextPds);
+int ReadPDSSeries (char *pdsPtr, char *seriesFile, sInt4 *seriesOffset,
+                   uShort2 *seriesLen);
+int SetPDSSeries (char **flxArray, int *flxArrayLen, sInt4 supOffset,
+                  sInt4 pdsOffset, const char *seriesFile,
+                  sInt4 seriesOffset, uShort2 seriesLen);
 void ReadSupPDSBuff (char *sPtr, char *elem, double *refTime, char *unit,
                      char *comment, uShort2 *gdsNum, uShort2 *center,
                      uShort2 *subCenter, uShort2 *numPDS, char **pdsPtr,
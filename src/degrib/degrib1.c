@@ -20,6 +20,7 @@
 #include "myerror.h"
 #include "myassert.h"
 #include "tendian.h"
+#include "bitstream.h"
 #include "scan.h"
 #include "degrib1.h"
 #include "metaname.h"
@@ -1267,11 +1268,9 @@ static int UnpackCmplx (uChar *bds, uInt4 gribLen, uInt4 *curLoc,
    uChar f_secBitmap = 0;
    uChar f_secValDiffWid;
    int i;
-   uInt4 uli_temp;      /* Used to store sInt4s (temporarily) */
-   uChar bufLoc;        /* Keeps track of where to start getting more data
-                         * out of the packed data stream. */
-   size_t numUsed;      /* How many bytes were used in a given call to
-                         * memBitRead. */
+   uInt4 *vals;         /* The unpacked secondary bitmap or first order
+                         * values. */
+   bitStreamType bs;    /* Used to read the packed values. */
    uChar *width;
 
    secLen = 11;
@@ -1302,20 +1301,16 @@ static int UnpackCmplx (uChar *bds, uInt4 gribLen, uInt4 *curLoc,
       secLen++;
    }
    if (f_secBitmap) {
-      bufLoc = 8;
+      vals = (uInt4 *) malloc (P2 * sizeof (uInt4));
+      memBitReadInit (&bs, bds, (P2 + 7) / 8, 8);
+      memBitReadN (&bs, vals, P2, 1);
       for (i = 0; i < P2; i++) {
-         memBitRead (&uli_temp, sizeof (sInt4), bds, 1, &bufLoc, &numUsed);
-         printf ("(%d %ld) ", i, uli_temp);
-         if (numUsed != 0) {
-            printf ("\n");
-            bds += numUsed;
-            secLen++;
-         }
-      }
-      if (bufLoc != 8) {
-         bds++;
-         secLen++;
+         printf ("(%d %ld) ", i, (long int) vals[i]);
       }
+      printf ("\n");
+      free (vals);
+      bds += (P2 + 7) / 8;
+      secLen += (P2 + 7) / 8;
       printf ("Observed Sec Len %ld\n", secLen);
    } else {
       /* Jump over widths and secondary bitmap */
@@ -1323,21 +1318,15 @@ static int UnpackCmplx (uChar *bds, uInt4 gribLen, uInt4 *curLoc,
       secLen += (N1 - 21);
    }
 
-   bufLoc = 8;
+   vals = (uInt4 *) malloc (P1 * sizeof (uInt4));
+   memBitReadInit (&bs, bds, (P1 * numBits + 7) / 8, 8);
+   memBitReadN (&bs, vals, P1, numBits);
    for (i = 0; i < P1; i++) {
-      memBitRead (&uli_temp, sizeof (sInt4), bds, numBits, &bufLoc, &numUsed);
-      printf ("(%d %ld) (numUsed %d numBits %d)", i, uli_temp, numUsed,
-              numBits);
-      if (numUsed != 0) {
-         printf ("\n");
-         bds += numUsed;
-         secLen++;
-      }
-   }
-   if (bufLoc != 8) {
-      bds++;
-      secLen++;
+      printf ("(%d %ld) (numBits %d)\n", i, (long int) vals[i], numBits);
    }
+   free (vals);
+   bds += (P1 * numBits + 7) / 8;
+   secLen += (P1 * numBits + 7) / 8;
 
    printf ("Observed Sec Len %ld\n", secLen);
    printf ("N2 = %d\n", N2);
@@ -1380,6 +1369,8 @@ static int UnpackCmplx (uChar *bds, uInt4 gribLen, uInt4 *curLoc,
  *   3/2004 AAT: Switched {# Pts * (# Bits in a Group) +
  *          # of unused bits != # of available bits} to a warning from an
  *          error.
+ *  10/2026 AAT: Unpack all the values at once (memBitReadN) instead of
+ *          calling memBitRead for each point.
  *
  * NOTES
  * 1) See metaparse.c : ParseGrid()
@@ -1401,14 +1392,16 @@ static int ReadGrib1Sect4 (uChar *bds, uInt4 gribLen, uInt4 *curLoc,
    uChar f_spherHarm;   /* Flag if data contains Spherical Harmonics. */
    uChar f_cmplxPack;   /* Flag if complex packing was used. */
    uChar f_octet14;     /* Flag if octet 14 was used. */
-   uChar bufLoc;        /* Keeps track of where to start getting more data
-                         * out of the packed data stream. */
    uChar f_convert;     /* Determine if scan mode implies that we have to do
                          * manipulation as we read the grid to get desired
                          * internal scan mode. */
    uInt4 i;             /* Used to traverse the grid. */
-   size_t numUsed;      /* How many bytes were used in a given call to
-                         * memBitRead. */
+   uInt4 *vals;         /* The unpacked values (before scaling). */
+   uInt4 numVals;       /* Number of packed values (length of vals). */
+   uInt4 curVal;        /* The next value in vals (if there is a bitmap). */
+   bitStreamType bs;    /* Used to read the packed values. */
+   double scale2;       /* pow (2, ESF). */
+   double scale10;      /* pow (10, DSF). */
    double d_temp;       /* Holds the extracted data until we put it in data */
    sInt4 newIndex;      /* Where to put the answer (primarily if f_convert) */
    sInt4 x;             /* Used to help compute newIndex , if f_convert. */
@@ -1528,11 +1521,35 @@ static int ReadGrib1Sect4 (uChar *bds, uInt4 gribLen, uInt4 *curLoc,
    meta->gridAttrib.refVal = refVal;
    meta->gridAttrib.ESF = ESF;
    meta->gridAttrib.DSF = DSF;
-   bufLoc = 8;
    /* Internally we use scan = 0100.  Scan is usually 0100 but if need be, we
     * can convert it. */
    f_convert = ((meta->gds.scan & 0xe0) != 0x40);
 
+   /* Unpack all the packed values in one pass. */
+   numVals = 0;
+   vals = NULL;
+   if (numBits != 0) {
+      if (f_bms) {
+         for (i = 0; i < meta->gds.numPts; i++) {
+            if (bitmap[i]) {
+               numVals++;
+            }
+         }
+      } else {
+         numVals = meta->gds.numPts;
+      }
+      vals = (uInt4 *) malloc (numVals * sizeof (uInt4));
+      memBitReadInit (&bs, bds, sectLen - 11, 8);
+      if (memBitReadN (&bs, vals, numVals, numBits) != 0) {
+         errSprintf ("Ran out of data in BDS (GRIB 1 Section 4)\n");
+         free (vals);
+         return -1;
+      }
+   }
+   scale2 = pow (2, ESF);
+   scale10 = pow (10, DSF);
+   curVal = 0;
+
    if (f_bms) {
 /*
 #ifdef DEBUG
@@ -1558,10 +1575,7 @@ static int ReadGrib1Sect4 (uChar *bds, uInt4 gribLen, uInt4 *curLoc,
             data[newIndex] = UNDEFINED;
          } else {
             if (numBits != 0) {
-               memBitRead (&uli_temp, sizeof (sInt4), bds, numBits,
-                           &bufLoc, &numUsed);
-               bds += numUsed;
-               d_temp = (refVal + (uli_temp * pow (2, ESF))) / pow (10, DSF);
+               d_temp = (refVal + (vals[curVal++] * scale2)) / scale10;
                /* Convert Units. */
                if (unitM == -10) {
                   d_temp = pow (10, d_temp);
@@ -1630,21 +1644,7 @@ static int ReadGrib1Sect4 (uChar *bds, uInt4 gribLen, uInt4 *curLoc,
                newIndex = i;
             }
 
-            memBitRead (&uli_temp, sizeof (sInt4), bds, numBits, &bufLoc,
-                        &numUsed);
-            bds += numUsed;
-            d_temp = (refVal + (uli_temp * pow (2, ESF))) / pow (10, DSF);
-
-#ifdef DEBUG
-/*
-            if (i == 1) {
-               printf ("refVal %f, uli_temp %ld, ans %f\n", refVal, uli_temp,
-                       d_temp);
-               printf ("numBits %d, bufLoc %d, numUsed %d\n", numBits,
-                       bufLoc, numUsed);
-            }
-*/
-#endif
+            d_temp = (refVal + (vals[i] * scale2)) / scale10;
 
             /* Convert Units. */
             if (unitM == -10) {
@@ -1663,6 +1663,7 @@ static int ReadGrib1Sect4 (uChar *bds, uInt4 gribLen, uInt4 *curLoc,
          }
       }
    }
+   free (vals);
    return 0;
 }
 
@@ -30,9 +30,197 @@
 #include "degrib-core.h"
 #include "mymapf.h"
 #include "clock.h"
+#include "myutil.h"
+#ifdef USE_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #define GRIB_UNSIGN_INT3(a,b,c) ((a<<16)+(b<<8)+c)
 
+#ifdef USE_MMAP
+/* The memory mapped view of a GRIB file (IS_dataType.map). dev, ino, size,
+ * and mtime identify the file, since the FILE * may be reused by fopen. */
+typedef struct {
+   uChar *ptr;          /* Start of the mapped file. */
+   size_t len;          /* Length of the mapped file. */
+   dev_t dev;           /* Device of the mapped file. */
+   ino_t ino;           /* Inode of the mapped file. */
+   time_t mtime;        /* Modification time of the mapped file. */
+} GribMapType;
+#endif
+
+/* Size of the first block ScanSECT0 reads, and the most it reads at once.
+ * Most WMO headers fit in the first block, so usually the block is still in
+ * the stdio buffer when we seek back to the end of section 0. */
+#define SECT0_BLOCK_MIN 256
+#define SECT0_BLOCK_MAX 65536
+
+/*****************************************************************************
+ * Sect0Chr() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Finds the next occurrence of c in buff[start..end), using memchr.
+ *
+ * ARGUMENTS
+ *  buff = The bytes to look through. (Input)
+ * start = Where to start looking. (Input)
+ *   end = Where to stop looking. (Input)
+ *     c = The character to look for. (Input)
+ *
+ * RETURNS: uInt4
+ *   The index of c, or end if c was not found.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static uInt4 Sect0Chr (const char *buff, uInt4 start, uInt4 end, int c)
+{
+   const char *ptr;     /* The found character. */
+
+   if (start >= end) {
+      return end;
+   }
+   if ((ptr = (const char *) memchr (buff + start, c, end - start)) == NULL) {
+      return end;
+   }
+   return (uInt4) (ptr - buff);
+}
+
+/*****************************************************************************
+ * ScanSECT0() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Looks for the next "GRIB" or "TDLP" keyword by reading the file in
+ * blocks and searching them with memchr, rather than a byte at a time.
+ * When found, it seeks fp back to just after the first 8 bytes of section
+ * 0, so the caller sees the same file position as the byte at a time
+ * search.
+ *
+ * ARGUMENTS
+ *       fp = A pointer to an opened file in which to read. (Input/Output)
+ *     buff = The bytes read.  The header (the data between messages) is
+ *            buff[0..curLen - 8), and buff[curLen - 8..curLen) is the start
+ *            of section 0. (Input/Output)
+ *  buffLen = The allocated length of buff. (Input/Output)
+ *    limit = How many bytes to read before giving up (-1 means no limit).
+ *            (Input)
+ *   curLen = Where section 0's first 8 bytes end in buff. (Output)
+ * tdlpMatch = 4 if we found "TDLP", 0 if we found "GRIB". (Output)
+ *
+ * FILES/DATABASES:
+ *   An already opened file
+ *
+ * RETURNS: int (could use errSprintf())
+ *  1 = fp is not seekable (a pipe), so caller should search a byte at a time.
+ *  0 = OK
+ * -1 = Couldn't find "GRIB" or "TDLP".
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) Finding "GRIB" requires the edition (byte 8) to be 1 or 2, so a 'G'
+ *    needs 8 bytes in memory before it can be checked.
+ * 2) The 'G' and 'T' candidates are found separately and the earlier one is
+ *    checked, so each byte is looked at once per letter.
+ *****************************************************************************
+ */
+static int ScanSECT0 (FILE *fp, char **buff, uInt4 *buffLen, sInt4 limit,
+                      uInt4 *curLen, uChar *tdlpMatch)
+{
+   long int start;      /* Where fp was when we were called. */
+   uInt4 numRead;       /* Number of bytes read into buff. */
+   uInt4 maxRead;       /* Most bytes we are allowed to read. */
+   uInt4 block;         /* How many bytes to read this time. */
+   uInt4 numGot;        /* How many bytes we actually read. */
+   uInt4 scan;          /* First position in buff not yet checked. */
+   uInt4 end;           /* Positions < end have 8 bytes in buff. */
+   uInt4 gPos;          /* Next 'G' in buff[scan..end), or end. */
+   uInt4 tPos;          /* Next 'T' in buff[scan..end), or end. */
+   char *ptr;           /* The current candidate. */
+
+   if ((start = ftell (fp)) < 0) {
+      return 1;
+   }
+   /* Always read the first 8 bytes, as the byte at a time search did. */
+   maxRead = 0;
+   if (limit >= 0) {
+      maxRead = (limit > 8) ? (uInt4) limit : 8;
+   }
+   numRead = 0;
+   scan = 0;
+   block = SECT0_BLOCK_MIN;
+   while (1) {
+      if ((maxRead != 0) && (numRead + block > maxRead)) {
+         block = maxRead - numRead;
+      }
+      if (block == 0) {
+         errSprintf ("ERROR: Couldn't find type in %ld bytes\n",
+                     (long int) limit);
+         return -1;
+      }
+      if (*buffLen < numRead + block) {
+         *buffLen = numRead + block;
+         *buff = (char *) realloc ((void *) *buff, *buffLen * sizeof (char));
+      }
+      numGot = fread ((*buff) + numRead, sizeof (char), block, fp);
+      numRead += numGot;
+      if (numRead < 8) {
+         errSprintf ("ERROR: Couldn't find 'GRIB' or 'TDLP'\n");
+         return -1;
+      }
+      end = numRead - 7;
+      gPos = Sect0Chr (*buff, scan, end, 'G');
+      tPos = Sect0Chr (*buff, scan, end, 'T');
+      while ((gPos < end) || (tPos < end)) {
+         if (gPos < tPos) {
+            ptr = (*buff) + gPos;
+            if ((ptr[1] == 'R') && (ptr[2] == 'I') && (ptr[3] == 'B') &&
+                ((ptr[7] == 1) || (ptr[7] == 2))) {
+               *tdlpMatch = 0;
+               *curLen = gPos + 8;
+               break;
+            }
+            gPos = Sect0Chr (*buff, gPos + 1, end, 'G');
+         } else {
+            ptr = (*buff) + tPos;
+            if ((ptr[1] == 'D') && (ptr[2] == 'L') && (ptr[3] == 'P')) {
+               *tdlpMatch = 4;
+               *curLen = tPos + 8;
+               break;
+            }
+            tPos = Sect0Chr (*buff, tPos + 1, end, 'T');
+         }
+      }
+      if ((gPos < end) || (tPos < end)) {
+         /* Give back the bytes after the first 8 bytes of section 0. */
+         if (fseek (fp, start + (long int) *curLen, SEEK_SET) != 0) {
+            errSprintf ("ERROR: Couldn't fseek in ScanSECT0\n");
+            return -1;
+         }
+         return 0;
+      }
+      if (numGot < block) {
+         errSprintf ("ERROR: Ran out of file reading SECT0\n");
+         return -1;
+      }
+      scan = end;
+      if (block < SECT0_BLOCK_MAX) {
+         block *= 2;
+      }
+   }
+}
+
 /*****************************************************************************
  * ReadSect0() -- Review 12/2002
  *
@@ -97,6 +285,8 @@
  *   5/2003 AAT: Added limit option.
  *   8/2003 AAT: Removed dependence on offset, and fileLen.
  *  10/2004 AAT: Modified to allow for TDLP files
+ *  10/2026 AAT: Search in blocks with memchr (ScanSECT0) when fp is
+ *          seekable, instead of reading a byte at a time.
  *
  * NOTES
  * 1a) 1196575042L == ASCII representation of "GRIB" (GRIB in MSB)
@@ -125,19 +315,27 @@ int ReadSECT0 (FILE *fp, char **buff, uInt4 *buffLen, sInt4 limit,
    uInt4 i;             /* Used to loop over the first few char's */
    uInt4 stillNeed;     /* Number of bytes still needed to get 1st 8 bytes of
                          * message into memory. */
+   int ans;             /* The return value of ScanSECT0. */
 
-   /* Get first 8 bytes.  If GRIB we don't care.  If TDLP, this is the length
-    * of record.  Read at least 1 record (length + 2 * 8) + 8 (next record
-    * length) + 8 bytes before giving up. */
-   curLen = 8;
-   if (*buffLen < curLen) {
-      *buffLen = curLen;
-      *buff = (char *) realloc ((void *) *buff, *buffLen * sizeof (char));
-   }
-   if (fread (*buff, sizeof (char), curLen, fp) != curLen) {
-      errSprintf ("ERROR: Couldn't find 'GRIB' or 'TDLP'\n");
+   /* Search for the keyword in blocks, unless fp is a pipe, in which case
+    * we can't give back what we read past section 0. */
+   if ((ans = ScanSECT0 (fp, buff, buffLen, limit, &curLen,
+                         &tdlpMatch)) < 0) {
       return -1;
    }
+   if (ans == 1) {
+      /* Get first 8 bytes.  If GRIB we don't care.  If TDLP, this is the
+       * length of record.  Read at least 1 record (length + 2 * 8) + 8
+       * (next record length) + 8 bytes before giving up. */
+      curLen = 8;
+      if (*buffLen < curLen) {
+         *buffLen = curLen;
+         *buff = (char *) realloc ((void *) *buff, *buffLen * sizeof (char));
+      }
+      if (fread (*buff, sizeof (char), curLen, fp) != curLen) {
+         errSprintf ("ERROR: Couldn't find 'GRIB' or 'TDLP'\n");
+         return -1;
+      }
 /*
    Can't do the following because we don't know if the file is a GRIB file or
    not, or if it was a FORTRAN file.
@@ -146,46 +344,49 @@ int ReadSECT0 (FILE *fp, char **buff, uInt4 *buffLen, sInt4 limit,
       limit = (limit > recLen + 32) ? limit : recLen + 32;
    }
 */
-   while ((tdlpMatch != 4) && (gribMatch != 4)) {
-      for (i = curLen - 8; i + 7 < curLen; i++) {
-         if ((*buff)[i] == 'G') {
-            if (((*buff)[i + 1] == 'R') && ((*buff)[i + 2] == 'I') &&
-                ((*buff)[i + 3] == 'B')) {
-               if (((*buff)[i + 7] == 1) ||
-                   ((*buff)[i + 7] == 2)) {
-                  gribMatch = 4;
+      while ((tdlpMatch != 4) && (gribMatch != 4)) {
+         for (i = curLen - 8; i + 7 < curLen; i++) {
+            if ((*buff)[i] == 'G') {
+               if (((*buff)[i + 1] == 'R') && ((*buff)[i + 2] == 'I') &&
+                   ((*buff)[i + 3] == 'B')) {
+                  if (((*buff)[i + 7] == 1) ||
+                      ((*buff)[i + 7] == 2)) {
+                     gribMatch = 4;
+                     break;
+                  }
+               }
+            } else if ((*buff)[i] == 'T') {
+               if (((*buff)[i + 1] == 'D') && ((*buff)[i + 2] == 'L') &&
+                   ((*buff)[i + 3] == 'P')) {
+                  tdlpMatch = 4;
                   break;
                }
             }
-         } else if ((*buff)[i] == 'T') {
-            if (((*buff)[i + 1] == 'D') && ((*buff)[i + 2] == 'L') &&
-                ((*buff)[i + 3] == 'P')) {
-               tdlpMatch = 4;
-               break;
-            }
-         }
-      }
-      stillNeed = i - (curLen - 8);
-      /* Read enough of message to have the first 8 bytes (including ID). */
-      if (stillNeed != 0) {
-         curLen += stillNeed;
-         if ((limit >= 0) && (curLen > (size_t) limit)) {
-            errSprintf ("ERROR: Couldn't find type in %ld bytes\n", limit);
-            *buffLen = curLen - stillNeed;
-            return -1;
          }
-         if (*buffLen < curLen) {
-            myAssert (200 > stillNeed);
-            *buffLen = *buffLen + 200;
-            /* *buffLen = curLen; */
-            *buff = (char *) realloc ((void *) *buff,
-                                      *buffLen * sizeof (char));
-         }
-         if (fread ((*buff) + (curLen - stillNeed), sizeof (char), stillNeed,
-                    fp) != stillNeed) {
-            errSprintf ("ERROR: Ran out of file reading SECT0\n");
-            *buffLen = curLen;
-            return -1;
+         stillNeed = i - (curLen - 8);
+         /* Read enough of message to have the first 8 bytes (including
+          * ID). */
+         if (stillNeed != 0) {
+            curLen += stillNeed;
+            if ((limit >= 0) && (curLen > (size_t) limit)) {
+               errSprintf ("ERROR: Couldn't find type in %ld bytes\n",
+                           limit);
+               *buffLen = curLen - stillNeed;
+               return -1;
+            }
+            if (*buffLen < curLen) {
+               myAssert (200 > stillNeed);
+               *buffLen = *buffLen + 200;
+               /* *buffLen = curLen; */
+               *buff = (char *) realloc ((void *) *buff,
+                                         *buffLen * sizeof (char));
+            }
+            if (fread ((*buff) + (curLen - stillNeed), sizeof (char),
+                       stillNeed, fp) != stillNeed) {
+               errSprintf ("ERROR: Ran out of file reading SECT0\n");
+               *buffLen = curLen;
+               return -1;
+            }
          }
       }
    }
@@ -291,6 +492,12 @@ int ReadSECT0 (FILE *fp, char **buff, uInt4 *buffLen, sInt4 limit,
  *   6/2003 Matthew T. Kallio (matt@wunderground.com):
  *          "wmo" dimension increased to WMO_HEADER_LEN + 1 (for '\0' char)
  *   8/2003 AAT: Removed dependence on offset and fileLen.
+ *  10/2026 AAT: Only use GRIB_LIMIT on the first message (as GRIB2Inventory
+ *          does), and treat a missing "GRIB" after that as trailing bytes
+ *          (the end of the file), so a long WMO header doesn't stop -msg.
+ *          Skip the TDLPack padding as GRIB2Inventory does, and check that
+ *          message msgNum isn't just trailing bytes, so both count messages
+ *          the same way.
  *
  * NOTES
  *****************************************************************************
@@ -305,34 +512,59 @@ int FindGRIBMsg (FILE *fp, int msgNum, sInt4 *offset, int *curMsg)
    int version;         /* Which version of GRIB is in this message. */
    int c;               /* Determine if end of the file without fileLen. */
    sInt4 jump;          /* How far to jump to get to past GRIB message. */
+   int grib_limit;      /* How many bytes to look for before the "GRIB". */
+   char *msg;           /* Used to pop messages off the error Stack. */
+   fpos_t msgPos;       /* Where the message we are looking for starts. */
 
    cnt = *curMsg + 1;
    buff = NULL;
    buffLen = 0;
+   grib_limit = GRIB_LIMIT;
    while ((c = fgetc (fp)) != EOF) {
       ungetc (c, fp);
       if (cnt >= msgNum) {
+         /* Make sure this isn't just trailing bytes. */
+         if ((grib_limit == -1) && (fgetpos (fp, &msgPos) == 0)) {
+            if (ReadSECT0 (fp, &buff, &buffLen, grib_limit, sect0, &gribLen,
+                           &version) < 0) {
+               msg = errSprintf (NULL);
+               free (msg);
+               break;
+            }
+            fsetpos (fp, &msgPos);
+         }
          /* 12/1/2004 version 1.63 forgot to free buff */
          free (buff);
          *curMsg = cnt;
          return 0;
       }
       /* Read section 0 to find gribLen and wmoLen. */
-      if (ReadSECT0 (fp, &buff, &buffLen, GRIB_LIMIT, sect0, &gribLen,
+      if (ReadSECT0 (fp, &buff, &buffLen, grib_limit, sect0, &gribLen,
                      &version) < 0) {
-         preErrSprintf ("Inside FindGRIBMsg\n");
-         free (buff);
-         return -1;
+         if (grib_limit == GRIB_LIMIT) {
+            preErrSprintf ("Inside FindGRIBMsg\n");
+            free (buff);
+            return -1;
+         }
+         /* Trailing bytes, so we are at the end of the file. */
+         msg = errSprintf (NULL);
+         free (msg);
+         break;
       }
+      grib_limit = -1;
       myAssert ((version == 1) || (version == 2) || (version == -1));
-      /* Continue on to the next grib message. */
-      if ((version == 1) || (version == -1)) {
+      /* Continue on to the next grib message.  TDLPack data is rounded up
+       * to an 8 byte boundary, followed by a 4 byte FORTRAN record size
+       * (see GRIB2Inventory). */
+      if (version == 1) {
          jump = gribLen - 8;
+      } else if (version == -1) {
+         jump = ((gribLen + 7) / 8) * 8 + 4 - 8;
       } else {
          jump = gribLen - 16;
       }
       fseek (fp, jump, SEEK_CUR);
-      *offset = *offset + gribLen + buffLen;
+      *offset = *offset + buffLen + jump + ((version == 2) ? 16 : 8);
       cnt++;
    }
    free (buff);
@@ -346,6 +578,109 @@ int FindGRIBMsg (FILE *fp, int msgNum, sInt4 *offset, int *curMsg)
 */
 }
 
+/*****************************************************************************
+ * FindGRIBOffsets() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Jumps through the rest of a GRIB file, making a list of where each of
+ * the messages start.  Used when converting messages in parallel (see
+ * -threads), since each thread needs to know where its messages are.
+ *
+ * ARGUMENTS
+ *      fp = The current GRIB file to look through. (Input)
+ *  offset = Where in the file each message starts (this is before the wmo
+ *           ASCII part if there is one.)  These are fgetpos() positions
+ *           (for fsetpos()) so they work past 2 GB. (Output)
+ *  numMsg = The number of messages found (length of offset). (Output)
+ *
+ * FILES/DATABASES:
+ *   An already opened "GRIB2" File
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ * -1 = Problems reading Section 0, or fp is not seekable.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created (based on FindGRIBMsg).
+ *  10/2026 AAT: Store fpos_t instead of sInt4 so large files work.
+ *  10/2026 AAT: Only use GRIB_LIMIT on the first message, stop at
+ *          trailing bytes, and skip TDLPack padding (as FindGRIBMsg does).
+ *
+ * NOTES
+ *   Caller should free offset (even if there is an error).  Leaves fp at
+ * the end of the last message.
+ *****************************************************************************
+ */
+int FindGRIBOffsets (FILE *fp, fpos_t **offset, int *numMsg)
+{
+   char *buff;          /* Holds the info between records. */
+   uInt4 buffLen;       /* Length of info between records. */
+   sInt4 sect0[SECT0LEN_WORD]; /* Holds the current Section 0. */
+   uInt4 gribLen;       /* Length of the current GRIB message. */
+   int version;         /* Which version of GRIB is in this message. */
+   int c;               /* Determine if end of the file without fileLen. */
+   uInt4 jump;          /* How far to jump to get to past GRIB message. */
+   long int step;       /* Part of jump that fits in an fseek. */
+   fpos_t curLoc;       /* Where the current message starts. */
+   int grib_limit;      /* How many bytes to look for before the "GRIB". */
+   char *msg;           /* Used to pop messages off the error Stack. */
+
+   *offset = NULL;
+   grib_limit = GRIB_LIMIT;
+   *numMsg = 0;
+   buff = NULL;
+   buffLen = 0;
+   while ((c = fgetc (fp)) != EOF) {
+      ungetc (c, fp);
+      if (fgetpos (fp, &curLoc) != 0) {
+         errSprintf ("ERROR: Couldn't fgetpos in FindGRIBOffsets\n");
+         free (buff);
+         return -1;
+      }
+      /* Read section 0 to find gribLen and wmoLen. */
+      if (ReadSECT0 (fp, &buff, &buffLen, grib_limit, sect0, &gribLen,
+                     &version) < 0) {
+         if (grib_limit == GRIB_LIMIT) {
+            preErrSprintf ("Inside FindGRIBOffsets\n");
+            free (buff);
+            return -1;
+         }
+         /* Trailing bytes, so we are at the end of the file. */
+         msg = errSprintf (NULL);
+         free (msg);
+         break;
+      }
+      grib_limit = -1;
+      myAssert ((version == 1) || (version == 2) || (version == -1));
+      *offset = (fpos_t *) realloc ((void *) *offset,
+                                    (*numMsg + 1) * sizeof (fpos_t));
+      (*offset)[*numMsg] = curLoc;
+      (*numMsg)++;
+      /* Continue on to the next grib message (see FindGRIBMsg). */
+      if (version == 1) {
+         jump = gribLen - 8;
+      } else if (version == -1) {
+         jump = ((gribLen + 7) / 8) * 8 + 4 - 8;
+      } else {
+         jump = gribLen - 16;
+      }
+      /* gribLen can be more than a long int (on 32 bit systems) holds. */
+      while (jump > 0) {
+         step = (jump > 0x7fffffffUL) ? 0x7fffffffL : (long int) jump;
+         if (fseek (fp, step, SEEK_CUR) != 0) {
+            errSprintf ("ERROR: Couldn't fseek in FindGRIBOffsets\n");
+            free (buff);
+            return -1;
+         }
+         jump -= (uInt4) step;
+      }
+   }
+   free (buff);
+   return 0;
+}
+
 /*****************************************************************************
  * FindSectLen2to7() --
  *
@@ -600,6 +935,132 @@ static int FindSectLen (unsigned char *c_ipack, sInt4 gribLen, sInt4 ns[8],
    return 0;
 }
 
+/*****************************************************************************
+ * GribMapFree() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Releases the memory mapped view (if any) of the GRIB file that IS has
+ * been reading from.
+ *
+ * ARGUMENTS
+ * IS = The structure containing the memory map to release. (Input/Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void GribMapFree (IS_dataType *IS)
+{
+#ifdef USE_MMAP
+   GribMapType *map = (GribMapType *) IS->map; /* The current map. */
+
+   if (map != NULL) {
+      munmap ((void *) map->ptr, map->len);
+      free (map);
+   }
+#endif
+   IS->map = NULL;
+   IS->mapMsg = NULL;
+}
+
+/*****************************************************************************
+ * GribMapMsg() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Finds the current GRIB message in a memory mapped view of fp, so that
+ * the unpacker can work directly on the bytes of the file instead of a copy
+ * of them in IS->ipack.  The file is mapped once, and the map is reused for
+ * subsequent messages in the same file.  If the file can't be mapped (pipe,
+ * special file, USE_MMAP not defined, etc) returns 1 so that the caller can
+ * fread the message instead.
+ *
+ * ARGUMENTS
+ *      fp = An opened GRIB2 file pointing to the end of section 0. When done
+ *           it points past the end of the message. (Input/Output)
+ *      IS = Holds the current memory map. (Input/Output)
+ * gribLen = Length of this GRIB message. (Input)
+ * c_ipack = The start of the message in the memory map. (Output)
+ *
+ * FILES/DATABASES:
+ *   An already opened "GRIB2" File
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ *  1 = Couldn't memory map the file (use fread instead).
+ * -1 = Ran out of file.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) The FILE * could be reused by a later fopen, so the map is identified
+ *    by the device, inode, size, and modification time of the file.
+ *****************************************************************************
+ */
+static int GribMapMsg (FILE *fp, IS_dataType *IS, uInt4 gribLen,
+                       unsigned char **c_ipack)
+{
+#ifdef USE_MMAP
+   struct stat stbuf;   /* Used to identify the file and find its size. */
+   GribMapType *map;    /* The current map. */
+   void *ptr;           /* The return value from mmap. */
+   long int curLoc;     /* Where we are in the file (end of section 0). */
+
+   if (!IS->f_mmap) {
+      return 1;
+   }
+   if ((fstat (fileno (fp), &stbuf) != 0) || (!S_ISREG (stbuf.st_mode)) ||
+       (stbuf.st_size <= 0)) {
+      return 1;
+   }
+   map = (GribMapType *) IS->map;
+   if ((map == NULL) || (map->dev != stbuf.st_dev) ||
+       (map->ino != stbuf.st_ino) || (map->len != (size_t) stbuf.st_size) ||
+       (map->mtime != stbuf.st_mtime)) {
+      GribMapFree (IS);
+      ptr = mmap (NULL, (size_t) stbuf.st_size, PROT_READ, MAP_PRIVATE,
+                  fileno (fp), 0);
+      if (ptr == MAP_FAILED) {
+         return 1;
+      }
+#ifdef MADV_SEQUENTIAL
+      madvise (ptr, (size_t) stbuf.st_size, MADV_SEQUENTIAL);
+#endif
+      map = (GribMapType *) malloc (sizeof (GribMapType));
+      map->ptr = (uChar *) ptr;
+      map->len = (size_t) stbuf.st_size;
+      map->dev = stbuf.st_dev;
+      map->ino = stbuf.st_ino;
+      map->mtime = stbuf.st_mtime;
+      IS->map = map;
+   }
+
+   /* ReadSECT0 left fp at the end of section 0. */
+   curLoc = ftell (fp) - SECT0LEN_WORD * 4;
+   if ((curLoc < 0) || ((size_t) curLoc + gribLen > map->len)) {
+      errSprintf ("GribLen = %ld, SECT0Len_WORD = %d\n", gribLen,
+                  SECT0LEN_WORD);
+      errSprintf ("Ran out of file\n");
+      return -1;
+   }
+   *c_ipack = map->ptr + curLoc;
+   fseek (fp, gribLen - SECT0LEN_WORD * 4, SEEK_CUR);
+   return 0;
+#else
+   return 1;
+#endif
+}
+
 /*****************************************************************************
  * IS_Init() -- Review 12/2002
  *
@@ -661,6 +1122,70 @@ void IS_Init (IS_dataType *is)
    /* Allocate storage for ipack. */
    is->ipackLen = 0;
    is->ipack = NULL;
+   /* Memory map the GRIB file if possible. */
+#ifdef USE_MMAP
+   is->f_mmap = 1;
+#else
+   is->f_mmap = 0;
+#endif
+   is->map = NULL;
+   is->mapMsg = NULL;
+   is->numSaved = 0;
+}
+
+/*****************************************************************************
+ * IS_Recycle() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Gets the IS data structure ready to read another file, without freeing
+ * the arrays that the unpack library uses.  Since ReadGrib2Msg only ever
+ * grows those arrays, they stay at the largest size needed so far, so a long
+ * run (such as genProbe over many files) doesn't free and re-allocate them
+ * for every file.
+ *
+ * ARGUMENTS
+ * is = The data structure to recycle. (Input/Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) Each array that is kept counts as one allocation saved (the IS_Init
+ *    that IS_Free + IS_Init would have done), and is added to is->numSaved.
+ *****************************************************************************
+ */
+void IS_Recycle (IS_dataType *is)
+{
+   int i;               /* A simple loop counter. */
+
+   for (i = 0; i < 8; i++) {
+      if (is->is[i] != NULL) {
+         is->numSaved++;
+      }
+   }
+   if (is->iain != NULL) {
+      is->numSaved++;
+   }
+   if (is->ib != NULL) {
+      is->numSaved++;
+   }
+   if (is->idat != NULL) {
+      is->numSaved++;
+   }
+   if (is->rdat != NULL) {
+      is->numSaved++;
+   }
+   if (is->ipack != NULL) {
+      is->numSaved++;
+   }
+   /* The memory map belongs to the old file. */
+   GribMapFree (is);
 }
 
 /*****************************************************************************
@@ -714,215 +1239,75 @@ void IS_Free (IS_dataType *is)
    free (is->ipack);
    is->ipack = NULL;
    is->ipackLen = 0;
+   /* Release the memory mapped file. */
+   GribMapFree (is);
 }
 
 /*****************************************************************************
- * ReadGrib2Record() -- Review 12/2002
+ * ReadGrib2Msg() --
  *
  * Arthur Taylor / MDL
  *
  * PURPOSE
- *   Reads a GRIB2 message from a file which is already opened and is pointing
- * at the correct message.  It reads in the message storing the results in
- * Grib_Data which is of size grib_DataLen.  If needed, it increases
- * grib_DataLen enough to fit the current message's grid.  It converts (if
- * appropriate) the data in Grib_Data to the units specified in f_unit.
+ *   Gets the rest of the current GRIB2 message (after ReadSECT0 found section
+ * 0) into memory, and makes sure the IS arrays are large enough for the call
+ * to the unpacker library.  If possible the message is left in a memory
+ * mapped view of the file (IS->mapMsg), otherwise it is read into IS->ipack.
  *
- *   In addition it updates offset, and stores the meta data returned by the
- * unpacker library in both IS, and (after parsing it) in meta.
+ * ARGUMENTS
+ *      fp = An opened GRIB2 file pointing to the end of section 0. (Input)
+ *      IS = The structure containing all the arrays that the unpacker uses
+ *           (Input/Output)
+ *   sect0 = The section 0 that ReadSECT0 read. (Input)
+ * gribLen = Length of this GRIB message. (Input)
+ * c_ipack = The message to pass to the unpacker. (Output)
  *
- *   Note: It expects meta and IS to already be initialized through calls to
- * MetaInit(&meta) and IS_Init(&is) respectively.
- *
- * ARGUMENTS
- *           fp = An opened GRIB2 file already at the correct message. (Input)
- *      fileLen = Length of the opened file. (Input)
- *       f_unit = 0 use GRIB2 units, 1 use English, 2 use metric. (Input)
- *    Grib_Data = The read in GRIB2 grid. (Output)
- * grib_DataLen = Size of Grib_Data. (Output)
- *         meta = A filled in meta structure (Output)
- *           IS = The structure containing all the arrays that the
- *                unpacker uses (Output)
- *      subgNum = Which subgrid in the GRIB2 message is of interest.
- *                (0 = first grid), if it can't find message subgNum,
- *                returns -5, and an error message (Input)
- *     majEarth = Used to override the GRIB major axis of earth. (Input)
- *     minEarth = Used to override the GRIB minor axis of earth. (Input)
- *      simpVer = The version of the simple weather code to use when parsing
- *                the WxString. (Input)
- *     f_endMsg = 1 means we finished reading the previous GRIB message, or
- *                there was no previous GRIB message.  0 means that we need
- *                to read a subgrid of the previous message. (Input/Output)
- *   lwlt, uprt = If the lat is not -100, then lwlt, and uprt define a
- *                subgrid that the user is interested in.  Get the map
- *                projection out of the GRIB2 message, and do everything
- *                on the subgrid. (if lwlt, and uprt are not "correct", the
- *                lat/lons may get swapped) (Input/Output)
- *
- * FILES/DATABASES:
- *   An already opened "GRIB2" File
+ * FILES/DATABASES:
+ *   An already opened "GRIB2" File
  *
  * RETURNS: int (could use errSprintf())
  *  0 = OK
- * -1 = Problems in section 0
+ * -1 = Ran out of file.
  * -2 = Problems figuring out the Section Lengths.
- * -3 = Error returned by unpack library.
- * -4 = Problems parsing the Meta Data.
  *
  * HISTORY
- *   9/2002 Arthur Taylor (MDL/RSIS): Created.
- *  11/2002 AAT: Updated.
- *  12/2002 (TK,AC,TB,&MS): Code Review.
- *   1/2003 AAT: It wasn't error coded 208, but rather 202 to look for.
- *   3/2003 AAT: Modified handling of section 2 stuff (no loop)
- *   3/2003 AAT: Added ability to handle multiple grids in same message.
- *   4/2003 AAT: Added ability to call GRIB1 decoder for GRIB1 messages.
- *   5/2003 AAT: Update the offset for ReadGrib1.
- *   6/2003 Matthew T. Kallio (matt@wunderground.com):
- *          "wmo" dimension increased to WMO_HEADER_LEN + 1 (for '\0' char)
- *   7/2003 AAT: switched to checking against element name for Wx instead
- *          of pds2.sect2.ptrType == GS2_WXTYPE
- *   7/2003 AAT: Allowed user to override the radius of earth.
- *   8/2003 AAT: Removed dependence on fileLen and offset.
- *   2/2004 AAT: Added "f_endMsg" logic.
- *   2/2004 AAT: Added subgrid potential.
- *   2/2004 AAT: Added maj/min Earth override.
+ *   9/2002 Arthur Taylor (MDL/RSIS): Created (as part of ReadGrib2Record).
+ *  10/2026 AAT: Moved out of ReadGrib2Record, and added memory map option.
  *
  * NOTES
- * 1) Reason ns[7] is not MAX (IS.ns[], local_ns[]) is because local_ns[7]
- *    is size of the packed message, but ns[7] refers to the returned meta
- *    data which unpacker library found in section 7, which is a lot smaller.
- * 2) Problem: MDL's sect2 is packed and we have no idea how large it is
- *    when unpacked.  So we allocate room for 4000 sInt4s and 500 floats.
- *    We then check 'jer' for error "202", if we find it we double the size
- *    and call the unpacker again.
- *    3/26/2003: Changed this to be: try once with size
- *       = max (32 * packed size, 4000)
- *    Should be fewer calls (more memory intensive) same result, since we had
- *    been doubling it 5 times.
- * 3) For Complex second order packing (GS5_CMPLXSEC) the unpacker needs nd5
- *    (which is size of message) to be >= nd2x3 (size of grid).
- * 3a) Appears to also need this if simple packing, and has a bitmap.
- * 4) inew = 1:  Currently we only expect 1 grid in 1 GRIB message, although
- *    the library does allow for multiple grids in a GRIB message.
- * 5) iclean = 1:  This only maters if there is bitmap data, otherwise it is
- *    ignored.  For bitmap data, if == 0, it embeds the given values for
- *    xmissp, and xmisss.  We don't embed because we don't know what to set
- *    xmissp or xmisss to.  Instead after we know the range, we choose a value
- *    and walk through the bitmap setting grib_Data appropriately.
- * 5a) iclean = 0;  This is because we do want the missing values embeded.
- *    that is we want the missing values to be place holders.
- * 6) f_endMsg is true if in the past we either completed reading a message,
- *    or we haven't read any messages.  In either case we need to read the
- *    next message from file. If f_endMsg is false, then there is more to read
- *    from IS->ipack, so we don't want to throw it out, nor have to re-read
- *    ipack from disk.
- *
- * Question: Should we double ns[2] when we double nrdat, and nidat?
+ * See notes 1, 2, and 3 in ReadGrib2Record.
  *****************************************************************************
  */
 #define SECT2_INIT_SIZE 4000
-#define UNPK_NUM_ERRORS 22
-int ReadGrib2Record (FILE *fp, sChar f_unit, double **Grib_Data,
-                     uInt4 *grib_DataLen, grib_MetaData *meta,
-                     IS_dataType *IS, int subgNum, double majEarth,
-                     double minEarth, int simpVer, int simpWWA,
-                     sInt4 *f_endMsg, LatLon *lwlf, LatLon *uprt)
+static int ReadGrib2Msg (FILE *fp, IS_dataType *IS,
+                         sInt4 sect0[SECT0LEN_WORD], uInt4 gribLen,
+                         unsigned char **C_ipack)
 {
-   sInt4 l3264b;        /* Number of bits in a sInt4.  Needed by FORTRAN
-                         * unpack library to determine if system has a 4
-                         * byte_ sInt4 or an 8 byte sInt4. */
-   char *buff;          /* Holds the info between records. */
-   uInt4 buffLen;       /* Length of info between records. */
-   sInt4 sect0[SECT0LEN_WORD]; /* Holds the current Section 0. */
-   uInt4 gribLen;       /* Length of the current GRIB message. */
    sInt4 nd5;           /* Size of grib message rounded up to the nearest
                          * sInt4. */
-   unsigned char *c_ipack; /* A char ptr to the message stored in IS->ipack */
+   unsigned char *c_ipack; /* A char ptr to the message. */
    sInt4 local_ns[8];   /* Local copy of section lengths. */
    sInt4 nd2x3;         /* Total number of grid points. */
    short int table50;   /* Type of packing used. (See code table 5.0)
                          * (GS5_SIMPLE==0, GS5_CMPLX==2, GS5_CMPLXSEC==3) */
    sInt4 nidat;         /* Size of section 2 if it contains integer data. */
    sInt4 nrdat;         /* Size of section 2 if it contains float data. */
-   sInt4 inew;          /* 1 if this is the first grid we are reading. 0 if
-                         * this is the second or later grid from the same
-                         * GRIB message. */
-   sInt4 iclean = 0;    /* 0 embed the missing values, 1 don't. */
-   int j;               /* Counter used to find the desired subgrid. */
-   sInt4 kfildo = 5;    /* FORTRAN Unit number for diagnostic info. Ignored,
-                         * unless library is compiled a particular way. */
-   sInt4 ibitmap;       /* 0 means no bitmap returned, otherwise 1. */
-   float xmissp;        /* The primary missing value.  If iclean = 0, this
-                         * value is embeded in grid, otherwise it is the
-                         * value returned from the GRIB message. */
-   float xmisss;        /* The secondary missing value.  If iclean = 0, this
-                         * value is embeded in grid, otherwise it is the
-                         * value returned from the GRIB message. */
-   sInt4 jer[UNPK_NUM_ERRORS * 2]; /* Any Error codes along with their *
-                                    * severity levels generated using the *
-                                    * unpack GRIB2 library. */
-   sInt4 ndjer = UNPK_NUM_ERRORS; /* The number of rows in JER( ). */
-   sInt4 kjer;          /* The actual number of errors returned in JER. */
-   size_t i;            /* counter as we loop through jer. */
-   double unitM, unitB; /* values in y = m x + b used for unit conversion. */
-   char unitName[15];   /* Holds the string name of the current unit. */
-   int unitLen;         /* String length of string name of current unit. */
-   int version;         /* Which version of GRIB is in this message. */
-   sInt4 cnt;           /* Used to help compact the weather table. */
-   gdsType newGds;      /* The GDS of the subgrid if needed. */
-   int x1, y1;          /* The original grid coordinates of the lower left
-                         * corner of the subgrid. */
-   int x2, y2;          /* The original grid coordinates of the upper right
-                         * corner of the subgrid. */
-   uChar f_subGrid;     /* True if we have a subgrid. */
-   sInt4 Nx, Ny;        /* original size of the data. */
-
-   /*
-    * f_endMsg is 1 if in the past we either completed reading a message,
-    * or we haven't read any messages.  In either case we need to read the
-    * next message from file.
-    * If f_endMsg is false, then there is more to read from IS->ipack, so we
-    * don't want to throw it out, nor have to re-read ipack from disk.
-    */
-   l3264b = sizeof (sInt4) * 8;
-   buff = NULL;
-   buffLen = 0;
-   if (*f_endMsg == 1) {
-      if (ReadSECT0 (fp, &buff, &buffLen, -1, sect0, &gribLen, &version) < 0) {
-         preErrSprintf ("Inside ReadGrib2Record\n");
-         free (buff);
-         return -1;
-      }
-      meta->GribVersion = version;
-      if (version == 1) {
-         if (ReadGrib1Record (fp, f_unit, Grib_Data, grib_DataLen, meta, IS,
-                              sect0, gribLen, majEarth, minEarth) != 0) {
-            preErrSprintf ("Problems with ReadGrib1Record called by "
-                           "ReadGrib2Record\n");
-            free (buff);
-            return -1;
-         }
-         *f_endMsg = 1;
-         free (buff);
-         return 0;
-      } else if (version == -1) {
-         if (ReadTDLPRecord (fp, Grib_Data, grib_DataLen, meta, IS,
-                             sect0, gribLen, majEarth, minEarth) != 0) {
-            preErrSprintf ("Problems with ReadGrib1Record called by "
-                           "ReadGrib2Record\n");
-            free (buff);
-            return -1;
-         }
-         free (buff);
-         return 0;
-      }
+   int ans;             /* The return value from GribMapMsg. */
+   size_t i;            /* counter as we loop through the sections. */
 
+   /* nd5 needs to be gribLen in (sInt4) units rounded up. */
+   nd5 = (gribLen + 3) / 4;
+   IS->mapMsg = NULL;
+   if ((ans = GribMapMsg (fp, IS, gribLen, &c_ipack)) < 0) {
+      return -1;
+   }
+   if (ans == 0) {
+      /* The unpacker works directly on the memory mapped file. */
+      IS->mapMsg = c_ipack;
+   } else {
       /*
        * Make room for entire message, and read it in.
        */
-      /* nd5 needs to be gribLen in (sInt4) units rounded up. */
-      nd5 = (gribLen + 3) / 4;
       if (nd5 > IS->ipackLen) {
          IS->ipackLen = nd5;
          IS->ipack = (sInt4 *) realloc ((void *) (IS->ipack),
@@ -940,123 +1325,215 @@ int ReadGrib2Record (FILE *fp, sChar f_unit, double **Grib_Data,
          errSprintf ("GribLen = %ld, SECT0Len_WORD = %d\n", gribLen,
                      SECT0LEN_WORD);
          errSprintf ("Ran out of file\n");
-         free (buff);
          return -1;
       }
+   }
 
-      /*
-       * Make sure the arrays are large enough for call to unpacker library.
-       */
-      /* FindSectLen Does not want (ipack / c_ipack) word swapped, because
-       * that would make it much more confusing to find bytes in c_ipack. */
-      if (FindSectLen (c_ipack, gribLen, local_ns, &nd2x3, &table50) < 0) {
-         preErrSprintf ("Inside ReadGrib2Record.. Calling FindSectLen\n");
-         free (buff);
-         return -2;
+   /*
+    * Make sure the arrays are large enough for call to unpacker library.
+    */
+   /* FindSectLen Does not want (ipack / c_ipack) word swapped, because
+    * that would make it much more confusing to find bytes in c_ipack. */
+   if (FindSectLen (c_ipack, gribLen, local_ns, &nd2x3, &table50) < 0) {
+      preErrSprintf ("Inside ReadGrib2Record.. Calling FindSectLen\n");
+      return -2;
+   }
+
+   /* Make sure all 'is' arrays except ns[7] are MAX (IS.ns[] ,
+    * local_ns[]). See note 1 for reason to exclude ns[7] from MAX (). */
+   for (i = 0; i < 7; i++) {
+      if (local_ns[i] > IS->ns[i]) {
+         IS->ns[i] = local_ns[i];
+         IS->is[i] = (sInt4 *) realloc ((void *) (IS->is[i]),
+                                        IS->ns[i] * sizeof (sInt4));
       }
+   }
 
-      /* Make sure all 'is' arrays except ns[7] are MAX (IS.ns[] ,
-       * local_ns[]). See note 1 for reason to exclude ns[7] from MAX (). */
-      for (i = 0; i < 7; i++) {
-         if (local_ns[i] > IS->ns[i]) {
-            IS->ns[i] = local_ns[i];
-            IS->is[i] = (sInt4 *) realloc ((void *) (IS->is[i]),
-                                           IS->ns[i] * sizeof (sInt4));
+   /* Allocate room for sect 2. If local_ns[2] = -1 there is no sect 2. */
+   if (local_ns[2] == -1) {
+      nidat = 10;
+      nrdat = 10;
+   } else {
+      /*
+       * See note 2) We have a section 2, so use:
+       *     MAX (32 * local_ns[2],SECT2_INTSIZE)
+       * and MAX (32 * local_ns[2],SECT2_FLOATSIZE)
+       * for size of section 2 unpacked.
+       */
+      nidat = (32 * local_ns[2] < SECT2_INIT_SIZE) ? SECT2_INIT_SIZE :
+            32 * local_ns[2];
+      nrdat = nidat;
+   }
+   if (nidat > IS->nidat) {
+      IS->nidat = nidat;
+      IS->idat = (sInt4 *) realloc ((void *) IS->idat,
+                                    IS->nidat * sizeof (sInt4));
+   }
+   if (nrdat > IS->nrdat) {
+      IS->nrdat = nrdat;
+      IS->rdat = (float *) realloc ((void *) IS->rdat,
+                                    IS->nrdat * sizeof (float));
+   }
+   /* Make sure we have room for the GRID part of the output. */
+   if (nd2x3 > IS->nd2x3) {
+      IS->nd2x3 = nd2x3;
+      IS->iain = (sInt4 *) realloc ((void *) IS->iain,
+                                    IS->nd2x3 * sizeof (sInt4));
+      IS->ib = (sInt4 *) realloc ((void *) IS->ib,
+                                  IS->nd2x3 * sizeof (sInt4));
+   }
+   /* See note 3) If table50 == 3, unpacker library needs nd5 >= nd2x3.
+    * The NCEP unpacker (unpk_g2ncep) only uses nd5 to bound its search for
+    * the section lengths, so we don't pad the memory mapped message. */
+   if ((IS->mapMsg == NULL) && ((table50 == 3) || (table50 == 0))) {
+      if (nd5 < nd2x3) {
+         nd5 = nd2x3;
+         if (nd5 > IS->ipackLen) {
+            IS->ipackLen = nd5;
+            IS->ipack = (sInt4 *) realloc ((void *) (IS->ipack),
+                                           IS->ipackLen * sizeof (sInt4));
          }
+         /* Don't need to do the following, but we do in case code
+          * changes. */
+         c_ipack = (unsigned char *) IS->ipack;
       }
+   }
+   IS->nd5 = nd5;
+   *C_ipack = c_ipack;
+   return 0;
+}
 
-      /* Allocate room for sect 2. If local_ns[2] = -1 there is no sect 2. */
-      if (local_ns[2] == -1) {
-         nidat = 10;
-         nrdat = 10;
-      } else {
-         /*
-          * See note 2) We have a section 2, so use:
-          *     MAX (32 * local_ns[2],SECT2_INTSIZE)
-          * and MAX (32 * local_ns[2],SECT2_FLOATSIZE)
-          * for size of section 2 unpacked.
-          */
-         nidat = (32 * local_ns[2] < SECT2_INIT_SIZE) ? SECT2_INIT_SIZE :
-               32 * local_ns[2];
-         nrdat = nidat;
-      }
-      if (nidat > IS->nidat) {
-         IS->nidat = nidat;
-         IS->idat = (sInt4 *) realloc ((void *) IS->idat,
-                                       IS->nidat * sizeof (sInt4));
-      }
-      if (nrdat > IS->nrdat) {
-         IS->nrdat = nrdat;
-         IS->rdat = (float *) realloc ((void *) IS->rdat,
-                                       IS->nrdat * sizeof (float));
-      }
-      /* Make sure we have room for the GRID part of the output. */
-      if (nd2x3 > IS->nd2x3) {
-         IS->nd2x3 = nd2x3;
-         IS->iain = (sInt4 *) realloc ((void *) IS->iain,
-                                       IS->nd2x3 * sizeof (sInt4));
-         IS->ib = (sInt4 *) realloc ((void *) IS->ib,
-                                     IS->nd2x3 * sizeof (sInt4));
-      }
-      /* See note 3) If table50 == 3, unpacker library needs nd5 >= nd2x3. */
-      if ((table50 == 3) || (table50 == 0)) {
-         if (nd5 < nd2x3) {
-            nd5 = nd2x3;
-            if (nd5 > IS->ipackLen) {
-               IS->ipackLen = nd5;
-               IS->ipack = (sInt4 *) realloc ((void *) (IS->ipack),
-                                              IS->ipackLen * sizeof (sInt4));
-            }
-            /* Don't need to do the following, but we do in case code
-             * changes. */
-            c_ipack = (unsigned char *) IS->ipack;
+/*****************************************************************************
+ * CompactTxtTable() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   After ParseGrid has marked which entries of the Wx (or WWA) table the
+ * grid uses (f_valid = 2, or 3 for used but invalid), compact the table to
+ * only those which are actually used, by setting validIndex.
+ *
+ * ARGUMENTS
+ * meta = The meta data with the Wx or WWA table. (Input/Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Moved out of ReadGrib2Record.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void CompactTxtTable (grib_MetaData *meta)
+{
+   sInt4 cnt;           /* Used to help compact the weather table. */
+   size_t i;            /* Loop counter over the table. */
+
+   cnt = 0;
+   if (strcmp (meta->element, "Wx") == 0) {
+      for (i = 0; i < meta->pds2.sect2.wx.dataLen; i++) {
+         if (meta->pds2.sect2.wx.f_valid[i] == 2) {
+            meta->pds2.sect2.wx.ugly[i].validIndex = cnt;
+            cnt++;
+         } else if (meta->pds2.sect2.wx.f_valid[i] == 3) {
+            meta->pds2.sect2.wx.f_valid[i] = 0;
+            meta->pds2.sect2.wx.ugly[i].validIndex = cnt;
+            cnt++;
+         } else {
+            meta->pds2.sect2.wx.ugly[i].validIndex = -1;
          }
       }
-      IS->nd5 = nd5;
-      /* Unpacker library requires ipack to be MSB. */
-/*
-#ifdef DEBUG
-      if (1==1) {
-         FILE *fp = fopen ("test.bin", "wb");
-         fwrite (IS->ipack, sizeof (sInt4), IS->nd5, fp);
-         fclose (fp);
+   } else if (strcmp (meta->element, "WWA") == 0) {
+      for (i = 0; i < meta->pds2.sect2.hazard.dataLen; i++) {
+         if (meta->pds2.sect2.hazard.f_valid[i] == 2) {
+            meta->pds2.sect2.hazard.haz[i].validIndex = cnt;
+            cnt++;
+         } else if (meta->pds2.sect2.hazard.f_valid[i] == 3) {
+            meta->pds2.sect2.hazard.f_valid[i] = 0;
+            meta->pds2.sect2.hazard.haz[i].validIndex = cnt;
+            cnt++;
+         } else {
+            meta->pds2.sect2.hazard.haz[i].validIndex = -1;
+         }
       }
-#endif
-*/
-/*
-#ifdef LITTLE_ENDIAN
-      memswp (IS->ipack , sizeof (sInt4), IS->nd5);
-#endif
-*/
-   } else {
-      c_ipack = (unsigned char *) IS->ipack;
-      /* GRIB2 files are in big endian so c_ipack is as well. */
-#ifdef LITTLE_ENDIAN
-      revmemcpy (&gribLen, &(c_ipack[12]), sizeof (sInt4));
-#else
-      memcpy (&gribLen, &(c_ipack[12]), sizeof (sInt4));
-#endif
    }
-   free (buff);
+}
 
-   /* Loop through the grib message looking for the subgNum grid.  subgNum
-    * goes from 0 to n-1. */
-   for (j = 0; j <= subgNum; j++) {
-      if (j == 0) {
-         inew = 1;
-      } else {
-         inew = 0;
-      }
+#define UNPK_NUM_ERRORS 22
 
-      /* Note we are getting data back either as a float or an int, but not
-       * both, so we don't need to allocated room for both. */
-      unpk_g2ncep (&kfildo, (float *) (IS->iain), IS->iain, &(IS->nd2x3),
-                  IS->idat, &(IS->nidat), IS->rdat, &(IS->nrdat), IS->is[0],
-                  &(IS->ns[0]), IS->is[1], &(IS->ns[1]), IS->is[2],
-                  &(IS->ns[2]), IS->is[3], &(IS->ns[3]), IS->is[4],
-                  &(IS->ns[4]), IS->is[5], &(IS->ns[5]), IS->is[6],
-                  &(IS->ns[6]), IS->is[7], &(IS->ns[7]), IS->ib, &ibitmap,
-                  c_ipack, &(IS->nd5), &xmissp, &xmisss, &inew, &iclean,
+/*****************************************************************************
+ * UnpackGrib2Grid() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Calls the unpacker library on each grid of the GRIB2 message in c_ipack
+ * up to the subgNum grid, leaving the subgNum grid in IS->iain (with its
+ * bitmap in IS->ib) and its meta data in IS->is[].
+ *
+ * ARGUMENTS
+ *       IS = Un-parsed meta data and the arrays for the unpacker. (Output)
+ *  c_ipack = The GRIB2 message. (Input)
+ *  subgNum = Which sub grid to get. (0 to n-1) (Input)
+ *  ibitmap = 0 means no bitmap returned, otherwise 1. (Output)
+ *   xmissp = The primary missing value. (Output)
+ *   xmisss = The secondary missing value. (Output)
+ * f_endMsg = 1 if there are no more grids in this message. (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ * -3 = Problems in the unpacker library.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Moved out of ReadGrib2Record.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int UnpackGrib2Grid (IS_dataType *IS, unsigned char *c_ipack,
+                            int subgNum, sInt4 *ibitmap, float *xmissp,
+                            float *xmisss, sInt4 *f_endMsg)
+{
+   sInt4 l3264b;        /* Number of bits in a sInt4.  Needed by FORTRAN
+                         * unpack library to determine if system has a 4
+                         * byte_ sInt4 or an 8 byte sInt4. */
+   sInt4 inew;          /* 1 if this is the first grid we are reading. 0 if
+                         * this is the second or later grid from the same
+                         * GRIB message. */
+   sInt4 iclean = 0;    /* 0 embed the missing values, 1 don't. */
+   int j;               /* Counter used to find the desired subgrid. */
+   sInt4 kfildo = 5;    /* FORTRAN Unit number for diagnostic info. Ignored,
+                         * unless library is compiled a particular way. */
+   sInt4 jer[UNPK_NUM_ERRORS * 2]; /* Any Error codes along with their *
+                                    * severity levels generated using the *
+                                    * unpack GRIB2 library. */
+   sInt4 ndjer = UNPK_NUM_ERRORS; /* The number of rows in JER( ). */
+   sInt4 kjer;          /* The actual number of errors returned in JER. */
+   size_t i;            /* counter as we loop through jer. */
+
+   l3264b = sizeof (sInt4) * 8;
+   /* Loop through the grib message looking for the subgNum grid.  subgNum
+    * goes from 0 to n-1. */
+   for (j = 0; j <= subgNum; j++) {
+      if (j == 0) {
+         inew = 1;
+      } else {
+         inew = 0;
+      }
+
+      /* Note we are getting data back either as a float or an int, but not
+       * both, so we don't need to allocated room for both. */
+      unpk_g2ncep (&kfildo, (float *) (IS->iain), IS->iain, &(IS->nd2x3),
+                  IS->idat, &(IS->nidat), IS->rdat, &(IS->nrdat), IS->is[0],
+                  &(IS->ns[0]), IS->is[1], &(IS->ns[1]), IS->is[2],
+                  &(IS->ns[2]), IS->is[3], &(IS->ns[3]), IS->is[4],
+                  &(IS->ns[4]), IS->is[5], &(IS->ns[5]), IS->is[6],
+                  &(IS->ns[6]), IS->is[7], &(IS->ns[7]), IS->ib, ibitmap,
+                  c_ipack, &(IS->nd5), xmissp, xmisss, &inew, &iclean,
                   &l3264b, f_endMsg, jer, &ndjer, &kjer);
 /*
       unpk_grib2 (&kfildo, (float *) (IS->iain), IS->iain, &(IS->nd2x3),
@@ -1064,8 +1541,8 @@ int ReadGrib2Record (FILE *fp, sChar f_unit, double **Grib_Data,
                   &(IS->ns[0]), IS->is[1], &(IS->ns[1]), IS->is[2],
                   &(IS->ns[2]), IS->is[3], &(IS->ns[3]), IS->is[4],
                   &(IS->ns[4]), IS->is[5], &(IS->ns[5]), IS->is[6],
-                  &(IS->ns[6]), IS->is[7], &(IS->ns[7]), IS->ib, &ibitmap,
-                  IS->ipack, &(IS->nd5), &xmissp, &xmisss, &inew, &iclean,
+                  &(IS->ns[6]), IS->is[7], &(IS->ns[7]), IS->ib, ibitmap,
+                  IS->ipack, &(IS->nd5), xmissp, xmisss, &inew, &iclean,
                   &l3264b, f_endMsg, jer, &ndjer, &kjer);
 */
       /*
@@ -1089,184 +1566,275 @@ int ReadGrib2Record (FILE *fp, sChar f_unit, double **Grib_Data,
          }
       }
    }
+   return 0;
+}
 
-   /* Parse the meta data out. */
-   if (MetaParse (meta, IS->is[0], IS->ns[0], IS->is[1], IS->ns[1],
-                  IS->is[2], IS->ns[2], IS->rdat, IS->nrdat, IS->idat,
-                  IS->nidat, IS->is[3], IS->ns[3], IS->is[4], IS->ns[4],
-                  IS->is[5], IS->ns[5], gribLen, xmissp, xmisss, simpVer, simpWWA)
-       != 0) {
-#ifdef DEBUG
-      FILE *fp;
-      if ((fp = fopen ("dump.is0", "wt")) != NULL) {
-         for (i = 0; i < 8; i++) {
-            fprintf (fp, "---Section %d---\n", i);
-            for (j = 1; j <= IS->ns[i]; j++) {
-               fprintf (fp, "IS%d Item %d = %ld\n", i, j, IS->is[i][j - 1]);
-            }
-         }
-         fclose (fp);
-      }
-#endif
-      preErrSprintf ("Inside ReadGrib2Record.. Problems in MetaParse\n");
-      return -4;
-   }
+/*****************************************************************************
+ * UnpackGrib2Rows() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   When the user only wants a subgrid, the first call to UnpackGrib2Grid
+ * (made with unpk_g2ncepRows (1, 1)) only unpacked enough to get the meta
+ * data.  Once the subgrid is known, this unpacks the rows y1..y2 of the
+ * subgNum grid.  The simple and complex packing (templates 5.0, 5.2, 5.3)
+ * can seek to a row, so only those rows are unpacked.  Other packings
+ * ignored unpk_g2ncepRows (the first call already unpacked all of the
+ * grid), so are left alone.
+ *
+ * ARGUMENTS
+ *       IS = Un-parsed meta data and the arrays for the unpacker. (Output)
+ *  c_ipack = The GRIB2 message. (Input)
+ *  subgNum = Which sub grid to get. (0 to n-1) (Input)
+ * packType = The data representation template (meta->gridAttrib.packType)
+ *            (Input)
+ *   y1, y2 = The rows of the original grid the subgrid uses (1-based, may
+ *            be outside the grid). (Input)
+ *       Ny = Number of rows in the original grid. (Input)
+ *  ibitmap = 0 means no bitmap returned, otherwise 1. (Output)
+ *   xmissp = The primary missing value. (Output)
+ *   xmisss = The secondary missing value. (Output)
+ * f_endMsg = 1 if there are no more grids in this message. (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ * -3 = Problems in the unpacker library.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int UnpackGrib2Rows (IS_dataType *IS, unsigned char *c_ipack,
+                            int subgNum, sInt4 packType, int y1, int y2,
+                            sInt4 Ny, sInt4 *ibitmap, float *xmissp,
+                            float *xmisss, sInt4 *f_endMsg)
+{
+   int ans;             /* The return value from UnpackGrib2Grid. */
 
-   if ((majEarth > 6000) && (majEarth < 7000)) {
-      if ((minEarth > 6000) && (minEarth < 7000)) {
-         meta->gds.f_sphere = 0;
-         meta->gds.majEarth = majEarth;
-         meta->gds.minEarth = minEarth;
-      } else {
-         meta->gds.f_sphere = 1;
-         meta->gds.majEarth = majEarth;
-         meta->gds.minEarth = majEarth;
-      }
+   if ((packType != 0) && (packType != 2) && (packType != 3)) {
+      return 0;
+   }
+   if (y1 < 1) {
+      y1 = 1;
+   } else if (y1 > Ny) {
+      y1 = Ny;
+   }
+   if (y2 > Ny) {
+      y2 = Ny;
+   } else if (y2 < y1) {
+      y2 = y1;
    }
+   unpk_g2ncepRows (y1, y2);
+   ans = UnpackGrib2Grid (IS, c_ipack, subgNum, ibitmap, xmissp, xmisss,
+                          f_endMsg);
+   unpk_g2ncepRows (0, 0);
+   return ans;
+}
+
+/*****************************************************************************
+ * Grib2UnitConvert() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Figures out the equation (y = m x + b) which converts a GRIB2 grid to
+ * the units the user asked for, and changes meta->unitName to match.
+ *
+ * ARGUMENTS
+ *   meta = The meta data of the grid (uses convert, updates unitName).
+ *          (Input/Output)
+ * f_unit = The unit system the user wants (see ComputeUnit). (Input)
+ *  unitM = M in unit conversion equation y(new) = m x(orig) + b (Output)
+ *  unitB = B in unit conversion equation y(new) = m x(orig) + b (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Moved out of ReadGrib2Record.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void Grib2UnitConvert (grib_MetaData *meta, sChar f_unit,
+                              double *unitM, double *unitB)
+{
+   char unitName[15];   /* Holds the string name of the current unit. */
+   size_t unitLen;      /* String length of string name of current unit. */
 
-   /* Figure out an equation to pass to ParseGrid to convert the units for
-    * this grid. */
 /*
    if (ComputeUnit (meta->pds2.prodType, meta->pds2.sect4.templat,
                     meta->pds2.sect4.cat, meta->pds2.sect4.subcat, f_unit,
-                    &unitM, &unitB, unitName) == 0) {
+                    unitM, unitB, unitName) == 0) {
 */
-   if (ComputeUnit (meta->convert, meta->unitName, f_unit, &unitM, &unitB,
+   if (ComputeUnit (meta->convert, meta->unitName, f_unit, unitM, unitB,
                     unitName) == 0) {
       unitLen = strlen (unitName);
       meta->unitName = (char *) realloc ((void *) (meta->unitName),
-                                         1 + unitLen * sizeof (char));
-      strncpy (meta->unitName, unitName, unitLen);
-      meta->unitName[unitLen] = '\0';
+                                         (unitLen + 1) * sizeof (char));
+      memcpy (meta->unitName, unitName, unitLen + 1);
    }
+}
 
-   /* compute the subgrid. */
-   if ((lwlf->lat != -100) && (uprt->lat != -100)) {
-      Nx = meta->gds.Nx;
-      Ny = meta->gds.Ny;
-      if (computeSubGrid (lwlf, &x1, &y1, uprt, &x2, &y2, &(meta->gds),
-                          &newGds) != 0) {
-         preErrSprintf ("ERROR: In compute subgrid.\n");
-         return 1;
-      }
-      /* I couldn't decide if I should "permanently" change the GDS or not.
-       * when I wrote computeSubGrid.  If next line stays, really should
-       * rewrite computeSubGrid. */
-      memcpy (&(meta->gds), &newGds, sizeof (gdsType));
-      f_subGrid = 1;
+/*****************************************************************************
+ * Grib2ParseGrid() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Calls ParseGrid, or ParseGridFlt if the caller wants a float grid.
+ *
+ * ARGUMENTS
+ *    Grib_Data = The double grid to fill in (if Flt_Data is NULL). (Output)
+ *     Flt_Data = The float grid to fill in (or NULL). (Output)
+ *      decimal = Decimal places to round Flt_Data to (see ParseGridFlt). (In)
+ * grib_DataLen = Size of the grid being filled in. (Input/Output)
+ *  (the rest) = See ParseGrid. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void Grib2ParseGrid (gridAttribType *attrib, double **Grib_Data,
+                            float **Flt_Data, sChar decimal,
+                            uInt4 *grib_DataLen, uInt4 Nx, uInt4 Ny,
+                            int scan, IS_dataType *IS,
+                            sInt4 ibitmap, double unitM, double unitB,
+                            uChar f_txtType, uInt4 txt_dataLen,
+                            uChar *txt_f_valid, uChar f_subGrid, int startX,
+                            int startY, int stopX, int stopY)
+{
+   if (Flt_Data != NULL) {
+      ParseGridFlt (attrib, Flt_Data, grib_DataLen, Nx, Ny, scan, IS->iain,
+                    ibitmap, IS->ib, unitM, unitB, f_txtType, txt_dataLen,
+                    txt_f_valid, f_subGrid, startX, startY, stopX, stopY,
+                    decimal);
    } else {
-      Nx = meta->gds.Nx;
-      Ny = meta->gds.Ny;
-      x1 = 1;
-      x2 = Nx;
-      y1 = 1;
-      y2 = Ny;
-      f_subGrid = 0;
-   }
-
-   /* Figure out if we need iain or ain, and set it to Grib_Data.  At the
-    * same time handle any bitmaps, and compute some statistics. */
-   if ((f_subGrid) && (meta->gds.scan != 64)) {
-      errSprintf ("Can not do a subgrid of non scanmode 64 grid yet.\n");
-      return -3;
+      ParseGrid (attrib, Grib_Data, grib_DataLen, Nx, Ny, scan, IS->iain,
+                 ibitmap, IS->ib, unitM, unitB, f_txtType, txt_dataLen,
+                 txt_f_valid, f_subGrid, startX, startY, stopX, stopY);
    }
+}
 
-   if (strcmp (meta->element, "Wx") != 0) {
-      if (strcmp (meta->element, "WWA") != 0) {
-         ParseGrid (&(meta->gridAttrib), Grib_Data, grib_DataLen, Nx, Ny,
-                    meta->gds.scan, IS->iain, ibitmap, IS->ib, unitM, unitB, 0,
-                    0, NULL, f_subGrid, x1, y1, x2, y2);
-      } else {
-         ParseGrid (&(meta->gridAttrib), Grib_Data, grib_DataLen, Nx, Ny,
-                    meta->gds.scan, IS->iain, ibitmap, IS->ib, unitM, unitB, 1,
-                    meta->pds2.sect2.hazard.dataLen, meta->pds2.sect2.hazard.f_valid, f_subGrid, x1, y1,
-                    x2, y2);
-         /* compact the table to only those which are actually used. */
-         cnt = 0;
-         for (i = 0; i < meta->pds2.sect2.hazard.dataLen; i++) {
-            if (meta->pds2.sect2.hazard.f_valid[i] == 2) {
-               meta->pds2.sect2.hazard.haz[i].validIndex = cnt;
-               cnt++;
-            } else if (meta->pds2.sect2.hazard.f_valid[i] == 3) {
-               meta->pds2.sect2.hazard.f_valid[i] = 0;
-               meta->pds2.sect2.hazard.haz[i].validIndex = cnt;
-               cnt++;
-            } else {
-               meta->pds2.sect2.hazard.haz[i].validIndex = -1;
-            }
-         }
-      }
-   } else {
-      /* Handle weather grid.  ParseGrid looks up the values... If they are
-       * "<Invalid>" it sets it to missing (or creates one).  If the table
-       * entry is used it sets f_valid to 2. */
-      ParseGrid (&(meta->gridAttrib), Grib_Data, grib_DataLen, Nx, Ny,
-                 meta->gds.scan, IS->iain, ibitmap, IS->ib, unitM, unitB, 1,
-                 meta->pds2.sect2.wx.dataLen, meta->pds2.sect2.wx.f_valid, f_subGrid, x1, y1,
-                 x2, y2);
+/*****************************************************************************
+ * NarrowGrid() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Copies a double grid into a float grid.  Used by ReadGrib2RecordFlt for
+ * GRIB1 and TDLP messages, whose readers only produce double grids.  Like
+ * ParseGridFlt, it rounds the values which aren't missing to decimal places
+ * first.
+ *
+ * ARGUMENTS
+ *      attrib = The grid's missing value info. (Input)
+ *        data = The double grid. (Input)
+ *     dataLen = Number of values in data. (Input)
+ *     decimal = How many decimal places to round the values to. (Input)
+ *    Flt_Data = The float grid (grown if needed). (Output)
+ * flt_DataLen = Size of Flt_Data. (Input/Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void NarrowGrid (const gridAttribType *attrib, const double *data,
+                        uInt4 dataLen, sChar decimal, float **Flt_Data,
+                        uInt4 *flt_DataLen)
+{
+   uInt4 i;             /* Loop counter over the grid. */
+   double value;        /* The current cell. */
 
-      /* compact the table to only those which are actually used. */
-      cnt = 0;
-      for (i = 0; i < meta->pds2.sect2.wx.dataLen; i++) {
-         if (meta->pds2.sect2.wx.f_valid[i] == 2) {
-            meta->pds2.sect2.wx.ugly[i].validIndex = cnt;
-            cnt++;
-         } else if (meta->pds2.sect2.wx.f_valid[i] == 3) {
-            meta->pds2.sect2.wx.f_valid[i] = 0;
-            meta->pds2.sect2.wx.ugly[i].validIndex = cnt;
-            cnt++;
-         } else {
-            meta->pds2.sect2.wx.ugly[i].validIndex = -1;
-         }
+   if (dataLen > *flt_DataLen) {
+      *flt_DataLen = dataLen;
+      *Flt_Data = (float *) realloc ((void *) (*Flt_Data),
+                                     dataLen * sizeof (float));
+   }
+   if (decimal < 0) {
+      decimal = 0;
+   }
+   for (i = 0; i < dataLen; i++) {
+      value = data[i];
+      if ((attrib->f_miss == 0) ||
+          ((value != attrib->missPri) &&
+           ((attrib->f_miss != 2) || (value != attrib->missSec)))) {
+         value = myRound (value, (uChar) decimal);
       }
+      (*Flt_Data)[i] = (float) value;
    }
-
-   /* Figure out some other non-section oriented meta data. */
-/*   strftime (meta->refTime, 20, "%Y%m%d%H%M",
-             gmtime (&(meta->pds2.refTime)));
-*/
-   Clock_Print (meta->refTime, 20, meta->pds2.refTime, "%Y%m%d%H%M", 0);
-/*
-   strftime (meta->validTime, 20, "%Y%m%d%H%M",
-             gmtime (&(meta->pds2.sect4.validTime)));
-*/
-   Clock_Print (meta->validTime, 20, meta->pds2.sect4.validTime,
-                "%Y%m%d%H%M", 0);
-
-   meta->deltTime = (sInt4) (meta->pds2.sect4.validTime - meta->pds2.refTime);
-
-   return 0;
 }
 
-int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
-                         uInt4 *grib_DataLen, grib_MetaData *meta,
-                         IS_dataType *IS, int subgNum, double majEarth,
-                         double minEarth, int simpVer, int simpWWA,
-                         sInt4 *f_endMsg, LatLon *lwlf, LatLon *uprt)
-{
-   sInt4 l3264b;        /* Number of bits in a sInt4.  Needed by FORTRAN
-                         * unpack library to determine if system has a 4
-                         * byte_ sInt4 or an 8 byte sInt4. */
-   char *buff;          /* Holds the info between records. */
-   uInt4 buffLen;       /* Length of info between records. */
-   sInt4 sect0[SECT0LEN_WORD]; /* Holds the current Section 0. */
-   uInt4 gribLen;       /* Length of the current GRIB message. */
-   sInt4 nd5;           /* Size of grib message rounded up to the nearest
-                         * sInt4. */
-   unsigned char *c_ipack; /* A char ptr to the message stored in IS->ipack */
-   sInt4 local_ns[8];   /* Local copy of section lengths. */
-   sInt4 nd2x3;         /* Total number of grid points. */
-   short int table50;   /* Type of packing used. (See code table 5.0)
-                         * (GS5_SIMPLE==0, GS5_CMPLX==2, GS5_CMPLXSEC==3) */
-   sInt4 nidat;         /* Size of section 2 if it contains integer data. */
-   sInt4 nrdat;         /* Size of section 2 if it contains float data. */
-   sInt4 inew;          /* 1 if this is the first grid we are reading. 0 if
-                         * this is the second or later grid from the same
-                         * GRIB message. */
-   sInt4 iclean = 0;    /* 0 embed the missing values, 1 don't. */
-   int j;               /* Counter used to find the desired subgrid. */
-   sInt4 kfildo = 5;    /* FORTRAN Unit number for diagnostic info. Ignored,
-                         * unless library is compiled a particular way. */
+/*****************************************************************************
+ * ReadGrib2Core() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   The body of ReadGrib2Record, ReadGrib2RecordFlt and
+ * ReadGrib2RecordFast.  Reads the next GRIB message (or grid of the current
+ * message), unpacks it and parses the meta data.  Unless f_fast is set, it
+ * then converts the grid into Grib_Data (or Flt_Data).
+ *
+ * ARGUMENTS
+ *  See ReadGrib2Record, plus:
+ *   Flt_Data = If not NULL, the float grid to fill in instead of Grib_Data.
+ *              grib_DataLen is then the size of Flt_Data. (Output)
+ *    decimal = Decimal places to round Flt_Data to (see ParseGridFlt). (In)
+ *     f_fast = 1 to stop after the meta data (leaving the unpacked grid in
+ *              IS->iain), which only works for GRIB2 messages. (Input)
+ *
+ * FILES/DATABASES:
+ *    An already opened "GRIB2" File
+ *
+ * RETURNS: int (could use errSprintf())
+ *  See ReadGrib2Record.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Combined ReadGrib2Record and
+ *          ReadGrib2RecordFast.
+ *  10/2026 AAT: Added Flt_Data (for ReadGrib2RecordFlt).
+ *
+ * NOTES
+ *  See ReadGrib2Record.
+ *  GRIB1 and TDLP messages are read into a double grid, which is then
+ *  copied into Flt_Data.
+ *****************************************************************************
+ */
+static int ReadGrib2Core (FILE *fp, sChar f_unit, double **Grib_Data,
+                          float **Flt_Data, sChar decimal,
+                          uInt4 *grib_DataLen,
+                          grib_MetaData *meta,
+                          IS_dataType *IS, int subgNum, double majEarth,
+                          double minEarth, int simpVer, int simpWWA,
+                          sInt4 *f_endMsg, LatLon *lwlf, LatLon *uprt,
+                          sChar f_fast)
+{
+   char *buff;          /* Holds the info between records. */
+   uInt4 buffLen;       /* Length of info between records. */
+   sInt4 sect0[SECT0LEN_WORD]; /* Holds the current Section 0. */
+   uInt4 gribLen;       /* Length of the current GRIB message. */
+   unsigned char *c_ipack; /* A char ptr to the message (either stored in
+                            * IS->ipack or in the memory mapped file) */
+   int ans;             /* The return value from ReadGrib2Msg. */
    sInt4 ibitmap;       /* 0 means no bitmap returned, otherwise 1. */
    float xmissp;        /* The primary missing value.  If iclean = 0, this
                          * value is embeded in grid, otherwise it is the
@@ -1274,15 +1842,7 @@ int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
    float xmisss;        /* The secondary missing value.  If iclean = 0, this
                          * value is embeded in grid, otherwise it is the
                          * value returned from the GRIB message. */
-   sInt4 jer[UNPK_NUM_ERRORS * 2]; /* Any Error codes along with their *
-                                    * severity levels generated using the *
-                                    * unpack GRIB2 library. */
-   sInt4 ndjer = UNPK_NUM_ERRORS; /* The number of rows in JER( ). */
-   sInt4 kjer;          /* The actual number of errors returned in JER. */
-   size_t i;            /* counter as we loop through jer. */
    double unitM, unitB; /* values in y = m x + b used for unit conversion. */
-   char unitName[15];   /* Holds the string name of the current unit. */
-   int unitLen;         /* String length of string name of current unit. */
    int version;         /* Which version of GRIB is in this message. */
    gdsType newGds;      /* The GDS of the subgrid if needed. */
    int x1, y1;          /* The original grid coordinates of the lower left
@@ -1291,6 +1851,8 @@ int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
                          * corner of the subgrid. */
    uChar f_subGrid;     /* True if we have a subgrid. */
    sInt4 Nx, Ny;        /* original size of the data. */
+   double *data = NULL; /* GRIB1 / TDLP grid if the caller wants floats. */
+   uInt4 dataLen = 0;   /* Size of data. */
 
    /*
     * f_endMsg is 1 if in the past we either completed reading a message,
@@ -1299,7 +1861,6 @@ int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
     * If f_endMsg is false, then there is more to read from IS->ipack, so we
     * don't want to throw it out, nor have to re-read ipack from disk.
     */
-   l3264b = sizeof (sInt4) * 8;
    buff = NULL;
    buffLen = 0;
    if (*f_endMsg == 1) {
@@ -1309,118 +1870,59 @@ int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
          return -1;
       }
       meta->GribVersion = version;
-      if (version != 2) {
+      if ((f_fast) && (version != 2)) {
          printf ("Fast parsing doesn't handle this version because ReadGrib1Record/ReadTDLPRecord used Grib_Data[]\n");
+         free (buff);
          return -1;
       }
-
-      /*
-       * Make room for entire message, and read it in.
-       */
-      /* nd5 needs to be gribLen in (sInt4) units rounded up. */
-      nd5 = (gribLen + 3) / 4;
-      if (nd5 > IS->ipackLen) {
-         IS->ipackLen = nd5;
-         IS->ipack = (sInt4 *) realloc ((void *) (IS->ipack),
-                                        (IS->ipackLen) * sizeof (sInt4));
+      if (version == 1) {
+         if (ReadGrib1Record (fp, f_unit,
+                              (Flt_Data != NULL) ? &data : Grib_Data,
+                              (Flt_Data != NULL) ? &dataLen : grib_DataLen,
+                              meta, IS, sect0, gribLen, majEarth,
+                              minEarth) != 0) {
+            preErrSprintf ("Problems with ReadGrib1Record called by "
+                           "ReadGrib2Record\n");
+            free (data);
+            free (buff);
+            return -1;
+         }
+         *f_endMsg = 1;
+      } else if (version == -1) {
+         if (ReadTDLPRecord (fp, (Flt_Data != NULL) ? &data : Grib_Data,
+                             (Flt_Data != NULL) ? &dataLen : grib_DataLen,
+                             meta, IS, sect0, gribLen, majEarth,
+                             minEarth) != 0) {
+            preErrSprintf ("Problems with ReadGrib1Record called by "
+                           "ReadGrib2Record\n");
+            free (data);
+            free (buff);
+            return -1;
+         }
       }
-      c_ipack = (unsigned char *) IS->ipack;
-      /* Init last sInt4 to 0, to make sure that the padded bytes are 0. */
-      IS->ipack[nd5 - 1] = 0;
-      /* Init first 4 sInt4 to sect0. */
-      memcpy (c_ipack, sect0, SECT0LEN_WORD * 4);
-      /* Read in the rest of the message. */
-      if (fread (c_ipack + SECT0LEN_WORD * 4, sizeof (char),
-                 (gribLen - SECT0LEN_WORD * 4),
-                 fp) != (gribLen - SECT0LEN_WORD * 4)) {
-         errSprintf ("GribLen = %ld, SECT0Len_WORD = %d\n", gribLen,
-                     SECT0LEN_WORD);
-         errSprintf ("Ran out of file\n");
+      if (version != 2) {
+         if (Flt_Data != NULL) {
+            NarrowGrid (&(meta->gridAttrib), data, dataLen, decimal,
+                        Flt_Data, grib_DataLen);
+            free (data);
+         }
          free (buff);
-         return -1;
+         return 0;
       }
 
-      /*
-       * Make sure the arrays are large enough for call to unpacker library.
-       */
-      /* FindSectLen Does not want (ipack / c_ipack) word swapped, because
-       * that would make it much more confusing to find bytes in c_ipack. */
-      if (FindSectLen (c_ipack, gribLen, local_ns, &nd2x3, &table50) < 0) {
-         preErrSprintf ("Inside ReadGrib2Record.. Calling FindSectLen\n");
+      /* Read (or memory map) the message, and size the IS arrays. */
+      if ((ans = ReadGrib2Msg (fp, IS, sect0, gribLen, &c_ipack)) != 0) {
+         preErrSprintf ("Inside ReadGrib2Record\n");
          free (buff);
-         return -2;
-      }
-
-      /* Make sure all 'is' arrays except ns[7] are MAX (IS.ns[] ,
-       * local_ns[]). See note 1 for reason to exclude ns[7] from MAX (). */
-      for (i = 0; i < 7; i++) {
-         if (local_ns[i] > IS->ns[i]) {
-            IS->ns[i] = local_ns[i];
-            IS->is[i] = (sInt4 *) realloc ((void *) (IS->is[i]),
-                                           IS->ns[i] * sizeof (sInt4));
-         }
+         return ans;
       }
-
-      /* Allocate room for sect 2. If local_ns[2] = -1 there is no sect 2. */
-      if (local_ns[2] == -1) {
-         nidat = 10;
-         nrdat = 10;
+   } else {
+      /* The rest of the message is either in the memory map or ipack. */
+      if (IS->mapMsg != NULL) {
+         c_ipack = IS->mapMsg;
       } else {
-         /*
-          * See note 2) We have a section 2, so use:
-          *     MAX (32 * local_ns[2],SECT2_INTSIZE)
-          * and MAX (32 * local_ns[2],SECT2_FLOATSIZE)
-          * for size of section 2 unpacked.
-          */
-         nidat = (32 * local_ns[2] < SECT2_INIT_SIZE) ? SECT2_INIT_SIZE :
-               32 * local_ns[2];
-         nrdat = nidat;
-      }
-      if (nidat > IS->nidat) {
-         IS->nidat = nidat;
-         IS->idat = (sInt4 *) realloc ((void *) IS->idat,
-                                       IS->nidat * sizeof (sInt4));
-      }
-      if (nrdat > IS->nrdat) {
-         IS->nrdat = nrdat;
-         IS->rdat = (float *) realloc ((void *) IS->rdat,
-                                       IS->nrdat * sizeof (float));
-      }
-      /* Make sure we have room for the GRID part of the output. */
-      if (nd2x3 > IS->nd2x3) {
-         IS->nd2x3 = nd2x3;
-         IS->iain = (sInt4 *) realloc ((void *) IS->iain,
-                                       IS->nd2x3 * sizeof (sInt4));
-         IS->ib = (sInt4 *) realloc ((void *) IS->ib,
-                                     IS->nd2x3 * sizeof (sInt4));
-      }
-      /* See note 3) If table50 == 3, unpacker library needs nd5 >= nd2x3. */
-      if ((table50 == 3) || (table50 == 0)) {
-         if (nd5 < nd2x3) {
-            nd5 = nd2x3;
-            if (nd5 > IS->ipackLen) {
-               IS->ipackLen = nd5;
-               IS->ipack = (sInt4 *) realloc ((void *) (IS->ipack),
-                                              IS->ipackLen * sizeof (sInt4));
-            }
-            /* Don't need to do the following, but we do in case code
-             * changes. */
-            c_ipack = (unsigned char *) IS->ipack;
-         }
-      }
-      IS->nd5 = nd5;
-      /* Unpacker library requires ipack to be MSB. */
-/*
-#ifdef DEBUG
-      if (1==1) {
-         FILE *fp = fopen ("test.bin", "wb");
-         fwrite (IS->ipack, sizeof (sInt4), IS->nd5, fp);
-         fclose (fp);
+         c_ipack = (unsigned char *) IS->ipack;
       }
-#endif
-*/
-   } else {
-      c_ipack = (unsigned char *) IS->ipack;
       /* GRIB2 files are in big endian so c_ipack is as well. */
 #ifdef LITTLE_ENDIAN
       revmemcpy (&gribLen, &(c_ipack[12]), sizeof (sInt4));
@@ -1430,58 +1932,16 @@ int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
    }
    free (buff);
 
-   /* Loop through the grib message looking for the subgNum grid.  subgNum
-    * goes from 0 to n-1. */
-   for (j = 0; j <= subgNum; j++) {
-      if (j == 0) {
-         inew = 1;
-      } else {
-         inew = 0;
-      }
-
-      /* Note we are getting data back either as a float or an int, but not
-       * both, so we don't need to allocated room for both. */
-/*
-      unpk_grib2 (&kfildo, (float *) (IS->iain), IS->iain, &(IS->nd2x3),
-                  IS->idat, &(IS->nidat), IS->rdat, &(IS->nrdat), IS->is[0],
-                  &(IS->ns[0]), IS->is[1], &(IS->ns[1]), IS->is[2],
-                  &(IS->ns[2]), IS->is[3], &(IS->ns[3]), IS->is[4],
-                  &(IS->ns[4]), IS->is[5], &(IS->ns[5]), IS->is[6],
-                  &(IS->ns[6]), IS->is[7], &(IS->ns[7]), IS->ib, &ibitmap,
-                  IS->ipack, &(IS->nd5), &xmissp, &xmisss, &inew, &iclean,
-                  &l3264b, f_endMsg, jer, &ndjer, &kjer);
-*/
-      c_ipack = (unsigned char *)IS->ipack;
-      unpk_g2ncep(&kfildo, (float *) (IS->iain), IS->iain, &(IS->nd2x3),
-                  IS->idat, &(IS->nidat), IS->rdat, &(IS->nrdat), IS->is[0],
-                  &(IS->ns[0]), IS->is[1], &(IS->ns[1]), IS->is[2],
-                  &(IS->ns[2]), IS->is[3], &(IS->ns[3]), IS->is[4],
-                  &(IS->ns[4]), IS->is[5], &(IS->ns[5]), IS->is[6],
-                  &(IS->ns[6]), IS->is[7], &(IS->ns[7]), IS->ib, &ibitmap,
-                  c_ipack, &(IS->nd5), &xmissp, &xmisss, &inew, &iclean,
-                  &l3264b, f_endMsg, jer, &ndjer, &kjer);
-
-
-      /*
-       * Check for error messages...
-       *   If we get an error message, print it, and return.
-       */
-      for (i = 0; i < (uInt4) kjer; i++) {
-         if (jer[ndjer + i] == 0) {
-            /* no error. */
-         } else if (jer[ndjer + i] == 1) {
-            /* Warning. */
-#ifdef DEBUG
-            printf ("Warning: Unpack library warning code (%ld %ld)\n",
-                    jer[i], jer[ndjer + i]);
-#endif
-         } else {
-            /* BAD Error. */
-            errSprintf ("ERROR: Unpack library error code (%ld %ld)\n",
-                        jer[i], jer[ndjer + i]);
-            return -3;
-         }
-      }
+   /* If the user wants a subgrid, only unpack the first row for now (to
+    * get the meta data), and get the rest once the subgrid is known. */
+   if ((lwlf->lat != -100) && (uprt->lat != -100)) {
+      unpk_g2ncepRows (1, 1);
+   }
+   ans = UnpackGrib2Grid (IS, c_ipack, subgNum, &ibitmap, &xmissp, &xmisss,
+                          f_endMsg);
+   unpk_g2ncepRows (0, 0);
+   if (ans != 0) {
+      return ans;
    }
 
    /* Parse the meta data out. */
@@ -1492,6 +1952,7 @@ int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
        != 0) {
 #ifdef DEBUG
       FILE *fp;
+      int i, j;
       if ((fp = fopen ("dump.is0", "wt")) != NULL) {
          for (i = 0; i < 8; i++) {
             fprintf (fp, "---Section %d---\n", i);
@@ -1520,19 +1981,7 @@ int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
 
    /* Figure out an equation to pass to ParseGrid to convert the units for
     * this grid. */
-/*
-   if (ComputeUnit (meta->pds2.prodType, meta->pds2.sect4.templat,
-                    meta->pds2.sect4.cat, meta->pds2.sect4.subcat, f_unit,
-                    &unitM, &unitB, unitName) == 0) {
-*/
-   if (ComputeUnit (meta->convert, meta->unitName, f_unit, &unitM, &unitB,
-                    unitName) == 0) {
-      unitLen = strlen (unitName);
-      meta->unitName = (char *) realloc ((void *) (meta->unitName),
-                                         1 + unitLen * sizeof (char));
-      strncpy (meta->unitName, unitName, unitLen);
-      meta->unitName[unitLen] = '\0';
-   }
+   Grib2UnitConvert (meta, f_unit, &unitM, &unitB);
 
    /* compute the subgrid. */
    if ((lwlf->lat != -100) && (uprt->lat != -100)) {
@@ -1562,6 +2011,45 @@ int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
       errSprintf ("Can not do a subgrid of non scanmode 64 grid yet.\n");
       return -3;
    }
+   if (f_subGrid) {
+      if (UnpackGrib2Rows (IS, c_ipack, subgNum, meta->gridAttrib.packType,
+                           y1, y2, Ny, &ibitmap, &xmissp, &xmisss,
+                           f_endMsg) != 0) {
+         return -3;
+      }
+   }
+
+   /* Figure out if we need iain or ain, and set it to Grib_Data (or
+    * Flt_Data).  At the same time handle any bitmaps, and compute some
+    * statistics. */
+   if (f_fast) {
+      /* Leave the grid in IS->iain. */
+   } else if (strcmp (meta->element, "Wx") != 0) {
+      if (strcmp (meta->element, "WWA") != 0) {
+         Grib2ParseGrid (&(meta->gridAttrib), Grib_Data, Flt_Data, decimal,
+                         grib_DataLen, Nx, Ny, meta->gds.scan, IS, ibitmap,
+                         unitM, unitB, 0, 0, NULL, f_subGrid, x1, y1, x2, y2);
+      } else {
+         Grib2ParseGrid (&(meta->gridAttrib), Grib_Data, Flt_Data, decimal,
+                         grib_DataLen, Nx, Ny, meta->gds.scan, IS, ibitmap,
+                         unitM, unitB, 1, meta->pds2.sect2.hazard.dataLen,
+                         meta->pds2.sect2.hazard.f_valid, f_subGrid, x1, y1,
+                         x2, y2);
+         /* compact the table to only those which are actually used. */
+         CompactTxtTable (meta);
+      }
+   } else {
+      /* Handle weather grid.  ParseGrid looks up the values... If they are
+       * "<Invalid>" it sets it to missing (or creates one).  If the table
+       * entry is used it sets f_valid to 2. */
+      Grib2ParseGrid (&(meta->gridAttrib), Grib_Data, Flt_Data, decimal,
+                      grib_DataLen, Nx, Ny, meta->gds.scan, IS, ibitmap,
+                      unitM, unitB, 1, meta->pds2.sect2.wx.dataLen,
+                      meta->pds2.sect2.wx.f_valid, f_subGrid, x1, y1, x2, y2);
+
+      /* compact the table to only those which are actually used. */
+      CompactTxtTable (meta);
+   }
 
    /* Figure out some other non-section oriented meta data. */
 /*   strftime (meta->refTime, 20, "%Y%m%d%H%M",
@@ -1579,3 +2067,598 @@ int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
 
    return 0;
 }
+
+/*****************************************************************************
+ * ReadGrib2Record() -- Review 12/2002
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Reads a GRIB2 message from a file which is already opened and is pointing
+ * at the correct message.  It reads in the message storing the results in
+ * Grib_Data which is of size grib_DataLen.  If needed, it increases
+ * grib_DataLen enough to fit the current message's grid.  It converts (if
+ * appropriate) the data in Grib_Data to the units specified in f_unit.
+ *
+ *   In addition it updates offset, and stores the meta data returned by the
+ * unpacker library in both IS, and (after parsing it) in meta.
+ *
+ *   Note: It expects meta and IS to already be initialized through calls to
+ * MetaInit(&meta) and IS_Init(&is) respectively.
+ *
+ * ARGUMENTS
+ *           fp = An opened GRIB2 file already at the correct message. (Input)
+ *      fileLen = Length of the opened file. (Input)
+ *       f_unit = 0 use GRIB2 units, 1 use English, 2 use metric. (Input)
+ *    Grib_Data = The read in GRIB2 grid. (Output)
+ * grib_DataLen = Size of Grib_Data. (Output)
+ *         meta = A filled in meta structure (Output)
+ *           IS = The structure containing all the arrays that the
+ *                unpacker uses (Output)
+ *      subgNum = Which subgrid in the GRIB2 message is of interest.
+ *                (0 = first grid), if it can't find message subgNum,
+ *                returns -5, and an error message (Input)
+ *     majEarth = Used to override the GRIB major axis of earth. (Input)
+ *     minEarth = Used to override the GRIB minor axis of earth. (Input)
+ *      simpVer = The version of the simple weather code to use when parsing
+ *                the WxString. (Input)
+ *     f_endMsg = 1 means we finished reading the previous GRIB message, or
+ *                there was no previous GRIB message.  0 means that we need
+ *                to read a subgrid of the previous message. (Input/Output)
+ *   lwlt, uprt = If the lat is not -100, then lwlt, and uprt define a
+ *                subgrid that the user is interested in.  Get the map
+ *                projection out of the GRIB2 message, and do everything
+ *                on the subgrid. (if lwlt, and uprt are not "correct", the
+ *                lat/lons may get swapped) (Input/Output)
+ *      decimal = (ReadGrib2RecordFlt) How many decimal places to round the
+ *                values to before storing them as floats, which should be
+ *                what the caller later rounds to (see ParseGridFlt). (Input)
+ *
+ * FILES/DATABASES:
+ *   An already opened "GRIB2" File
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ * -1 = Problems in section 0
+ * -2 = Problems figuring out the Section Lengths.
+ * -3 = Error returned by unpack library.
+ * -4 = Problems parsing the Meta Data.
+ *
+ * HISTORY
+ *   9/2002 Arthur Taylor (MDL/RSIS): Created.
+ *  11/2002 AAT: Updated.
+ *  12/2002 (TK,AC,TB,&MS): Code Review.
+ *   1/2003 AAT: It wasn't error coded 208, but rather 202 to look for.
+ *   3/2003 AAT: Modified handling of section 2 stuff (no loop)
+ *   3/2003 AAT: Added ability to handle multiple grids in same message.
+ *   4/2003 AAT: Added ability to call GRIB1 decoder for GRIB1 messages.
+ *   5/2003 AAT: Update the offset for ReadGrib1.
+ *   6/2003 Matthew T. Kallio (matt@wunderground.com):
+ *          "wmo" dimension increased to WMO_HEADER_LEN + 1 (for '\0' char)
+ *   7/2003 AAT: switched to checking against element name for Wx instead
+ *          of pds2.sect2.ptrType == GS2_WXTYPE
+ *   7/2003 AAT: Allowed user to override the radius of earth.
+ *   8/2003 AAT: Removed dependence on fileLen and offset.
+ *   2/2004 AAT: Added "f_endMsg" logic.
+ *   2/2004 AAT: Added subgrid potential.
+ *   2/2004 AAT: Added maj/min Earth override.
+ *  10/2026 AAT: Only unpack the rows of the subgrid (see note 7).
+ *  10/2026 AAT: Moved the body to ReadGrib2Core (shared with
+ *          ReadGrib2RecordFast).
+ *  10/2026 AAT: Added ReadGrib2RecordFlt, which stores the grid in a float
+ *          array (Flt_Data / flt_DataLen instead of Grib_Data /
+ *          grib_DataLen), for output that is written as floats anyway.
+ *
+ * NOTES
+ * 1) Reason ns[7] is not MAX (IS.ns[], local_ns[]) is because local_ns[7]
+ *    is size of the packed message, but ns[7] refers to the returned meta
+ *    data which unpacker library found in section 7, which is a lot smaller.
+ * 2) Problem: MDL's sect2 is packed and we have no idea how large it is
+ *    when unpacked.  So we allocate room for 4000 sInt4s and 500 floats.
+ *    We then check 'jer' for error "202", if we find it we double the size
+ *    and call the unpacker again.
+ *    3/26/2003: Changed this to be: try once with size
+ *       = max (32 * packed size, 4000)
+ *    Should be fewer calls (more memory intensive) same result, since we had
+ *    been doubling it 5 times.
+ * 3) For Complex second order packing (GS5_CMPLXSEC) the unpacker needs nd5
+ *    (which is size of message) to be >= nd2x3 (size of grid).
+ * 3a) Appears to also need this if simple packing, and has a bitmap.
+ * 4) inew = 1:  Currently we only expect 1 grid in 1 GRIB message, although
+ *    the library does allow for multiple grids in a GRIB message.
+ * 5) iclean = 1:  This only maters if there is bitmap data, otherwise it is
+ *    ignored.  For bitmap data, if == 0, it embeds the given values for
+ *    xmissp, and xmisss.  We don't embed because we don't know what to set
+ *    xmissp or xmisss to.  Instead after we know the range, we choose a value
+ *    and walk through the bitmap setting grib_Data appropriately.
+ * 5a) iclean = 0;  This is because we do want the missing values embeded.
+ *    that is we want the missing values to be place holders.
+ * 6) f_endMsg is true if in the past we either completed reading a message,
+ *    or we haven't read any messages.  In either case we need to read the
+ *    next message from file. If f_endMsg is false, then there is more to read
+ *    from IS->ipack, so we don't want to throw it out, nor have to re-read
+ *    ipack from disk.
+ * 7) For a subgrid (lwlf / uprt) the grid is unpacked twice: first just the
+ *    first row (to get the meta data needed by computeSubGrid), then only
+ *    the rows of the subgrid (see UnpackGrib2Rows).  For packings which
+ *    can't seek to a row the first call unpacks the whole grid.
+ *
+ * Question: Should we double ns[2] when we double nrdat, and nidat?
+ *****************************************************************************
+ */
+int ReadGrib2Record (FILE *fp, sChar f_unit, double **Grib_Data,
+                     uInt4 *grib_DataLen, grib_MetaData *meta,
+                     IS_dataType *IS, int subgNum, double majEarth,
+                     double minEarth, int simpVer, int simpWWA,
+                     sInt4 *f_endMsg, LatLon *lwlf, LatLon *uprt)
+{
+   return ReadGrib2Core (fp, f_unit, Grib_Data, NULL, 0, grib_DataLen,
+                         meta, IS, subgNum, majEarth, minEarth, simpVer,
+                         simpWWA, f_endMsg, lwlf, uprt, 0);
+}
+
+int ReadGrib2RecordFlt (FILE *fp, sChar f_unit, float **Flt_Data,
+                        uInt4 *flt_DataLen, grib_MetaData *meta,
+                        IS_dataType *IS, int subgNum, double majEarth,
+                        double minEarth, int simpVer, int simpWWA,
+                        sInt4 *f_endMsg, LatLon *lwlf, LatLon *uprt,
+                        sChar decimal)
+{
+   return ReadGrib2Core (fp, f_unit, NULL, Flt_Data, decimal, flt_DataLen,
+                         meta, IS, subgNum, majEarth, minEarth, simpVer,
+                         simpWWA, f_endMsg, lwlf, uprt, 0);
+}
+
+int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
+                         uInt4 *grib_DataLen, grib_MetaData *meta,
+                         IS_dataType *IS, int subgNum, double majEarth,
+                         double minEarth, int simpVer, int simpWWA,
+                         sInt4 *f_endMsg, LatLon *lwlf, LatLon *uprt)
+{
+   return ReadGrib2Core (fp, f_unit, Grib_Data, NULL, 0, grib_DataLen,
+                         meta, IS, subgNum, majEarth, minEarth, simpVer,
+                         simpWWA, f_endMsg, lwlf, uprt, 1);
+}
+
+/*****************************************************************************
+ * ReadGrib2Peek() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Reads the next GRIB2 message (or the next grid of the current one) and
+ * parses the meta data from sections 0 through 5 (center, templates,
+ * category, surface, reference / valid time, grid, packing) without
+ * unpacking the bitmap or the data.  This lets a caller (such as a probe
+ * looking for certain elements) decide if it is interested in a grid at
+ * little cost.  If it is, it can call ReadGrib2Record with f_endMsg = 0 to
+ * unpack the same grid without re-reading it (see note 1).
+ *
+ * ARGUMENTS
+ *       fp = An opened GRIB2 file already at the correct message. (Input)
+ *     meta = The meta data from sections 0 - 5. (Output)
+ *       IS = Un-parsed meta data for this GRIB2 message.  As well as some
+ *            memory used by the unpacker. (Output)
+ *  subgNum = Which sub grid to look at. (Input)
+ * majEarth = Use this to override the majEarth (< 6000 ignored) (Input)
+ * minEarth = Use this to override the minEarth (< 6000 ignored) (Input)
+ *  simpVer = The version of the simple weather code to use. (Input)
+ *  simpWWA = The version of the simple hazard code to use. (Input)
+ * f_endMsg = 1 means we need to read the next message from fp.  Set to 1
+ *            if this was the last grid in the message. (Input/Output)
+ *
+ * FILES/DATABASES:
+ *    An already opened "GRIB2" File
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK, meta has the header information.
+ *  1 = The message isn't GRIB2 (GRIB1 or TDLPack).  fp was moved back to
+ *      where it was, so the caller should use ReadGrib2Record.
+ * -1 = Problems reading in the GRIB message.
+ * -2 = Problems in FindSectLen.
+ * -3 = Problems in the unpacker library.
+ * -4 = Problems in MetaParse.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) The message is left in IS, so after a successful peek:
+ *       f_reuse = 0;
+ *       ReadGrib2Record (fp, ..., IS, subgNum, ..., &f_reuse, ...);
+ *    unpacks the grid, while the peek's f_endMsg says whether to read a new
+ *    message next time.  Call MetaFree (meta) in between.
+ * 2) meta->gridAttrib (max, min, numMiss) and meta->unitName are not set,
+ *    since they require the data.
+ *****************************************************************************
+ */
+int ReadGrib2Peek (FILE *fp, grib_MetaData *meta, IS_dataType *IS,
+                   int subgNum, double majEarth, double minEarth,
+                   int simpVer, int simpWWA, sInt4 *f_endMsg)
+{
+   long int offset;     /* Where the message started in fp. */
+   char *buff;          /* Holds the info between records. */
+   uInt4 buffLen;       /* Length of info between records. */
+   sInt4 sect0[SECT0LEN_WORD]; /* Holds the current Section 0. */
+   uInt4 gribLen;       /* Length of the current GRIB message. */
+   unsigned char *c_ipack; /* A char ptr to the message (either stored in
+                            * IS->ipack or in the memory mapped file) */
+   int ans;             /* The return value from called routines. */
+   int version;         /* Which version of GRIB is in this message. */
+   sInt4 ibitmap;       /* 0 means no bitmap returned, otherwise 1. */
+   float xmissp;        /* The primary missing value. */
+   float xmisss;        /* The secondary missing value. */
+
+   if (*f_endMsg == 1) {
+      offset = ftell (fp);
+      buff = NULL;
+      buffLen = 0;
+      if (ReadSECT0 (fp, &buff, &buffLen, -1, sect0, &gribLen,
+                     &version) < 0) {
+         preErrSprintf ("Inside ReadGrib2Peek\n");
+         free (buff);
+         return -1;
+      }
+      free (buff);
+      meta->GribVersion = version;
+      if (version != 2) {
+         fseek (fp, offset, SEEK_SET);
+         return 1;
+      }
+      /* Read (or memory map) the message, and size the IS arrays. */
+      if ((ans = ReadGrib2Msg (fp, IS, sect0, gribLen, &c_ipack)) != 0) {
+         preErrSprintf ("Inside ReadGrib2Peek\n");
+         return ans;
+      }
+   } else {
+      /* The rest of the message is either in the memory map or ipack. */
+      if (IS->mapMsg != NULL) {
+         c_ipack = IS->mapMsg;
+      } else {
+         c_ipack = (unsigned char *) IS->ipack;
+      }
+      /* GRIB2 files are in big endian so c_ipack is as well. */
+#ifdef LITTLE_ENDIAN
+      revmemcpy (&gribLen, &(c_ipack[12]), sizeof (sInt4));
+#else
+      memcpy (&gribLen, &(c_ipack[12]), sizeof (sInt4));
+#endif
+   }
+
+   unpk_g2ncepMetaOnly (1);
+   ans = UnpackGrib2Grid (IS, c_ipack, subgNum, &ibitmap, &xmissp, &xmisss,
+                          f_endMsg);
+   unpk_g2ncepMetaOnly (0);
+   if (ans != 0) {
+      return ans;
+   }
+
+   if (MetaParse (meta, IS->is[0], IS->ns[0], IS->is[1], IS->ns[1],
+                  IS->is[2], IS->ns[2], IS->rdat, IS->nrdat, IS->idat,
+                  IS->nidat, IS->is[3], IS->ns[3], IS->is[4], IS->ns[4],
+                  IS->is[5], IS->ns[5], gribLen, xmissp, xmisss, simpVer,
+                  simpWWA) != 0) {
+      preErrSprintf ("Inside ReadGrib2Peek.. Problems in MetaParse\n");
+      return -4;
+   }
+
+   if ((majEarth > 6000) && (majEarth < 7000)) {
+      if ((minEarth > 6000) && (minEarth < 7000)) {
+         meta->gds.f_sphere = 0;
+         meta->gds.majEarth = majEarth;
+         meta->gds.minEarth = minEarth;
+      } else {
+         meta->gds.f_sphere = 1;
+         meta->gds.majEarth = majEarth;
+         meta->gds.minEarth = majEarth;
+      }
+   }
+
+   Clock_Print (meta->refTime, 20, meta->pds2.refTime, "%Y%m%d%H%M", 0);
+   Clock_Print (meta->validTime, 20, meta->pds2.sect4.validTime,
+                "%Y%m%d%H%M", 0);
+   meta->deltTime = (sInt4) (meta->pds2.sect4.validTime - meta->pds2.refTime);
+   return 0;
+}
+
+/*****************************************************************************
+ * ReadGrib2CellsPrep() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   After a ReadGrib2Peek, determines if the grid can be read with
+ * ReadGrib2Cells (simple packing, and not a weather or hazard grid).  If so
+ * it sets meta->gds.scan to the scan mode ReadGrib2Record would report
+ * (the unpacker rearranges every grid to scan 0100), so the caller can find
+ * where its points fall on the grid before calling ReadGrib2Cells.
+ *
+ * ARGUMENTS
+ * meta = The meta data from ReadGrib2Peek. (Input/Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *  0 = ReadGrib2Cells can read the grid.
+ *  1 = Use ReadGrib2Record (meta is not changed).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) Keep the scan from ReadGrib2Peek, since ReadGrib2Cells needs it to
+ *    find the points in the message.
+ *****************************************************************************
+ */
+int ReadGrib2CellsPrep (grib_MetaData *meta)
+{
+   if ((meta->GribVersion != 2) || (meta->gridAttrib.packType != GS5_SIMPLE)
+       || (strcmp (meta->element, "Wx") == 0) ||
+       (strcmp (meta->element, "WWA") == 0) || (meta->gds.Nx == 0) ||
+       (meta->gds.Ny == 0) ||
+       (meta->gds.numPts != meta->gds.Nx * meta->gds.Ny)) {
+      return 1;
+   }
+   /* See TransferFloat in grib2api.c */
+   if ((meta->gds.scan & 0xf0) != GRIB2BIT_2) {
+      meta->gds.scan = GRIB2BIT_2 + (meta->gds.scan & 0x0f);
+   }
+   return 0;
+}
+
+/* A grid cell that ReadGrib2Cells is to fill in. */
+typedef struct {
+   sInt4 msgIndex;      /* Where the cell is in the message. */
+   sInt4 index;         /* Where the cell is in Grib_Data (scan 0100). */
+} grib2CellType;
+
+/*****************************************************************************
+ * Grib2CellCmp() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Compares two grib2CellType by where they are in the message (for
+ * qsort).
+ *
+ * ARGUMENTS
+ * A = The first cell. (Input)
+ * B = The second cell. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *   -1, 0, or 1 as A is before, at, or after B in the message.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int Grib2CellCmp (const void *A, const void *B)
+{
+   const grib2CellType *a = (const grib2CellType *) A;
+   const grib2CellType *b = (const grib2CellType *) B;
+
+   if (a->msgIndex < b->msgIndex) {
+      return -1;
+   }
+   return (a->msgIndex > b->msgIndex) ? 1 : 0;
+}
+
+/*****************************************************************************
+ * Grib2CellValue() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Converts an unpacked value to the user's units, as ParseGrid does
+ * (integer fields are truncated to an integer first, as the unpacker
+ * does).
+ *
+ * ARGUMENTS
+ * fieldType = 1 if the field is an integer field. (Input)
+ *       val = The unpacked value. (Input)
+ *     unitM = M in unit conversion equation y(new) = m x(orig) + b (Input)
+ *     unitB = B in unit conversion equation y(new) = m x(orig) + b (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: double
+ *   The value in the user's units.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static double Grib2CellValue (uChar fieldType, float val, double unitM,
+                              double unitB)
+{
+   sInt4 ival;          /* val as an integer field. */
+
+   if (fieldType) {
+      ival = (sInt4) val;
+      if (unitM == -10) {
+         return pow (10, ival);
+      }
+      return unitM * ival + unitB;
+   }
+   if (unitM == -10) {
+      return pow (10, val);
+   }
+   return unitM * val + unitB;
+}
+
+/*****************************************************************************
+ * ReadGrib2Cells() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   After ReadGrib2Peek and ReadGrib2CellsPrep, fills in only some of the
+ * cells of Grib_Data, rather than unpacking the whole grid as
+ * ReadGrib2Record does.  For a probe of a few points on a large grid this
+ * reads a handful of values out of section 7 (see unpk_g2ncepCells) instead
+ * of millions.  The cells get the same values (units, bitmap) that
+ * ReadGrib2Record would give them.  Other cells of Grib_Data are left as
+ * they were.
+ *
+ * ARGUMENTS
+ *       f_unit = 0 use GRIB2 units, 1 use English, 2 use metric. (Input)
+ *    Grib_Data = The grid (scan 0100), grown to Nx * Ny if needed. (Output)
+ * grib_DataLen = Size of Grib_Data. (Input/Output)
+ *         meta = The meta data from ReadGrib2Peek. (Input/Output)
+ *           IS = The IS used by ReadGrib2Peek (holds the message). (Input)
+ *      subgNum = Which sub grid of the message (0 to n-1). (Input)
+ *      msgScan = The scan mode of the grid given by ReadGrib2Peek (before
+ *                ReadGrib2CellsPrep). (Input)
+ *      numCell = Number of cells to fill in. (Input)
+ *         cell = The cells to fill in (indexes into Grib_Data). (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ *  1 = Use ReadGrib2Record (packing, bitmap, or missing value that this
+ *      doesn't handle).  meta may have been changed, so MetaRecycle it.
+ * -3 = Problems in the unpacker library.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) A simple packed grid can't have missing value management, so
+ *    ReadGrib2Record either uses 9999 as the missing value for the bitmap
+ *    (f_miss 1), or has no missing value, in which case probes use 9999
+ *    unless it is in the range of the grid.  Since only some values are
+ *    read, this uses the range the packing can represent, and returns 1 if
+ *    9999 is in it.
+ * 2) meta->gridAttrib max and min are the range the packing can represent
+ *    (see note 1), and numMiss is not counted.
+ *****************************************************************************
+ */
+int ReadGrib2Cells (sChar f_unit, double **Grib_Data, uInt4 *grib_DataLen,
+                    grib_MetaData *meta, IS_dataType *IS, int subgNum,
+                    uChar msgScan, sInt4 numCell, const sInt4 *cell)
+{
+   unsigned char *c_ipack; /* A char ptr to the message (either stored in
+                            * IS->ipack or in the memory mapped file) */
+   grib2CellType *cells; /* The cells sorted by where they are in the msg. */
+   sInt4 *msgIndex;     /* The distinct cells, in message order. */
+   float *val;          /* The unpacked values of msgIndex. */
+   sInt4 *ib;           /* The bitmap of msgIndex. */
+   sInt4 numMsg;        /* The number of distinct cells. */
+   sInt4 ibitmap;       /* 1 if the grid has a bitmap. */
+   float minVal, maxVal; /* The range the packing can represent. */
+   double unitM, unitB; /* values in y = m x + b used for unit conversion. */
+   double min, max;     /* minVal, maxVal in the user's units. */
+   double value;        /* The value of the current cell. */
+   sInt4 Nx, Ny;        /* The size of the grid. */
+   sInt4 i, j;          /* Loop counters over the cells. */
+   int ans;             /* The return value from unpk_g2ncepCells. */
+
+   Nx = meta->gds.Nx;
+   Ny = meta->gds.Ny;
+   if (IS->mapMsg != NULL) {
+      c_ipack = IS->mapMsg;
+   } else {
+      c_ipack = (unsigned char *) IS->ipack;
+   }
+
+   /* Find the cells in the message, in the order they are there. */
+   i = (numCell > 0) ? numCell : 1;
+   cells = (grib2CellType *) malloc (i * sizeof (grib2CellType));
+   msgIndex = (sInt4 *) malloc (i * sizeof (sInt4));
+   val = (float *) malloc (i * sizeof (float));
+   ib = (sInt4 *) malloc (i * sizeof (sInt4));
+   if ((cells == NULL) || (msgIndex == NULL) || (val == NULL) ||
+       (ib == NULL)) {
+      free (cells);
+      free (msgIndex);
+      free (val);
+      free (ib);
+      return 1;
+   }
+   for (i = 0; i < numCell; i++) {
+      myAssert ((cell[i] >= 0) && (cell[i] < Nx * Ny));
+      XY2ScanIndex (&(cells[i].msgIndex), cell[i] % Nx + 1, cell[i] / Nx + 1,
+                    msgScan, Nx, Ny);
+      cells[i].index = cell[i];
+   }
+   qsort (cells, numCell, sizeof (grib2CellType), Grib2CellCmp);
+   numMsg = 0;
+   for (i = 0; i < numCell; i++) {
+      if ((numMsg == 0) || (msgIndex[numMsg - 1] != cells[i].msgIndex)) {
+         msgIndex[numMsg++] = cells[i].msgIndex;
+      }
+   }
+
+   ans = unpk_g2ncepCells (c_ipack, subgNum, numMsg, msgIndex, val, ib,
+                           &ibitmap, &minVal, &maxVal);
+   if (ans != 0) {
+      free (cells);
+      free (msgIndex);
+      free (val);
+      free (ib);
+      if (ans < 0) {
+         errSprintf ("ERROR: Unpack library could not read the cells\n");
+         return -3;
+      }
+      return 1;
+   }
+
+   /* Figure out the unit conversion (as in ReadGrib2Record). */
+   Grib2UnitConvert (meta, f_unit, &unitM, &unitB);
+   min = Grib2CellValue (meta->gridAttrib.fieldType, minVal, unitM, unitB);
+   max = Grib2CellValue (meta->gridAttrib.fieldType, maxVal, unitM, unitB);
+   if (min > max) {
+      value = min;
+      min = max;
+      max = value;
+   }
+   /* See note 1. */
+   if ((!ibitmap) && (9999 >= min) && (9999 <= max)) {
+      free (cells);
+      free (msgIndex);
+      free (val);
+      free (ib);
+      return 1;
+   }
+
+   if ((uInt4) (Nx * Ny) > *grib_DataLen) {
+      *grib_DataLen = Nx * Ny;
+      *Grib_Data = (double *) realloc ((void *) (*Grib_Data),
+                                       (*grib_DataLen) * sizeof (double));
+   }
+   j = -1;
+   for (i = 0; i < numCell; i++) {
+      if ((j < 0) || (msgIndex[j] != cells[i].msgIndex)) {
+         j++;
+      }
+      if (ib[j] != 1) {
+         value = 9999;
+      } else {
+         value = Grib2CellValue (meta->gridAttrib.fieldType, val[j], unitM,
+                                 unitB);
+      }
+      (*Grib_Data)[cells[i].index] = value;
+   }
+   free (cells);
+   free (msgIndex);
+   free (val);
+   free (ib);
+
+   /* Set the attributes as ParseGrid would (see notes). */
+   if (ibitmap) {
+      meta->gridAttrib.f_miss = 1;
+      meta->gridAttrib.missPri = 9999;
+   }
+   meta->gridAttrib.f_maxmin = 1;
+   meta->gridAttrib.min = min;
+   meta->gridAttrib.max = max;
+   meta->gridAttrib.numMiss = 0;
+   return 0;
+}
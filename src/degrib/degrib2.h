@@ -37,9 +37,18 @@ typedef struct {
    sInt4 ipackLen;      /* The length of ipack. */
    sInt4 nd5;           /* Size of current GRIB message rounded up to the
                          * nearest sInt4. nd5 <= ipackLen */
+   uChar f_mmap;        /* 1 if we should try to memory map the GRIB file
+                         * instead of reading each message into ipack. */
+   void *map;           /* The memory mapped view of the current file (see
+                         * GribMapType in degrib2.c), or NULL. */
+   uChar *mapMsg;       /* If not NULL, the current message as seen in the
+                         * memory mapped file (used instead of ipack). */
+   uInt4 numSaved;      /* Number of allocations saved by reusing these
+                         * arrays for another file (see IS_Recycle). */
 } IS_dataType;
 
 void IS_Init (IS_dataType *is);
+void IS_Recycle (IS_dataType *is);
 void IS_Free (IS_dataType *is);
 
 /*
@@ -54,6 +63,12 @@ void IS_Free (IS_dataType *is);
 #define GRIB_LIMIT 300
 
 #define SECT0LEN_WORD 4
+
+/* Memory map GRIB files (POSIX mmap) rather than fread each message. */
+#if !defined(_WINDOWS_) && !defined(MS_WINDOWS)
+#define USE_MMAP
+#endif
+
 /* Possible error messages left in errSprintf() */
 int ReadSECT0 (FILE * fp, char **buff, uInt4 *buffLen, sInt4 limit,
                sInt4 sect0[SECT0LEN_WORD], uInt4 *gribLen,
@@ -66,13 +81,35 @@ int ReadGrib2Record (FILE * fp, sChar f_unit, double **Grib_Data,
                      double minEarth, int simpVer, int simpWWA, sInt4 * f_endMsg,
                      LatLon *lwlf, LatLon *uprt);
 
+int ReadGrib2RecordFlt (FILE *fp, sChar f_unit, float **Flt_Data,
+                        uInt4 *flt_DataLen, grib_MetaData *meta,
+                        IS_dataType *IS, int subgNum, double majEarth,
+                        double minEarth, int simpVer, int simpWWA,
+                        sInt4 *f_endMsg, LatLon *lwlf, LatLon *uprt,
+                        sChar decimal);
+
 int ReadGrib2RecordFast (FILE *fp, sChar f_unit, double **Grib_Data,
                          uInt4 *grib_DataLen, grib_MetaData *meta,
                          IS_dataType *IS, int subgNum, double majEarth,
                          double minEarth, int simpVer, int simpWWA,
                          sInt4 *f_endMsg, LatLon *lwlf, LatLon *uprt);
 
+/* Possible error messages left in errSprintf() */
+int ReadGrib2Peek (FILE *fp, grib_MetaData *meta, IS_dataType *IS,
+                   int subgNum, double majEarth, double minEarth,
+                   int simpVer, int simpWWA, sInt4 *f_endMsg);
+
+int ReadGrib2CellsPrep (grib_MetaData *meta);
+
+/* Possible error messages left in errSprintf() */
+int ReadGrib2Cells (sChar f_unit, double **Grib_Data, uInt4 *grib_DataLen,
+                    grib_MetaData *meta, IS_dataType *IS, int subgNum,
+                    uChar msgScan, sInt4 numCell, const sInt4 *cell);
+
 /* Possible error messages left in errSprintf() */
 int FindGRIBMsg (FILE * fp, int msg, sInt4 *offset, int *curMsg);
 
+/* Possible error messages left in errSprintf() */
+int FindGRIBOffsets (FILE *fp, fpos_t **offset, int *numMsg);
+
 #endif
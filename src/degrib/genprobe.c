@@ -35,6 +35,30 @@
 #include "memwatch.h"
 #endif
 #include "hazard.h"
+#ifndef DP_ONLY
+#include "degrib-core.h"
+#include "gidx.h"
+#endif
+
+#ifdef USE_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+/* genProbe can probe several GRIB files at once on POSIX threads. */
+#if !defined(_WINDOWS_) && !defined(MS_WINDOWS)
+#define USE_PTHREAD
+#include <pthread.h>
+#endif
+
+/* genProbeGrib only reads the cells the points need when they are fewer
+ * than 1 / GENPROBE_CELL_FRACT of the grid (see genProbeCells). */
+#define GENPROBE_CELL_FRACT 16
+
+/* 1 if genProbe should write a .gidx index of a GRIB file that is missing
+ * one, or whose index is stale (see genProbeGidx). */
+static sChar genProbeF_gidx = 0;
 
 /* *INDENT-OFF* */
 /* Problems using MISSING to denote all possible, since subcenter = Missing
@@ -1114,6 +1138,135 @@ static void getValAtPnt (sInt4 gribDataLen, const double *gribData,
 }
 #endif
 
+/* An opened data cube file.  The file is memory mapped if possible, so that
+ * each value is a memory access instead of an fseek and fread. */
+typedef struct {
+   FILE *fp;            /* The data cube file (NULL if not opened). */
+   uChar *ptr;          /* The memory mapped view of fp, or NULL. */
+   size_t len;          /* Length of ptr. */
+} cubeDataType;
+
+/*****************************************************************************
+ * cubeDataOpen() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Opens a data cube file for reading, and memory maps it if possible.
+ *
+ * ARGUMENTS
+ *     data = The opened data cube. (Output)
+ * fileName = The data cube file to open. (Input)
+ *
+ * RETURNS: int
+ *    0 = OK
+ *   -1 = Couldn't open the file.
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ *   If the file can't be mapped (USE_MMAP not defined, empty file, etc),
+ * cubeDataRead falls back to fseek and fread.
+ *****************************************************************************
+ */
+static int cubeDataOpen (cubeDataType *data, const char *fileName)
+{
+#ifdef USE_MMAP
+   struct stat stbuf;   /* Used to find the size of the file. */
+   void *ptr;           /* The return value from mmap. */
+#endif
+
+   data->ptr = NULL;
+   data->len = 0;
+   if ((data->fp = fopen (fileName, "rb")) == NULL) {
+      return -1;
+   }
+#ifdef USE_MMAP
+   if ((fstat (fileno (data->fp), &stbuf) == 0) && S_ISREG (stbuf.st_mode) &&
+       (stbuf.st_size > 0)) {
+      ptr = mmap (NULL, (size_t) stbuf.st_size, PROT_READ, MAP_PRIVATE,
+                  fileno (data->fp), 0);
+      if (ptr != MAP_FAILED) {
+         data->ptr = (uChar *) ptr;
+         data->len = (size_t) stbuf.st_size;
+      }
+   }
+#endif
+   return 0;
+}
+
+/*****************************************************************************
+ * cubeDataClose() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Closes a data cube file opened by cubeDataOpen (if it is open).
+ *
+ * ARGUMENTS
+ * data = The data cube to close. (Input/Output)
+ *
+ * RETURNS: void
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ *****************************************************************************
+ */
+static void cubeDataClose (cubeDataType *data)
+{
+#ifdef USE_MMAP
+   if (data->ptr != NULL) {
+      munmap ((void *) data->ptr, data->len);
+   }
+#endif
+   if (data->fp != NULL) {
+      fclose (data->fp);
+   }
+   data->fp = NULL;
+   data->ptr = NULL;
+   data->len = 0;
+}
+
+/*****************************************************************************
+ * cubeDataRead() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Reads one float from a data cube file.
+ *
+ * ARGUMENTS
+ *        data = The opened data cube to read from. (Input)
+ *      offset = Where the float is in the data cube file. (Input)
+ * f_bigEndian = Endian'ness of the data cube file (1=Big, 0=Lit) (Input)
+ *
+ * RETURNS: float
+ *   The value (9999 if offset is past the end of a mapped file).
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ *****************************************************************************
+ */
+static float cubeDataRead (const cubeDataType *data, sInt4 offset,
+                           uChar f_bigEndian)
+{
+   float ans = 9999;    /* The value read. */
+
+   if (data->ptr != NULL) {
+      if ((offset >= 0) && ((size_t) offset + sizeof (float) <= data->len)) {
+         if (f_bigEndian) {
+            MEMCPY_BIG (&ans, data->ptr + offset, sizeof (float));
+         } else {
+            MEMCPY_LIT (&ans, data->ptr + offset, sizeof (float));
+         }
+      }
+      return ans;
+   }
+   fseek (data->fp, offset, SEEK_SET);
+   if (f_bigEndian) {
+      FREAD_BIG (&ans, sizeof (float), 1, data->fp);
+   } else {
+      FREAD_LIT (&ans, sizeof (float), 1, data->fp);
+   }
+   return ans;
+}
+
 /*****************************************************************************
  * getCubeValAtPnt() -- Arthur Taylor / MDL
  *
@@ -1123,6 +1276,8 @@ static void getValAtPnt (sInt4 gribDataLen, const double *gribData,
  * ARGUMENTS
  *        data = The opened data cube to read from. (Input)
  *  dataOffset = The starting offset in the data cube file. (Input)
+ *     cellLen = Bytes from one cell to the next in the data cube file
+ *               (sizeof (float), or more for a time series file). (Input)
  *        scan = The scan mode of the data cube file (0 or 64) (Input)
  * f_bigEndian = Endian'ness of the data cube file (1=Big, 0=Lit) (Input)
  *         map = The current map transformation (Input)
@@ -1136,15 +1291,17 @@ static void getValAtPnt (sInt4 gribDataLen, const double *gribData,
  * RETURNS: void
  *
  *  2/2006 Arthur Taylor (MDL): Created.
+ * 10/2026 AAT: Read from the memory mapped cube (see cubeDataRead).
+ * 10/2026 AAT: Added cellLen (for time series files).
  *
  * NOTES:
  * Doesn't handle border interpolation exception for lat/lon grids.
  *****************************************************************************
  */
-static void getCubeValAtPnt (FILE *data, sInt4 dataOffset, uChar scan,
-                             uChar f_bigEndian, myMaparam *map, double pntX,
-                             double pntY, sInt4 Nx, sInt4 Ny, uChar f_interp,
-                             float *ans)
+static void getCubeValAtPnt (const cubeDataType *data, sInt4 dataOffset,
+                             sInt4 cellLen, uChar scan, uChar f_bigEndian,
+                             myMaparam *map, double pntX, double pntY,
+                             sInt4 Nx, sInt4 Ny, uChar f_interp, float *ans)
 {
    sInt4 offset;        /* Where the current data is in the data file. */
    sInt4 x1, y1;        /* f_interp=0, The nearest grid point, Otherwise
@@ -1170,16 +1327,11 @@ static void getCubeValAtPnt (FILE *data, sInt4 dataOffset, uChar scan,
 
       if (scan == 0) {
          offset = dataOffset + (((x1 - 1) + ((Ny - 1) - (y1 - 1)) * Nx) *
-                                sizeof (float));
+                                cellLen);
       } else {
-         offset = dataOffset + ((x1 - 1) + (y1 - 1) * Nx) * sizeof (float);
-      }
-      fseek (data, offset, SEEK_SET);
-      if (f_bigEndian) {
-         FREAD_BIG (ans, sizeof (float), 1, data);
-      } else {
-         FREAD_LIT (ans, sizeof (float), 1, data);
+         offset = dataOffset + ((x1 - 1) + (y1 - 1) * Nx) * cellLen;
       }
+      *ans = cubeDataRead (data, offset, f_bigEndian);
       return;
    }
 
@@ -1206,16 +1358,11 @@ static void getCubeValAtPnt (FILE *data, sInt4 dataOffset, uChar scan,
    /* Get the (1,1) corner value. */
    if (scan == 0) {
       offset = dataOffset + (((x1 - 1) + ((Ny - 1) - (y1 - 1)) * Nx) *
-                             sizeof (float));
-   } else {
-      offset = dataOffset + ((x1 - 1) + (y1 - 1) * Nx) * sizeof (float);
-   }
-   fseek (data, offset, SEEK_SET);
-   if (f_bigEndian) {
-      FREAD_BIG (&d11, sizeof (float), 1, data);
+                             cellLen);
    } else {
-      FREAD_LIT (&d11, sizeof (float), 1, data);
+      offset = dataOffset + ((x1 - 1) + (y1 - 1) * Nx) * cellLen;
    }
+   d11 = cubeDataRead (data, offset, f_bigEndian);
    if (d11 == missPri) {
       *ans = missPri;
       return;
@@ -1224,16 +1371,11 @@ static void getCubeValAtPnt (FILE *data, sInt4 dataOffset, uChar scan,
    /* Get the (1,2) corner value. */
    if (scan == 0) {
       offset = dataOffset + (((x1 - 1) + ((Ny - 1) - (y2 - 1)) * Nx) *
-                             sizeof (float));
-   } else {
-      offset = dataOffset + ((x1 - 1) + (y2 - 1) * Nx) * sizeof (float);
-   }
-   fseek (data, offset, SEEK_SET);
-   if (f_bigEndian) {
-      FREAD_BIG (&d12, sizeof (float), 1, data);
+                             cellLen);
    } else {
-      FREAD_LIT (&d12, sizeof (float), 1, data);
+      offset = dataOffset + ((x1 - 1) + (y2 - 1) * Nx) * cellLen;
    }
+   d12 = cubeDataRead (data, offset, f_bigEndian);
    if (d12 == missPri) {
       *ans = missPri;
       return;
@@ -1242,16 +1384,11 @@ static void getCubeValAtPnt (FILE *data, sInt4 dataOffset, uChar scan,
    /* Get the (2,1) corner value. */
    if (scan == 0) {
       offset = dataOffset + (((x2 - 1) + ((Ny - 1) - (y1 - 1)) * Nx) *
-                             sizeof (float));
+                             cellLen);
    } else {
-      offset = dataOffset + ((x2 - 1) + (y1 - 1) * Nx) * sizeof (float);
-   }
-   fseek (data, offset, SEEK_SET);
-   if (f_bigEndian) {
-      FREAD_BIG (&d21, sizeof (float), 1, data);
-   } else {
-      FREAD_LIT (&d21, sizeof (float), 1, data);
+      offset = dataOffset + ((x2 - 1) + (y1 - 1) * Nx) * cellLen;
    }
+   d21 = cubeDataRead (data, offset, f_bigEndian);
    if (d21 == missPri) {
       *ans = missPri;
       return;
@@ -1260,16 +1397,11 @@ static void getCubeValAtPnt (FILE *data, sInt4 dataOffset, uChar scan,
    /* Get the (2,2) corner value. */
    if (scan == 0) {
       offset = dataOffset + (((x2 - 1) + ((Ny - 1) - (y2 - 1)) * Nx) *
-                             sizeof (float));
-   } else {
-      offset = dataOffset + ((x2 - 1) + (y2 - 1) * Nx) * sizeof (float);
-   }
-   fseek (data, offset, SEEK_SET);
-   if (f_bigEndian) {
-      FREAD_BIG (&d22, sizeof (float), 1, data);
+                             cellLen);
    } else {
-      FREAD_LIT (&d22, sizeof (float), 1, data);
+      offset = dataOffset + ((x2 - 1) + (y2 - 1) * Nx) * cellLen;
    }
+   d22 = cubeDataRead (data, offset, f_bigEndian);
    if (d21 == missPri) {
       *ans = missPri;
       return;
@@ -1639,6 +1771,88 @@ static int InverseComputeUnit (int convert, const char *origName, sChar f_unit,
    return 1;
 }
 
+/* A point, and where the first cell we read for it is in a data cube. */
+typedef struct {
+   sInt4 cell;          /* The cell (in file order), or -1 if off the grid. */
+   size_t pnt;          /* Which point. */
+} cubePntType;
+
+static int cubePntCmp (const void *A, const void *B)
+{
+   const cubePntType *a = (const cubePntType *) A;
+   const cubePntType *b = (const cubePntType *) B;
+
+   if (a->cell != b->cell) {
+      return (a->cell < b->cell) ? -1 : 1;
+   }
+   return (a->pnt < b->pnt) ? -1 : (a->pnt > b->pnt);
+}
+
+/*****************************************************************************
+ * cubePntOrder() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Sorts the points by where their cells are in a data cube grid, so that
+ * genCubeFillValue reads the grid from the start of the file to the end
+ * instead of jumping back and forth.
+ *
+ * ARGUMENTS
+ *  numPnts = Number of points (Input)
+ *     pnts = The points (in grid cell units). (Input)
+ *       Nx = Number of X values in the grid (Input)
+ *       Ny = Number of Y values in the grid (Input)
+ *     scan = The scan mode of the data cube file (0 or 64) (Input)
+ * f_interp = true => bi-linear, false => nearest neighbor (Input)
+ *
+ * RETURNS: size_t *
+ *   The points in the order to visit them (caller frees), or NULL if there
+ *   are no points.
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ *   Uses the same cell as getCubeValAtPnt (the nearest one, or the (1,1)
+ * corner).  Points off the grid are first.
+ *****************************************************************************
+ */
+static size_t *cubePntOrder (size_t numPnts, const Point * pnts, sInt4 Nx,
+                             sInt4 Ny, uChar scan, uChar f_interp)
+{
+   cubePntType *list;   /* The points with their cells. */
+   size_t *order;       /* The points in the order to visit them. */
+   size_t i;            /* Loop counter over the points. */
+   sInt4 x1, y1;        /* The cell we read first for the point. */
+
+   if (numPnts == 0) {
+      return NULL;
+   }
+   list = (cubePntType *) malloc (numPnts * sizeof (cubePntType));
+   for (i = 0; i < numPnts; i++) {
+      list[i].pnt = i;
+      if (!f_interp) {
+         x1 = (sInt4) (pnts[i].X + .5);
+         y1 = (sInt4) (pnts[i].Y + .5);
+      } else {
+         x1 = (sInt4) pnts[i].X;
+         y1 = (sInt4) pnts[i].Y;
+      }
+      if ((x1 < 1) || (x1 > Nx) || (y1 < 1) || (y1 > Ny)) {
+         list[i].cell = -1;
+      } else if (scan == 0) {
+         list[i].cell = (x1 - 1) + ((Ny - 1) - (y1 - 1)) * Nx;
+      } else {
+         list[i].cell = (x1 - 1) + (y1 - 1) * Nx;
+      }
+   }
+   qsort (list, numPnts, sizeof (cubePntType), cubePntCmp);
+   order = (size_t *) malloc (numPnts * sizeof (size_t));
+   for (i = 0; i < numPnts; i++) {
+      order[i] = list[i].pnt;
+   }
+   free (list);
+   return order;
+}
+
 /*****************************************************************************
  * genCubeFillValue() -- Arthur Taylor / MDL
  *
@@ -1649,11 +1863,14 @@ static int InverseComputeUnit (int convert, const char *origName, sChar f_unit,
  * ARGUMENTS
  *        data = The opened data cube to read from. (Input)
  *  dataOffset = The starting offset in the data cube file. (Input)
+ *     cellLen = Bytes from one cell to the next in the data cube file. (In)
  *        scan = The scan mode of the data cube file (0 or 64) (Input)
  * f_bigEndian = Endian'ness of the data cube file (1=Big, 0=Lit) (Input)
  *         map = The current map transformation (Input)
  *     numPnts = Number of points (Input)
  *        pnts = The points to probe (at this point in grid cell units). (In)
+ *       order = The order to visit the points in (see cubePntOrder), or
+ *               NULL for 0..numPnts-1. (Input)
  *          Nx = Number of X values in the grid (Input)
  *          Ny = Number of Y values in the grid (Input)
  *    f_interp = true => bi-linear, false => nearest neighbor (Input)
@@ -1668,21 +1885,26 @@ static int InverseComputeUnit (int convert, const char *origName, sChar f_unit,
  * RETURNS: void
  *
  *  2/2006 Arthur Taylor (MDL): Created.
+ * 10/2026 AAT: Visit the points in file order (see cubePntOrder).
+ * 10/2026 AAT: Added cellLen (for time series files).
  *
  * NOTES:
  *****************************************************************************
  */
-static void genCubeFillValue (FILE *data, sInt4 dataOffset, uChar scan,
-                              uChar f_bigEndian, myMaparam *map,
-                              size_t numPnts, const Point * pnts, sInt4 Nx,
-                              sInt4 Ny, uChar f_interp, uChar elemEnum,
+static void genCubeFillValue (const cubeDataType *data, sInt4 dataOffset,
+                              sInt4 cellLen, uChar scan, uChar f_bigEndian,
+                              myMaparam *map, size_t numPnts,
+                              const Point * pnts, const size_t *order,
+                              sInt4 Nx, sInt4 Ny, uChar f_interp,
+                              uChar elemEnum,
                               uShort2 numTable, char **table,
                               sChar f_WxParse, sChar f_SimpleVer, 
                               sChar f_SimpleWWA, char *unitReadFromBufr, 
                               sChar f_unit, char **convertedUnit,
                               genValueType *value)
 {
-   size_t i;            /* loop counter over number of points. */
+   size_t ii;           /* loop counter over number of points. */
+   size_t i;            /* The point we are on (order[ii]). */
    float ans;           /* The current cell value. */
    uShort2 wxIndex;     /* 'value' cast to an integer for table lookup. */
    size_t j;            /* Counter used to print "english" weather. */
@@ -1762,9 +1984,10 @@ static void genCubeFillValue (FILE *data, sInt4 dataOffset, uChar scan,
       }
    } 
 
-   for (i = 0; i < numPnts; i++) {
-      getCubeValAtPnt (data, dataOffset, scan, f_bigEndian, map, pnts[i].X,
-                       pnts[i].Y, Nx, Ny, f_interp, &ans);
+   for (ii = 0; ii < numPnts; ii++) {
+      i = (order != NULL) ? order[ii] : ii;
+      getCubeValAtPnt (data, dataOffset, cellLen, scan, f_bigEndian, map,
+                       pnts[i].X, pnts[i].Y, Nx, Ny, f_interp, &ans);
 
       /* 9999 is the missing value for data cubes */
       if (ans == 9999) {
@@ -1859,6 +2082,116 @@ static void genCubeFillValue (FILE *data, sInt4 dataOffset, uChar scan,
    }
 }
 
+/*****************************************************************************
+ * genProbeCells() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Given a grid that ReadGrib2Peek has looked at, tries to read only the
+ * cells of the grid that genFillValue will look at for the given points
+ * (the nearest cell, or the 4 corners around each point), rather than
+ * unpacking the whole grid (see ReadGrib2Cells).
+ *
+ * ARGUMENTS
+ *     numPnts = Number of points (Input)
+ *        pnts = The points to probe. (Input)
+ *   f_pntType = 0 => pntX, pntY are lat/lon, 1 => they are X,Y (Input)
+ *    f_interp = true => bi-linear, false => nearest neighbor (Input)
+ *      f_unit = 0 -Unit n || 1 -Unit e || 2 -Unit m (Input)
+ *          is = The IS ReadGrib2Peek used. (Input)
+ *        meta = Meta data of the current grid from ReadGrib2Peek.
+ *               (Input/Output)
+ *     subgNum = The subgrid of the message that meta is for. (Input)
+ *    GribData = The current grid (only the cells are set). (Output)
+ * gribDataLen = Allocated length of GribData. (Input/Output)
+ *    pntCache = Where pnts fall on the grids seen so far. (Input/Output)
+ *
+ * RETURNS: int
+ *    0 = The cells were read.
+ *    1 = Use ReadGrib2Record instead (after MetaRecycle (meta)).
+ *  < 0 = Problems with the message (see ReadGrib2Cells).
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ * 1) Points needing a border interpolation of a lat/lon grid (see
+ *    BiLinearBorder) use cells all along the border, so those grids are
+ *    unpacked in full.
+ * 2) If the points use more than 1 / GENPROBE_CELL_FRACT of the grid, it
+ *    is quicker to unpack all of it.
+ *****************************************************************************
+ */
+#ifndef DP_ONLY
+static int genProbeCells (size_t numPnts, const Point * pnts,
+                          sChar f_pntType, uChar f_interp, sChar f_unit,
+                          IS_dataType *is, grib_MetaData *meta, int subgNum,
+                          double **GribData, uInt4 *gribDataLen,
+                          gridPntCacheType *pntCache)
+{
+   uChar msgScan;       /* The scan mode of the grid in the message. */
+   sInt4 Nx, Ny;        /* The size of the grid. */
+   myMaparam map;       /* The current grid's map parameter. */
+   const Point *gridPnts; /* The points in grid cell space. */
+   sInt4 *cell;         /* The cells genFillValue will look at. */
+   sInt4 numCell;       /* The number of cells. */
+   sInt4 x1, y1;        /* Nearest cell, or lower left corner of the cells
+                         * around the point. */
+   size_t i;            /* Loop counter over the points. */
+   int ans;             /* The return value from ReadGrib2Cells. */
+
+   msgScan = meta->gds.scan;
+   if (ReadGrib2CellsPrep (meta) != 0) {
+      return 1;
+   }
+   Nx = meta->gds.Nx;
+   Ny = meta->gds.Ny;
+   if (((f_interp) ? 4 : 1) * numPnts >
+       (size_t) Nx * Ny / GENPROBE_CELL_FRACT) {
+      return 1;
+   }
+   if (f_pntType == 0) {
+      if ((gridPnts = GridPntCacheFind (pntCache, &(meta->gds),
+                                        &map)) == NULL) {
+         return 1;
+      }
+   } else {
+      gridPnts = pnts;
+      SetMapParamGDS (&map, &(meta->gds));
+   }
+
+   /* Same cells as getValAtPnt. */
+   cell = (sInt4 *) malloc (((f_interp) ? 4 : 1) * numPnts * sizeof (sInt4));
+   numCell = 0;
+   for (i = 0; i < numPnts; i++) {
+      if (!f_interp) {
+         x1 = (sInt4) (gridPnts[i].X + .5);
+         y1 = (sInt4) (gridPnts[i].Y + .5);
+         if ((x1 >= 1) && (x1 <= Nx) && (y1 >= 1) && (y1 <= Ny)) {
+            cell[numCell++] = (x1 - 1) + (y1 - 1) * Nx;
+         }
+         continue;
+      }
+      x1 = (sInt4) gridPnts[i].X;
+      y1 = (sInt4) gridPnts[i].Y;
+      if ((x1 < 1) || (x1 + 1 > Nx) || (y1 < 1) || (y1 + 1 > Ny)) {
+         if (map.f_latlon) {
+            /* See note 1. */
+            free (cell);
+            return 1;
+         }
+         continue;
+      }
+      cell[numCell++] = (x1 - 1) + (y1 - 1) * Nx;
+      cell[numCell++] = (x1 - 1) + y1 * Nx;
+      cell[numCell++] = x1 + (y1 - 1) * Nx;
+      cell[numCell++] = x1 + y1 * Nx;
+   }
+   ans = ReadGrib2Cells (f_unit, GribData, gribDataLen, meta, is, subgNum,
+                         msgScan, numCell, cell);
+   free (cell);
+   return ans;
+}
+#endif
+
 /*****************************************************************************
  * genProbeGrib() -- Arthur Taylor / MDL
  *
@@ -1869,6 +2202,9 @@ static void genCubeFillValue (FILE *data, sInt4 dataOffset, uChar scan,
  *
  * ARGUMENTS
  *          fp = Opened GRIB file ready to be read. (Input)
+ *    fileName = Name of that GRIB file, used to find its .gidx index (NULL
+ *               for stdin). (Input)
+ *     f_write = 1 if we should (re)write a missing or stale index. (Input)
  *                      POINT FILTERING INFO
  *     numPnts = Number of points (Input)
  *        pnts = The points to probe. (Input)
@@ -1893,32 +2229,48 @@ static void genCubeFillValue (FILE *data, sInt4 dataOffset, uChar scan,
  *                      OUTPUT
  *    numMatch = Number of matches found. (Output)
  *       match = Matches. (Output)
+ *                      REUSED MEMORY
+ *          is = Un-parsed meta data, and memory used by the unpacker, kept
+ *               between files (see IS_Recycle). (Input/Output)
+ *        meta = Meta data of the current grid (see MetaRecycle).
+ *               (Input/Output)
+ *    GribData = The current grid. (Input/Output)
+ * gribDataLen = Allocated length of GribData. (Input/Output)
+ *    pntCache = Where pnts fall on the grids seen so far. (Input/Output)
  *
  * RETURNS: int
  *   -1 = problems reading a GRIB message
  *   -2 = problems with the Grid Definition Section.
  *
  * 12/2005 Arthur Taylor (MDL): Created.
+ * 10/2026 AAT: Use ReadGrib2Peek to skip grids before unpacking them.
+ * 10/2026 AAT: Caller owns is, meta, and GribData so they can be reused.
+ * 10/2026 AAT: Project the points once per grid (see GridPntCacheFind).
+ * 10/2026 AAT: Only read the cells the points need (see genProbeCells).
+ * 10/2026 AAT: Use the .gidx index to skip messages that are outside the
+ *        time window, and to stop before any trailing bytes.
  *
  * NOTES:
+ *   With an index, a message is skipped (without reading it) if none of
+ * its grids have an indexed valid time in the window.  This is the same
+ * valid time -I shows.  So a bad message outside the window no longer
+ * stops the probe of the rest of the file.
  *****************************************************************************
  */
 #ifndef DP_ONLY
-static int genProbeGrib (FILE *fp, size_t numPnts, const Point * pnts,
+static int genProbeGrib (FILE *fp, char *fileName, sChar f_write,
+                         size_t numPnts, const Point * pnts,
                          sChar f_pntType, size_t numElem,
                          const genElemDescript * elem, sChar f_valTime,
                          double startTime, double endTime, uChar f_interp,
                          sChar f_unit, double majEarth, double minEarth,
                          sChar f_WxParse, sChar f_SimpleVer, sChar f_SimpleWWA,
                          size_t *numMatch, genMatchType ** match,
-                         sChar f_avgInterp)
+                         sChar f_avgInterp, IS_dataType *is,
+                         grib_MetaData *meta, double **GribData,
+                         uInt4 *gribDataLen, gridPntCacheType *pntCache)
 {
-   IS_dataType is;      /* Un-parsed meta data for this GRIB2 message. As
-                         * well as some memory used by the unpacker. */
-   grib_MetaData meta;  /* The meta structure for this GRIB2 message. */
    int subgNum;         /* Subgrid in the msg that we are interested in. */
-   uInt4 gribDataLen;   /* Current length of gribData. */
-   double *gribData;    /* Holds the grid retrieved from a GRIB2 message. */
    int c;               /* Determine if end of the file without fileLen. */
    sInt4 f_lstSubGrd;   /* 1 if we read the last subGrid in a message */
    LatLon lwlf;         /* ReadGrib2Record allows subgrids.  We want entire
@@ -1935,37 +2287,91 @@ static int genProbeGrib (FILE *fp, size_t numPnts, const Point * pnts,
    char f_interest;     /* used to help determine if we've already found
                          * this match so we don't need to do it again. */
    int elemEnum;        /* The NDFD element enumeration for the read grid */
+   int ans;             /* The return value from ReadGrib2Peek, or
+                         * genProbeCells. */
+   int curSubgNum;      /* The subgrid we are currently looking at. */
+   sInt4 f_reuse;       /* 0 so ReadGrib2Record reuses the peeked message */
+   const Point *fillPnts; /* The points to fill the values with. */
+   sChar fillPntType;   /* The f_pntType of fillPnts. */
+   inventoryType *Inv = NULL; /* The grids in the file (from its index). */
+   uInt4 LenInv = 0;    /* Number of grids in Inv. */
+   int numMsg = 0;      /* Number of messages in Inv. */
+   uInt4 curInv = 0;    /* The grid in Inv we are about to read. */
+   uInt4 j;             /* Loop counter over the grids of a message. */
+   char f_want;         /* 1 if a grid of the message is in the window. */
+   char *msg;           /* Used to clear the error stack. */
 
    /* getValAtPnt does not currently allow f_pntType == 2 */
    myAssert (f_pntType != 2);
 
-   /* Initialize data and structures used when unpacking a message */
-   IS_Init (&is);
-   MetaInit (&meta);
+   /* Use the file's index if it is fresh (or f_write made it so). */
+   if (GidxInventory (fileName, f_write, 0, &Inv, &LenInv, &numMsg) != 0) {
+      msg = errSprintf (NULL);
+      free (msg);
+      GidxFree (Inv, LenInv);
+      Inv = NULL;
+      LenInv = 0;
+   }
+
+   /* The caller owns is, meta, and GribData, so that they are reused (at
+    * the size of the largest grid so far) from one file to the next. */
    f_lstSubGrd = 1;
    subgNum = 0;
    lwlf.lat = -100;
    uprt.lat = -100;
-   gribDataLen = 0;
-   gribData = NULL;
 
    /* Start loop for all messages. */
    while ((c = fgetc (fp)) != EOF) {
       ungetc (c, fp);
 
-      /* Improve this by reading the message into memory, parsing key peices
-       * out of it, and returning them to the caller.  Then if caller still
-       * interested call ReadGrib2Record to break up the message. */
-
-      /* Read the GRIB message. */
-      if (ReadGrib2Record (fp, f_unit, &gribData, &gribDataLen, &meta,
-                           &is, subgNum, majEarth, minEarth, f_SimpleVer, f_SimpleWWA,
-                           &f_lstSubGrd, &(lwlf), &(uprt)) != 0) {
-         preErrSprintf ("ERROR: In call to ReadGrib2Record.\n");
-         free (gribData);
-         IS_Free (&is);
-         MetaFree (&meta);
+      /* At the start of a message, use the index to skip to the next
+       * message with a grid in the time window. */
+      if ((Inv != NULL) && (subgNum == 0)) {
+         while (curInv < LenInv) {
+            f_want = 0;
+            for (j = curInv; (j < LenInv) &&
+                 (Inv[j].msgNum == Inv[curInv].msgNum); j++) {
+               if (!((f_valTime & 1) && (Inv[j].validTime < startTime)) &&
+                   !((f_valTime & 2) && (Inv[j].validTime > endTime))) {
+                  f_want = 1;
+               }
+            }
+            if (f_want) {
+               break;
+            }
+            curInv = j;
+         }
+         if ((curInv == LenInv) || (GidxSeek (fp, Inv[curInv].start) != 0)) {
+            break;
+         }
+      }
+      curInv++;
+
+      /* Only parse the header of GRIB2 messages, so we can skip the ones we
+       * aren't interested in without unpacking them.  ReadGrib2Peek returns
+       * 1 for GRIB1 and TDLPack, which we read in full. */
+      curSubgNum = subgNum;
+      ans = ReadGrib2Peek (fp, meta, is, subgNum, majEarth, minEarth,
+                           f_SimpleVer, f_SimpleWWA, &f_lstSubGrd);
+      if (ans == 1) {
+         ans = ReadGrib2Record (fp, f_unit, GribData, gribDataLen, meta,
+                                is, subgNum, majEarth, minEarth,
+                                f_SimpleVer, f_SimpleWWA, &f_lstSubGrd,
+                                &(lwlf), &(uprt));
+         if (ans != 0) {
+            preErrSprintf ("ERROR: In call to ReadGrib2Record.\n");
+            MetaRecycle (meta);
+            GidxFree (Inv, LenInv);
+            return -1;
+         }
+         f_reuse = 1;
+      } else if (ans != 0) {
+         preErrSprintf ("ERROR: In call to ReadGrib2Peek.\n");
+         MetaRecycle (meta);
+         GidxFree (Inv, LenInv);
          return -1;
+      } else {
+         f_reuse = 0;
       }
       if (!f_lstSubGrd) {
          subgNum++;
@@ -1974,59 +2380,56 @@ static int genProbeGrib (FILE *fp, size_t numPnts, const Point * pnts,
       }
 
       /* Check if we're interested in this data based on validTime. */
-      if (meta.GribVersion == 2) {
-         validTime = meta.pds2.sect4.validTime;
-         refTime = meta.pds2.refTime;
-      } else if (meta.GribVersion == 1) {
-         validTime = meta.pds1.validTime;
-         refTime = meta.pds1.refTime;
-      } else if (meta.GribVersion == -1) {
-         validTime = meta.pdsTdlp.refTime + meta.pdsTdlp.project;
-         refTime = meta.pdsTdlp.refTime;
+      if (meta->GribVersion == 2) {
+         validTime = meta->pds2.sect4.validTime;
+         refTime = meta->pds2.refTime;
+      } else if (meta->GribVersion == 1) {
+         validTime = meta->pds1.validTime;
+         refTime = meta->pds1.refTime;
+      } else if (meta->GribVersion == -1) {
+         validTime = meta->pdsTdlp.refTime + meta->pdsTdlp.project;
+         refTime = meta->pdsTdlp.refTime;
       } else {
-         MetaFree (&meta);
+         MetaRecycle (meta);
          continue;
       }
 
       if ((f_valTime & 1) && (validTime < startTime)) {
-         MetaFree (&meta);
+         MetaRecycle (meta);
          continue;
       }
       if ((f_valTime & 2) && (validTime > endTime)) {
-         MetaFree (&meta);
+         MetaRecycle (meta);
          continue;
       }
 
 #ifdef DEBUG
 /*
-      elemEnum = genNdfdEnum_fromMeta (&meta);
+      elemEnum = genNdfdEnum_fromMeta (meta);
       printf ("Element is entry %d\n", elemEnum);
 */
 #endif
 
       /* Check if we're interested in this data based on an element match. */
       for (i = 0; i < numElem; i++) {
-         if (genElemMatchMeta (&(elem[i]), &meta) == 1) {
+         if (genElemMatchMeta (&(elem[i]), meta) == 1) {
             break;
          }
       }
       if (i == numElem) {
-         MetaFree (&meta);
+         MetaRecycle (meta);
          continue;
       }
-      elemEnum = genNdfdEnum_fromMeta (&meta);
+      elemEnum = genNdfdEnum_fromMeta (meta);
 
       /* Check that gds is valid before setting up map projection. */
-      if ((GDSValid (&(meta.gds)) != 0) ||
-          (meta.gds.Nx * meta.gds.Ny < gribDataLen)) {
+      if (GDSValid (&(meta->gds)) != 0) {
          preErrSprintf ("ERROR: Sect3 was not Valid.\n");
-         free (gribData);
-         IS_Free (&is);
-         MetaFree (&meta);
+         MetaRecycle (meta);
+         GidxFree (Inv, LenInv);
          return -2;
       }
-      SetMapParamGDS (&map, &(meta.gds));
-      f_sector = SectorFindGDS (&(meta.gds));
+      f_sector = SectorFindGDS (&(meta->gds));
       if (f_sector == -1) {
          f_sector = NDFD_OCONUS_UNDEF;
       }
@@ -2046,9 +2449,59 @@ static int genProbeGrib (FILE *fp, size_t numPnts, const Point * pnts,
          }
       }
       if (f_interest == 0) {
-         MetaFree (&meta);
+         MetaRecycle (meta);
          continue;
       }
+
+      /* We are interested, so if we only peeked at the header, read the
+       * cells the points need, or if that isn't possible unpack the grid. */
+      if (f_reuse == 0) {
+         ans = genProbeCells (numPnts, pnts, f_pntType, f_interp, f_unit, is,
+                              meta, curSubgNum, GribData, gribDataLen,
+                              pntCache);
+         if (ans < 0) {
+            preErrSprintf ("ERROR: In call to ReadGrib2Cells.\n");
+            MetaRecycle (meta);
+            GidxFree (Inv, LenInv);
+            return -1;
+         }
+      }
+      if ((f_reuse == 0) && (ans != 0)) {
+         MetaRecycle (meta);
+         if (ReadGrib2Record (fp, f_unit, GribData, gribDataLen, meta,
+                              is, curSubgNum, majEarth, minEarth,
+                              f_SimpleVer, f_SimpleWWA, &f_reuse, &(lwlf),
+                              &(uprt)) != 0) {
+            preErrSprintf ("ERROR: In call to ReadGrib2Record.\n");
+            MetaRecycle (meta);
+            GidxFree (Inv, LenInv);
+            return -1;
+         }
+      }
+      /* GribData only grows, so it may be larger than this grid (from an
+       * earlier grid in this or an earlier file), but never smaller. */
+      if (*gribDataLen < meta->gds.Nx * meta->gds.Ny) {
+         preErrSprintf ("ERROR: Sect3 was not Valid.\n");
+         MetaRecycle (meta);
+         GidxFree (Inv, LenInv);
+         return -2;
+      }
+
+      /* Set up the map projection, and find where lat/lon points fall on
+       * the grid, reusing both if an earlier grid was the same. */
+      fillPnts = pnts;
+      fillPntType = f_pntType;
+      if (f_pntType == 0) {
+         if ((fillPnts = GridPntCacheFind (pntCache, &(meta->gds),
+                                           &map)) != NULL) {
+            fillPntType = 1;
+         } else {
+            fillPnts = pnts;
+         }
+      } else {
+         SetMapParamGDS (&map, &(meta->gds));
+      }
+
       /* Have determined that this is a good match, allocate memory */
       *numMatch = *numMatch + 1;
       *match = (genMatchType *) realloc (*match,
@@ -2058,7 +2511,7 @@ static int genProbeGrib (FILE *fp, size_t numPnts, const Point * pnts,
       /* Might try to use genElemMatchMeta info to help with the enum type.
        * Note: Can't just init the elem type since the data could be
        * NDFD_UNDEF, so we need to call setGenElem. */
-      setGenElem (&(curMatch->elem), &meta);
+      setGenElem (&(curMatch->elem), meta);
 #ifdef DEBUG
       if (curMatch->elem.ndfdEnum != elem[i].ndfdEnum) {
          printf ("%d %d\n", curMatch->elem.ndfdEnum, elem[i].ndfdEnum);
@@ -2070,35 +2523,37 @@ static int genProbeGrib (FILE *fp, size_t numPnts, const Point * pnts,
       curMatch->refTime = refTime;
       curMatch->validTime = validTime;
       curMatch->f_sector = f_sector;
-      curMatch->unit = (char *) malloc (strlen (meta.unitName) + 1);
-      strcpy (curMatch->unit, meta.unitName);
+      curMatch->unit = (char *) malloc (strlen (meta->unitName) + 1);
+      strcpy (curMatch->unit, meta->unitName);
 
       /* fill in the value structure. */
       curMatch->numValue = numPnts;
       curMatch->value = (genValueType *) malloc (numPnts * sizeof (genValueType));
-      if ((meta.GribVersion == 2) && (strcmp (meta.element, "Wx") == 0)) {
-         genFillValue (gribDataLen, gribData, &(meta.gridAttrib), &map,
-                       meta.gds.Nx, meta.gds.Ny, f_interp, &(meta.pds2.sect2.wx), NULL, f_WxParse,
-                       numPnts, pnts, f_pntType, curMatch->value,
+      if ((meta->GribVersion == 2) && (strcmp (meta->element, "Wx") == 0)) {
+         genFillValue (meta->gds.Nx * meta->gds.Ny, *GribData,
+                       &(meta->gridAttrib), &map,
+                       meta->gds.Nx, meta->gds.Ny, f_interp, &(meta->pds2.sect2.wx), NULL, f_WxParse,
+                       numPnts, fillPnts, fillPntType, curMatch->value,
                        f_avgInterp);
 
-      } else if ((meta.GribVersion == 2) && (strcmp (meta.element, "WWA") == 0)) {
-         genFillValue (gribDataLen, gribData, &(meta.gridAttrib), &map,
-                       meta.gds.Nx, meta.gds.Ny, f_interp, NULL, &(meta.pds2.sect2.hazard), f_WxParse,
-                       numPnts, pnts, f_pntType, curMatch->value,
+      } else if ((meta->GribVersion == 2) && (strcmp (meta->element, "WWA") == 0)) {
+         genFillValue (meta->gds.Nx * meta->gds.Ny, *GribData,
+                       &(meta->gridAttrib), &map,
+                       meta->gds.Nx, meta->gds.Ny, f_interp, NULL, &(meta->pds2.sect2.hazard), f_WxParse,
+                       numPnts, fillPnts, fillPntType, curMatch->value,
                        f_avgInterp);
 
       } else {
-         genFillValue (gribDataLen, gribData, &(meta.gridAttrib), &map,
-                       meta.gds.Nx, meta.gds.Ny, f_interp, NULL, NULL, f_WxParse,
-                       numPnts, pnts, f_pntType, curMatch->value,
+         genFillValue (meta->gds.Nx * meta->gds.Ny, *GribData,
+                       &(meta->gridAttrib), &map,
+                       meta->gds.Nx, meta->gds.Ny, f_interp, NULL, NULL, f_WxParse,
+                       numPnts, fillPnts, fillPntType, curMatch->value,
                        f_avgInterp);
 
       }
-      MetaFree (&meta);
+      MetaRecycle (meta);
    }
-   IS_Free (&is);
-   free (gribData);
+   GidxFree (Inv, LenInv);
    return 0;
 }
 #endif
@@ -2137,12 +2592,16 @@ static int genProbeGrib (FILE *fp, size_t numPnts, const Point * pnts,
  *                      OUTPUT
  *    numMatch = Number of matches found. (Output)
  *       match = Matches. (Output)
+ *    pntCache = Where pnts fall on the grids seen so far. (Input/Output)
  *
  * RETURNS: int
  *   -1 = problems reading a GRIB message
  *   -2 = problems with the Grid Definition Section.
  *
  *  2/2006 Arthur Taylor (MDL): Created.
+ * 10/2026 AAT: Project the points once per grid (see GridPntCacheFind).
+ * 10/2026 AAT: Memory map the data cube, and read it in file order.
+ * 10/2026 AAT: Read from the time series file if the PDS has one.
  *
  * NOTES:
  *****************************************************************************
@@ -2153,7 +2612,8 @@ static int genProbeCube (const char *filename, size_t numPnts,
                          double startTime, double endTime, uChar f_interp,
                          sChar f_unit, double majEarth, double minEarth,
                          sChar f_WxParse, uChar f_XML, sChar f_SimpleVer, sChar f_SimpleWWA,
-                         size_t *numMatch, genMatchType ** match)
+                         size_t *numMatch, genMatchType ** match,
+                         gridPntCacheType *pntCache)
 {
    char *flxArray = NULL; /* The index file in a char buffer. */
    int flxArrayLen;     /* The length of the flxArray buffer. */
@@ -2173,11 +2633,14 @@ static int genProbeCube (const char *filename, size_t numPnts,
    uShort2 subCenter;   /* The subCenter that created this data */
    uShort2 numPDS;      /* number of PDS Sections. */
    char *pdsPtr;        /* A pointer to the current PDS in the PDS array. */
+   char *thisPds;       /* The PDS that was just read. */
    int j;               /* Loop counter over PDS Array. */
    double validTime;    /* Valid time of this PDS. */
    char dataFile[256];  /* A holder for the Data file for this record. */
    char curFile[256];   /* A holder for the Current Data file. */
    sInt4 dataOffset;    /* An offset into dataFile for this record. */
+   sInt4 cellLen;       /* Bytes from one cell to the next in dataFile. */
+   uShort2 seriesLen;   /* Number of values in each cell's time series. */
    uChar f_bigEndian;   /* Endian'ness of the data grid. */
    uChar scan;          /* Scan mode for the data grid. */
    uShort2 numTable = 0; /* Number of strings in the table */
@@ -2187,12 +2650,15 @@ static int genProbeCube (const char *filename, size_t numPnts,
    int curGdsNum;       /* Which gdsNum currently in gds. */
    gdsType gds;         /* The current grid definition section. */
    myMaparam map;       /* Used to compute the grid lat/lon points. */
-   Point *gridPnts = NULL; /* Holds the converted to grid point points. */
-   size_t ii;           /* Loop counter over number of points. */
+   const Point *gridPnts = NULL; /* Holds the converted to grid point
+                         * points (owned by pntCache). */
    genMatchType *curMatch; /* The current match */
    char *dataName = NULL; /* The name of the current opened data file. */
    char *lastSlash;     /* A pointer to last slash in the index file. */
-   FILE *data = NULL;   /* A pointer to the data file. */
+   cubeDataType data;   /* The current data file. */
+   size_t *pntOrder = NULL; /* The order to visit the points in. */
+   int orderGdsNum = -1; /* Which gdsNum pntOrder is for. */
+   uChar orderScan = 0; /* Which scan mode pntOrder is for. */
    char f_sector = NDFD_OCONUS_UNDEF; /* Enumerated Sector associated with
                          * this file */
    char f_interest;     /* used to help determine if we've already found
@@ -2215,10 +2681,10 @@ static int genProbeCube (const char *filename, size_t numPnts,
    sPtr = ptr;
 
    curGdsNum = -1;
-   if (f_pntType == 0) {
-      gridPnts = (Point *) malloc (numPnts * sizeof (Point));
-   }
    curFile[0] = '\0';
+   data.fp = NULL;
+   data.ptr = NULL;
+   data.len = 0;
    if ((lastSlash = strrchr (filename, '/')) == NULL) {
       lastSlash = strrchr (filename, '\\');
    }
@@ -2254,6 +2720,7 @@ printf ("element is %d\n", elemEnum);
       }
 
       for (j = 0; j < numPDS; j++) {
+         thisPds = pdsPtr;
          ReadPDSBuff (pdsPtr, &validTime, dataFile, &dataOffset,
                       &f_bigEndian, &scan, &numTable, &table, &pdsPtr);
 
@@ -2303,26 +2770,42 @@ printf ("element is %d\n", elemEnum);
                      numTable = 0;
                      table = NULL;
                   }
-                  if (data != NULL) fclose (data);
+                  cubeDataClose (&data);
+                  free (pntOrder);
                   if (dataName != NULL) free (dataName);
-                  if (gridPnts != NULL) free (gridPnts);
                   free (flxArray);
                   return -2;
                }
-               SetMapParamGDS (&map, &gds);
                f_sector = SectorFindGDS (&gds);
                if (f_sector == -1) {
                   f_sector = NDFD_OCONUS_UNDEF;
                }
 
-               /* Get points on the grid. */
+               /* Get points on the grid (reusing them if an earlier cube
+                * was on the same grid). */
                myAssert ((f_pntType == 0) || (f_pntType == 1));
                if (f_pntType == 0) {
-                  for (ii = 0; ii < numPnts; ii++) {
-                     myCll2xy (&map, pnts[ii].Y, pnts[ii].X, &(gridPnts[ii].X),
-                               &(gridPnts[ii].Y));
+                  gridPnts = GridPntCacheFind (pntCache, &gds, &map);
+                  if ((gridPnts == NULL) && (numPnts != 0)) {
+                     errSprintf ("ERROR: Ran out of memory.\n");
+                     if (numTable != 0) {
+                        for (k = 0; k < numTable; k++) {
+                           free (table[k]);
+                        }
+                        free (table);
+                        numTable = 0;
+                        table = NULL;
+                     }
+                     cubeDataClose (&data);
+                     free (pntOrder);
+                     if (dataName != NULL) free (dataName);
+                     free (flxArray);
+                     return -2;
                   }
+               } else {
+                  SetMapParamGDS (&map, &gds);
                }
+               curGdsNum = gdsNum;
             }
 
             /* Check if this f_sector, refTime, validTime, element has already
@@ -2351,6 +2834,14 @@ printf ("element is %d\n", elemEnum);
                continue;
             }
 
+            /* Read from the point major (time series) copy if there is one,
+             * since then a point's values are next to each other. */
+            if (ReadPDSSeries (thisPds, dataFile, &dataOffset, &seriesLen)) {
+               cellLen = seriesLen * sizeof (float);
+            } else {
+               cellLen = sizeof (float);
+            }
+
             if (strcmp (curFile, dataFile) != 0) {
                if (lastSlash == NULL) {
                   dataName = (char *) realloc (dataName, strlen (dataFile) + 1);
@@ -2364,10 +2855,8 @@ printf ("element is %d\n", elemEnum);
                   strcat (dataName, dataFile);
                }
                strcpy (curFile, dataFile);
-               if (data != NULL) {
-                  fclose (data);
-               }
-               if ((data = fopen (dataName, "rb")) == NULL) {
+               cubeDataClose (&data);
+               if (cubeDataOpen (&data, dataName) != 0) {
                   errSprintf ("Problems opening %s\n", dataName);
                   if (numTable != 0) {
                      for (k = 0; k < numTable; k++) {
@@ -2377,9 +2866,9 @@ printf ("element is %d\n", elemEnum);
                      numTable = 0;
                      table = NULL;
                   }
-                  if (data != NULL) fclose (data);
+                  cubeDataClose (&data);
+                  free (pntOrder);
                   if (dataName != NULL) free (dataName);
-                  if (gridPnts != NULL) free (gridPnts);
                   free (flxArray);
                   return -2;
                }
@@ -2408,17 +2897,31 @@ printf ("element is %d\n", elemEnum);
             curMatch->numValue = numPnts;
             curMatch->value = (genValueType *) malloc (numPnts *
                                                        sizeof (genValueType));
+            /* Visit the points in the order their cells are in the file
+             * (the same for all the grids with this gds and scan). */
+            if ((orderGdsNum != gdsNum) || (orderScan != scan)) {
+               free (pntOrder);
+               pntOrder = cubePntOrder (numPnts, (f_pntType == 0) ?
+                                        gridPnts : pnts, gds.Nx, gds.Ny,
+                                        scan, f_interp);
+               orderGdsNum = gdsNum;
+               orderScan = scan;
+            }
             /* Read from data, and fill in the value. */
             if (f_pntType == 0) {
-               genCubeFillValue (data, dataOffset, scan, f_bigEndian, &map,
-                                 numPnts, gridPnts, gds.Nx, gds.Ny, f_interp,
-                                 elemEnum, numTable, table, f_WxParse,
+               genCubeFillValue (&data, dataOffset, cellLen, scan,
+                                 f_bigEndian, &map, numPnts, gridPnts,
+                                 pntOrder, gds.Nx, gds.Ny,
+                                 f_interp, elemEnum, numTable, table,
+                                 f_WxParse,
                                  f_SimpleVer, f_SimpleWWA, unit, f_unit, 
                                  &curMatch->unit, curMatch->value);
             } else {
-               genCubeFillValue (data, dataOffset, scan, f_bigEndian, &map,
-                                 numPnts, pnts, gds.Nx, gds.Ny, f_interp,
-                                 elemEnum, numTable, table, f_WxParse,
+               genCubeFillValue (&data, dataOffset, cellLen, scan,
+                                 f_bigEndian, &map, numPnts, pnts, pntOrder,
+                                 gds.Nx, gds.Ny,
+                                 f_interp, elemEnum, numTable, table,
+                                 f_WxParse,
                                  f_SimpleVer, f_SimpleWWA, unit, f_unit, 
                                  &curMatch->unit, curMatch->value);
             }
@@ -2436,19 +2939,337 @@ printf ("element is %d\n", elemEnum);
       sPtr += lenTotPds;
    }
 
-   if (data != NULL) {
-      fclose (data);
-   }
+   cubeDataClose (&data);
+   free (pntOrder);
    if (dataName != NULL) {
       free (dataName);
    }
-   if (gridPnts != NULL) {
-      free (gridPnts);
-   }
    free (flxArray);
    return 0;
 }
 
+/* Number of threads genProbe uses to probe GRIB files (see
+ * genProbeThreads). */
+static int genProbeNumThreads = 1;
+
+/*****************************************************************************
+ * genProbeThreads() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Sets how many threads genProbe uses to probe a list of GRIB files.
+ *
+ * ARGUMENTS
+ * numThreads = Number of threads (1 means probe the files one at a time on
+ *              the calling thread). (Input)
+ *
+ * RETURNS: void
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ *****************************************************************************
+ */
+void genProbeThreads (int numThreads)
+{
+   genProbeNumThreads = (numThreads < 1) ? 1 : numThreads;
+}
+
+/* 1 if genProbe should report the allocations that reusing the unpacker's
+ * memory saved (see genProbeStats). */
+static sChar genProbeF_stats = 0;
+
+/*****************************************************************************
+ * genProbeStats() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Sets whether genProbe reports (on stderr) how many allocations were
+ * saved by reusing the unpacker's memory for all the GRIB files.
+ *
+ * ARGUMENTS
+ * f_stats = 1 if genProbe should report the count (see -stats). (Input)
+ *
+ * RETURNS: void
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ *****************************************************************************
+ */
+void genProbeStats (sChar f_stats)
+{
+   genProbeF_stats = f_stats;
+}
+
+/*****************************************************************************
+ * genProbeGidx() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Sets whether genProbe writes a .gidx index for a GRIB file that is
+ * missing one, or whose index is stale.  A fresh index is always used.
+ *
+ * ARGUMENTS
+ * f_gidx = 1 if genProbe should write the index (see -gidx). (Input)
+ *
+ * RETURNS: void
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ *****************************************************************************
+ */
+void genProbeGidx (sChar f_gidx)
+{
+   genProbeF_gidx = f_gidx;
+}
+
+#if defined(USE_PTHREAD) && !defined(DP_ONLY)
+/* The data shared between genProbeGribThreads and its workers. */
+typedef struct {
+   size_t numFiles;     /* Number of GRIB files. */
+   char **fileNames;    /* The GRIB files. */
+   size_t nextFile;     /* The next file a worker should probe. */
+   pthread_mutex_t mutex; /* Guards nextFile. */
+   size_t *numMatch;    /* Number of matches found in each file. */
+   genMatchType **match; /* The matches found in each file. */
+   /* The rest are passed through to genProbeGrib. */
+   size_t numPnts;
+   const Point *pnts;
+   sChar f_pntType;
+   size_t numElem;
+   const genElemDescript *elem;
+   sChar f_valTime;
+   double startTime;
+   double endTime;
+   uChar f_interp;
+   sChar f_unit;
+   double majEarth;
+   double minEarth;
+   sChar f_WxParse;
+   sChar f_SimpleVer;
+   sChar f_SimpleWWA;
+   sChar f_avgInterp;
+   uInt4 numSaved;      /* Allocations the workers' reuse saved (guarded by
+                         * mutex). */
+} probePoolType;
+
+/*****************************************************************************
+ * genProbeGribWorker() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   The thread procedure for genProbeGribThreads.  Takes the next file that
+ * no one has probed yet, and probes it with genProbeGrib into that file's
+ * own match list, until there are no files left.
+ *
+ * ARGUMENTS
+ * arg = The probePoolType shared by the workers. (Input/Output)
+ *
+ * RETURNS: void *
+ *   NULL (a file with problems is skipped, as genProbe does)
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ *   Each worker has its own unpacker memory and point cache.
+ *   Workers use a fresh .gidx index, but don't write one, since the same
+ * file may be in the list twice.
+ *****************************************************************************
+ */
+static void *genProbeGribWorker (void *arg)
+{
+   probePoolType *pool = (probePoolType *) arg; /* The shared data. */
+   FILE *fp;            /* The file we are probing. */
+   size_t fileNum;      /* Which file we are probing. */
+   IS_dataType is;      /* Un-parsed meta data, and unpacker memory. */
+   grib_MetaData meta;  /* The meta structure for the GRIB message. */
+   uInt4 gribDataLen;   /* Current length of gribData. */
+   double *gribData;    /* Holds the grid retrieved from a GRIB message. */
+   gridPntCacheType pntCache; /* Where pnts fall on the grids seen so far. */
+   char *msg;           /* Used to clear the error stack. */
+
+   IS_Init (&is);
+   MetaInit (&meta);
+   gribDataLen = 0;
+   gribData = NULL;
+   GridPntCacheInit (&pntCache, pool->numPnts, pool->pnts);
+   for (;;) {
+      pthread_mutex_lock (&(pool->mutex));
+      fileNum = pool->nextFile++;
+      pthread_mutex_unlock (&(pool->mutex));
+      if (fileNum >= pool->numFiles) {
+         break;
+      }
+      if ((fp = fopen (pool->fileNames[fileNum], "rb")) == NULL) {
+         continue;
+      }
+      if (genProbeGrib (fp, pool->fileNames[fileNum], 0, pool->numPnts,
+                        pool->pnts, pool->f_pntType,
+                        pool->numElem, pool->elem, pool->f_valTime,
+                        pool->startTime, pool->endTime, pool->f_interp,
+                        pool->f_unit, pool->majEarth, pool->minEarth,
+                        pool->f_WxParse, pool->f_SimpleVer,
+                        pool->f_SimpleWWA, pool->numMatch + fileNum,
+                        pool->match + fileNum, pool->f_avgInterp, &is,
+                        &meta, &gribData, &gribDataLen, &pntCache) != 0) {
+         /* The error stack is per thread, so clear it before we exit. */
+         msg = errSprintf (NULL);
+#ifdef DEBUG
+         printf ("Error message was: '%s'\n", msg);
+         printf ("\nProblems with GRIB file '%s'\n",
+                 pool->fileNames[fileNum]);
+#endif
+         free (msg);
+      }
+      fclose (fp);
+      IS_Recycle (&is);
+   }
+   pthread_mutex_lock (&(pool->mutex));
+   pool->numSaved += is.numSaved + meta.numSaved;
+   pthread_mutex_unlock (&(pool->mutex));
+   GridPntCacheFree (&pntCache);
+   MetaFree (&meta);
+   IS_Free (&is);
+   free (gribData);
+   return NULL;
+}
+
+/*****************************************************************************
+ * genProbeGribThreads() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Same as calling genProbeGrib on each of the files in turn, except that
+ * genProbeNumThreads threads probe different files at the same time.  The
+ * matches are merged in file order, dropping the ones that an earlier file
+ * already found (the same test genProbeGrib uses), so the result is the same
+ * as probing the files one at a time.
+ *
+ * ARGUMENTS
+ *    numFiles = Number of GRIB files. (Input)
+ *   fileNames = The GRIB files. (Input)
+ *    numSaved = Incremented by the allocations the workers saved by reusing
+ *               their unpacker memory. (Input/Output)
+ *  (The rest are the same as genProbeGrib.)
+ *
+ * RETURNS: int
+ *   0 = OK
+ *   1 = Couldn't start any threads (nothing was probed).
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES:
+ *   1) A file that genProbeGrib has problems with still contributes the
+ *      matches it found before the problem, as it does when probed alone.
+ *   2) Each thread decodes JPEG2000 fields on its own (see
+ *      unpk_g2ncepThreads), so we don't have threads of threads.
+ *   3) A duplicate match from a later file is still decoded, and then
+ *      dropped.
+ *****************************************************************************
+ */
+static int genProbeGribThreads (size_t numFiles, char **fileNames,
+                                size_t numPnts, const Point * pnts,
+                                sChar f_pntType, size_t numElem,
+                                const genElemDescript * elem,
+                                sChar f_valTime, double startTime,
+                                double endTime, uChar f_interp, sChar f_unit,
+                                double majEarth, double minEarth,
+                                sChar f_WxParse, sChar f_SimpleVer,
+                                sChar f_SimpleWWA, size_t *numMatch,
+                                genMatchType ** match, sChar f_avgInterp,
+                                uInt4 *numSaved)
+{
+   probePoolType pool;  /* The data shared with the workers. */
+   pthread_t *threads;  /* The workers. */
+   int numThreads;      /* Number of workers to start. */
+   int numStarted;      /* Number of workers we started. */
+   size_t numPrev;      /* Number of matches from the earlier files. */
+   genMatchType *cur;   /* The match we are merging. */
+   size_t i;            /* Loop counter over the files. */
+   size_t j;            /* Loop counter over a file's matches. */
+   size_t k;            /* Loop counter over the earlier matches. */
+
+   pool.numFiles = numFiles;
+   pool.fileNames = fileNames;
+   pool.nextFile = 0;
+   pool.numMatch = (size_t *) calloc (numFiles, sizeof (size_t));
+   pool.match = (genMatchType **) calloc (numFiles, sizeof (genMatchType *));
+   pool.numPnts = numPnts;
+   pool.pnts = pnts;
+   pool.f_pntType = f_pntType;
+   pool.numElem = numElem;
+   pool.elem = elem;
+   pool.f_valTime = f_valTime;
+   pool.startTime = startTime;
+   pool.endTime = endTime;
+   pool.f_interp = f_interp;
+   pool.f_unit = f_unit;
+   pool.majEarth = majEarth;
+   pool.minEarth = minEarth;
+   pool.f_WxParse = f_WxParse;
+   pool.f_SimpleVer = f_SimpleVer;
+   pool.f_SimpleWWA = f_SimpleWWA;
+   pool.f_avgInterp = f_avgInterp;
+   pool.numSaved = 0;
+   pthread_mutex_init (&(pool.mutex), NULL);
+
+   /* Start the workers.  The files are handed out one at a time, so if we
+    * couldn't start all of them, the ones we did start do all the files. */
+   numThreads = ((size_t) genProbeNumThreads < numFiles) ?
+         genProbeNumThreads : (int) numFiles;
+   threads = (pthread_t *) malloc (numThreads * sizeof (pthread_t));
+   unpk_g2ncepThreads (1);
+   for (numStarted = 0; numStarted < numThreads; numStarted++) {
+      if (pthread_create (threads + numStarted, NULL, genProbeGribWorker,
+                          &pool) != 0) {
+         break;
+      }
+   }
+   while (numStarted > 0) {
+      pthread_join (threads[--numStarted], NULL);
+   }
+   unpk_g2ncepThreads (genProbeNumThreads);
+   free (threads);
+   pthread_mutex_destroy (&(pool.mutex));
+   *numSaved += pool.numSaved;
+   if (pool.nextFile == 0) {
+      free (pool.numMatch);
+      free (pool.match);
+      return 1;
+   }
+
+   /* Merge the matches in file order. */
+   for (i = 0; i < numFiles; i++) {
+      if (pool.numMatch[i] == 0) {
+         continue;
+      }
+      numPrev = *numMatch;
+      *match = (genMatchType *) realloc (*match, (numPrev + pool.numMatch[i])
+                                         * sizeof (genMatchType));
+      for (j = 0; j < pool.numMatch[i]; j++) {
+         cur = pool.match[i] + j;
+         if (cur->elem.ndfdEnum != NDFD_UNDEF) {
+            for (k = 0; k < numPrev; k++) {
+               if (((*match)[k].refTime == cur->refTime) &&
+                   ((*match)[k].validTime == cur->validTime) &&
+                   ((*match)[k].f_sector == cur->f_sector) &&
+                   ((*match)[k].elem.ndfdEnum == cur->elem.ndfdEnum)) {
+                  break;
+               }
+            }
+            if (k != numPrev) {
+               genMatchFree (cur);
+               continue;
+            }
+         }
+         (*match)[*numMatch] = *cur;
+         *numMatch = *numMatch + 1;
+      }
+      free (pool.match[i]);
+   }
+   free (pool.numMatch);
+   free (pool.match);
+   return 0;
+}
+#endif
+
 /*****************************************************************************
  * genProbe() -- Arthur Taylor / MDL
  *
@@ -2499,6 +3320,10 @@ printf ("element is %d\n", elemEnum);
  * 12/2005 Arthur Taylor (MDL): Created.
  *  1/2006 AAT: Modified so some matches will return values, and it will
  *         ignore bad files.
+ * 10/2026 AAT: Reuse the unpacker's memory for all the GRIB files.
+ * 10/2026 AAT: Project the points once per grid for all the files.
+ * 10/2026 AAT: Probe several GRIB files at once (see genProbeThreads).
+ * 10/2026 AAT: Report the allocations reuse saved (see genProbeStats).
  *
  * NOTES:
  *   1) May want to add a valid time list to also match.
@@ -2519,12 +3344,19 @@ int genProbe (size_t numPnts, Point * pnts, sChar f_pntType,
 {
 #ifndef DP_ONLY
    FILE *fp;
+   IS_dataType is;      /* Un-parsed meta data for this GRIB2 message. As
+                         * well as some memory used by the unpacker. */
+   grib_MetaData meta;  /* The meta structure for this GRIB2 message. */
+   uInt4 gribDataLen;   /* Current length of gribData. */
+   double *gribData;    /* Holds the grid retrieved from a GRIB2 message. */
 #endif
    char f_stdin;
    size_t i;
+   size_t numDone = 0;  /* Number of files genProbeGribThreads probed. */
 #ifdef DEBUG
    char *msg;
 #endif
+   gridPntCacheType pntCache; /* Where pnts fall on the grids seen so far. */
    size_t numOutNames;
    char **outNames;
    char f_conus2_5;     /* whether 2.5km res conus was seen in sector list. */
@@ -2640,7 +3472,33 @@ int genProbe (size_t numPnts, Point * pnts, sChar f_pntType,
    }
 #endif
 */
-   for (i = 0; i < numOutNames; i++) {
+#ifndef DP_ONLY
+   /* Initialize data and structures used when unpacking a message.  These
+    * are reused for every GRIB file, so they stay at the size of the largest
+    * grid seen, instead of being allocated and freed for each file. */
+   IS_Init (&is);
+   MetaInit (&meta);
+   gribDataLen = 0;
+   gribData = NULL;
+#endif
+   /* Lat/lon points are projected once per grid, for all the files. */
+   GridPntCacheInit (&pntCache, numPnts, pnts);
+#if defined(USE_PTHREAD) && !defined(DP_ONLY)
+   /* Probe several GRIB files at once.  The matches come back in the same
+    * order as probing them one at a time (below). */
+   if ((f_fileType == 0) && (!f_stdin) && (genProbeNumThreads > 1) &&
+       (numOutNames > 1)) {
+      if (genProbeGribThreads (numOutNames, outNames, numPnts, pnts,
+                               f_pntType, numElem, elem, f_valTime,
+                               startTime, endTime, f_interp, f_unit,
+                               majEarth, minEarth, f_WxParse, f_SimpleVer,
+                               f_SimpleWWA, numMatch, match,
+                               f_avgInterp, &(is.numSaved)) == 0) {
+         numDone = numOutNames;
+      }
+   }
+#endif
+   for (i = numDone; i < numOutNames; i++) {
 #ifndef DP_ONLY
       if (f_fileType == 0) {
          if ((i == 0) && f_stdin) {
@@ -2650,10 +3508,12 @@ int genProbe (size_t numPnts, Point * pnts, sChar f_pntType,
                continue;
             }
          }
-         if (genProbeGrib (fp, numPnts, pnts, f_pntType, numElem, elem,
+         if (genProbeGrib (fp, f_stdin ? NULL : outNames[i], genProbeF_gidx,
+                           numPnts, pnts, f_pntType, numElem, elem,
                            f_valTime, startTime, endTime, f_interp, f_unit,
                            majEarth, minEarth, f_WxParse, f_SimpleVer, f_SimpleWWA,
-                           numMatch, match, f_avgInterp) != 0) {
+                           numMatch, match, f_avgInterp, &is, &meta,
+                           &gribData, &gribDataLen, &pntCache) != 0) {
 #ifdef DEBUG
             msg = errSprintf (NULL);
             printf ("Error message was: '%s'\n", msg);
@@ -2665,18 +3525,21 @@ int genProbe (size_t numPnts, Point * pnts, sChar f_pntType,
 #endif
                fclose (fp);
             }
+            IS_Recycle (&is);
             continue;
             /* return -3; */
          }
          if (!f_stdin) {
             fclose (fp);
          }
+         IS_Recycle (&is);
       } else {
 #endif
          if (genProbeCube (outNames[i], numPnts, pnts, f_pntType, numElem,
                            elem, f_valTime, startTime, endTime, f_interp,
                            f_unit, majEarth, minEarth, f_WxParse, f_XML,
-                           f_SimpleVer, f_SimpleWWA, numMatch, match) != 0) {
+                           f_SimpleVer, f_SimpleWWA, numMatch, match,
+                           &pntCache) != 0) {
 #ifdef DEBUG
             msg = errSprintf (NULL);
             printf ("Error message was: '%s'\n", msg);
@@ -2689,6 +3552,17 @@ int genProbe (size_t numPnts, Point * pnts, sChar f_pntType,
       }
 #endif
    }
+   GridPntCacheFree (&pntCache);
+#ifndef DP_ONLY
+   if (genProbeF_stats) {
+      fprintf (stderr, "Reusing the unpacker's memory saved %lu "
+               "allocations\n",
+               (unsigned long int) (is.numSaved + meta.numSaved));
+   }
+   MetaFree (&meta);
+   IS_Free (&is);
+   free (gribData);
+#endif
 
 #ifdef DEBUG
 /*
@@ -2863,6 +3737,7 @@ static int ReadPntFile (char *pntFile, Point ** pnts, size_t *NumPnts,
  *
  * HISTORY
  *   8/2003 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Read from the time series file if the PDS has one.
  *
  * NOTES
  * May want to move some of this to a ReadPDS in database.c
@@ -2897,6 +3772,8 @@ int Grib2DataProbe (userType *usr, int numPnts, Point * pnts, char **labels,
    double validTime;    /* Valid time of this PDS. */
    char dataFile[256];  /* A holder for the Data file for this record. */
    sInt4 dataOffset;    /* An offset into dataFile for this record. */
+   sInt4 cellLen;       /* Bytes from one cell to the next in dataFile. */
+   uShort2 seriesLen;   /* Number of values in each cell's time series. */
    uChar endian;        /* Endian'ness of the data grid. */
    uChar scan;          /* Scan mode for the data grid. */
    char *gdsPtr;        /* The location of the current GDS data. */
@@ -3080,6 +3957,12 @@ int Grib2DataProbe (userType *usr, int numPnts, Point * pnts, char **labels,
                table[k][sNumBytes] = '\0';
             }
          }
+         /* Read from the point major (time series) copy if there is one. */
+         if (ReadPDSSeries (PDSptr, dataFile, &dataOffset, &seriesLen)) {
+            cellLen = seriesLen * sizeof (float);
+         } else {
+            cellLen = sizeof (float);
+         }
          if (grid_gdsIndex != gdsIndex) {
             gdsPtr = flxArray + HEADLEN + 2 + (gdsIndex - 1) * GDSLEN;
             ReadGDSBuffer (gdsPtr, &gds);
@@ -3194,10 +4077,10 @@ int Grib2DataProbe (userType *usr, int numPnts, Point * pnts, char **labels,
                   if (scan == 0) {
                      offset += (((grid_X[k] - 1) +
                                  ((gds.Ny - 1) - (grid_Y[k] - 1)) * gds.Nx) *
-                                sizeof (float));
+                                cellLen);
                   } else {
                      offset += (((grid_X[k] - 1) + (grid_Y[k] - 1) * gds.Nx) *
-                                sizeof (float));
+                                cellLen);
                   }
                   fseek (data, offset, SEEK_SET);
                   if (endian) {
@@ -3297,10 +4180,10 @@ int Grib2DataProbe (userType *usr, int numPnts, Point * pnts, char **labels,
                   if (scan == 0) {
                      offset += (((grid_X[k] - 1) +
                                  ((gds.Ny - 1) - (grid_Y[k] - 1)) * gds.Nx) *
-                                sizeof (float));
+                                cellLen);
                   } else {
                      offset += (((grid_X[k] - 1) + (grid_Y[k] - 1) * gds.Nx) *
-                                sizeof (float));
+                                cellLen);
                   }
                   fseek (data, offset, SEEK_SET);
                   if (endian) {
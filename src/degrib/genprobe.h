@@ -104,6 +104,12 @@ void genElemListInit2 (uChar varFilter[NDFD_MATCHALL + 1],
 void genMatchInit (genMatchType *match);
 void genMatchFree (genMatchType *match);
 
+void genProbeThreads (int numThreads);
+
+void genProbeStats (sChar f_stats);
+
+void genProbeGidx (sChar f_gidx);
+
 int genProbe (size_t numPnts, Point * pnts, sChar f_pntType,
               size_t numInFiles, char **inFiles, uChar f_fileType,
               uChar f_interp, sChar f_unit, double majEarth, double minEarth,
@@ -0,0 +1,839 @@
+/*****************************************************************************
+ * gidx.c
+ *
+ * DESCRIPTION
+ *    This file contains the code to read and write a ".gidx" file, which is
+ * a binary index of a GRIB file (where each message starts, how long it is,
+ * and the keys from its inventory).  With a fresh index, degrib can find a
+ * message or print an inventory without reading the GRIB file.
+ *
+ *    The index is stored next to the GRIB file as <filename>.gidx.  It is
+ * big endian, and is laid out as:
+ *    "GIDX", sInt4 GIDX_VERSION, double size, double mtime (seconds) and
+ *    sInt4 mtime (nanoseconds) of the GRIB file when the index was made,
+ *    uInt4 number of messages, uInt4 number of grids, double number of
+ *    trailing bytes after the last message (0 if none).
+ *    The message table, a fixed size entry per message: double start,
+ *    uInt4 msgLen, sChar GribVersion.
+ *    The trailing bytes warning (see below for how strings are stored).
+ *    For each grid: uShort2 msgNum, uShort2 subgNum, uInt4 gdsHash, double
+ *    refTime, double validTime, double foreSec, then element, comment,
+ *    unitName, shortFstLevel, longFstLevel as an sInt4 length (-1 for NULL)
+ *    followed by the chars.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *  10/2026 AAT: Version 2: size is a double (files over 2 GB), mtime has
+ *          nanoseconds, and gdsHash was dropped.
+ *  10/2026 AAT: Version 3: a fixed size table of messages (so GidxSeekMsg
+ *          can go straight to message N), start is a double, gdsHash is
+ *          back, and the trailing bytes warning is saved.
+ *
+ * NOTES
+ * 1) The index is "fresh" if the GRIB file has the same size and mtime as
+ *    when the index was written.  Otherwise it is ignored (or rewritten if
+ *    the user asked for -gidx).
+ * 2) msgNum is stored relative to the GRIB file (1..n) so the index is still
+ *    valid when the file is one of several on the command line.
+ * 3) A double holds the size and the message starts exactly up to 2^53
+ *    bytes.
+ * 4) gdsHash lets a caller group grids by their grid definition (section 3)
+ *    without reading the GRIB file.  It is 0 for GRIB1 and TDLPack.
+ *****************************************************************************
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "gidx.h"
+#include "tendian.h"
+#include "myerror.h"
+
+/* Change this if the layout of the index changes. */
+#define GIDX_VERSION 3
+
+/* Bytes in the header, in one entry of the message table, and in the
+ * smallest possible grid record (all five strings empty).  Used to find
+ * message N, and to check the counts against the size of the index. */
+#define GIDX_HEADLEN 44
+#define GIDX_MSGLEN 13
+#define GIDX_MINREC 52
+
+/*****************************************************************************
+ * GidxStat() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Finds the size and modification time of a file.  Unlike myStat(), the
+ * size isn't limited to an sInt4, and the time includes nanoseconds where
+ * the system provides them.
+ *
+ * ARGUMENTS
+ * filename = The file to stat. (Input)
+ *     size = The size of the file in bytes. (Output)
+ *    mtime = The modification time (seconds since 1970). (Output)
+ *     nsec = The nanoseconds part of the modification time (0 if the
+ *            system doesn't provide it). (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *  0 = OK
+ * -1 = Couldn't stat the file, or it isn't a regular file.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int GidxStat (char *filename, double *size, double *mtime,
+                     sInt4 *nsec)
+{
+   struct stat stbuf;   /* The file's status. */
+
+   if ((stat (filename, &stbuf) != 0) ||
+       ((stbuf.st_mode & S_IFMT) != S_IFREG)) {
+      return -1;
+   }
+   *size = (double) stbuf.st_size;
+   *mtime = (double) stbuf.st_mtime;
+#if defined(__APPLE__)
+   *nsec = (sInt4) stbuf.st_mtimespec.tv_nsec;
+#elif defined(__linux__) || defined(__CYGWIN__)
+   *nsec = (sInt4) stbuf.st_mtim.tv_nsec;
+#else
+   *nsec = 0;
+#endif
+   return 0;
+}
+
+/*****************************************************************************
+ * GidxName() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Creates the name of the index file for a given GRIB file.
+ *
+ * ARGUMENTS
+ * filename = The GRIB file. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: char *
+ *    The name of the index (caller should free).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static char *GidxName (char *filename)
+{
+   char *name;          /* The name of the index. */
+
+   name = (char *) malloc (strlen (filename) + 6);
+   strcpy (name, filename);
+   strcat (name, ".gidx");
+   return name;
+}
+
+/*****************************************************************************
+ * GidxWriteStr() / GidxReadStr() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Write / read a string to / from the index as an sInt4 length followed
+ * by the chars (no '\0').  A NULL string is stored as a length of -1.
+ *
+ * ARGUMENTS
+ *  fp = The opened index file. (Input)
+ * str = The string to write (GidxWriteStr). (Input)
+ *       The string that was read (GidxReadStr) (caller frees). (Output)
+ *
+ * FILES/DATABASES:
+ *    An already opened ".gidx" file.
+ *
+ * RETURNS: int
+ *  0 = OK
+ * -1 = Problems reading / writing the file.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int GidxWriteStr (FILE *fp, char *str)
+{
+   sInt4 len;           /* Length of str (or -1 if NULL). */
+
+   len = (str == NULL) ? -1 : (sInt4) strlen (str);
+   if (FWRITE_BIG (&len, sizeof (sInt4), 1, fp) != 1) {
+      return -1;
+   }
+   if ((len > 0) && (fwrite (str, sizeof (char), len, fp) != (size_t) len)) {
+      return -1;
+   }
+   return 0;
+}
+
+static int GidxReadStr (FILE *fp, char **str)
+{
+   sInt4 len;           /* Length of str (or -1 if NULL). */
+
+   *str = NULL;
+   if (FREAD_BIG (&len, sizeof (sInt4), 1, fp) != 1) {
+      return -1;
+   }
+   if (len < 0) {
+      return 0;
+   }
+   *str = (char *) malloc (len + 1);
+   if ((len > 0) && (fread (*str, sizeof (char), len, fp) != (size_t) len)) {
+      free (*str);
+      *str = NULL;
+      return -1;
+   }
+   (*str)[len] = '\0';
+   return 0;
+}
+
+/*****************************************************************************
+ * GidxWrite() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Writes the index for a GRIB file, given its inventory.
+ *
+ * ARGUMENTS
+ * filename = The GRIB file that was inventoried. (Input)
+ *      Inv = The inventory of just that file. (Input)
+ *   LenInv = Number of records in Inv. (Input)
+ *  baseMsg = How many messages were before this file (subtracted from
+ *            msgNum, so the index starts at message 1). (Input)
+ *   numMsg = Number of messages in this file. (Input)
+ * trailMsg = The trailing bytes warning (NULL if none). (Input)
+ * trailLen = Number of trailing bytes (0 if none). (Input)
+ *
+ * FILES/DATABASES:
+ *    Creates <filename>.gidx
+ *
+ * RETURNS: int
+ *  0 = OK
+ * -1 = Couldn't stat the GRIB file, a message had no grids, or couldn't
+ *      write the index.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *  10/2026 AAT: Version 2 header (see top of file).
+ *  10/2026 AAT: Version 3 (message table, gdsHash, trailing bytes), and
+ *          files over 2 GB are indexed.
+ *
+ * NOTES
+ *    On error the partial index is removed.
+ *****************************************************************************
+ */
+static int GidxWrite (char *filename, inventoryType *Inv, uInt4 LenInv,
+                      int baseMsg, int numMsg, char *trailMsg,
+                      double trailLen)
+{
+   char *name;          /* The name of the index file. */
+   FILE *fp;            /* The opened index file. */
+   double size;         /* Size of the GRIB file. */
+   double mtime;        /* Modification time of the GRIB file. */
+   sInt4 nsec;          /* Nanoseconds part of mtime. */
+   sInt4 li_temp;       /* Used to write sInt4 values. */
+   uShort2 si_temp;     /* Used to write uShort2 values. */
+   uInt4 ui_temp;       /* Used to write uInt4 values. */
+   uInt4 *first;        /* First grid of each message (LenInv if none). */
+   int msg;             /* Loop counter over the messages. */
+   uInt4 i;             /* Loop counter over the inventory. */
+   int ierr = 0;        /* Number of failed writes. */
+
+   if ((numMsg <= 0) || (GidxStat (filename, &size, &mtime, &nsec) != 0)) {
+      return -1;
+   }
+   /* Find the first grid of each message, for the message table. */
+   first = (uInt4 *) malloc (numMsg * sizeof (uInt4));
+   for (msg = 0; msg < numMsg; msg++) {
+      first[msg] = LenInv;
+   }
+   for (i = LenInv; i > 0; i--) {
+      msg = Inv[i - 1].msgNum - baseMsg - 1;
+      if ((msg >= 0) && (msg < numMsg)) {
+         first[msg] = i - 1;
+      }
+   }
+   for (msg = 0; msg < numMsg; msg++) {
+      if (first[msg] == LenInv) {
+         free (first);
+         return -1;
+      }
+   }
+   name = GidxName (filename);
+   if ((fp = fopen (name, "wb")) == NULL) {
+      free (name);
+      free (first);
+      return -1;
+   }
+   li_temp = GIDX_VERSION;
+   ierr += (fwrite ("GIDX", sizeof (char), 4, fp) != 4);
+   ierr += (FWRITE_BIG (&li_temp, sizeof (sInt4), 1, fp) != 1);
+   ierr += (FWRITE_BIG (&size, sizeof (double), 1, fp) != 1);
+   ierr += (FWRITE_BIG (&mtime, sizeof (double), 1, fp) != 1);
+   ierr += (FWRITE_BIG (&nsec, sizeof (sInt4), 1, fp) != 1);
+   ui_temp = (uInt4) numMsg;
+   ierr += (FWRITE_BIG (&ui_temp, sizeof (uInt4), 1, fp) != 1);
+   ierr += (FWRITE_BIG (&LenInv, sizeof (uInt4), 1, fp) != 1);
+   ierr += (FWRITE_BIG (&trailLen, sizeof (double), 1, fp) != 1);
+   for (msg = 0; (msg < numMsg) && (ierr == 0); msg++) {
+      i = first[msg];
+      ierr += (FWRITE_BIG (&(Inv[i].start), sizeof (double), 1, fp) != 1);
+      ierr += (FWRITE_BIG (&(Inv[i].msgLen), sizeof (uInt4), 1, fp) != 1);
+      ierr += (fwrite (&(Inv[i].GribVersion), sizeof (sChar), 1, fp) != 1);
+   }
+   free (first);
+   ierr += (GidxWriteStr (fp, trailMsg) != 0);
+   for (i = 0; (i < LenInv) && (ierr == 0); i++) {
+      si_temp = (uShort2) (Inv[i].msgNum - baseMsg);
+      ierr += (FWRITE_BIG (&si_temp, sizeof (uShort2), 1, fp) != 1);
+      si_temp = Inv[i].subgNum;
+      ierr += (FWRITE_BIG (&si_temp, sizeof (uShort2), 1, fp) != 1);
+      ierr += (FWRITE_BIG (&(Inv[i].gdsHash), sizeof (uInt4), 1, fp) != 1);
+      ierr += (FWRITE_BIG (&(Inv[i].refTime), sizeof (double), 1, fp) != 1);
+      ierr += (FWRITE_BIG (&(Inv[i].validTime), sizeof (double), 1, fp) != 1);
+      ierr += (FWRITE_BIG (&(Inv[i].foreSec), sizeof (double), 1, fp) != 1);
+      ierr += (GidxWriteStr (fp, Inv[i].element) != 0);
+      ierr += (GidxWriteStr (fp, Inv[i].comment) != 0);
+      ierr += (GidxWriteStr (fp, Inv[i].unitName) != 0);
+      ierr += (GidxWriteStr (fp, Inv[i].shortFstLevel) != 0);
+      ierr += (GidxWriteStr (fp, Inv[i].longFstLevel) != 0);
+   }
+   if (fclose (fp) != 0) {
+      ierr++;
+   }
+   if (ierr != 0) {
+      remove (name);
+      free (name);
+      return -1;
+   }
+   free (name);
+   return 0;
+}
+
+/*****************************************************************************
+ * GidxOpen() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Opens the index for a GRIB file, and reads its header, if the index is
+ * fresh.
+ *
+ * ARGUMENTS
+ * filename = The GRIB file to open the index of. (Input)
+ *   numMsg = Number of messages in the GRIB file. (Output)
+ *   numRec = Number of grids in the GRIB file. (Output)
+ * trailLen = Number of trailing bytes after the last message. (Output)
+ *     size = Size of the GRIB file. (Output)
+ *
+ * FILES/DATABASES:
+ *    Opens <filename>.gidx
+ *
+ * RETURNS: FILE *
+ *    The opened index, just past the header (at the message table), or NULL
+ * if there is no index, it is stale, or the counts don't fit in it.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created (from GidxRead).
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static FILE *GidxOpen (char *filename, uInt4 *numMsg, uInt4 *numRec,
+                       double *trailLen, double *size)
+{
+   char *name;          /* The name of the index file. */
+   FILE *fp;            /* The opened index file. */
+   char magic[4];       /* Should be "GIDX". */
+   sInt4 version;       /* Should be GIDX_VERSION. */
+   double mtime;        /* Modification time of the GRIB file (now). */
+   sInt4 nsec;          /* Nanoseconds part of mtime (now). */
+   double gidxSize;     /* Size of the GRIB file when index was made. */
+   double gidxMtime;    /* Mod time of the GRIB file when index was made. */
+   sInt4 gidxNsec;      /* Nanoseconds part of gidxMtime. */
+   double idxSize;      /* Size of the index file. */
+   double idxMtime;     /* Mod time of the index file (unused). */
+   sInt4 idxNsec;       /* Nanoseconds part of idxMtime (unused). */
+
+   if (GidxStat (filename, size, &mtime, &nsec) != 0) {
+      return NULL;
+   }
+   name = GidxName (filename);
+   if (GidxStat (name, &idxSize, &idxMtime, &idxNsec) != 0) {
+      free (name);
+      return NULL;
+   }
+   fp = fopen (name, "rb");
+   free (name);
+   if (fp == NULL) {
+      return NULL;
+   }
+   if ((fread (magic, sizeof (char), 4, fp) != 4) ||
+       (strncmp (magic, "GIDX", 4) != 0) ||
+       (FREAD_BIG (&version, sizeof (sInt4), 1, fp) != 1) ||
+       (version != GIDX_VERSION) ||
+       (FREAD_BIG (&gidxSize, sizeof (double), 1, fp) != 1) ||
+       (FREAD_BIG (&gidxMtime, sizeof (double), 1, fp) != 1) ||
+       (FREAD_BIG (&gidxNsec, sizeof (sInt4), 1, fp) != 1) ||
+       (FREAD_BIG (numMsg, sizeof (uInt4), 1, fp) != 1) ||
+       (FREAD_BIG (numRec, sizeof (uInt4), 1, fp) != 1) ||
+       (FREAD_BIG (trailLen, sizeof (double), 1, fp) != 1) ||
+       (gidxSize != *size) || (gidxMtime != mtime) || (gidxNsec != nsec) ||
+       (*numMsg == 0) || (*numRec < *numMsg) ||
+       ((double) *numMsg * GIDX_MSGLEN + (double) *numRec * GIDX_MINREC >
+        idxSize - GIDX_HEADLEN)) {
+      fclose (fp);
+      return NULL;
+   }
+   return fp;
+}
+
+/*****************************************************************************
+ * GidxRead() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Reads the index for a GRIB file (if it is fresh), appending it to an
+ * inventory list.
+ *
+ * ARGUMENTS
+ * filename = The GRIB file to read the index of. (Input)
+ *      Inv = The inventory list to append to. (Input/Output)
+ *   LenInv = Number of records in Inv. (Input/Output)
+ *   MsgNum = How many messages were before this file.  Set to that plus the
+ *            number of messages in this file. (Input/Output)
+ * trailMsg = The trailing bytes warning (NULL if none) (caller frees).
+ *            (Output)
+ * trailLen = Number of trailing bytes (0 if none). (Output)
+ *
+ * FILES/DATABASES:
+ *    Reads <filename>.gidx
+ *
+ * RETURNS: int
+ *  0 = OK
+ *  1 = There is no index, it is stale, or it is corrupt (Inv, LenInv, and
+ *      MsgNum are unchanged).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *  10/2026 AAT: Version 2 header.  Check the number of records against the
+ *          size of the index before allocating them, and check that each
+ *          message (start, msgLen) is inside the GRIB file.
+ *  10/2026 AAT: Version 3 (message table, gdsHash, trailing bytes).
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int GidxRead (char *filename, inventoryType **Inv, uInt4 *LenInv,
+                     int *MsgNum, char **trailMsg, double *trailLen)
+{
+   FILE *fp;            /* The opened index file. */
+   double size;         /* Size of the GRIB file. */
+   uInt4 numMsg;        /* Number of messages in the index. */
+   uInt4 numRec;        /* Number of records in the index. */
+   double *start;       /* Where each message starts. */
+   uInt4 *msgLen;       /* Length of each message. */
+   sChar *version;      /* GribVersion of each message. */
+   inventoryType *inv;  /* The records being read. */
+   uShort2 si_temp;     /* Used to read uShort2 values. */
+   uInt4 i;             /* Loop counter over the messages / records. */
+   uInt4 j;             /* Loop counter used to free the records. */
+   int ierr = 0;        /* Number of failed reads. */
+
+   *trailMsg = NULL;
+   if ((fp = GidxOpen (filename, &numMsg, &numRec, trailLen, &size)) ==
+       NULL) {
+      return 1;
+   }
+
+   /* Read the message table. */
+   start = (double *) malloc (numMsg * sizeof (double));
+   msgLen = (uInt4 *) malloc (numMsg * sizeof (uInt4));
+   version = (sChar *) malloc (numMsg * sizeof (sChar));
+   for (i = 0; (i < numMsg) && (ierr == 0); i++) {
+      ierr += (FREAD_BIG (start + i, sizeof (double), 1, fp) != 1);
+      ierr += (FREAD_BIG (msgLen + i, sizeof (uInt4), 1, fp) != 1);
+      ierr += (fread (version + i, sizeof (sChar), 1, fp) != 1);
+      if ((start[i] < 0) || (msgLen[i] == 0) ||
+          (start[i] + (double) msgLen[i] > size)) {
+         ierr++;
+      }
+   }
+   if (ierr == 0) {
+      ierr += (GidxReadStr (fp, trailMsg) != 0);
+   }
+   if (ierr != 0) {
+      free (start);
+      free (msgLen);
+      free (version);
+      free (*trailMsg);
+      *trailMsg = NULL;
+      fclose (fp);
+      return 1;
+   }
+
+   inv = (inventoryType *) malloc (numRec * sizeof (inventoryType));
+   for (i = 0; i < numRec; i++) {
+      inv[i].element = NULL;
+      inv[i].comment = NULL;
+      inv[i].unitName = NULL;
+      inv[i].shortFstLevel = NULL;
+      inv[i].longFstLevel = NULL;
+      ierr += (FREAD_BIG (&si_temp, sizeof (uShort2), 1, fp) != 1);
+      if ((si_temp < 1) || (si_temp > numMsg)) {
+         ierr++;
+      } else {
+         inv[i].GribVersion = version[si_temp - 1];
+         inv[i].start = start[si_temp - 1];
+         inv[i].msgLen = msgLen[si_temp - 1];
+      }
+      inv[i].msgNum = (unsigned short int) (si_temp + *MsgNum);
+      ierr += (FREAD_BIG (&si_temp, sizeof (uShort2), 1, fp) != 1);
+      inv[i].subgNum = si_temp;
+      ierr += (FREAD_BIG (&(inv[i].gdsHash), sizeof (uInt4), 1, fp) != 1);
+      ierr += (FREAD_BIG (&(inv[i].refTime), sizeof (double), 1, fp) != 1);
+      ierr += (FREAD_BIG (&(inv[i].validTime), sizeof (double), 1, fp) != 1);
+      ierr += (FREAD_BIG (&(inv[i].foreSec), sizeof (double), 1, fp) != 1);
+      ierr += (GidxReadStr (fp, &(inv[i].element)) != 0);
+      ierr += (GidxReadStr (fp, &(inv[i].comment)) != 0);
+      ierr += (GidxReadStr (fp, &(inv[i].unitName)) != 0);
+      ierr += (GidxReadStr (fp, &(inv[i].shortFstLevel)) != 0);
+      ierr += (GidxReadStr (fp, &(inv[i].longFstLevel)) != 0);
+      if (ierr != 0) {
+         /* Corrupt index, so pretend it isn't there. */
+         for (j = 0; j <= i; j++) {
+            GRIB2InventoryFree (inv + j);
+         }
+         free (inv);
+         free (start);
+         free (msgLen);
+         free (version);
+         free (*trailMsg);
+         *trailMsg = NULL;
+         fclose (fp);
+         return 1;
+      }
+   }
+   fclose (fp);
+   free (start);
+   free (msgLen);
+   free (version);
+
+   *Inv = (inventoryType *) realloc ((void *) *Inv,
+                                     (*LenInv + numRec) *
+                                     sizeof (inventoryType));
+   memcpy (*Inv + *LenInv, inv, numRec * sizeof (inventoryType));
+   free (inv);
+   *LenInv += numRec;
+   *MsgNum += numMsg;
+   return 0;
+}
+
+/*****************************************************************************
+ * GidxBuild() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Inventories a GRIB file (GRIB2InventoryCore), and writes its index.
+ *
+ * ARGUMENTS
+ * filename = The GRIB file to inventory. (Input)
+ *      Inv = The inventory list to append to. (Input/Output)
+ *   LenInv = Number of records in Inv. (Input/Output)
+ *   MsgNum = How many messages were before this file.  Set to that plus the
+ *            number of messages in this file. (Input/Output)
+ * trailMsg = The trailing bytes warning (NULL if none) (caller frees).
+ *            (Output)
+ * trailLen = Number of trailing bytes (0 if none). (Output)
+ *
+ * FILES/DATABASES:
+ *    Reads filename and writes its ".gidx".
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ * <0 = The error code from GRIB2InventoryCore.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created (from GidxInventory).
+ *
+ * NOTES
+ *    Doesn't print the trailing bytes warning, so GidxSeekMsg is as quiet
+ * as FindGRIBMsg.
+ *****************************************************************************
+ */
+static int GidxBuild (char *filename, inventoryType **Inv, uInt4 *LenInv,
+                      int *MsgNum, char **trailMsg, double *trailLen)
+{
+   uInt4 first;         /* The first record belonging to this file. */
+   int baseMsg;         /* How many messages were before this file. */
+   int ans;             /* Return value of GRIB2InventoryCore. */
+
+   first = *LenInv;
+   baseMsg = *MsgNum;
+   if ((ans = GRIB2InventoryCore (filename, Inv, LenInv, 0, MsgNum,
+                                  trailMsg, trailLen)) < 0) {
+      free (*trailMsg);
+      *trailMsg = NULL;
+      return ans;
+   }
+   GidxWrite (filename, *Inv + first, *LenInv - first, baseMsg,
+              *MsgNum - baseMsg, *trailMsg, *trailLen);
+   return 0;
+}
+
+/*****************************************************************************
+ * GidxInventory() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Inventories a GRIB file using its index.  If the index is missing or
+ * stale, and f_write is set, the file is inventoried (GRIB2Inventory) and a
+ * new index is written.
+ *
+ * ARGUMENTS
+ * filename = The GRIB file to inventory (NULL means stdin). (Input)
+ *  f_write = 1 if we should (re)write a missing or stale index. (Input)
+ *   f_warn = 1 to print the trailing bytes warning (as GRIB2Inventory
+ *            does), 0 to keep quiet (the probes). (Input)
+ *      Inv = The inventory list to append to. (Input/Output)
+ *   LenInv = Number of records in Inv. (Input/Output)
+ *   MsgNum = How many messages were before this file.  Set to that plus the
+ *            number of messages in this file. (Input/Output)
+ *
+ * FILES/DATABASES:
+ *    Reads <filename>.gidx, and may read filename and write its ".gidx".
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ *  1 = No fresh index (and f_write not set), so caller should call
+ *      GRIB2Inventory itself.
+ * <0 = The error code from GRIB2Inventory.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *  10/2026 AAT: Print (and save) the trailing bytes warning the way
+ *          GRIB2Inventory does.  Added f_warn.
+ *
+ * NOTES
+ *    If the index can't be written (read only directory, etc) the inventory
+ * is still returned.
+ *****************************************************************************
+ */
+int GidxInventory (char *filename, sChar f_write, sChar f_warn,
+                   inventoryType **Inv, uInt4 *LenInv, int *MsgNum)
+{
+   int ans;             /* Return value of GidxBuild. */
+   char *trailMsg;      /* The trailing bytes warning (or NULL). */
+   double trailLen;     /* Number of trailing bytes. */
+
+   if (filename == NULL) {
+      return 1;
+   }
+   if (GidxRead (filename, Inv, LenInv, MsgNum, &trailMsg, &trailLen) != 0) {
+      if (!f_write) {
+         return 1;
+      }
+      if ((ans = GidxBuild (filename, Inv, LenInv, MsgNum, &trailMsg,
+                            &trailLen)) < 0) {
+         return ans;
+      }
+   }
+   if (trailMsg != NULL) {
+      if (f_warn) {
+         GRIB2InventoryTrail (*MsgNum + 1, trailMsg, trailLen);
+      }
+      free (trailMsg);
+   }
+   return 0;
+}
+
+/*****************************************************************************
+ * GidxFree() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Frees an inventory list (from GidxInventory or GRIB2Inventory).
+ *
+ * ARGUMENTS
+ *    Inv = The inventory list (may be NULL). (Input)
+ * LenInv = Number of records in Inv. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+void GidxFree (inventoryType *Inv, uInt4 LenInv)
+{
+   uInt4 i;             /* Loop counter over the inventory. */
+
+   for (i = 0; i < LenInv; i++) {
+      GRIB2InventoryFree (Inv + i);
+   }
+   free (Inv);
+}
+
+/*****************************************************************************
+ * GidxSeek() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Moves a GRIB file to where a message starts (inventoryType start).
+ * The start is a double, so it is reached with steps that fit in a long int
+ * (for files over 2 GB).
+ *
+ * ARGUMENTS
+ *    fp = The opened GRIB file. (Input/Output)
+ * start = Where the message starts. (Input)
+ *
+ * FILES/DATABASES:
+ *    An already opened GRIB file.
+ *
+ * RETURNS: int
+ *  0 = OK
+ * -1 = Couldn't fseek (fp is a pipe?).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created (from GidxSeekMsg).
+ *
+ * NOTES
+ *****************************************************************************
+ */
+int GidxSeek (FILE *fp, double start)
+{
+   long int step;       /* Part of start that fits in an fseek. */
+
+   if (fseek (fp, 0L, SEEK_SET) != 0) {
+      return -1;
+   }
+   while (start > 0) {
+      step = (start > 2147483647.) ? 2147483647L : (long int) start;
+      if (fseek (fp, step, SEEK_CUR) != 0) {
+         return -1;
+      }
+      start -= step;
+   }
+   return 0;
+}
+
+/*****************************************************************************
+ * GidxSeekMsg() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Uses the index of a GRIB file to jump to a given message.  This is the
+ * same as FindGRIBMsg(), without reading each message before it.  Only the
+ * header of the index and the message's entry in the message table are
+ * read.
+ *
+ * ARGUMENTS
+ *       fp = The opened GRIB file (at its start). (Input/Output)
+ * filename = The name of that GRIB file (NULL means stdin). (Input)
+ *  f_write = 1 if we should (re)write a missing or stale index. (Input)
+ *   msgNum = The message number we are looking for. (Input)
+ *   curMsg = The number of messages before this file.  Set to msgNum if
+ *            found, or to that plus the number of messages in this file if
+ *            not. (Input/Output)
+ *
+ * FILES/DATABASES:
+ *    Reads <filename>.gidx, and may read filename and write its ".gidx".
+ *
+ * RETURNS: int
+ *  0 = OK (fp is at the start of the message)
+ *  1 = No fresh index, so caller should use FindGRIBMsg.
+ * -2 = The message is not in this file (see FindGRIBMsg).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *  10/2026 AAT: Read just the one entry of the message table, instead of
+ *          the whole inventory.  Dropped the offset argument (unused).
+ *
+ * NOTES
+ *****************************************************************************
+ */
+int GidxSeekMsg (FILE *fp, char *filename, sChar f_write, int msgNum,
+                 int *curMsg)
+{
+   FILE *idx;           /* The opened index file. */
+   uInt4 numMsg;        /* Number of messages in the index. */
+   uInt4 numRec;        /* Number of grids in the index (unused). */
+   double trailLen;     /* Number of trailing bytes (unused). */
+   double size;         /* Size of the GRIB file. */
+   double start;        /* Where the message starts. */
+   uInt4 msgLen;        /* Length of the message. */
+   inventoryType *Inv = NULL; /* Inventory used to (re)write the index. */
+   uInt4 LenInv = 0;    /* Number of records in Inv. */
+   int numInv = 0;      /* Number of messages in Inv. */
+   char *msg;           /* Used to clear the error stack. */
+   char *trailMsg;      /* The trailing bytes warning (unused). */
+
+   if (filename == NULL) {
+      return 1;
+   }
+   idx = GidxOpen (filename, &numMsg, &numRec, &trailLen, &size);
+   if ((idx == NULL) && f_write) {
+      /* Build the index, then try again. */
+      if (GidxBuild (filename, &Inv, &LenInv, &numInv, &trailMsg,
+                     &trailLen) != 0) {
+         /* Leave the error (if any) to FindGRIBMsg. */
+         msg = errSprintf (NULL);
+         free (msg);
+      }
+      free (trailMsg);
+      GidxFree (Inv, LenInv);
+      idx = GidxOpen (filename, &numMsg, &numRec, &trailLen, &size);
+   }
+   if (idx == NULL) {
+      return 1;
+   }
+   if ((msgNum <= *curMsg) || (msgNum - *curMsg > (double) numMsg)) {
+      fclose (idx);
+      *curMsg += numMsg;
+      return -2;
+   }
+   /* Read the message's entry in the message table. */
+   if ((fseek (idx, GIDX_HEADLEN + (long int) (msgNum - *curMsg - 1) *
+               GIDX_MSGLEN, SEEK_SET) != 0) ||
+       (FREAD_BIG (&start, sizeof (double), 1, idx) != 1) ||
+       (FREAD_BIG (&msgLen, sizeof (uInt4), 1, idx) != 1) ||
+       (start < 0) || (msgLen == 0) || (start + (double) msgLen > size)) {
+      fclose (idx);
+      return 1;
+   }
+   fclose (idx);
+   if (GidxSeek (fp, start) != 0) {
+      fseek (fp, 0L, SEEK_SET);
+      return 1;
+   }
+   *curMsg = msgNum;
+   return 0;
+}
@@ -0,0 +1,35 @@
+/*****************************************************************************
+ * gidx.h
+ *
+ * DESCRIPTION
+ *    This file contains the code to read and write a ".gidx" file, which is
+ * a binary index of a GRIB file (where each message starts, how long it is,
+ * and the keys from its inventory).  With a fresh index, degrib can find a
+ * message or print an inventory without reading the GRIB file.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+#ifndef GIDX_H
+#define GIDX_H
+
+#include <stdio.h>
+#include "type.h"
+#include "inventory.h"
+
+/* Possible error messages left in errSprintf() */
+int GidxInventory (char *filename, sChar f_write, sChar f_warn,
+                   inventoryType **Inv, uInt4 *LenInv, int *MsgNum);
+
+void GidxFree (inventoryType *Inv, uInt4 LenInv);
+
+int GidxSeek (FILE *fp, double start);
+
+/* Possible error messages left in errSprintf() */
+int GidxSeekMsg (FILE *fp, char *filename, sChar f_write, int msgNum,
+                 int *curMsg);
+
+#endif
@@ -0,0 +1,438 @@
+/*****************************************************************************
+ * gpbench.c
+ *
+ * DESCRIPTION
+ *    This file contains a timing driver for the grouping step of the GRIB2
+ * complex packer (pack_gp vs pack_gpmt).  It makes synthetic 2145 x 1377
+ * fields (the size of the NDFD CONUS grid), then times how long C_pkGrib2
+ * takes to pack them with 1 to N threads, and how big the messages are.
+ * The fields come from a fixed seed, so every run (and every build) packs
+ * the same values.  There is one field for each combination of:
+ *       values: smooth (temperature like), patchy with missing values
+ *               (precipitation like, missing outside an ellipse)
+ *       packing: template 5.2 (complex), 5.3 (complex + second order
+ *                spatial differences)
+ *    With 1 thread pack_gpmt is pack_gp.  Each message is read back with
+ * ReadGrib2Record to check that the decoded values are within the
+ * precision of the decimal scale factor, and that the threaded messages
+ * decode to the same values as the single threaded one.
+ *
+ *    Usage: gpbench [-k] [reps] [threads] [file]
+ *         -k = Keep the GRIB2 file (it has the messages from the last
+ *              thread count).
+ *       reps = Number of times to pack each field (default 3)
+ *    threads = Largest number of threads to try (default 4)
+ *       file = Where to write the messages to read back (default
+ *              "gpbench.grb")
+ *    Returns 0 if every message decoded as expected, 1 if not.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *    Times are wall clock seconds per pack (clock () on Windows), since
+ * CPU seconds would add up the time of all the threads.  Only the call to
+ * C_pkGrib2 is timed.
+ *****************************************************************************
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#if !defined(_WINDOWS_) && !defined(MS_WINDOWS)
+#include <sys/time.h>
+#endif
+#include "meta.h"
+#include "degrib2.h"
+#include "degrib-core.h"
+#include "myerror.h"
+
+#define BENCH_NX 2145
+#define BENCH_NY 1377
+#define BENCH_SEED 7
+#define BENCH_MISS 9999
+#define BENCH_NUMFIELD 4
+
+/*****************************************************************************
+ * BenchRand() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Returns a pseudo random number in [0, 1).
+ *
+ * ARGUMENTS
+ * seed = The state of the generator. (Input/Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: double
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Uses its own generator (rather than rand ()) so the fields are the
+ * same on every system.
+ *****************************************************************************
+ */
+static double BenchRand (uInt4 *seed)
+{
+   uInt4 val;           /* 30 random bits. */
+
+   *seed = *seed * 1103515245 + 12345;
+   val = (*seed >> 16) & 0x7fff;
+   *seed = *seed * 1103515245 + 12345;
+   val = (val << 15) | ((*seed >> 16) & 0x7fff);
+   return val / 1073741824.;
+}
+
+/*****************************************************************************
+ * BenchWall() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Returns the wall clock time in seconds.
+ *
+ * ARGUMENTS: None
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: double
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Windows falls back to clock (), which is wall clock time there.
+ *****************************************************************************
+ */
+static double BenchWall (void)
+{
+#if !defined(_WINDOWS_) && !defined(MS_WINDOWS)
+   struct timeval tv;   /* The current time. */
+
+   gettimeofday (&tv, NULL);
+   return tv.tv_sec + tv.tv_usec / 1000000.;
+#else
+   return clock () / (double) CLOCKS_PER_SEC;
+#endif
+}
+
+/*****************************************************************************
+ * MakeField() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Fills a grid with synthetic values.
+ *
+ * ARGUMENTS
+ *   data = The grid (BENCH_NX * BENCH_NY values). (Output)
+ * f_miss = 0 for a smooth field without missing values, 1 for a patchy
+ *          field which is missing outside an ellipse. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   The smooth field is stored to tenths, the patchy one to hundredths, to
+ * match the decimal scale factors used in main.
+ *****************************************************************************
+ */
+static void MakeField (double *data, int f_miss)
+{
+   uInt4 seed = BENCH_SEED; /* The state of the random generator. */
+   sInt4 x;             /* Loop counter over the columns. */
+   sInt4 y;             /* Loop counter over the rows. */
+   double dx;           /* Scaled distance from the center in x. */
+   double dy;           /* Scaled distance from the center in y. */
+   double val;          /* The value of a cell. */
+
+   for (y = 0; y < BENCH_NY; y++) {
+      for (x = 0; x < BENCH_NX; x++) {
+         if (!f_miss) {
+            val = 280 + 20 * sin (x / 150.) * cos (y / 110.) + y / 100. +
+                  BenchRand (&seed) - .5;
+            data[x + y * BENCH_NX] = floor (val * 10 + .5) / 10.;
+         } else {
+            dx = (x - BENCH_NX / 2.) / (BENCH_NX / 2.);
+            dy = (y - BENCH_NY / 2.) / (BENCH_NY / 2.);
+            if (dx * dx + dy * dy > 1) {
+               data[x + y * BENCH_NX] = BENCH_MISS;
+               continue;
+            }
+            val = 3 * sin (x / 60.) * sin (y / 45.) + BenchRand (&seed) - 1;
+            data[x + y * BENCH_NX] = (val < 0) ? 0 :
+                  floor (val * 100 + .5) / 100.;
+         }
+      }
+   }
+}
+
+/*****************************************************************************
+ * CheckMsg() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Writes a message to a file, reads it back with ReadGrib2Record, and
+ * compares the values to the field and to an earlier decode.
+ *
+ * ARGUMENTS
+ * fileName = Where to write the message. (Input)
+ *    cPack = The message. (Input)
+ *    c_len = Length of cPack. (Input)
+ *     data = The values that were packed. (Input)
+ *      tol = How far a decoded value may be from data. (Input)
+ *     prev = The values of an earlier decode, or NULL. (Input)
+ *    value = Where to put the decoded values (BENCH_NX * BENCH_NY).
+ *            (Output)
+ *
+ * FILES/DATABASES:
+ *   Writes (and reads) fileName.
+ *
+ * RETURNS: int
+ *    0 = Decoded within tol, and the same as prev.
+ *    1 = Decoded within tol, but not the same as prev.
+ *   -1 = Problems reading the message, or a value was off by more than tol.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int CheckMsg (const char *fileName, const uChar *cPack, sInt4 c_len,
+                     const double *data, double tol, const double *prev,
+                     double *value)
+{
+   FILE *fp;            /* The GRIB2 file. */
+   double *grib = NULL; /* The values read back. */
+   uInt4 gribLen = 0;   /* Length of grib. */
+   grib_MetaData meta;  /* The meta data read back. */
+   IS_dataType is;      /* Un-parsed meta data. */
+   sInt4 f_endMsg = 1;  /* 1 if we need to read the next message. */
+   LatLon lwlf;         /* Lower left of the subgrid (unused). */
+   LatLon uprt;         /* Upper right of the subgrid (unused). */
+   uInt4 i;             /* Loop counter over the values. */
+   int ierr = 0;        /* The return value. */
+   char *msg;           /* Error message. */
+
+   if ((fp = fopen (fileName, "wb")) == NULL) {
+      printf ("Problems opening %s for write\n", fileName);
+      return -1;
+   }
+   fwrite (cPack, sizeof (uChar), c_len, fp);
+   fclose (fp);
+   if ((fp = fopen (fileName, "rb")) == NULL) {
+      printf ("Problems opening %s for read\n", fileName);
+      return -1;
+   }
+   lwlf.lat = -100;
+   lwlf.lon = -100;
+   uprt.lat = -100;
+   uprt.lon = -100;
+   IS_Init (&is);
+   MetaInit (&meta);
+   if (ReadGrib2Record (fp, 0, &grib, &gribLen, &meta, &is, 0, 0, 0, 0, 0,
+                        &f_endMsg, &lwlf, &uprt) != 0) {
+      msg = errSprintf (NULL);
+      printf ("Problems reading %s (%s)\n", fileName, msg);
+      free (msg);
+      ierr = -1;
+   } else if (gribLen != BENCH_NX * BENCH_NY) {
+      printf ("Read %lu values rather than %d\n", (unsigned long int) gribLen,
+              BENCH_NX * BENCH_NY);
+      ierr = -1;
+   } else {
+      for (i = 0; i < gribLen; i++) {
+         if ((data[i] == BENCH_MISS) ? (grib[i] != BENCH_MISS) :
+             (fabs (grib[i] - data[i]) > tol)) {
+            printf ("Value %lu decoded as %f rather than %f\n",
+                    (unsigned long int) i, grib[i], data[i]);
+            ierr = -1;
+            break;
+         }
+         if ((prev != NULL) && (grib[i] != prev[i])) {
+            ierr = 1;
+         }
+         value[i] = grib[i];
+      }
+   }
+   MetaFree (&meta);
+   IS_Free (&is);
+   free (grib);
+   fclose (fp);
+   return ierr;
+}
+
+/*****************************************************************************
+ * FillMeta() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Fills in sections 0 to 4 of the encoder's meta data for the benchmark
+ * grid.
+ *
+ * ARGUMENTS
+ * en = The encoder's meta data. (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: sInt4
+ *   Length of sections 0 to 4 (and section 8), or -1 on error.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   The grid is the NDFD 2.5 km Lambert conformal CONUS grid.
+ *****************************************************************************
+ */
+static sInt4 FillMeta (enGribMeta *en)
+{
+   sInt4 len = 16 + 21; /* Section 0 and 1 (and 8). */
+   int ans;             /* Length of a section. */
+
+   fillSect0 (en, 0);
+   fillSect1 (en, 8, 0, 2, 1, 1, 2026, 10, 1, 12, 0, 0, 0, 1);
+   fillSect2 (en, NULL, 0);
+   len += 5 + en->lenSec2;
+   ans = fillSect3 (en, GS3_LAMBERT, 6371.2, 6371.2, BENCH_NX, BENCH_NY,
+                    20.191999, 238.445999, 0, 0, 2539.703, 2539.703, 8, 64,
+                    0, 0, 0, 25, 265, 25, 25, -90, 0);
+   if (ans < 0) {
+      return -1;
+   }
+   len += ans;
+   ans = fillSect4_0 (en, 0, 0, 0, 2, 0, 0, 0, 0, 1, 3600, 1, 0, 0, 255, 0,
+                      0);
+   if (ans < 0) {
+      return -1;
+   }
+   return len + ans;
+}
+
+int main (int argc, char **argv)
+{
+   static const char *fieldName[] = { "smooth", "missing" };
+   int f_keep = 0;      /* 1 if we should keep the GRIB2 file. */
+   int reps;            /* Number of times to pack each field. */
+   int maxThreads;      /* Largest number of threads to try. */
+   const char *fileName; /* Where to write the messages. */
+   enGribMeta en;       /* The encoder's meta data. */
+   sInt4 metaLen;       /* Length of sections 0 to 4 (and 8). */
+   sInt4 cgribLen;      /* Length of cPack. */
+   uChar *cPack;        /* The packed message. */
+   sInt4 c_len = 0;     /* Length of the packed message. */
+   double *data;        /* The synthetic field. */
+   double *first;       /* Values decoded from the single thread message. */
+   double *value;       /* Values decoded from a threaded message. */
+   int field;           /* Loop counter over the fields. */
+   int f_miss;          /* 1 if this field has missing values. */
+   int drsNum;          /* Data representation template (2 or 3). */
+   int numThreads;      /* Loop counter over the number of threads. */
+   int rep;             /* Loop counter over the packs. */
+   double start;        /* When the pack started. */
+   double secs;         /* Seconds spent packing. */
+   sInt4 firstLen = 0;  /* Length of the single thread message. */
+   int ans;             /* Return value of the checks. */
+   int ierr = 0;        /* Non-zero if something went wrong. */
+
+   if ((argc > 1) && (strcmp (argv[1], "-k") == 0)) {
+      f_keep = 1;
+      argc--;
+      argv++;
+   }
+   reps = (argc > 1) ? atoi (argv[1]) : 3;
+   maxThreads = (argc > 2) ? atoi (argv[2]) : 4;
+   fileName = (argc > 3) ? argv[3] : "gpbench.grb";
+   if ((reps < 1) || (maxThreads < 1)) {
+      printf ("Usage: gpbench [-k] [reps] [threads] [file]\n");
+      return 1;
+   }
+
+   initEnGribMeta (&en);
+   if ((metaLen = FillMeta (&en)) < 0) {
+      printf ("Problems filling sections 0 to 4\n");
+      freeEnGribMeta (&en);
+      return 1;
+   }
+   data = (double *) malloc (BENCH_NX * BENCH_NY * sizeof (double));
+   first = (double *) malloc (BENCH_NX * BENCH_NY * sizeof (double));
+   value = (double *) malloc (BENCH_NX * BENCH_NY * sizeof (double));
+   cgribLen = metaLen + 70 + 6 + 5 + BENCH_NX * BENCH_NY * 4;
+   cPack = (uChar *) malloc (cgribLen * sizeof (uChar));
+
+   printf ("%-8s %-3s %7s %9s %10s %8s  %s\n", "field", "drs", "threads",
+           "seconds", "bytes", "size", "decode");
+   for (field = 0; (field < BENCH_NUMFIELD) && (ierr == 0); field++) {
+      f_miss = field / 2;
+      drsNum = 2 + (field % 2);
+      MakeField (data, f_miss);
+      for (numThreads = 1; numThreads <= maxThreads; numThreads++) {
+         pk_g2ncepThreads (numThreads);
+         secs = 0;
+         for (rep = 0; rep < reps; rep++) {
+            /* The packer changes section 5, so fill it in every time. */
+            if ((fillSect5 (&en, drsNum, 0, f_miss ? 2 : 1, 0, f_miss,
+                            BENCH_MISS, BENCH_MISS, 2) < 0) ||
+                (fillGrid (&en, data, BENCH_NX * BENCH_NY, BENCH_NX,
+                           BENCH_NY, 255, 0, f_miss, BENCH_MISS,
+                           BENCH_MISS) < 0)) {
+               printf ("Problems filling section 5 to 7\n");
+               ierr = 1;
+               break;
+            }
+            start = BenchWall ();
+            c_len = C_pkGrib2 (cPack, en.sec0, en.sec1, en.sec2, en.lenSec2,
+                               en.gds, en.gdsTmpl, en.idefList, en.idefnum,
+                               en.ipdsnum, en.pdsTmpl, en.coordlist,
+                               en.numcoord, en.idrsnum, en.drsTmpl, en.fld,
+                               en.ngrdpts, en.ibmap, en.bmap);
+            secs += BenchWall () - start;
+            if (c_len < 0) {
+               printf ("Error in pkGrib2 %ld\n", (long int) c_len);
+               ierr = 1;
+               break;
+            }
+         }
+         if (ierr != 0) {
+            break;
+         }
+         if (numThreads == 1) {
+            firstLen = c_len;
+            ans = CheckMsg (fileName, cPack, c_len, data,
+                            (f_miss ? .005 : .05) + 1e-4, NULL, first);
+         } else {
+            ans = CheckMsg (fileName, cPack, c_len, data,
+                            (f_miss ? .005 : .05) + 1e-4, first, value);
+         }
+         printf ("%-8s 5.%d %7d %9.4f %10ld %+7.2f%%  %s\n",
+                 fieldName[f_miss], drsNum, numThreads, secs / reps,
+                 (long int) c_len, 100. * (c_len - firstLen) / firstLen,
+                 (ans == 0) ? "same" : ((ans == 1) ? "differs" : "bad"));
+         if (ans != 0) {
+            ierr = 1;
+         }
+      }
+   }
+   pk_g2ncepThreads (1);
+   if (!f_keep) {
+      remove (fileName);
+   }
+   free (cPack);
+   free (data);
+   free (first);
+   free (value);
+   freeEnGribMeta (&en);
+   return ierr;
+}
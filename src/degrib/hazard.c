@@ -4,6 +4,12 @@
 #include "hazard.h"
 #include "myassert.h"
 
+/* The cache of parsed hazard strings is shared by all threads. */
+#if !defined(_WINDOWS_) && !defined(MS_WINDOWS)
+#define USE_PTHREAD
+#include <pthread.h>
+#endif
+
 /*
  * Uncomment the following to have error messages sent to stdout.
  */
@@ -807,7 +813,8 @@ static void Hazard2English (HazardStringType * haz)
    }
 }
 
-void ParseHazardString (HazardStringType * haz, char *data, int simpleVer)
+static void ParseHazardStringNoCache (HazardStringType * haz, char *data,
+                                      int simpleVer)
 {
    char *start;         /* Where current phrase starts. */
    char *end;
@@ -949,6 +956,137 @@ void ParseHazardString (HazardStringType * haz, char *data, int simpleVer)
    return;
 }
 
+/* Number of hash chains in the hazard string cache (a power of 2). */
+#define HAZ_CACHE_HASH 1024
+/* Most hazard strings to keep in the cache.  Beyond this they are parsed
+ * each time. */
+#define HAZ_CACHE_MAX 16384
+
+/* A hazard string that has been parsed (see ParseHazardString). */
+typedef struct HazCacheType {
+   char *data;          /* The hazard string. */
+   int simpleVer;       /* The simple hazard table version it was parsed
+                         * with. */
+   HazardStringType haz; /* The parsed hazard string. */
+   struct HazCacheType *next; /* Next entry in the same hash chain. */
+} HazCacheType;
+
+static HazCacheType *HazCache[HAZ_CACHE_HASH];
+static int HazCacheLen = 0;
+#ifdef USE_PTHREAD
+static pthread_mutex_t HazCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/* Copies a parsed hazard string, with its own copy of the english phrases
+ * (so it can be freed with FreeHazardString). */
+static void CopyHazardString (HazardStringType * dst,
+                              const HazardStringType * src)
+{
+   int j;               /* Used to copy all the english words. */
+
+   *dst = *src;
+   for (j = 0; j < NUM_HAZARD_WORD; j++) {
+      if (src->english[j] != NULL) {
+         dst->english[j] = (char *) malloc (strlen (src->english[j]) + 1);
+         strcpy (dst->english[j], src->english[j]);
+      }
+   }
+}
+
+static unsigned int HazCacheHash (const char *data, int simpleVer)
+{
+   unsigned int hash = 5381 + simpleVer;
+
+   while (*data != '\0') {
+      hash = hash * 33 + (unsigned char) *(data++);
+   }
+   return hash & (HAZ_CACHE_HASH - 1);
+}
+
+/* Each distinct (hazard string, simpleVer) is only parsed once per run
+ * (by ParseHazardStringNoCache).  After that the answer is copied from a
+ * process wide cache, since the WWA tables repeat from grid to grid, and
+ * probes look up the same strings point after point.  Like before, it is
+ * ok for data to be modified during the parse, and the result is freed with
+ * FreeHazardString. */
+void ParseHazardString (HazardStringType * haz, char *data, int simpleVer)
+{
+   unsigned int hash;   /* Which hash chain data belongs to. */
+   HazCacheType *entry; /* An entry in the cache. */
+   HazCacheType *other; /* Used to check if another thread added it. */
+
+   hash = HazCacheHash (data, simpleVer);
+#ifdef USE_PTHREAD
+   pthread_mutex_lock (&HazCacheMutex);
+#endif
+   for (entry = HazCache[hash]; entry != NULL; entry = entry->next) {
+      if ((entry->simpleVer == simpleVer) &&
+          (strcmp (entry->data, data) == 0)) {
+         CopyHazardString (haz, &(entry->haz));
+#ifdef USE_PTHREAD
+         pthread_mutex_unlock (&HazCacheMutex);
+#endif
+         return;
+      }
+   }
+#ifdef USE_PTHREAD
+   pthread_mutex_unlock (&HazCacheMutex);
+#endif
+
+   /* Copy data before parsing it, since the parse edits it as it goes. */
+   entry = (HazCacheType *) malloc (sizeof (HazCacheType));
+   entry->data = (char *) malloc (strlen (data) + 1);
+   strcpy (entry->data, data);
+   entry->simpleVer = simpleVer;
+   ParseHazardStringNoCache (haz, data, simpleVer);
+   CopyHazardString (&(entry->haz), haz);
+
+#ifdef USE_PTHREAD
+   pthread_mutex_lock (&HazCacheMutex);
+#endif
+   if (HazCacheLen < HAZ_CACHE_MAX) {
+      for (other = HazCache[hash]; other != NULL; other = other->next) {
+         if ((other->simpleVer == simpleVer) &&
+             (strcmp (other->data, entry->data) == 0)) {
+            break;
+         }
+      }
+      if (other == NULL) {
+         entry->next = HazCache[hash];
+         HazCache[hash] = entry;
+         HazCacheLen++;
+         entry = NULL;
+      }
+   }
+#ifdef USE_PTHREAD
+   pthread_mutex_unlock (&HazCacheMutex);
+#endif
+   if (entry != NULL) {
+      FreeHazardString (&(entry->haz));
+      free (entry->data);
+      free (entry);
+   }
+}
+
+/* Frees the cache that ParseHazardString keeps.  Only call when no other
+ * thread is parsing hazard strings. */
+void FreeHazardStringCache (void)
+{
+   int i;               /* Loop counter over the hash chains. */
+   HazCacheType *entry; /* The entry to free. */
+
+   for (i = 0; i < HAZ_CACHE_HASH; i++) {
+      while (HazCache[i] != NULL) {
+         entry = HazCache[i];
+         HazCache[i] = entry->next;
+         FreeHazardString (&(entry->haz));
+         free (entry->data);
+         free (entry);
+      }
+   }
+   HazCacheLen = 0;
+}
+
 void PrintHazardString (HazardStringType * haz)
 {
    int i;               /* Used to traverse the ugly string structure. */
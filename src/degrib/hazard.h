@@ -7,6 +7,8 @@ void FreeHazardString (HazardStringType * haz);
 
 void ParseHazardString (HazardStringType * haz, char *data, int simpleVer);
 
+void FreeHazardStringCache (void);
+
 void PrintHazardString (HazardStringType * haz);
 
 #endif
@@ -303,6 +303,7 @@ double BiLinearBorder (const double *gribData, myMaparam *map, double newX,
  *  12/2002 (RY,FC,MA,&TB): Code Review.
  *   4/2004 AAT: Added call to BiLinearBorder()
  *  10/2007 AAT: Added f_avgInterp option. 
+ *  10/2026 AAT: Moved the interpolation to BiLinearComputeXY.
  *
  * NOTES
  *    Could speed this up a bit, since we know scan is GRIB2BIT_2
@@ -314,6 +315,47 @@ double BiLinearCompute (double *grib_Data, myMaparam *map, double lat,
                         double missPri, double missSec, sChar f_avgInterp)
 {
    double newX, newY;   /* The location of lat/lon on the input grid. */
+
+   myCll2xy (map, lat, lon, &newX, &newY);
+   return BiLinearComputeXY (grib_Data, map, newX, newY, Nx, Ny, f_miss,
+                             missPri, missSec, f_avgInterp);
+}
+
+/*****************************************************************************
+ * BiLinearComputeXY() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Same as BiLinearCompute, except that the point is already in grid cell
+ * space (for example from GridPntCacheFind), so no projection is needed.
+ *
+ * ARGUMENTS
+ *  grib_Data = The grib2 data to write. (Input)
+ *        map = Holds the current map projection info to interpolate from.(In)
+ * newX, newY = The point we are interested in (in grid cell space). (Input)
+ *     Nx, Ny = Dimensions of input grid (Input)
+ *     f_miss = How missing values are handled in grib_Data (Input)
+ *    missPri = The value to use for missing data. (Input)
+ *    missSec = Secondary missing value if there is one. (Input)
+ * f_avgInterp = 1 if some of corners are missing, we should dist weight
+ *               average the values, 0 return missing. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: double
+ *   Interpolated value, or "missPri" if it couldn't compute it.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Split from BiLinearCompute.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+double BiLinearComputeXY (double *grib_Data, myMaparam *map, double newX,
+                          double newY, sInt4 Nx, sInt4 Ny, uChar f_miss,
+                          double missPri, double missSec, sChar f_avgInterp)
+{
    sInt4 row;           /* The index into grib_Data for a given x,y pair
                          * using scan-mode = 0100 = GRIB2BIT_2 */
    sInt4 x1, x2, y1, y2; /* Corners of bounding box lat/lon is in. */
@@ -327,7 +369,6 @@ double BiLinearCompute (double *grib_Data, myMaparam *map, double lat,
    double dist22 = 0;   /* Distance from point to 22 cell */
    double val;          /* sum of the distance weighted values. */
 
-   myCll2xy (map, lat, lon, &newX, &newY);
    if ((newX < 1) || (newX > Nx) || (newY < 1) || (newY > Ny)) {
       if (map->f_latlon) {
          /* Find out if we can do a border interpolation. */
@@ -119,14 +119,14 @@ void GRIB2InventoryPrint (inventoryType *Inv, uInt4 LenInv)
       delta = (Inv[i].validTime - Inv[i].refTime) / 3600.;
       delta = myRound (delta, 2);
       if (Inv[i].comment == NULL) {
-         printf ("%d.%d, %ld, %d, %s, %s, %s, %s, %.2f\n",
-                 Inv[i].msgNum, Inv[i].subgNum, (long int) Inv[i].start,
+         printf ("%d.%d, %.0f, %d, %s, %s, %s, %s, %.2f\n",
+                 Inv[i].msgNum, Inv[i].subgNum, Inv[i].start,
                  Inv[i].GribVersion, Inv[i].element, Inv[i].shortFstLevel,
                  refTime, validTime, delta);
          fflush (stdout);
       } else {
-         printf ("%d.%d, %ld, %d, %s=\"%s\", %s, %s, %s, %.2f\n",
-                 Inv[i].msgNum, Inv[i].subgNum, (long int) Inv[i].start,
+         printf ("%d.%d, %.0f, %d, %s=\"%s\", %s, %s, %s, %.2f\n",
+                 Inv[i].msgNum, Inv[i].subgNum, Inv[i].start,
                  Inv[i].GribVersion, Inv[i].element, Inv[i].comment,
                  Inv[i].shortFstLevel, refTime, validTime, delta);
          fflush (stdout);
@@ -351,6 +351,42 @@ static int GRIB2SectJump (FILE *fp, sInt4 gribLen, sChar *sect, uInt4 *secLen)
    return 0;
 }
 
+/*****************************************************************************
+ * InventoryHash() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *    Computes a 32 bit FNV-1a hash of a buffer.  Used to summarize the grid
+ * definition section, so grids can be compared without unpacking them.
+ *
+ * ARGUMENTS
+ *    buff = The bytes to hash. (Input)
+ * buffLen = Number of bytes in buff. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: uInt4
+ *    The hash (never 0, so 0 can mean "no grid definition").
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static uInt4 InventoryHash (char *buff, uInt4 buffLen)
+{
+   uInt4 hash = 2166136261UL; /* FNV offset basis. */
+   uInt4 i;             /* Loop counter over the buffer. */
+
+   for (i = 0; i < buffLen; i++) {
+      hash ^= (uChar) buff[i];
+      hash *= 16777619UL;
+   }
+   return (hash == 0) ? 1 : hash;
+}
+
 /*****************************************************************************
  * GRIB2Inventory2to7() --
  *
@@ -390,6 +426,8 @@ static int GRIB2SectJump (FILE *fp, sInt4 gribLen, sChar *sect, uInt4 *secLen)
  *          inventoryType structure.
  *   8/2003 AAT: curTot no longer serves a purpose.
  *   1/2004 AAT: Added center/subcenter.
+ *  10/2026 AAT: Read section 3 (instead of jumping past it) to fill in
+ *          inv->gdsHash.
  *
  * NOTES
  *****************************************************************************
@@ -437,23 +475,30 @@ static int GRIB2Inventory2to7 (sChar sectNum, FILE *fp, sInt4 gribLen,
    sChar percentile = 0;
 
    if ((sectNum == 2) || (sectNum == 3)) {
-      /* Jump past section (2 or 3). */
-      sectNum = -1;
-      if (GRIB2SectJump (fp, gribLen, &sectNum, &secLen) != 0) {
-         errSprintf ("ERROR: Problems Jumping past section 2 || 3\n");
-         return -6;
-      }
-      if ((sectNum != 2) && (sectNum != 3)) {
-         errSprintf ("ERROR: Section 2 or 3 miss-labeled\n");
-         return -5;
-      } else if (sectNum == 2) {
-         /* Jump past section 3. */
-         sectNum = 3;
+      /* Jump past section 2 (if it is there), and read section 3 so we can
+       * hash it. */
+      if (sectNum == 2) {
+         sectNum = -1;
          if (GRIB2SectJump (fp, gribLen, &sectNum, &secLen) != 0) {
-            errSprintf ("ERROR: Problems Jumping past section 3\n");
+            errSprintf ("ERROR: Problems Jumping past section 2 || 3\n");
             return -6;
          }
+         if ((sectNum != 2) && (sectNum != 3)) {
+            errSprintf ("ERROR: Section 2 or 3 miss-labeled\n");
+            return -5;
+         }
+         if (sectNum == 3) {
+            /* No section 2, so back up and read section 3. */
+            fseek (fp, -1 * (long int) secLen, SEEK_CUR);
+         }
+      }
+      sectNum = 3;
+      if (GRIB2SectToBuffer (fp, gribLen, &sectNum, &secLen, buffLen,
+                             buffer) != 0) {
+         errSprintf ("ERROR: Problems with section 3\n");
+         return -6;
       }
+      inv->gdsHash = InventoryHash (*buffer, secLen - 4);
    }
    /* Read section 4 into buffer. */
    sectNum = 4;
@@ -776,6 +821,86 @@ enum { GS4_ANALYSIS, GS4_ENSEMBLE, GS4_DERIVED, GS4_PROBABIL_PNT = 5,
    return 0;
 }
 
+/*****************************************************************************
+ * GRIB2InventoryTrail() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Prints the warning GRIB2Inventory gives when there are bytes after the
+ * last message in a file which aren't a GRIB message.
+ *
+ * ARGUMENTS
+ *   msgNum = The message number where the GRIB message wasn't found. (Input)
+ *      msg = Why it wasn't found (from errSprintf()). (Input)
+ * trailLen = Number of bytes after the last message. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created (from GRIB2Inventory), so the .gidx
+ *          index can give the same warning.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+void GRIB2InventoryTrail (int msgNum, const char *msg, double trailLen)
+{
+   printf ("Warning: Inside GRIB2Inventory, Message # %ld\n",
+           (long int) msgNum);
+   printf ("%s", msg);
+   printf ("There were %.0f trailing bytes in the file.\n", trailLen);
+}
+
+/*****************************************************************************
+ * InventoryJump() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Moves the file to the start of the next message, given where the
+ * current one started and how long it is.  Seeks relative to the start of
+ * the message, so it works when the offset is past what a long int holds.
+ *
+ * ARGUMENTS
+ *     fp = The opened GRIB file. (Input/Output)
+ * msgPos = Where the current message started (from fgetpos). (Input)
+ * f_pos  = 1 if msgPos is valid, 0 if fgetpos failed. (Input)
+ * offset = Where the next message starts. (Used if f_pos is 0) (Input)
+ *   jump = Length of the current message. (Input)
+ *
+ * FILES/DATABASES:
+ *    An already opened GRIB file.
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void InventoryJump (FILE *fp, fpos_t *msgPos, sChar f_pos,
+                           double offset, uInt4 jump)
+{
+   long int step;       /* Part of jump that fits in an fseek. */
+
+   if (!f_pos) {
+      fseek (fp, (long int) offset, SEEK_SET);
+      return;
+   }
+   fsetpos (fp, msgPos);
+   while (jump > 0) {
+      step = (jump > 0x7fffffffUL) ? 0x7fffffffL : (long int) jump;
+      if (fseek (fp, step, SEEK_CUR) != 0) {
+         return;
+      }
+      jump -= (uInt4) step;
+   }
+}
+
 /*****************************************************************************
  * GRIB2Inventory() -- Review 12/2002
  *
@@ -792,6 +917,12 @@ enum { GS4_ANALYSIS, GS4_ENSEMBLE, GS4_DERIVED, GS4_PROBABIL_PNT = 5,
  *   LenInv = Length of the Array Inv (Output)
  *   numMsg = # of messages to inventory (0 = all, 1 = just first) (In)
  *   msgNum = MsgNum to start with, MsgNum of last message (Input/Output)
+ * trailMsg = (GRIB2InventoryCore) The warning if there were trailing bytes,
+ *            else NULL.  Caller frees (and prints it with
+ *            GRIB2InventoryTrail if it wants to).  If trailMsg is NULL the
+ *            warning is printed here. (Output)
+ * trailLen = (GRIB2InventoryCore) Number of trailing bytes (0 if none).
+ *            (NULL if not wanted) (Output)
  *
  * FILES/DATABASES:
  *    Opens a GRIB2 file for reading given its filename.
@@ -832,15 +963,28 @@ enum { GS4_ANALYSIS, GS4_ENSEMBLE, GS4_DERIVED, GS4_PROBABIL_PNT = 5,
  *   5/2004 AAT: Added a check for section number 2..8 for the repeated
  *          section (otherwise error)
  *  10/2004 AAT: Added ability to inventory TDLP records.
+ *  10/2026 AAT: Added msgLen and gdsHash (for the .gidx index).
+ *  10/2026 AAT: offset and start are doubles, and the next message is found
+ *          relative to the current one, so files over 2 GB work.
+ *  10/2026 AAT: GRIB2InventoryCore returns the trailing bytes warning (for
+ *          the .gidx index).
  *
  * NOTES
  *****************************************************************************
  */
 int GRIB2Inventory (char *filename, inventoryType **Inv, uInt4 *LenInv,
                     int numMsg, int *MsgNum)
+{
+   return GRIB2InventoryCore (filename, Inv, LenInv, numMsg, MsgNum, NULL,
+                              NULL);
+}
+
+int GRIB2InventoryCore (char *filename, inventoryType **Inv, uInt4 *LenInv,
+                        int numMsg, int *MsgNum, char **trailMsg,
+                        double *trailLen)
 {
    FILE *fp;            /* The opened GRIB2 file. */
-   sInt4 offset = 0;    /* Where we are in the file. */
+   double offset = 0;   /* Where we are in the file. */
    sInt4 msgNum;        /* Which GRIB2 message we are on. */
    uInt4 gribLen;       /* Length of the current GRIB message. */
    uInt4 secLen;        /* Length of current section. */
@@ -863,11 +1007,21 @@ int GRIB2Inventory (char *filename, inventoryType **Inv, uInt4 *LenInv,
    int grib_limit;      /* How many bytes to look for before the first "GRIB"
                          * in the file.  If not found, is not a GRIB file. */
    int c;               /* Determine if end of the file without fileLen. */
-   sInt4 fileLen;       /* Length of the GRIB2 file. */
+   long int fileLen;    /* Length of the GRIB2 file. */
    unsigned short int center, subcenter; /* Who produced it. */
    uChar mstrVersion;   /* The master table version (is it 255?) */
    char *ptr;           /* used to find the file extension. */
+   uInt4 jump;          /* Length of the current message in the file. */
+   uInt4 i;             /* Loop over the grids in the current message. */
+   fpos_t msgPos;       /* Where the current message starts. */
+   sChar f_pos;         /* 1 if msgPos is valid (fp isn't a pipe). */
 
+   if (trailMsg != NULL) {
+      *trailMsg = NULL;
+   }
+   if (trailLen != NULL) {
+      *trailLen = 0;
+   }
    grib_limit = GRIB_LIMIT;
    if (filename != NULL) {
       if ((fp = fopen (filename, "rb")) == NULL) {
@@ -905,6 +1059,7 @@ int GRIB2Inventory (char *filename, inventoryType **Inv, uInt4 *LenInv,
       if (msgNum > 1) {
          grib_limit = -1;
       }
+      f_pos = (fgetpos (fp, &msgPos) == 0);
       /* Read in the wmo header and sect0. */
       if (ReadSECT0 (fp, &buff, &buffLen, grib_limit, sect0, &gribLen,
                      &version) < 0) {
@@ -918,16 +1073,19 @@ int GRIB2Inventory (char *filename, inventoryType **Inv, uInt4 *LenInv,
          } else {
             /* Handle case where there are trailing bytes. */
             msg = errSprintf (NULL);
-            printf ("Warning: Inside GRIB2Inventory, Message # %ld\n",
-                    (long int) msgNum);
-            printf ("%s", msg);
-            free (msg);
             /* find out how big the file is. */
             fseek (fp, 0L, SEEK_END);
             fileLen = ftell (fp);
             /* fseek (fp, 0L, SEEK_SET); */
-            printf ("There were %ld trailing bytes in the file.\n",
-                    (long int) (fileLen - offset));
+            if (trailLen != NULL) {
+               *trailLen = fileLen - offset;
+            }
+            if (trailMsg != NULL) {
+               *trailMsg = msg;
+            } else {
+               GRIB2InventoryTrail (msgNum, msg, fileLen - offset);
+               free (msg);
+            }
             free (buffer);
             free (buff);
             fclose (fp);
@@ -948,6 +1106,8 @@ int GRIB2Inventory (char *filename, inventoryType **Inv, uInt4 *LenInv,
       inv->msgNum = msgNum;
       inv->subgNum = 0;
       inv->start = offset;
+      inv->msgLen = 0;
+      inv->gdsHash = 0;
       inv->element = NULL;
       inv->comment = NULL;
       inv->unitName = NULL;
@@ -1046,6 +1206,8 @@ int GRIB2Inventory (char *filename, inventoryType **Inv, uInt4 *LenInv,
                inv->msgNum = msgNum;
                inv->subgNum = lastInv->subgNum + 1;
                inv->start = offset;
+               inv->msgLen = 0;
+               inv->gdsHash = lastInv->gdsHash;
                inv->element = NULL;
                inv->comment = NULL;
                inv->unitName = NULL;
@@ -1059,10 +1221,6 @@ int GRIB2Inventory (char *filename, inventoryType **Inv, uInt4 *LenInv,
          } while (sectNum != 8);
       }
 
-      /* added to inventory either first msgNum messages, or all messages */
-      if (numMsg == msgNum) {
-         break;
-      }
       /* Continue on to the next GRIB2 message. */
       if (version == -1) {
          /* TDLPack uses 4 bytes for FORTRAN record size, then another 8
@@ -1071,11 +1229,21 @@ int GRIB2Inventory (char *filename, inventoryType **Inv, uInt4 *LenInv,
           * bytes for a final FORTRAN record size.  However it only stores
           * in_ the gribLen the non-rounded amount, so we need to take care
           * of the rounding, and the trailing 4 bytes here. */
-         offset += buffLen + ((sInt4) ceil (gribLen / 8.0)) * 8 + 4;
+         jump = buffLen + ((sInt4) ceil (gribLen / 8.0)) * 8 + 4;
       } else {
-         offset += buffLen + gribLen;
+         jump = buffLen + gribLen;
       }
-      fseek (fp, offset, SEEK_SET);
+      /* Every grid in this message gets the message's length. */
+      for (i = *LenInv; (i > 0) && ((*Inv)[i - 1].msgNum ==
+                                     (unsigned short int) msgNum); i--) {
+         (*Inv)[i - 1].msgLen = jump;
+      }
+      /* added to inventory either first msgNum messages, or all messages */
+      if (numMsg == msgNum) {
+         break;
+      }
+      offset += jump;
+      InventoryJump (fp, &msgPos, f_pos, offset, jump);
    }
    free (buffer);
    free (buff);
@@ -20,7 +20,10 @@
 
 typedef struct {
    sChar GribVersion;        /* 1 if GRIB1, 2 if GRIB2, -1 if it is TDLP */
-   sInt4 start;           /* Where this message starts in file. */
+   double start;             /* Where this message starts in file (a
+                              * double so files over 2 GB work). */
+   uInt4 msgLen;             /* How many bytes the message takes in the file
+                              * (wmo header and TDLP padding included). */
    unsigned short int msgNum; /* Which "GRIB2" message we are working on. */
    unsigned short int subgNum; /* 0 for the first grid in the GRIB2 message
                               * NOT file, 1 for the second, etc. */
@@ -38,6 +41,9 @@ typedef struct {
                                 (above ground) (500 mb), etc */
    char *longFstLevel;       /* Long description of the level of this data
                                 (above ground) (500 mb), etc */
+   uInt4 gdsHash;            /* Hash of the bytes in GRIB2 section 3, so two
+                              * grids can be compared without unpacking them.
+                              * 0 for GRIB1 and TDLP. */
 } inventoryType;
 
 void GRIB2InventoryFree (inventoryType *inv);
@@ -48,6 +54,13 @@ void GRIB2InventoryPrint (inventoryType *Inv, uInt4 LenInv);
 int GRIB2Inventory (char *filename, inventoryType ** Inv, uInt4 *LenInv,
                     int numMsg, int *MsgNum);
 
+/* Possible error messages left in errSprintf() */
+int GRIB2InventoryCore (char *filename, inventoryType ** Inv, uInt4 *LenInv,
+                        int numMsg, int *MsgNum, char **trailMsg,
+                        double *trailLen);
+
+void GRIB2InventoryTrail (int msgNum, const char *msg, double trailLen);
+
 int GRIB2RefTime (char *filename, double *refTime);
 
 #endif
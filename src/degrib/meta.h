@@ -154,6 +154,10 @@ typedef struct {
    UglyStringType *ugly;     /* The parsed Ugly string. */
    int maxEng[NUM_UGLY_WORD]; /* Max length of english phrases for all ugly
                                * word number X. */
+   uInt4 dataMax;            /* Number of strings data, f_valid, and ugly
+                              * have room for (kept between grids). */
+   char *buff;               /* Holds the strings that data points to. */
+   uInt4 buffLen;            /* Allocated length of buff. */
 } sect2_WxType;
 
 typedef struct {
@@ -183,6 +187,10 @@ typedef struct {
    HazardStringType *haz;    /* The parsed Ugly string. */
    int maxEng[NUM_HAZARD_WORD]; /* Max length of english phrases for all ugly
                                * word number X. */
+   uInt4 dataMax;            /* Number of strings data, f_valid, and haz
+                              * have room for (kept between grids). */
+   char *buff;               /* Holds the strings that data points to. */
+   uInt4 buffLen;            /* Allocated length of buff. */
 } sect2_HazardType;
 
 enum { GS2_NONE, GS2_WXTYPE, GS2_UNKNOWN, GS2_HAZARD };
@@ -546,6 +554,8 @@ typedef struct {
    char refTime[20];         /* When forecast was issued. */
    char validTime[20];       /* When forecast is valid. */
    sInt4 deltTime;           /* validTime - refTime in seconds. */
+   uInt4 numSaved;           /* Number of allocations saved by reusing the
+                              * section 2 tables (see MetaRecycle). */
 
 /*  int *size_wx; */         /* (idat[0] + 2) * sizeof (int) */
 /*  char **release_datetime; *//* pds2.refTime + pds2.cutOffHour */
@@ -560,10 +570,16 @@ char *Print (char *label, char *varName, Prt_TYPE fmt, ...);
 
 void MetaInit (grib_MetaData *meta);
 
+void MetaSect2Recycle (grib_MetaData *meta);
+
 void MetaSect2Free (grib_MetaData * meta);
 
+void MetaRecycle (grib_MetaData *meta);
+
 void MetaFree (grib_MetaData *meta);
 
+int MetaWxReserve (sect2_WxType *Wx, uInt4 numData, uInt4 buffLen);
+
 int ParseTime (double * AnsTime, int year, uChar mon, uChar day, uChar hour,
                uChar min, uChar sec);
 
@@ -586,6 +602,13 @@ void ParseGrid (gridAttribType * attrib, double **Grib_Data,
                 uChar *txt_f_valid,
                 uChar f_subGrid, int startX, int startY, int stopX, int stopY);
 
+void ParseGridFlt (gridAttribType * attrib, float **Flt_Data,
+                   uInt4 *flt_DataLen, uInt4 Nx, uInt4 Ny, int scan,
+                   sInt4 *iain, sInt4 ibitmap, sInt4 *ib, double unitM,
+                   double unitB, uChar f_txtType, uInt4 txt_dataLen,
+                   uChar *txt_f_valid, uChar f_subGrid, int startX,
+                   int startY, int stopX, int stopY, sChar decimal);
+
 void FreqPrint (char **ans, double *Data, sInt4 DataLen, sInt4 Nx,
                 sInt4 Ny, sChar decimal, char *comment);
 
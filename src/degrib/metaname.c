@@ -21,6 +21,12 @@
 #include "myerror.h"
 #include "myassert.h"
 #include "myutil.h"
+/* The local table hashes are built once, by whichever thread first needs
+ * them (see LocalHashReady). */
+#if !defined(_WINDOWS_) && !defined(MS_WINDOWS)
+#define USE_PTHREAD
+#include <pthread.h>
+#endif
 
 char *centerLookup (unsigned short int center)
 {
@@ -2526,6 +2532,188 @@ static GRIB2LocalTable *Choose_LocalParmTable (unsigned short int center,
    }
 }
 
+/* Number of slots in each local table's hash.  A power of 2, and more than
+ * twice as many entries as the longest local table. */
+#define LOCAL_HASH_SIZE 1024
+
+/* A hash of a local table from (prodType, cat, subcat) to the first entry in
+ * the table with that key. */
+typedef struct {
+   GRIB2LocalTable *table;
+   size_t tableLen;
+   short int slot[LOCAL_HASH_SIZE]; /* 1 + index into table, or 0 if empty. */
+} LocalHashType;
+
+static LocalHashType LocalHash[] = {
+   {NCEP_LclTable, sizeof (NCEP_LclTable) / sizeof (GRIB2LocalTable),
+    {0}},
+   {HPC_LclTable, sizeof (HPC_LclTable) / sizeof (GRIB2LocalTable),
+    {0}},
+   {NDFD_LclTable, sizeof (NDFD_LclTable) / sizeof (GRIB2LocalTable),
+    {0}},
+   {Canada_LclTable, sizeof (Canada_LclTable) / sizeof (GRIB2LocalTable),
+    {0}},
+   {MRMS_LclTable, sizeof (MRMS_LclTable) / sizeof (GRIB2LocalTable),
+    {0}},
+};
+
+#ifdef USE_PTHREAD
+static pthread_once_t LocalHashOnce = PTHREAD_ONCE_INIT;
+#else
+static int f_LocalHashDone = 0;
+#endif
+
+static unsigned int LocalHashKey (int prodType, int cat, int subcat)
+{
+   unsigned int key = (((unsigned int) prodType << 16) |
+                       ((unsigned int) (cat & 0xff) << 8) |
+                       (unsigned int) (subcat & 0xff));
+
+   /* Multiplicative (Fibonacci) hash, keeping the top 10 bits. */
+   return ((key * 2654435761u) >> 22) & (LOCAL_HASH_SIZE - 1);
+}
+
+/*****************************************************************************
+ * LocalHashInit() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Builds the hashes of the local parameter tables.  When a key is listed
+ * more than once in a table, the hash keeps the first, which is the one a
+ * walk of the table would find.
+ *
+ * ARGUMENTS
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Only call through LocalHashReady().
+ *****************************************************************************
+ */
+static void LocalHashInit (void)
+{
+   size_t i;
+   size_t j;
+   unsigned int h;
+   LocalHashType *hash;
+   GRIB2LocalTable *entry;
+   GRIB2LocalTable *other;
+
+   for (i = 0; i < sizeof (LocalHash) / sizeof (LocalHash[0]); i++) {
+      hash = &(LocalHash[i]);
+      myAssert (2 * hash->tableLen < LOCAL_HASH_SIZE);
+      memset (hash->slot, 0, sizeof (hash->slot));
+      for (j = 0; j < hash->tableLen; j++) {
+         entry = &(hash->table[j]);
+         h = LocalHashKey (entry->prodType, entry->cat, entry->subcat);
+         while (hash->slot[h] != 0) {
+            other = &(hash->table[hash->slot[h] - 1]);
+            if ((other->prodType == entry->prodType) &&
+                (other->cat == entry->cat) &&
+                (other->subcat == entry->subcat)) {
+               break;
+            }
+            h = (h + 1) & (LOCAL_HASH_SIZE - 1);
+         }
+         if (hash->slot[h] == 0) {
+            hash->slot[h] = (short int) (j + 1);
+         }
+      }
+   }
+}
+
+static void LocalHashReady (void)
+{
+#ifdef USE_PTHREAD
+   pthread_once (&LocalHashOnce, LocalHashInit);
+#else
+   if (!f_LocalHashDone) {
+      LocalHashInit ();
+      f_LocalHashDone = 1;
+   }
+#endif
+}
+
+/*****************************************************************************
+ * LocalParmLookUp() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Finds a product in the local parameter table for a given
+ * center/subcenter (see Choose_LocalParmTable), using the table's hash
+ * rather than walking the table.
+ *
+ * ARGUMENTS
+ *    center = The center that created the data. (Input)
+ * subcenter = The subcenter that created the data. (Input)
+ *  prodType = The GRIB2, section 0 product type. (Input)
+ *       cat = The GRIB2 section 4 "General category of Product." (Input)
+ *    subcat = The GRIB2 section 4 "Specific subcategory of Product". (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: GRIB2LocalTable *
+ *   The first entry in the local table for (prodType, cat, subcat), or NULL
+ *   if there is no local table or the product isn't in it.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   A local table added to Choose_LocalParmTable but not to LocalHash is
+ * still found, by walking it.
+ *****************************************************************************
+ */
+static GRIB2LocalTable *LocalParmLookUp (unsigned short int center,
+                                         unsigned short int subcenter,
+                                         int prodType, int cat, int subcat)
+{
+   GRIB2LocalTable *local;
+   GRIB2LocalTable *entry;
+   LocalHashType *hash = NULL;
+   size_t tableLen;
+   size_t i;
+   unsigned int h;
+
+   local = Choose_LocalParmTable (center, subcenter, &tableLen);
+   if (local == NULL) {
+      return NULL;
+   }
+   for (i = 0; i < sizeof (LocalHash) / sizeof (LocalHash[0]); i++) {
+      if (LocalHash[i].table == local) {
+         hash = &(LocalHash[i]);
+         break;
+      }
+   }
+   if (hash == NULL) {
+      for (i = 0; i < tableLen; i++) {
+         if ((prodType == local[i].prodType) && (cat == local[i].cat) &&
+             (subcat == local[i].subcat)) {
+            return &(local[i]);
+         }
+      }
+      return NULL;
+   }
+   LocalHashReady ();
+   h = LocalHashKey (prodType, cat, subcat);
+   while (hash->slot[h] != 0) {
+      entry = &(local[hash->slot[h] - 1]);
+      if ((prodType == entry->prodType) && (cat == entry->cat) &&
+          (subcat == entry->subcat)) {
+         return entry;
+      }
+      h = (h + 1) & (LOCAL_HASH_SIZE - 1);
+   }
+   return NULL;
+}
+
 /*****************************************************************************
  * ParseElemName() --
  *
@@ -2563,6 +2751,8 @@ static GRIB2LocalTable *Choose_LocalParmTable (unsigned short int center,
  *   8/2004 AAT: Adjusted so template 9 gets units of % and no convert.
  *   3/2005 AAT: ReWrote to handle template 5, 9 and MOS.
  *   9/2005 AAT: Added code to handle MOS PoP06 vs MOS PoP12.
+ *  10/2026 AAT: Find local table entries with LocalParmLookUp, and build the
+ *               units without mallocSprintf.
  *
  * NOTES
  *****************************************************************************
@@ -2578,7 +2768,6 @@ static void ElemNameProb (uChar mstrVersion, uShort2 center, uShort2 subcenter,
    GRIB2ParmTable *table;
    GRIB2LocalTable *local;
    size_t tableLen;
-   size_t i;
    char f_isNdfd = IsData_NDFD (center, subcenter);
    char f_isMos = IsData_MOS (center, subcenter);
 
@@ -2852,54 +3041,48 @@ static void ElemNameProb (uChar mstrVersion, uShort2 center, uShort2 subcenter,
    }
 
    /* Local use tables. */
-   local = Choose_LocalParmTable (center, subcenter, &tableLen);
+   local = LocalParmLookUp (center, subcenter, prodType, cat, subcat);
    if (local != NULL) {
-      for (i = 0; i < tableLen; i++) {
-         if ((prodType == local[i].prodType) && (cat == local[i].cat) &&
-             (subcat == local[i].subcat)) {
-
-            /* Ignore adding Prob prefix and "Probability of" to NDFD SPC prob
-             * products. */
-            if (lenTime > 0) {
-               if (timeRangeUnit == 3) {
-                  mallocSprintf (name, "Prob%s%02dm", local[i].name, lenTime);
-                  mallocSprintf (comment, "%02d mon Prob of %s ", lenTime,
-                                 local[i].comment);
-               } else if (timeRangeUnit == 4) {
-                  mallocSprintf (name, "Prob%s%02dy", local[i].name, lenTime);
-                  mallocSprintf (comment, "%02d yr Prob of %s ", lenTime,
-                                 local[i].comment);
-               } else {
-                  mallocSprintf (name, "Prob%s%02d", local[i].name, lenTime);
-                  mallocSprintf (comment, "%02d hr Prob of %s ", lenTime,
-                                 local[i].comment);
-               }
-            } else {
-               mallocSprintf (name, "Prob%s", local[i].name);
-               mallocSprintf (comment, "Prob of %s ", local[i].comment);
-            }
-            if (probType == 0) {
-               reallocSprintf (comment, "< %g %s", lowerProb,
-                               local[i].unit);
-            } else if (probType == 1) {
-               reallocSprintf (comment, "> %g %s", upperProb,
-                               local[i].unit);
-            } else if (probType == 2) {
-               reallocSprintf (comment, ">= %g, < %g %s", lowerProb,
-                               upperProb, local[i].unit);
-            } else if (probType == 3) {
-               reallocSprintf (comment, "> %g %s", lowerProb,
-                               local[i].unit);
-            } else if (probType == 4) {
-               reallocSprintf (comment, "< %g %s", upperProb,
-                               local[i].unit);
-            } else {
-               reallocSprintf (comment, "%s", local[i].unit);
-            }
-            *convert = UC_NONE;
-            return;
+      /* Ignore adding Prob prefix and "Probability of" to NDFD SPC prob
+       * products. */
+      if (lenTime > 0) {
+         if (timeRangeUnit == 3) {
+            mallocSprintf (name, "Prob%s%02dm", local->name, lenTime);
+            mallocSprintf (comment, "%02d mon Prob of %s ", lenTime,
+                           local->comment);
+         } else if (timeRangeUnit == 4) {
+            mallocSprintf (name, "Prob%s%02dy", local->name, lenTime);
+            mallocSprintf (comment, "%02d yr Prob of %s ", lenTime,
+                           local->comment);
+         } else {
+            mallocSprintf (name, "Prob%s%02d", local->name, lenTime);
+            mallocSprintf (comment, "%02d hr Prob of %s ", lenTime,
+                           local->comment);
          }
+      } else {
+         mallocSprintf (name, "Prob%s", local->name);
+         mallocSprintf (comment, "Prob of %s ", local->comment);
+      }
+      if (probType == 0) {
+         reallocSprintf (comment, "< %g %s", lowerProb,
+                         local->unit);
+      } else if (probType == 1) {
+         reallocSprintf (comment, "> %g %s", upperProb,
+                         local->unit);
+      } else if (probType == 2) {
+         reallocSprintf (comment, ">= %g, < %g %s", lowerProb,
+                         upperProb, local->unit);
+      } else if (probType == 3) {
+         reallocSprintf (comment, "> %g %s", lowerProb,
+                         local->unit);
+      } else if (probType == 4) {
+         reallocSprintf (comment, "< %g %s", upperProb,
+                         local->unit);
+      } else {
+         reallocSprintf (comment, "%s", local->unit);
       }
+      *convert = UC_NONE;
+      return;
    }
 
    *name = (char *) malloc (strlen ("ProbUnknown") + 1);
@@ -2952,7 +3135,7 @@ static void ElemNamePerc (uChar mstrVersion, uShort2 center, uShort2 subcenter,
                     mallocSprintf (comment, "%02d hr %s Percentile(%d)", lenTime,
                                    table[subcat].comment, percentile);
                  }
-                 mallocSprintf (unit, "[%s]", table[subcat].unit);
+                 mallocStrCat (unit, "[", table[subcat].unit, "]", (char *) NULL);
                  *convert = table[subcat].convert;
                  return;
                }
@@ -2978,7 +3161,7 @@ static void ElemNamePerc (uChar mstrVersion, uShort2 center, uShort2 subcenter,
                      mallocSprintf (comment, "%s Percentile(%d)",
                                     table[subcat].comment, percentile);
                   }
-                  mallocSprintf (unit, "[%s]", table[subcat].unit);
+                  mallocStrCat (unit, "[", table[subcat].unit, "]", (char *) NULL);
                   *convert = table[subcat].convert;
                   return;
                }
@@ -3000,53 +3183,48 @@ static void ElemNamePerc (uChar mstrVersion, uShort2 center, uShort2 subcenter,
             mallocSprintf (comment, "%s Percentile(%d)",
                            table[subcat].comment, percentile);
          }
-         mallocSprintf (unit, "[%s]", table[subcat].unit);
+         mallocStrCat (unit, "[", table[subcat].unit, "]", (char *) NULL);
          *convert = table[subcat].convert;
          return;
       }
    }
 
    /* Local use tables. */
-   local = Choose_LocalParmTable (center, subcenter, &tableLen);
+   local = LocalParmLookUp (center, subcenter, prodType, cat, subcat);
    if (local != NULL) {
-      for (i = 0; i < tableLen; i++) {
-         if ((prodType == local[i].prodType) && (cat == local[i].cat) &&
-             (subcat == local[i].subcat)) {
 /* If last two characters in name are numbers, then the name contains
  * the percentile (or exceedance value) so don't tack on percentile here.*/
-            len = strlen(local[i].name);
-            if (isdigit(local[i].name[len -1]) && isdigit(local[i].name[len -2])) {
-               mallocSprintf (name, "%s", local[i].name);
-            } else if ((strcmp (local[i].name, "Surge") == 0) ||
-                       (strcmp (local[i].name, "SURGE") == 0)) {
+      len = strlen(local->name);
+      if (isdigit(local->name[len -1]) && isdigit(local->name[len -2])) {
+         mallocSprintf (name, "%s", local->name);
+      } else if ((strcmp (local->name, "Surge") == 0) ||
+                 (strcmp (local->name, "SURGE") == 0)) {
 /* Provide a special exception for storm surge exceedance.
  * Want exceedance value rather than percentile value.
  */
-               mallocSprintf (name, "%s%02d", local[i].name, 100 - percentile);
-            } else {
-               mallocSprintf (name, "%s%02d", local[i].name, percentile);
-            }
+         mallocSprintf (name, "%s%02d", local->name, 100 - percentile);
+      } else {
+         mallocSprintf (name, "%s%02d", local->name, percentile);
+      }
 
-            if (lenTime > 0) {
-               if (timeRangeUnit == 3) {
-                  mallocSprintf (comment, "%02d mon %s Percentile(%d)",
-                                 lenTime, local[i].comment, percentile);
-               } else if (timeRangeUnit == 4) {
-                  mallocSprintf (comment, "%02d yr %s Percentile(%d)",
-                                 lenTime, local[i].comment, percentile);
-               } else {
-                  mallocSprintf (comment, "%02d hr %s Percentile(%d)",
-                                 lenTime, local[i].comment, percentile);
-               }
-            } else {
-               mallocSprintf (comment, "%s Percentile(%d)",
-                              local[i].comment, percentile);
-            }
-            mallocSprintf (unit, "[%s]", local[i].unit);
-            *convert = local[i].convert;
-            return;
+      if (lenTime > 0) {
+         if (timeRangeUnit == 3) {
+            mallocSprintf (comment, "%02d mon %s Percentile(%d)",
+                           lenTime, local->comment, percentile);
+         } else if (timeRangeUnit == 4) {
+            mallocSprintf (comment, "%02d yr %s Percentile(%d)",
+                           lenTime, local->comment, percentile);
+         } else {
+            mallocSprintf (comment, "%02d hr %s Percentile(%d)",
+                           lenTime, local->comment, percentile);
          }
+      } else {
+         mallocSprintf (comment, "%s Percentile(%d)",
+                        local->comment, percentile);
       }
+      mallocStrCat (unit, "[", local->unit, "]", (char *) NULL);
+      *convert = local->convert;
+      return;
    }
 
    *name = (char *) malloc (strlen ("unknown") + 1);
@@ -3182,7 +3360,7 @@ static void ElemNameNorm (uChar mstrVersion, uShort2 center, uShort2 subcenter,
                   mallocSprintf (comment, "%02d hr %s", lenTime,
                                  table[subcat].comment);
                }
-               mallocSprintf (unit, "[%s]", table[subcat].unit);
+               mallocStrCat (unit, "[", table[subcat].unit, "]", (char *) NULL);
                *convert = table[subcat].convert;
                return;
             }
@@ -3200,7 +3378,7 @@ static void ElemNameNorm (uChar mstrVersion, uShort2 center, uShort2 subcenter,
                   mallocSprintf (comment, "%02d hr %s", lenTime,
                                  table[subcat].comment);
                } 
-               mallocSprintf (unit, "[%s]", table[subcat].unit);
+               mallocStrCat (unit, "[", table[subcat].unit, "]", (char *) NULL);
                *convert = table[subcat].convert;
                return;
             } 
@@ -3215,7 +3393,7 @@ static void ElemNameNorm (uChar mstrVersion, uShort2 center, uShort2 subcenter,
                   mallocSprintf (name, "%s%02d", "Evp", lenTime);              
                   mallocSprintf (comment, "%02d hr Evapo-Transpiration", lenTime);
                }
-               mallocSprintf (unit, "[%s]", table[subcat].unit);
+               mallocStrCat (unit, "[", table[subcat].unit, "]", (char *) NULL);
                *convert = table[subcat].convert;
                return;
             }   
@@ -3227,7 +3405,7 @@ static void ElemNameNorm (uChar mstrVersion, uShort2 center, uShort2 subcenter,
                   strcpy (*name, NDFD_Overide[i].NDFDname);
                   *comment = (char *) malloc (strlen (table[subcat].comment) + 1);
                   strcpy (*comment, table[subcat].comment);
-                  mallocSprintf (unit, "[%s]", table[subcat].unit);
+                  mallocStrCat (unit, "[", table[subcat].unit, "]", (char *) NULL);
                   *convert = table[subcat].convert;
                   return;
                }
@@ -3259,46 +3437,41 @@ static void ElemNameNorm (uChar mstrVersion, uShort2 center, uShort2 subcenter,
             *comment = (char *) malloc (strlen (table[subcat].comment) + 1);
             strcpy (*comment, table[subcat].comment);
          }
-         mallocSprintf (unit, "[%s]", table[subcat].unit);
+         mallocStrCat (unit, "[", table[subcat].unit, "]", (char *) NULL);
          *convert = table[subcat].convert;
          return;
       }
    }
 
    /* Local use tables. */
-   local = Choose_LocalParmTable (center, subcenter, &tableLen);
+   local = LocalParmLookUp (center, subcenter, prodType, cat, subcat);
    if (local != NULL) {
-      for (i = 0; i < tableLen; i++) {
-         if ((prodType == local[i].prodType) && (cat == local[i].cat) &&
-             (subcat == local[i].subcat)) {
-            /* Allow specific products with non-zero lenTime to reflect that.
-             */
-            f_accum = 0;
-            if (f_accum && (lenTime > 0)) {
-               if (timeRangeUnit == 3) {
-                  mallocSprintf (name, "%s%02dm", local[i].name, lenTime);
-                  mallocSprintf (comment, "%02d mon %s", lenTime,
-                                 local[i].comment);
-               } else if (timeRangeUnit == 4) {
-                  mallocSprintf (name, "%s%02dy", local[i].name, lenTime);
-                  mallocSprintf (comment, "%02d yr %s", lenTime,
-                                 local[i].comment);
-               } else {
-                  mallocSprintf (name, "%s%02d", local[i].name, lenTime);
-                  mallocSprintf (comment, "%02d hr %s", lenTime,
-                                 local[i].comment);
-               }
-            } else {
-               *name = (char *) malloc (strlen (local[i].name) + 1);
-               strcpy (*name, local[i].name);
-               *comment = (char *) malloc (strlen (local[i].comment) + 1);
-               strcpy (*comment, local[i].comment);
-            }
-            mallocSprintf (unit, "[%s]", local[i].unit);
-            *convert = local[i].convert;
-            return;
+      /* Allow specific products with non-zero lenTime to reflect that.
+       */
+      f_accum = 0;
+      if (f_accum && (lenTime > 0)) {
+         if (timeRangeUnit == 3) {
+            mallocSprintf (name, "%s%02dm", local->name, lenTime);
+            mallocSprintf (comment, "%02d mon %s", lenTime,
+                           local->comment);
+         } else if (timeRangeUnit == 4) {
+            mallocSprintf (name, "%s%02dy", local->name, lenTime);
+            mallocSprintf (comment, "%02d yr %s", lenTime,
+                           local->comment);
+         } else {
+            mallocSprintf (name, "%s%02d", local->name, lenTime);
+            mallocSprintf (comment, "%02d hr %s", lenTime,
+                           local->comment);
          }
+      } else {
+         *name = (char *) malloc (strlen (local->name) + 1);
+         strcpy (*name, local->name);
+         *comment = (char *) malloc (strlen (local->comment) + 1);
+         strcpy (*comment, local->comment);
       }
+      mallocStrCat (unit, "[", local->unit, "]", (char *) NULL);
+      *convert = local->convert;
+      return;
    }
 
    *name = (char *) malloc (strlen ("unknown") + 1);
@@ -3353,9 +3526,9 @@ void ParseElemName (uChar mstrVersion, uShort2 center, uShort2 subcenter,
    if ((genProcess == 6) || (genProcess == 7)) {
       *convert = UC_NONE;
       reallocSprintf (name, "ERR");
-      reallocSprintf (comment, " error %s", *unit);
+      reallocStrCat (comment, " error ", *unit, (char *) NULL);
    } else {
-      reallocSprintf (comment, " %s", *unit);
+      reallocStrCat (comment, " ", *unit, (char *) NULL);
    }
 }
 
@@ -3819,7 +3992,8 @@ typedef struct {
 } GRIB2LocalSurface;
 
 /* based on http://www.nco.ncep.noaa.gov/pmb/docs/grib2/grib2_table4-5.shtml
- * updated last on 3/14/2006 */
+ * updated last on 3/14/2006
+ * Keep in order of index (Table45Index does a binary search). */
 GRIB2LocalSurface NCEP_Surface[] = {
    {200, {"EATM", "Entire atmosphere (considerd as a single layer)", "-"}},
    {201, {"EOCN", "Entire ocean (considered as a single layer)", "-"}},
@@ -3877,6 +4051,7 @@ GRIB2LocalSurface NCEP_Surface[] = {
  * HISTORY
  *   9/2002 Arthur Taylor (MDL/RSIS): Created.
  *  12/2004 Arthur Taylor (RSIS): Modified to return SurfaceTable.
+ *  10/2026 AAT: Binary search NCEP_Surface.
  *
  * NOTES
  *****************************************************************************
@@ -3885,6 +4060,8 @@ GRIB2SurfTable Table45Index (int i, int *f_reserved, uShort2 center,
                              uShort2 subcenter)
 {
    size_t j;
+   size_t lo;
+   size_t hi;
 
    *f_reserved = 1;
    if ((i > 255) || (i < 0)) {
@@ -3897,13 +4074,22 @@ GRIB2SurfTable Table45Index (int i, int *f_reserved, uShort2 center,
       return Surface[33];
    if (i > 191) {
       if (center == 7) {
-         for (j = 0; j < sizeof (NCEP_Surface) / sizeof (NCEP_Surface[0]);
-              j++) {
-            if (i == NCEP_Surface[j].index) {
-               *f_reserved = 0;
-               return (NCEP_Surface[j].surface);
+         /* NCEP_Surface is in order of index. */
+         lo = 0;
+         hi = sizeof (NCEP_Surface) / sizeof (NCEP_Surface[0]);
+         while (lo < hi) {
+            j = (lo + hi) / 2;
+            if (NCEP_Surface[j].index < i) {
+               lo = j + 1;
+            } else {
+               hi = j;
             }
          }
+         if ((lo < sizeof (NCEP_Surface) / sizeof (NCEP_Surface[0])) &&
+             (NCEP_Surface[lo].index == i)) {
+            *f_reserved = 0;
+            return (NCEP_Surface[lo].surface);
+         }
       }
       return Surface[32];
    }
@@ -3952,6 +4138,49 @@ GRIB2SurfTable Table45Index (int i, int *f_reserved, uShort2 center,
    return Surface[0];
 }
 
+/*****************************************************************************
+ * LevelValueStr() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Prints a level value the way the level names show it: "%f" without the
+ * trailing zeros (or '.').  Whole numbers (most levels) are printed with
+ * "%d", which gives the same string and is a lot cheaper.
+ *
+ * ARGUMENTS
+ *  value = The level value. (Input)
+ * buffer = Where to print it (at least 20 bytes, as for "%f"). (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created (from ParseLevelName).
+ *
+ * NOTES
+ *   -0 goes through "%f" so it keeps its sign.
+ *****************************************************************************
+ */
+static void LevelValueStr (double value, char *buffer)
+{
+   int ival;
+
+   if ((value > -1e9) && (value < 1e9)) {
+      ival = (int) value;
+      if ((value == ival) && ((ival != 0) || (1 / value > 0))) {
+         sprintf (buffer, "%d", ival);
+         return;
+      }
+   }
+   sprintf (buffer, "%f", value);
+   strTrimRight (buffer, '0');
+   if (buffer[strlen (buffer) - 1] == '.') {
+      buffer[strlen (buffer) - 1] = '\0';
+   }
+}
+
 void ParseLevelName (unsigned short int center, unsigned short int subcenter,
                      uChar surfType, double value, sChar f_sndValue,
                      double sndValue, char **shortLevelName,
@@ -3968,17 +4197,9 @@ void ParseLevelName (unsigned short int center, unsigned short int subcenter,
    *shortLevelName = NULL;
    free (*longLevelName);
    *longLevelName = NULL;
-   sprintf (valBuff, "%f", value);
-   strTrimRight (valBuff, '0');
-   if (valBuff[strlen (valBuff) - 1] == '.') {
-      valBuff[strlen (valBuff) - 1] = '\0';
-   }
+   LevelValueStr (value, valBuff);
    if (f_sndValue) {
-      sprintf (sndBuff, "%f", sndValue);
-      strTrimRight (sndBuff, '0');
-      if (sndBuff[strlen (sndBuff) - 1] == '.') {
-         sndBuff[strlen (sndBuff) - 1] = '\0';
-      }
+      LevelValueStr (sndValue, sndBuff);
       if (f_reserved) {
          reallocSprintf (shortLevelName, "%s-%s-%s(%d)", valBuff, sndBuff,
                          surf.name, surfType);
@@ -3986,10 +4207,11 @@ void ParseLevelName (unsigned short int center, unsigned short int subcenter,
                          sndBuff, surf.unit, surf.name, surfType,
                          surf.comment);
       } else {
-         reallocSprintf (shortLevelName, "%s-%s-%s", valBuff, sndBuff,
-                         surf.name);
-         reallocSprintf (longLevelName, "%s-%s[%s] %s=\"%s\"", valBuff,
-                         sndBuff, surf.unit, surf.name, surf.comment);
+         mallocStrCat (shortLevelName, valBuff, "-", sndBuff, "-", surf.name,
+                       (char *) NULL);
+         mallocStrCat (longLevelName, valBuff, "-", sndBuff, "[", surf.unit,
+                       "] ", surf.name, "=\"", surf.comment, "\"",
+                       (char *) NULL);
       }
    } else {
       if (f_reserved) {
@@ -3998,9 +4220,10 @@ void ParseLevelName (unsigned short int center, unsigned short int subcenter,
          reallocSprintf (longLevelName, "%s[%s] %s(%d) (%s)", valBuff,
                          surf.unit, surf.name, surfType, surf.comment);
       } else {
-         reallocSprintf (shortLevelName, "%s-%s", valBuff, surf.name);
-         reallocSprintf (longLevelName, "%s[%s] %s=\"%s\"", valBuff,
-                         surf.unit, surf.name, surf.comment);
+         mallocStrCat (shortLevelName, valBuff, "-", surf.name,
+                       (char *) NULL);
+         mallocStrCat (longLevelName, valBuff, "[", surf.unit, "] ",
+                       surf.name, "=\"", surf.comment, "\"", (char *) NULL);
       }
    }
 }
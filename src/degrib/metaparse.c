@@ -29,6 +29,8 @@
 #include "tendian.h"
 #include "myutil.h"
 
+extern double POWERS_ONE[];
+
 /*****************************************************************************
  * MetaInit() --
  *
@@ -61,73 +63,70 @@ void MetaInit (grib_MetaData *meta)
    meta->pds2.sect2.ptrType = GS2_NONE;
 
    meta->pds2.sect2.wx.data = NULL;
+   meta->pds2.sect2.wx.f_valid = NULL;
    meta->pds2.sect2.wx.dataLen = 0;
    meta->pds2.sect2.wx.maxLen = 0;
    meta->pds2.sect2.wx.ugly = NULL;
+   meta->pds2.sect2.wx.dataMax = 0;
+   meta->pds2.sect2.wx.buff = NULL;
+   meta->pds2.sect2.wx.buffLen = 0;
    meta->pds2.sect2.unknown.data = NULL;
    meta->pds2.sect2.unknown.dataLen = 0;
    meta->pds2.sect2.hazard.data = NULL;
+   meta->pds2.sect2.hazard.f_valid = NULL;
    meta->pds2.sect2.hazard.dataLen = 0;
    meta->pds2.sect2.hazard.maxLen = 0;
    meta->pds2.sect2.hazard.haz = NULL;
+   meta->pds2.sect2.hazard.dataMax = 0;
+   meta->pds2.sect2.hazard.buff = NULL;
+   meta->pds2.sect2.hazard.buffLen = 0;
 
    meta->pds2.sect4.numInterval = 0;
    meta->pds2.sect4.Interval = NULL;
    meta->pds2.sect4.numBands = 0;
    meta->pds2.sect4.bands = NULL;
+   meta->numSaved = 0;
    return;
 }
 
 /*****************************************************************************
- * MetaSect2Free() --
+ * MetaSect2Recycle() --
  *
  * Arthur Taylor / MDL
  *
  * PURPOSE
- *   To free the section 2 data in the grib_metaData structure.
+ *   To free the parsed section 2 data in the grib_metaData structure, while
+ * keeping the weather and hazard tables (data, f_valid, ugly / haz, and the
+ * string buffer) so the next grid can reuse them.
  *
  * ARGUMENTS
- * meta = The structure to free. (Input/Output)
+ * meta = The structure to recycle. (Input/Output)
  *
  * FILES/DATABASES: None
  *
  * RETURNS: void
  *
  * HISTORY
- *   2/2003 Arthur Taylor (MDL/RSIS): Created.
- *   3/2003 AAT: Cleaned up declaration of variable: WxType.
+ *  10/2026 Arthur Taylor (MDL): Created (from MetaSect2Free).
  *
  * NOTES
+ * 1) The tables are only freed by MetaSect2Free (or MetaFree).
  *****************************************************************************
  */
-void MetaSect2Free (grib_MetaData *meta)
+void MetaSect2Recycle (grib_MetaData *meta)
 {
    size_t i;            /* Counter for use when freeing Wx data. */
 
    if (meta->pds2.sect2.ptrType == GS2_WXTYPE) {
       for (i = 0; i < meta->pds2.sect2.wx.dataLen; i++) {
-         free (meta->pds2.sect2.wx.data[i]);
          FreeUglyString (&(meta->pds2.sect2.wx.ugly[i]));
       }
-      free (meta->pds2.sect2.wx.ugly);
-      meta->pds2.sect2.wx.ugly = NULL;
-      free (meta->pds2.sect2.wx.data);
-      meta->pds2.sect2.wx.data = NULL;
-      free (meta->pds2.sect2.wx.f_valid);
-      meta->pds2.sect2.wx.f_valid = NULL;
       meta->pds2.sect2.wx.dataLen = 0;
       meta->pds2.sect2.wx.maxLen = 0;
    } else if (meta->pds2.sect2.ptrType == GS2_HAZARD) {
       for (i = 0; i < meta->pds2.sect2.hazard.dataLen; i++) {
-         free (meta->pds2.sect2.hazard.data[i]);
          FreeHazardString (&(meta->pds2.sect2.hazard.haz[i]));
       }
-      free (meta->pds2.sect2.hazard.haz);
-      meta->pds2.sect2.hazard.haz = NULL;
-      free (meta->pds2.sect2.hazard.data);
-      meta->pds2.sect2.hazard.data = NULL;
-      free (meta->pds2.sect2.hazard.f_valid);
-      meta->pds2.sect2.hazard.f_valid = NULL;
       meta->pds2.sect2.hazard.dataLen = 0;
       meta->pds2.sect2.hazard.maxLen = 0;
    } else {
@@ -139,27 +138,79 @@ void MetaSect2Free (grib_MetaData *meta)
 }
 
 /*****************************************************************************
- * MetaFree() --
+ * MetaSect2Free() --
  *
  * Arthur Taylor / MDL
  *
  * PURPOSE
- *   To free a grib_metaData structure.
+ *   To free the section 2 data in the grib_metaData structure.
  *
  * ARGUMENTS
- * meta = The structure to free. (Output)
+ * meta = The structure to free. (Input/Output)
  *
  * FILES/DATABASES: None
  *
  * RETURNS: void
  *
  * HISTORY
- *   9/2002 Arthur Taylor (MDL/RSIS): Created.
+ *   2/2003 Arthur Taylor (MDL/RSIS): Created.
+ *   3/2003 AAT: Cleaned up declaration of variable: WxType.
+ *  10/2026 AAT: Also frees the tables that MetaSect2Recycle kept.
  *
  * NOTES
  *****************************************************************************
  */
-void MetaFree (grib_MetaData *meta)
+void MetaSect2Free (grib_MetaData *meta)
+{
+   MetaSect2Recycle (meta);
+   free (meta->pds2.sect2.wx.ugly);
+   meta->pds2.sect2.wx.ugly = NULL;
+   free (meta->pds2.sect2.wx.data);
+   meta->pds2.sect2.wx.data = NULL;
+   free (meta->pds2.sect2.wx.f_valid);
+   meta->pds2.sect2.wx.f_valid = NULL;
+   meta->pds2.sect2.wx.dataMax = 0;
+   free (meta->pds2.sect2.wx.buff);
+   meta->pds2.sect2.wx.buff = NULL;
+   meta->pds2.sect2.wx.buffLen = 0;
+   free (meta->pds2.sect2.hazard.haz);
+   meta->pds2.sect2.hazard.haz = NULL;
+   free (meta->pds2.sect2.hazard.data);
+   meta->pds2.sect2.hazard.data = NULL;
+   free (meta->pds2.sect2.hazard.f_valid);
+   meta->pds2.sect2.hazard.f_valid = NULL;
+   meta->pds2.sect2.hazard.dataMax = 0;
+   free (meta->pds2.sect2.hazard.buff);
+   meta->pds2.sect2.hazard.buff = NULL;
+   meta->pds2.sect2.hazard.buffLen = 0;
+}
+
+/*****************************************************************************
+ * MetaRecycle() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To free a grib_metaData structure between grids of a long run (such as
+ * genProbe), keeping the section 2 tables sized to the largest grid seen so
+ * far, so that they aren't freed and re-allocated for each grid.
+ *
+ * ARGUMENTS
+ * meta = The structure to recycle. (Input/Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created (from MetaFree).
+ *
+ * NOTES
+ * 1) Call MetaFree (not MetaInit) when done with the structure.
+ * 2) meta->numSaved counts the allocations saved by reusing the tables.
+ *****************************************************************************
+ */
+void MetaRecycle (grib_MetaData *meta)
 {
    free (meta->pds2.sect4.bands);
    meta->pds2.sect4.bands = NULL;
@@ -167,7 +218,7 @@ void MetaFree (grib_MetaData *meta)
    free (meta->pds2.sect4.Interval);
    meta->pds2.sect4.Interval = NULL;
    meta->pds2.sect4.numInterval = 0;
-   MetaSect2Free (meta);
+   MetaSect2Recycle (meta);
    free (meta->unitName);
    meta->unitName = NULL;
    meta->convert = 0;
@@ -181,6 +232,142 @@ void MetaFree (grib_MetaData *meta)
    meta->longFstLevel = NULL;
 }
 
+/*****************************************************************************
+ * MetaFree() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To free a grib_metaData structure.
+ *
+ * ARGUMENTS
+ * meta = The structure to free. (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *   9/2002 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Uses MetaRecycle.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+void MetaFree (grib_MetaData *meta)
+{
+   MetaRecycle (meta);
+   MetaSect2Free (meta);
+}
+
+/*****************************************************************************
+ * MetaWxReserve() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Makes sure that the weather table has room for numData strings (in
+ * data, f_valid and ugly), and that its string buffer has room for buffLen
+ * characters.  The tables only grow, so once they are large enough the next
+ * grids reuse them without allocating.
+ *
+ * ARGUMENTS
+ *      Wx = The weather table to grow. (Input/Output)
+ * numData = The number of strings needed. (Input)
+ * buffLen = The number of characters (including the '\0's) needed. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *    The number of allocations made (0 if the tables were large enough).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) Growing buff moves the strings, so call this with the final buffLen
+ *    before setting data[] to point into buff.
+ *****************************************************************************
+ */
+int MetaWxReserve (sect2_WxType *Wx, uInt4 numData, uInt4 buffLen)
+{
+   int numAlloc = 0;    /* The number of allocations made. */
+
+   if (numData > Wx->dataMax) {
+      if (numData < 2 * Wx->dataMax) {
+         numData = 2 * Wx->dataMax;
+      }
+      Wx->dataMax = numData;
+      Wx->data = (char **) realloc ((void *) Wx->data,
+                                    Wx->dataMax * sizeof (char *));
+      Wx->ugly = (UglyStringType *) realloc ((void *) Wx->ugly,
+                                             Wx->dataMax *
+                                             sizeof (UglyStringType));
+      Wx->f_valid = (uChar *) realloc ((void *) Wx->f_valid,
+                                       Wx->dataMax * sizeof (uChar));
+      numAlloc += 3;
+   }
+   if (buffLen > Wx->buffLen) {
+      Wx->buffLen = buffLen;
+      Wx->buff = (char *) realloc ((void *) Wx->buff,
+                                   Wx->buffLen * sizeof (char));
+      numAlloc++;
+   }
+   return numAlloc;
+}
+
+/*****************************************************************************
+ * MetaHazardReserve() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Same as MetaWxReserve, but for the hazard table.
+ *
+ * ARGUMENTS
+ *  Hazard = The hazard table to grow. (Input/Output)
+ * numData = The number of strings needed. (Input)
+ * buffLen = The number of characters (including the '\0's) needed. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *    The number of allocations made (0 if the tables were large enough).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int MetaHazardReserve (sect2_HazardType *Hazard, uInt4 numData,
+                              uInt4 buffLen)
+{
+   int numAlloc = 0;    /* The number of allocations made. */
+
+   if (numData > Hazard->dataMax) {
+      if (numData < 2 * Hazard->dataMax) {
+         numData = 2 * Hazard->dataMax;
+      }
+      Hazard->dataMax = numData;
+      Hazard->data = (char **) realloc ((void *) Hazard->data,
+                                        Hazard->dataMax * sizeof (char *));
+      Hazard->haz = (HazardStringType *) realloc ((void *) Hazard->haz,
+                                                  Hazard->dataMax *
+                                                  sizeof (HazardStringType));
+      Hazard->f_valid = (uChar *) realloc ((void *) Hazard->f_valid,
+                                           Hazard->dataMax * sizeof (uChar));
+      numAlloc += 3;
+   }
+   if (buffLen > Hazard->buffLen) {
+      Hazard->buffLen = buffLen;
+      Hazard->buff = (char *) realloc ((void *) Hazard->buff,
+                                       Hazard->buffLen * sizeof (char));
+      numAlloc++;
+   }
+   return numAlloc;
+}
+
 /*****************************************************************************
  * ParseTime() --
  *
@@ -390,6 +577,8 @@ static int ParseSect1 (sInt4 *is1, sInt4 ns1, grib_MetaData *meta)
  *      Wx = The weather structure to fill. (Output)
  * simpVer = The version of the simple weather code to use when parsing the
  *           WxString. (Input)
+ * numSaved = Incremented by the allocations saved by reusing Wx's tables.
+ *           (Input/Output)
  *
  * FILES/DATABASES: None
  *
@@ -409,13 +598,16 @@ static int ParseSect1 (sInt4 *is1, sInt4 ns1, grib_MetaData *meta)
  *          2) buffLen could have increased out of bounds of buffer.
  *   8/2003 AAT: Found an invalid "assertion" when dealing with non-NULL
  *          terminated weather groups.
+ *  10/2026 AAT: Store the strings in Wx->buff, and reuse the tables from
+ *          the last grid (see MetaWxReserve).
  *
  * NOTES
  * 1) May want to rewrite so that we don't need 'meta->sect2NumGroups'
  *****************************************************************************
  */
 static int ParseSect2_Wx (float *rdat, sInt4 nrdat, sInt4 *idat,
-                          uInt4 nidat, sect2_WxType *Wx, int simpVer)
+                          uInt4 nidat, sect2_WxType *Wx, int simpVer,
+                          uInt4 *numSaved)
 {
    size_t loc;          /* Where we currently are in idat. */
    size_t groupLen;     /* Length of current group in idat. */
@@ -425,6 +617,7 @@ static int ParseSect2_Wx (float *rdat, sInt4 nrdat, sInt4 *idat,
    int len;             /* length of current english phrases during creation
                          * of the maxEng[] data. */
    int i;               /* assists in traversing the maxEng[] array. */
+   int numAlloc;        /* Number of allocations made to grow the table. */
 
    if (nrdat < 1) {
       return -1;
@@ -436,7 +629,6 @@ static int ParseSect2_Wx (float *rdat, sInt4 nrdat, sInt4 *idat,
       return -2;
    }
    Wx->dataLen = 0;
-   Wx->data = NULL;
    Wx->maxLen = 0;
    for (i = 0; i < NUM_UGLY_WORD; i++) {
       Wx->maxEng[i] = 0;
@@ -456,26 +648,26 @@ static int ParseSect2_Wx (float *rdat, sInt4 nrdat, sInt4 *idat,
       return -1;
    }
 
+   /* The strings are stored one after the other in Wx->buff, which is
+    * reused from the last grid if it is big enough.  Since each character
+    * comes from a different idat element, nidat + 1 is enough room. */
+   numAlloc = MetaWxReserve (Wx, 0, nidat + 1);
    buffLen = 0;
-   buffer = (char *) malloc ((nidat + 1) * sizeof (char));
+   buffer = Wx->buff;
    while (groupLen > 0) {
       for (j = 0; j < groupLen; j++) {
          buffer[buffLen] = (char) idat[loc];
          buffLen++;
          loc++;
          if (buffer[buffLen - 1] == '\0') {
-            Wx->dataLen++;
-            Wx->data = (char **) realloc ((void *) Wx->data,
-                                          Wx->dataLen * sizeof (char *));
-            /* This is done after the realloc, just to make sure we have
-             * enough memory allocated.  */
+            numAlloc += MetaWxReserve (Wx, Wx->dataLen + 1, 0);
             /* Assert: buffLen is 1 more than strlen(buffer). */
-            Wx->data[Wx->dataLen - 1] = (char *)
-                  malloc (buffLen * sizeof (char));
-            strcpy (Wx->data[Wx->dataLen - 1], buffer);
+            Wx->data[Wx->dataLen] = buffer;
+            Wx->dataLen++;
             if (Wx->maxLen < buffLen) {
                Wx->maxLen = buffLen;
             }
+            buffer += buffLen;
             buffLen = 0;
          }
       }
@@ -489,7 +681,8 @@ static int ParseSect2_Wx (float *rdat, sInt4 nrdat, sInt4 *idat,
             /* Note: This also assures that buffLen stays <= nidat. */
             if (loc + groupLen >= nidat) {
                errSprintf ("ERROR: Ran out of idat data\n");
-               free (buffer);
+               /* None of the strings have been parsed into ugly yet. */
+               Wx->dataLen = 0;
                return -1;
             }
          }
@@ -497,22 +690,21 @@ static int ParseSect2_Wx (float *rdat, sInt4 nrdat, sInt4 *idat,
    }
    if (buffLen != 0) {
       buffer[buffLen] = '\0';
-      Wx->dataLen++;
-      Wx->data = (char **) realloc ((void *) Wx->data,
-                                    Wx->dataLen * sizeof (char *));
+      numAlloc += MetaWxReserve (Wx, Wx->dataLen + 1, 0);
       /* Assert: buffLen is 1 more than strlen(buffer). -- FALSE -- */
       buffLen = strlen (buffer) + 1;
 
-      Wx->data[Wx->dataLen - 1] = (char *) malloc (buffLen * sizeof (char));
+      Wx->data[Wx->dataLen] = buffer;
+      Wx->dataLen++;
       if (Wx->maxLen < buffLen) {
          Wx->maxLen = buffLen;
       }
-      strcpy (Wx->data[Wx->dataLen - 1], buffer);
    }
-   free (buffer);
-   Wx->ugly = (UglyStringType *) malloc (Wx->dataLen *
-                                         sizeof (UglyStringType));
-   Wx->f_valid = (uChar *) malloc (Wx->dataLen * sizeof (uChar));
+   /* Without the reused tables, we would have allocated buffer, each
+    * string, data for each string, ugly, and f_valid. */
+   if (numAlloc < 3 + 2 * (int) Wx->dataLen) {
+      *numSaved += 3 + 2 * Wx->dataLen - numAlloc;
+   }
    for (j = 0; j < Wx->dataLen; j++) {
       if (ParseUglyString (&(Wx->ugly[j]), Wx->data[j], simpVer) == 0) {
          Wx->f_valid[j] = 1;
@@ -537,7 +729,8 @@ static int ParseSect2_Wx (float *rdat, sInt4 nrdat, sInt4 *idat,
 }
 
 static int ParseSect2_Hazard (float *rdat, sInt4 nrdat, sInt4 *idat,
-                          uInt4 nidat, sect2_HazardType *Hazard, int simpWWA)
+                          uInt4 nidat, sect2_HazardType *Hazard, int simpWWA,
+                          uInt4 *numSaved)
 {
    size_t loc;          /* Where we currently are in idat. */
    size_t groupLen;     /* Length of current group in idat. */
@@ -547,6 +740,7 @@ static int ParseSect2_Hazard (float *rdat, sInt4 nrdat, sInt4 *idat,
    int i;               /* assists in traversing the maxEng[] array. */
    char *buffer;        /* Used to store the current Hazard string. */
    int buffLen;         /* Length of current Hazard string. */
+   int numAlloc;        /* Number of allocations made to grow the table. */
 /*
    int k;
 */
@@ -561,7 +755,6 @@ static int ParseSect2_Hazard (float *rdat, sInt4 nrdat, sInt4 *idat,
       return -2;
    }
    Hazard->dataLen = 0;
-   Hazard->data = NULL;
    Hazard->maxLen = 0;
    for (j = 0; j < NUM_HAZARD_WORD; j++) {
       Hazard->maxEng[j] = 0;
@@ -581,26 +774,24 @@ static int ParseSect2_Hazard (float *rdat, sInt4 nrdat, sInt4 *idat,
       return -1;
    }
 
+   /* See ParseSect2_Wx for how the strings are stored in Hazard->buff. */
+   numAlloc = MetaHazardReserve (Hazard, 0, nidat + 1);
    buffLen = 0;
-   buffer = (char *) malloc ((nidat + 1) * sizeof (char));
+   buffer = Hazard->buff;
    while (groupLen > 0) {
       for (j = 0; j < groupLen; j++) {
          buffer[buffLen] = (char) idat[loc];
          buffLen++;
          loc++;
          if (buffer[buffLen - 1] == '\0') {
-            Hazard->dataLen++;
-            Hazard->data = (char **) realloc ((void *) Hazard->data,
-                                          Hazard->dataLen * sizeof (char *));
-            /* This is done after the realloc, just to make sure we have
-             * enough memory allocated.  */
+            numAlloc += MetaHazardReserve (Hazard, Hazard->dataLen + 1, 0);
             /* Assert: buffLen is 1 more than strlen(buffer). */
-            Hazard->data[Hazard->dataLen - 1] = (char *)
-                  malloc (buffLen * sizeof (char));
-            strcpy (Hazard->data[Hazard->dataLen - 1], buffer);
+            Hazard->data[Hazard->dataLen] = buffer;
+            Hazard->dataLen++;
             if (Hazard->maxLen < buffLen) {
                Hazard->maxLen = buffLen;
             }
+            buffer += buffLen;
             buffLen = 0;
          }
       }
@@ -614,7 +805,8 @@ static int ParseSect2_Hazard (float *rdat, sInt4 nrdat, sInt4 *idat,
             /* Note: This also assures that buffLen stays <= nidat. */
             if (loc + groupLen >= nidat) {
                errSprintf ("ERROR: Ran out of idat data\n");
-               free (buffer);
+               /* None of the strings have been parsed into haz yet. */
+               Hazard->dataLen = 0;
                return -1;
             }
          }
@@ -622,22 +814,21 @@ static int ParseSect2_Hazard (float *rdat, sInt4 nrdat, sInt4 *idat,
    }
    if (buffLen != 0) {
       buffer[buffLen] = '\0';
-      Hazard->dataLen++;
-      Hazard->data = (char **) realloc ((void *) Hazard->data,
-                                    Hazard->dataLen * sizeof (char *));
+      numAlloc += MetaHazardReserve (Hazard, Hazard->dataLen + 1, 0);
       /* Assert: buffLen is 1 more than strlen(buffer). -- FALSE -- */
       buffLen = strlen (buffer) + 1;
 
-      Hazard->data[Hazard->dataLen - 1] = (char *) malloc (buffLen * sizeof (char));
+      Hazard->data[Hazard->dataLen] = buffer;
+      Hazard->dataLen++;
       if (Hazard->maxLen < buffLen) {
          Hazard->maxLen = buffLen;
       }
-      strcpy (Hazard->data[Hazard->dataLen - 1], buffer);
    }
-   free (buffer);
-   Hazard->haz = (HazardStringType *) malloc (Hazard->dataLen *
-                                         sizeof (HazardStringType));
-   Hazard->f_valid = (uChar *) malloc (Hazard->dataLen * sizeof (uChar));
+   /* Without the reused tables, we would have allocated buffer, each
+    * string, data for each string, haz, and f_valid. */
+   if (numAlloc < 3 + 2 * (int) Hazard->dataLen) {
+      *numSaved += 3 + 2 * Hazard->dataLen - numAlloc;
+   }
    for (j = 0; j < Hazard->dataLen; j++) {
       ParseHazardString (&(Hazard->haz[j]), Hazard->data[j], simpWWA);
       Hazard->f_valid[j] = 1;
@@ -1984,6 +2175,7 @@ static int ParseSect5 (sInt4 *is5, sInt4 ns5, grib_MetaData *meta,
  *
  * HISTORY
  *   9/2002 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Recycle (rather than free) the section 2 tables.
  *
  * NOTES
  *****************************************************************************
@@ -2201,18 +2393,20 @@ int MetaParse (grib_MetaData *meta, sInt4 *is0, sInt4 ns0,
 
    /* Continue parsing section 2 data. */
    if (meta->pds2.f_sect2) {
-      MetaSect2Free (meta);
+      MetaSect2Recycle (meta);
       if (strcmp (meta->element, "Wx") == 0) {
          meta->pds2.sect2.ptrType = GS2_WXTYPE;
          if ((ierr = ParseSect2_Wx (rdat, nrdat, idat, nidat,
-                                    &(meta->pds2.sect2.wx), simpVer)) != 0) {
+                                    &(meta->pds2.sect2.wx), simpVer,
+                                    &(meta->numSaved))) != 0) {
             preErrSprintf ("Parse error Section 2 : Weather Data\n");
             return ierr;
          }
       } else if (strcmp (meta->element, "WWA") == 0) {
          meta->pds2.sect2.ptrType = GS2_HAZARD;
          if ((ierr = ParseSect2_Hazard (rdat, nrdat, idat, nidat,
-                                    &(meta->pds2.sect2.hazard), simpWWA)) != 0) {
+                                    &(meta->pds2.sect2.hazard), simpWWA,
+                                    &(meta->numSaved))) != 0) {
             preErrSprintf ("Parse error Section 2 : Hazard Data\n");
             return ierr;
          }
@@ -2237,6 +2431,143 @@ int MetaParse (grib_MetaData *meta, sInt4 *is0, sInt4 ns0,
    return 0;
 }
 
+/*****************************************************************************
+ * GridPut() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Stores a value in the grid ParseGrid is filling in, which is either a
+ * double grid (ParseGrid) or a float grid (ParseGridFlt).  Values stored in
+ * a float grid are first rounded to shift (see note 1).
+ *
+ * ARGUMENTS
+ * grib_Data = The double grid (or NULL). (Output)
+ *  flt_Data = The float grid (or NULL). (Output)
+ *     shift = 10^decimal to round a float value to, or 0 to store it as is
+ *             (missing values). (Input)
+ *     index = Where to store the value. (Input)
+ *     value = The value to store. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ * 1) The .flt and NetCDF writers round each value to -Decimal places and
+ *    then store it as a float.  Rounding a value after it is already a
+ *    float can give a different answer, so ParseGridFlt rounds the same way
+ *    first.  The writers' own rounding then leaves the value alone.
+ *****************************************************************************
+ */
+static void GridPut (double *grib_Data, float *flt_Data, double shift,
+                     sInt4 index, double value)
+{
+   if (flt_Data != NULL) {
+      if (shift != 0) {
+         value = floor (value * shift + .5) / shift;
+      }
+      flt_Data[index] = (float) value;
+   } else {
+      grib_Data[index] = value;
+   }
+}
+
+/* Returns the value GridPut stored at index. */
+static double GridGet (const double *grib_Data, const float *flt_Data,
+                       sInt4 index)
+{
+   if (flt_Data != NULL) {
+      return flt_Data[index];
+   }
+   return grib_Data[index];
+}
+
+/*****************************************************************************
+ * ConvertRowNoMiss() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   A helper function for ParseGridNoMiss.  Converts the units of one row of
+ * a float or integer grid which has no missing values, no bitmap, and no
+ * wx/hazard table, and finds the max/min of the row.  The loop is kept
+ * simple so the compiler can vectorize it.
+ *
+ * ARGUMENTS
+ * grib_Data = The place to store the row (or NULL). (Output)
+ *  flt_Data = The place to store the row as floats (or NULL). (Output)
+ *     shift = 10^decimal to round the float values to (see GridPut). (In)
+ *      iain = The start of the row if it is an Integer grid (or NULL) (In)
+ *       ain = The start of the row if it is a float grid (or NULL) (Input)
+ *       num = The number of values in the row (Input)
+ *     unitM = M in unit conversion equation y(new) = m x(orig) + b (Input)
+ *     unitB = B in unit conversion equation y(new) = m x(orig) + b (Input)
+ *       min = The max/min so far, which have to be valid. (Input/Output)
+ *       max = (see min)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *  10/2026 AAT: Added flt_Data (for ParseGridFlt).
+ *
+ * NOTES
+ * 1) "min = (value < min) ? value : min" gives the same answer as the
+ *    "if (value < min) ... else if (value > max)" used elsewhere, but has no
+ *    branch.
+ *****************************************************************************
+ */
+static void ConvertRowNoMiss (double *grib_Data, float *flt_Data,
+                              double shift, const sInt4 *iain,
+                              const float *ain, sInt4 num, double unitM,
+                              double unitB, double *min, double *max)
+{
+   sInt4 x;             /* Where we are in the row. */
+   double value;        /* The data in the new units. */
+   double lclMin = *min; /* Local copies of min / max. */
+   double lclMax = *max;
+
+   if (flt_Data != NULL) {
+      if (iain != NULL) {
+         for (x = 0; x < num; x++) {
+            value = unitM * iain[x] + unitB;
+            lclMin = (value < lclMin) ? value : lclMin;
+            lclMax = (value > lclMax) ? value : lclMax;
+            flt_Data[x] = (float) (floor (value * shift + .5) / shift);
+         }
+      } else {
+         for (x = 0; x < num; x++) {
+            value = unitM * ain[x] + unitB;
+            lclMin = (value < lclMin) ? value : lclMin;
+            lclMax = (value > lclMax) ? value : lclMax;
+            flt_Data[x] = (float) (floor (value * shift + .5) / shift);
+         }
+      }
+   } else if (iain != NULL) {
+      for (x = 0; x < num; x++) {
+         value = unitM * iain[x] + unitB;
+         lclMin = (value < lclMin) ? value : lclMin;
+         lclMax = (value > lclMax) ? value : lclMax;
+         grib_Data[x] = value;
+      }
+   } else {
+      for (x = 0; x < num; x++) {
+         value = unitM * ain[x] + unitB;
+         lclMin = (value < lclMin) ? value : lclMin;
+         lclMax = (value > lclMax) ? value : lclMax;
+         grib_Data[x] = value;
+      }
+   }
+   *min = lclMin;
+   *max = lclMax;
+}
+
 /*****************************************************************************
  * ParseGridNoMiss() --
  *
@@ -2248,14 +2579,20 @@ int MetaParse (grib_MetaData *meta, sInt4 *is0, sInt4 ns0,
  *   Walks through either a float or an integer grid, computing the min/max
  * values in the grid, and converts the units. It uses gridAttrib info for the
  * missing values and it updates gridAttrib with the observed min/max values.
+ *   If the field has a bitmap, the points the bitmap marks as missing are set
+ * to 9999 (and counted) in the same pass, and left out of the min/max.
  *
  * ARGUMENTS
  *    attrib = Grid Attribute structure already filled in (Input/Output)
- * grib_Data = The place to store the grid data. (Output)
+ * grib_Data = The place to store the grid data (or NULL). (Output)
+ *  flt_Data = The place to store the grid data as floats (or NULL). (Output)
+ *     shift = 10^decimal to round the float values to (see GridPut). (In)
  *    Nx, Ny = The dimensions of the grid (Input)
  *      iain = Place to find data if it is an Integer (or float). (Input)
+ *        ib = The bitmap (1 = valid), or NULL if there is none. (Input)
  *     unitM = M in unit conversion equation y(new) = m x(orig) + b (Input)
  *     unitB = B in unit conversion equation y(new) = m x(orig) + b (Input)
+ *   missCnt = Number of missing values (only counted if ib) (Input/Output)
  *    f_txtType = true if we have a valid wx/hazard type. (Input)
  *  txt_dataLen = Length of text table
  *  txt_f_valid = whether that entry is used/valid. (Input)
@@ -2274,88 +2611,145 @@ int MetaParse (grib_MetaData *meta, sInt4 *is0, sInt4 ns0,
  *          valid to 2, otherwise leaves it at 1.  If table valid is 0 then
  *          sets value to missing value (if applicable).
  *   2/2004 AAT: Added the subgrid capability.
+ *  10/2026 AAT: Fixed subgrids which start west of the grid (the data
+ *          pointer wasn't advanced for the points off the grid).
+ *  10/2026 AAT: Added ib, so ParseGrid doesn't need a second pass over the
+ *          grid for the bitmap.  Split each row into the part off / on the
+ *          grid, and use ConvertRowNoMiss for the common case.
+ *  10/2026 AAT: Added flt_Data (for ParseGridFlt).
  *
  * NOTES
  * 1) Don't have to check if value became missing value, because we can check
  *    if missing falls in the range of the min/max converted units.  If
  *    missing does fall in that range we need to move missing.
  *    (See f_readjust in ParseGrid)
+ * 2) Points of the subgrid off the original grid are 9999, and are only
+ *    counted as missing if there is a bitmap (as ParseGrid used to do).
+ * 3) The wx/hazard table is marked for every point, even the ones the bitmap
+ *    marks as missing (as ParseGrid used to do).
  *****************************************************************************
  */
 static void ParseGridNoMiss (gridAttribType *attrib, double *grib_Data,
-                             sInt4 Nx, sInt4 Ny, sInt4 *iain,
-                             double unitM, double unitB,
+                             float *flt_Data, double shift, sInt4 Nx,
+                             sInt4 Ny, sInt4 *iain, sInt4 *ib,
+                             double unitM, double unitB, sInt4 *missCnt,
                              uChar f_txtType, uInt4 txt_dataLen,
                              uChar *txt_f_valid, int startX, int startY,
                              int subNx, int subNy)
 {
    sInt4 x, y;          /* Where we are in the grid. */
+   sInt4 x1, x2;        /* The part of the row on the grid is [x1, x2). */
+   sInt4 offset;        /* Where the row starts in iain / ib. */
    double value;        /* The data in the new units. */
    uChar f_maxmin = 0;  /* Flag if max/min is valid yet. */
    uInt4 index;         /* Current index into Wx table. */
+   sInt4 n = 0;         /* Where we are in grib_Data / flt_Data. */
    sInt4 *itemp = NULL;
    float *ftemp = NULL;
 
+   /* Find which part of each row is on the grid. (see note 2) */
+   x1 = (startX < 1) ? 1 - startX : 0;
+   x2 = (startX - 1 + subNx > Nx) ? Nx - startX + 1 : subNx;
+   if (x1 > subNx) {
+      x1 = subNx;
+   }
+   if (x2 < x1) {
+      x2 = x1;
+   }
+
    /* Resolve possibility that the data is an integer or a float and find
     * max/min values. (see note 1) */
    for (y = 0; y < subNy; y++) {
       if (((startY + y - 1) < 0) || ((startY + y - 1) >= Ny)) {
          for (x = 0; x < subNx; x++) {
-            *grib_Data++ = 9999;
+            GridPut (grib_Data, flt_Data, 0, n++, 9999);
+         }
+         if (ib != NULL) {
+            *missCnt += subNx;
          }
+         continue;
+      }
+      for (x = 0; x < x1; x++) {
+         GridPut (grib_Data, flt_Data, 0, n++, 9999);
+      }
+      offset = (startY + y - 1) * Nx + (startX - 1);
+      if (attrib->fieldType) {
+         itemp = iain + offset;
       } else {
-         if (attrib->fieldType) {
-            itemp = iain + (startY + y - 1) * Nx + (startX - 1);
-         } else {
-            ftemp = ((float *) iain) + (startY + y - 1) * Nx + (startX - 1);
+         ftemp = ((float *) iain) + offset;
+      }
+      if ((ib == NULL) && (!f_txtType) && (unitM != -10) && (x1 < x2)) {
+         /* The common case. */
+         if (!f_maxmin) {
+            if (attrib->fieldType) {
+               attrib->min = attrib->max = unitM * itemp[x1] + unitB;
+            } else {
+               attrib->min = attrib->max = unitM * ftemp[x1] + unitB;
+            }
+            f_maxmin = 1;
          }
-         for (x = 0; x < subNx; x++) {
-            if (((startX + x - 1) < 0) || ((startX + x - 1) >= Nx)) {
-               *grib_Data++ = 9999;
+         ConvertRowNoMiss ((grib_Data != NULL) ? grib_Data + n : NULL,
+                           (flt_Data != NULL) ? flt_Data + n : NULL, shift,
+                           (attrib->fieldType) ? itemp + x1 : NULL,
+                           (attrib->fieldType) ? NULL : ftemp + x1, x2 - x1,
+                           unitM, unitB, &(attrib->min), &(attrib->max));
+         n += x2 - x1;
+      } else {
+         for (x = x1; x < x2; x++) {
+            /* Convert the units. */
+            if (attrib->fieldType) {
+               if (unitM == -10) {
+                  value = pow (10, itemp[x]);
+               } else {
+                  value = unitM * itemp[x] + unitB;
+               }
             } else {
-               /* Convert the units. */
-               if (attrib->fieldType) {
-                  if (unitM == -10) {
-                     value = pow (10, (*itemp++));
-                  } else {
-                     value = unitM * (*itemp++) + unitB;
-                  }
+               if (unitM == -10) {
+                  value = pow (10, ftemp[x]);
                } else {
-                  if (unitM == -10) {
-                     value = pow (10, (*ftemp++));
-                  } else {
-                     value = unitM * (*ftemp++) + unitB;
-                  }
+                  value = unitM * ftemp[x] + unitB;
                }
-               if (f_txtType) {
-                  index = (uInt4) value;
-                  if (index < txt_dataLen) {
-                     if (txt_f_valid[index] == 1) {
-                        txt_f_valid[index] = 2;
-                     } else if (txt_f_valid[index] == 0) {
-                        /* Table is not valid here so set value to missing? */
-                        /* No missing value, so use index = WxType->dataLen? */
-                        /* No... set f_valid to 3 so we know we used this
-                         * invalid element, then handle it in degrib2.c ::
-                         * ReadGrib2Record() where we set it back to 0. */
-                        txt_f_valid[index] = 3;
-                     }
+            }
+            if (f_txtType) {
+               index = (uInt4) value;
+               if (index < txt_dataLen) {
+                  if (txt_f_valid[index] == 1) {
+                     txt_f_valid[index] = 2;
+                  } else if (txt_f_valid[index] == 0) {
+                     /* Table is not valid here so set value to missing? */
+                     /* No missing value, so use index = WxType->dataLen? */
+                     /* No... set f_valid to 3 so we know we used this
+                      * invalid element, then handle it in degrib2.c ::
+                      * ReadGrib2Record() where we set it back to 0. */
+                     txt_f_valid[index] = 3;
                   }
                }
-               if (f_maxmin) {
-                  if (value < attrib->min) {
-                     attrib->min = value;
-                  } else if (value > attrib->max) {
-                     attrib->max = value;
-                  }
-               } else {
-                  attrib->min = attrib->max = value;
-                  f_maxmin = 1;
+            }
+            /* See note 3. */
+            if ((ib != NULL) && (ib[offset + x] != 1)) {
+               GridPut (grib_Data, flt_Data, 0, n++, 9999);
+               (*missCnt)++;
+               continue;
+            }
+            if (f_maxmin) {
+               if (value < attrib->min) {
+                  attrib->min = value;
+               } else if (value > attrib->max) {
+                  attrib->max = value;
                }
-               *grib_Data++ = value;
+            } else {
+               attrib->min = attrib->max = value;
+               f_maxmin = 1;
             }
+            GridPut (grib_Data, flt_Data, shift, n++, value);
          }
       }
+      for (x = x2; x < subNx; x++) {
+         GridPut (grib_Data, flt_Data, 0, n++, 9999);
+      }
+      if (ib != NULL) {
+         *missCnt += subNx - (x2 - x1);
+      }
    }
    attrib->f_maxmin = f_maxmin;
 }
@@ -2374,7 +2768,9 @@ static void ParseGridNoMiss (gridAttribType *attrib, double *grib_Data,
  *
  * ARGUMENTS
  *    attrib = sect 5 structure already filled in by ParseSect5 (In/Output)
- * grib_Data = The place to store the grid data. (Output)
+ * grib_Data = The place to store the grid data (or NULL). (Output)
+ *  flt_Data = The place to store the grid data as floats (or NULL). (Output)
+ *     shift = 10^decimal to round the float values to (see GridPut). (In)
  *    Nx, Ny = The dimensions of the grid (Input)
  *      iain = Place to find data if it is an Integer (or float). (Input)
  *     unitM = M in unit conversion equation y(new) = m x(orig) + b (Input)
@@ -2397,6 +2793,9 @@ static void ParseGridNoMiss (gridAttribType *attrib, double *grib_Data,
  *          valid to 2, otherwise leaves it at 1.  If table valid is 0 then
  *          sets value to missing value (if applicable).
  *   2/2004 AAT: Added the subgrid capability.
+ *  10/2026 AAT: Fixed subgrids which start west of the grid (the data
+ *          pointer wasn't advanced for the points off the grid).
+ *  10/2026 AAT: Added flt_Data (for ParseGridFlt).
  *
  * NOTES
  * 1) Don't have to check if value became missing value, because we can check
@@ -2406,7 +2805,8 @@ static void ParseGridNoMiss (gridAttribType *attrib, double *grib_Data,
  *****************************************************************************
  */
 static void ParseGridPrimMiss (gridAttribType *attrib, double *grib_Data,
-                               sInt4 Nx, sInt4 Ny, sInt4 *iain,
+                               float *flt_Data, double shift, sInt4 Nx,
+                               sInt4 Ny, sInt4 *iain,
                                double unitM, double unitB, sInt4 *missCnt,
                                uChar f_txtType, uInt4 txt_dataLen,
                                uChar *txt_f_valid,
@@ -2416,6 +2816,7 @@ static void ParseGridPrimMiss (gridAttribType *attrib, double *grib_Data,
    double value;        /* The data in the new units. */
    uChar f_maxmin = 0;  /* Flag if max/min is valid yet. */
    uInt4 index;         /* Current index into Wx table. */
+   sInt4 n = 0;         /* Where we are in grib_Data / flt_Data. */
    sInt4 *itemp = NULL;
    float *ftemp = NULL;
 /*   float *ain = (float *) iain;*/
@@ -2425,7 +2826,7 @@ static void ParseGridPrimMiss (gridAttribType *attrib, double *grib_Data,
    for (y = 0; y < subNy; y++) {
       if (((startY + y - 1) < 0) || ((startY + y - 1) >= Ny)) {
          for (x = 0; x < subNx; x++) {
-            *grib_Data++ = attrib->missPri;
+            GridPut (grib_Data, flt_Data, 0, n++, attrib->missPri);
             (*missCnt)++;
          }
       } else {
@@ -2436,8 +2837,14 @@ static void ParseGridPrimMiss (gridAttribType *attrib, double *grib_Data,
          }
          for (x = 0; x < subNx; x++) {
             if (((startX + x - 1) < 0) || ((startX + x - 1) >= Nx)) {
-               *grib_Data++ = attrib->missPri;
+               GridPut (grib_Data, flt_Data, 0, n++, attrib->missPri);
                (*missCnt)++;
+               /* Keep itemp / ftemp in step with x. */
+               if (attrib->fieldType) {
+                  itemp++;
+               } else {
+                  ftemp++;
+               }
             } else {
                if (attrib->fieldType) {
                   value = (*itemp++);
@@ -2482,7 +2889,9 @@ static void ParseGridPrimMiss (gridAttribType *attrib, double *grib_Data,
                      }
                   }
                }
-               *grib_Data++ = value;
+               /* Don't round a missing value (see GridPut). */
+               GridPut (grib_Data, flt_Data,
+                        (value == attrib->missPri) ? 0 : shift, n++, value);
             }
          }
       }
@@ -2504,7 +2913,9 @@ static void ParseGridPrimMiss (gridAttribType *attrib, double *grib_Data,
  *
  * ARGUMENTS
  *    attrib = sect 5 structure already filled in by ParseSect5 (In/Output)
- * grib_Data = The place to store the grid data. (Output)
+ * grib_Data = The place to store the grid data (or NULL). (Output)
+ *  flt_Data = The place to store the grid data as floats (or NULL). (Output)
+ *     shift = 10^decimal to round the float values to (see GridPut). (In)
  *    Nx, Ny = The dimensions of the grid (Input)
  *      iain = Place to find data if it is an Integer (or float). (Input)
  *     unitM = M in unit conversion equation y(new) = m x(orig) + b (Input)
@@ -2527,6 +2938,9 @@ static void ParseGridPrimMiss (gridAttribType *attrib, double *grib_Data,
  *          valid to 2, otherwise leaves it at 1.  If table valid is 0 then
  *          sets value to missing value (if applicable).
  *   2/2004 AAT: Added the subgrid capability.
+ *  10/2026 AAT: Fixed subgrids which start west of the grid (the data
+ *          pointer wasn't advanced for the points off the grid).
+ *  10/2026 AAT: Added flt_Data (for ParseGridFlt).
  *
  * NOTES
  * 1) Don't have to check if value became missing value, because we can check
@@ -2536,7 +2950,8 @@ static void ParseGridPrimMiss (gridAttribType *attrib, double *grib_Data,
  *****************************************************************************
  */
 static void ParseGridSecMiss (gridAttribType *attrib, double *grib_Data,
-                              sInt4 Nx, sInt4 Ny, sInt4 *iain,
+                              float *flt_Data, double shift, sInt4 Nx,
+                              sInt4 Ny, sInt4 *iain,
                               double unitM, double unitB, sInt4 *missCnt,
                               uChar f_txtType, uInt4 txt_dataLen,
                               uChar *txt_f_valid,
@@ -2546,6 +2961,7 @@ static void ParseGridSecMiss (gridAttribType *attrib, double *grib_Data,
    double value;        /* The data in the new units. */
    uChar f_maxmin = 0;  /* Flag if max/min is valid yet. */
    uInt4 index;         /* Current index into Wx table. */
+   sInt4 n = 0;         /* Where we are in grib_Data / flt_Data. */
    sInt4 *itemp = NULL;
    float *ftemp = NULL;
 /*   float *ain = (float *) iain;*/
@@ -2555,7 +2971,7 @@ static void ParseGridSecMiss (gridAttribType *attrib, double *grib_Data,
    for (y = 0; y < subNy; y++) {
       if (((startY + y - 1) < 0) || ((startY + y - 1) >= Ny)) {
          for (x = 0; x < subNx; x++) {
-            *grib_Data++ = attrib->missPri;
+            GridPut (grib_Data, flt_Data, 0, n++, attrib->missPri);
             (*missCnt)++;
          }
       } else {
@@ -2566,8 +2982,14 @@ static void ParseGridSecMiss (gridAttribType *attrib, double *grib_Data,
          }
          for (x = 0; x < subNx; x++) {
             if (((startX + x - 1) < 0) || ((startX + x - 1) >= Nx)) {
-               *grib_Data++ = attrib->missPri;
+               GridPut (grib_Data, flt_Data, 0, n++, attrib->missPri);
                (*missCnt)++;
+               /* Keep itemp / ftemp in step with x. */
+               if (attrib->fieldType) {
+                  itemp++;
+               } else {
+                  ftemp++;
+               }
             } else {
                if (attrib->fieldType) {
                   value = (*itemp++);
@@ -2612,7 +3034,11 @@ static void ParseGridSecMiss (gridAttribType *attrib, double *grib_Data,
                      }
                   }
                }
-               *grib_Data++ = value;
+               /* Don't round a missing value (see GridPut). */
+               GridPut (grib_Data, flt_Data,
+                        ((value == attrib->missPri) ||
+                         (value == attrib->missSec)) ? 0 : shift, n++,
+                        value);
             }
          }
       }
@@ -2621,65 +3047,44 @@ static void ParseGridSecMiss (gridAttribType *attrib, double *grib_Data,
 }
 
 /*****************************************************************************
- * ParseGrid() --
+ * ParseGridCore() --
  *
  * Arthur Taylor / MDL
  *
  * PURPOSE
- *   To walk through the 2 possible grids (and possible bitmap) created by
- * UNPK_GRIB2, and combine the info into 1 grid, at the same time computing
- * the min/max values in the grid.  It uses gridAttrib info for the missing values
- * and it then updates the gridAttrib structure for the min/max values that it
- * found.
- *   It also uses scan, and ScanIndex2XY, to parse the data and organize the
- * Grib_Data so that 0,0 is the lower left part of the grid, it then traverses
- * the row and then moved up to the next row starting on the left.
+ *   The body of ParseGrid and ParseGridFlt.  Fills in either Grib_Data (a
+ * double grid) or Flt_Data (a float grid), so the unit conversion, missing
+ * value, bitmap, and subgrid logic is the same for both.
  *
  * ARGUMENTS
- *       attrib = sect 5 structure already filled in by ParseSect5 (In/Output)
- *    Grib_Data = The place to store the grid data. (Output)
- * grib_DataLen = The current size of Grib_Data (can increase) (Input/Output)
- *       Nx, Ny = The dimensions of the grid (Input)
- *         scan = How to walk through the original grid. (Input)
- *         iain = Place to find data if it is an Integer (or float). (Input)
- *      ibitmap = Flag stating the data has a bitmap for missing values (In)
- *           ib = Where to find the bitmap if we have one (Input)
- *        unitM = M in unit conversion equation y(new) = m x(orig) + b (Input)
- *        unitB = B in unit conversion equation y(new) = m x(orig) + b (Input)
- *    f_txtType = true if we have a valid wx/hazard type. (Input)
- *  txt_dataLen = Length of text table
- *  txt_f_valid = whether that entry is used/valid. (Input)
- *    f_subGrid = True if we have a subgrid, false if not. (Input)
- * startX stopX = The bounds of the subgrid in X. (0,-1) means full grid (In)
- * startY stopY = The bounds of the subgrid in Y. (0,-1) means full grid (In)
+ *  See ParseGrid, plus:
+ *     Flt_Data = If not NULL, the float grid to fill in instead of
+ *                Grib_Data.  grib_DataLen is then the size of Flt_Data.
+ *                (Output)
+ *        shift = 10^decimal to round the Flt_Data values to (see GridPut).
+ *                (Input)
  *
  * FILES/DATABASES: None
  *
  * RETURNS: void
  *
  * HISTORY
- *   9/2002 Arthur Taylor (MDL/RSIS): Created.
- *  11/2002 AAT: Added unit conversion to metaparse.c
- *  12/2002 AAT: Optimized first loop to make it assume scan 0100 (64)
- *         (valid 99.9%), but still have slow loop for generic case.
- *   5/2003 AAT: Added ability to see if wxType occurs.  If so sets table
- *          valid to 2, otherwise leaves it at 1.  If table valid is 0 then
- *          sets value to missing value (if applicable).
- *   7/2003 AAT: added check if f_maxmin before checking if missing was in
- *          range of max, min for "readjust" check.
- *   2/2004 AAT: Added startX / startY / stopX / stopY
- *   5/2004 AAT: Found out that I used the opposite definition for bitmap
- *          0 = missing, 1 = valid.
+ *  10/2026 Arthur Taylor (MDL): Created (from ParseGrid).
  *
  * NOTES
+ * 1) The max / min are found before the values are rounded and stored as
+ *    floats.  The only exception is the bitmap pass for scan != 0100 fields
+ *    with no missing value management, which reads back what was stored.
  *****************************************************************************
  */
-void ParseGrid (gridAttribType *attrib, double **Grib_Data,
-                uInt4 *grib_DataLen, uInt4 Nx, uInt4 Ny, int scan,
-                sInt4 *iain, sInt4 ibitmap, sInt4 *ib, double unitM,
-                double unitB, uChar f_txtType, uInt4 txt_dataLen,
-                uChar *txt_f_valid,
-                uChar f_subGrid, int startX, int startY, int stopX, int stopY)
+static void ParseGridCore (gridAttribType *attrib, double **Grib_Data,
+                           float **Flt_Data, double shift,
+                           uInt4 *grib_DataLen, uInt4 Nx, uInt4 Ny, int scan,
+                           sInt4 *iain, sInt4 ibitmap, sInt4 *ib,
+                           double unitM, double unitB,
+                           uChar f_txtType, uInt4 txt_dataLen,
+                           uChar *txt_f_valid, uChar f_subGrid, int startX,
+                           int startY, int stopX, int stopY)
 {
    double xmissp;       /* computed missing value needed for ibitmap = 1,
                          * Also used if unit conversion causes confusion
@@ -2691,13 +3096,18 @@ void ParseGrid (gridAttribType *attrib, double **Grib_Data,
    uInt4 scanIndex;     /* Where we are in the original grid. */
    sInt4 x, y;          /* Where we are in a grid of scan value 0100 */
    sInt4 newIndex;      /* x,y in a 1 dimensional array. */
+   sInt4 col, row;      /* Where a subgrid point is in the original grid. */
    double value;        /* The data in the new units. */
-   double *grib_Data;   /* A pointer to Grib_Data for ease of manipulation. */
+   double valShift;     /* shift, or 0 if value is missing (see GridPut). */
+   double *grib_Data = NULL; /* A pointer to Grib_Data for ease of
+                         * manipulation (NULL if filling in Flt_Data). */
+   float *flt_Data = NULL; /* A pointer to Flt_Data (or NULL). */
    sInt4 missCnt = 0;   /* Number of detected missing values. */
    uInt4 index;         /* Current index into Wx table. */
    float *ain = (float *) iain;
    uInt4 subNx;         /* The Nx dimmension of the subgrid. */
    uInt4 subNy;         /* The Ny dimmension of the subgrid. */
+   uChar f_bitmapDone = 0; /* True if ParseGridNoMiss resolved the bitmap. */
 
    subNx = stopX - startX + 1;
    subNy = stopY - startY + 1;
@@ -2705,26 +3115,41 @@ void ParseGrid (gridAttribType *attrib, double **Grib_Data,
    myAssert (((!f_subGrid) && (subNx == Nx)) || (f_subGrid));
    myAssert (((!f_subGrid) && (subNy == Ny)) || (f_subGrid));
 
-   if (subNx * subNy > *grib_DataLen) {
-      *grib_DataLen = subNx * subNy;
-      *Grib_Data = (double *) realloc ((void *) (*Grib_Data),
-                                       (*grib_DataLen) * sizeof (double));
+   if (Flt_Data != NULL) {
+      if (subNx * subNy > *grib_DataLen) {
+         *grib_DataLen = subNx * subNy;
+         *Flt_Data = (float *) realloc ((void *) (*Flt_Data),
+                                        (*grib_DataLen) * sizeof (float));
+      }
+      flt_Data = *Flt_Data;
+   } else {
+      if (subNx * subNy > *grib_DataLen) {
+         *grib_DataLen = subNx * subNy;
+         *Grib_Data = (double *) realloc ((void *) (*Grib_Data),
+                                          (*grib_DataLen) * sizeof (double));
+      }
+      grib_Data = *Grib_Data;
    }
-   grib_Data = *Grib_Data;
 
    /* Resolve possibility that the data is an integer or a float, find
     * max/min values, and do unit conversion. (see note 1) */
    if (scan == 64) {
       if (attrib->f_miss == 0) {
-         ParseGridNoMiss (attrib, grib_Data, Nx, Ny, iain, unitM, unitB,
-                          f_txtType, txt_dataLen, txt_f_valid, startX, startY, subNx, subNy);
+         /* Resolves the bitmap (if there is one) in the same pass. */
+         ParseGridNoMiss (attrib, grib_Data, flt_Data, shift, Nx, Ny, iain,
+                          (ibitmap) ? ib : NULL, unitM, unitB, &missCnt,
+                          f_txtType, txt_dataLen, txt_f_valid, startX, startY,
+                          subNx, subNy);
+         f_bitmapDone = (ibitmap != 0);
       } else if (attrib->f_miss == 1) {
-         ParseGridPrimMiss (attrib, grib_Data, Nx, Ny, iain, unitM, unitB,
-                            &missCnt, f_txtType, txt_dataLen, txt_f_valid, startX, startY,
-                            subNx, subNy);
+         ParseGridPrimMiss (attrib, grib_Data, flt_Data, shift, Nx, Ny,
+                            iain, unitM, unitB, &missCnt, f_txtType,
+                            txt_dataLen, txt_f_valid, startX, startY, subNx,
+                            subNy);
       } else if (attrib->f_miss == 2) {
-         ParseGridSecMiss (attrib, grib_Data, Nx, Ny, iain, unitM, unitB,
-                           &missCnt, f_txtType, txt_dataLen, txt_f_valid, startX, startY, subNx,
+         ParseGridSecMiss (attrib, grib_Data, flt_Data, shift, Nx, Ny,
+                           iain, unitM, unitB, &missCnt, f_txtType,
+                           txt_dataLen, txt_f_valid, startX, startY, subNx,
                            subNy);
       }
    } else {
@@ -2746,6 +3171,7 @@ void ParseGrid (gridAttribType *attrib, double **Grib_Data,
              ((attrib->f_miss == 1) && (value != attrib->missPri)) ||
              ((attrib->f_miss == 2) && (value != attrib->missPri) &&
               (value != attrib->missSec))) {
+            valShift = shift;
             /* Convert the units. */
             if (unitM == -10) {
                value = pow (10, value);
@@ -2790,12 +3216,13 @@ void ParseGrid (gridAttribType *attrib, double **Grib_Data,
                }
             }
          } else {
+            valShift = 0;
             missCnt++;
          }
          ScanIndex2XY (scanIndex, &x, &y, scan, Nx, Ny);
          /* ScanIndex returns value as if scan was 0100 */
          newIndex = (x - 1) + (y - 1) * Nx;
-         grib_Data[newIndex] = value;
+         GridPut (grib_Data, flt_Data, valShift, newIndex, value);
       }
    }
 
@@ -2823,7 +3250,30 @@ void ParseGrid (gridAttribType *attrib, double **Grib_Data,
 
    /* Walk through the grid, resetting the missing values, as determined by
     * the original grid. */
-   if (f_readjust) {
+   if (f_readjust && f_subGrid) {
+      /* grib_Data is the subgrid (scan 0100), so walk it rather than the
+       * original grid. */
+      for (y = 0; y < (sInt4) subNy; y++) {
+         row = startY + y - 1;
+         for (x = 0; x < (sInt4) subNx; x++) {
+            col = startX + x - 1;
+            if ((row < 0) || (row >= (sInt4) Ny) || (col < 0) ||
+                (col >= (sInt4) Nx)) {
+               continue;
+            }
+            if (attrib->fieldType) {
+               value = iain[row * Nx + col];
+            } else {
+               value = ain[row * Nx + col];
+            }
+            if (value == attrib->missPri) {
+               GridPut (grib_Data, flt_Data, 0, y * subNx + x, xmissp);
+            } else if ((attrib->f_miss == 2) && (value == attrib->missSec)) {
+               GridPut (grib_Data, flt_Data, 0, y * subNx + x, xmisss);
+            }
+         }
+      }
+   } else if (f_readjust) {
       for (scanIndex = 0; scanIndex < Nx * Ny; scanIndex++) {
          ScanIndex2XY (scanIndex, &x, &y, scan, Nx, Ny);
          /* ScanIndex returns value as if scan was 0100 */
@@ -2834,11 +3284,13 @@ void ParseGrid (gridAttribType *attrib, double **Grib_Data,
             value = ain[scanIndex];
          }
          if (value == attrib->missPri) {
-            grib_Data[newIndex] = xmissp;
+            GridPut (grib_Data, flt_Data, 0, newIndex, xmissp);
          } else if ((attrib->f_miss == 2) && (value == attrib->missSec)) {
-            grib_Data[newIndex] = xmisss;
+            GridPut (grib_Data, flt_Data, 0, newIndex, xmisss);
          }
       }
+   }
+   if (f_readjust) {
       attrib->missPri = xmissp;
       if (attrib->f_miss == 2) {
          attrib->missSec = xmisss;
@@ -2846,7 +3298,17 @@ void ParseGrid (gridAttribType *attrib, double **Grib_Data,
    }
 
    /* Resolve bitmap (if there is one) in the data. */
-   if (ibitmap) {
+   if (f_bitmapDone) {
+      /* ParseGridNoMiss set the missing points to 9999, and found the
+       * max/min of the others. */
+      xmissp = 9999;
+      attrib->f_miss = 1;
+      attrib->missPri = xmissp;
+      if (!attrib->f_maxmin) {
+         attrib->f_maxmin = 1;
+         attrib->max = attrib->min = xmissp;
+      }
+   } else if (ibitmap) {
       attrib->f_maxmin = 0;
       if ((attrib->f_miss != 1) && (attrib->f_miss != 2)) {
          missCnt = 0;
@@ -2858,23 +3320,39 @@ void ParseGrid (gridAttribType *attrib, double **Grib_Data,
             }
          }
          /* embed the missing value. */
-         for (scanIndex = 0; scanIndex < Nx * Ny; scanIndex++) {
-            ScanIndex2XY (scanIndex, &x, &y, scan, Nx, Ny);
-            /* ScanIndex returns value as if scan was 0100 */
-            newIndex = (x - 1) + (y - 1) * Nx;
+         for (scanIndex = 0; scanIndex < subNx * subNy; scanIndex++) {
+            if (f_subGrid) {
+               /* Walk the subgrid, treating points off the original grid
+                * as missing. */
+               newIndex = scanIndex;
+               row = startY + scanIndex / subNx - 1;
+               col = startX + scanIndex % subNx - 1;
+               if ((row < 0) || (row >= (sInt4) Ny) || (col < 0) ||
+                   (col >= (sInt4) Nx) || (ib[row * Nx + col] != 1)) {
+                  GridPut (grib_Data, flt_Data, 0, newIndex, xmissp);
+                  missCnt++;
+                  continue;
+               }
+            } else {
+               ScanIndex2XY (scanIndex, &x, &y, scan, Nx, Ny);
+               /* ScanIndex returns value as if scan was 0100 */
+               newIndex = (x - 1) + (y - 1) * Nx;
+            }
             /* Corrected this on 5/10/2004 */
-            if (ib[scanIndex] != 1) {
-               grib_Data[newIndex] = xmissp;
+            if ((!f_subGrid) && (ib[scanIndex] != 1)) {
+               GridPut (grib_Data, flt_Data, 0, newIndex, xmissp);
                missCnt++;
             } else {
                if (!attrib->f_maxmin) {
                   attrib->f_maxmin = 1;
-                  attrib->max = attrib->min = grib_Data[newIndex];
+                  attrib->max = attrib->min =
+                        GridGet (grib_Data, flt_Data, newIndex);
                } else {
-                  if (attrib->max < grib_Data[newIndex])
-                     attrib->max = grib_Data[newIndex];
-                  if (attrib->min > grib_Data[newIndex])
-                     attrib->min = grib_Data[newIndex];
+                  value = GridGet (grib_Data, flt_Data, newIndex);
+                  if (attrib->max < value)
+                     attrib->max = value;
+                  if (attrib->min > value)
+                     attrib->min = value;
                }
             }
          }
@@ -2889,6 +3367,98 @@ void ParseGrid (gridAttribType *attrib, double **Grib_Data,
    attrib->numMiss = missCnt;
 }
 
+/*****************************************************************************
+ * ParseGrid() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   To walk through the 2 possible grids (and possible bitmap) created by
+ * UNPK_GRIB2, and combine the info into 1 grid, at the same time computing
+ * the min/max values in the grid.  It uses gridAttrib info for the missing values
+ * and it then updates the gridAttrib structure for the min/max values that it
+ * found.
+ *   It also uses scan, and ScanIndex2XY, to parse the data and organize the
+ * Grib_Data so that 0,0 is the lower left part of the grid, it then traverses
+ * the row and then moved up to the next row starting on the left.
+ *
+ * ARGUMENTS
+ *       attrib = sect 5 structure already filled in by ParseSect5 (In/Output)
+ *    Grib_Data = The place to store the grid data. (Output)
+ *                (ParseGridFlt: Flt_Data, a float grid)
+ * grib_DataLen = The current size of Grib_Data (can increase) (Input/Output)
+ *       Nx, Ny = The dimensions of the grid (Input)
+ *         scan = How to walk through the original grid. (Input)
+ *         iain = Place to find data if it is an Integer (or float). (Input)
+ *      ibitmap = Flag stating the data has a bitmap for missing values (In)
+ *           ib = Where to find the bitmap if we have one (Input)
+ *        unitM = M in unit conversion equation y(new) = m x(orig) + b (Input)
+ *        unitB = B in unit conversion equation y(new) = m x(orig) + b (Input)
+ *    f_txtType = true if we have a valid wx/hazard type. (Input)
+ *  txt_dataLen = Length of text table
+ *  txt_f_valid = whether that entry is used/valid. (Input)
+ *    f_subGrid = True if we have a subgrid, false if not. (Input)
+ * startX stopX = The bounds of the subgrid in X. (0,-1) means full grid (In)
+ * startY stopY = The bounds of the subgrid in Y. (0,-1) means full grid (In)
+ *      decimal = (ParseGridFlt) How many decimal places to round the values
+ *                to before storing them as floats (see GridPut). (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *   9/2002 Arthur Taylor (MDL/RSIS): Created.
+ *  11/2002 AAT: Added unit conversion to metaparse.c
+ *  12/2002 AAT: Optimized first loop to make it assume scan 0100 (64)
+ *         (valid 99.9%), but still have slow loop for generic case.
+ *   5/2003 AAT: Added ability to see if wxType occurs.  If so sets table
+ *          valid to 2, otherwise leaves it at 1.  If table valid is 0 then
+ *          sets value to missing value (if applicable).
+ *   7/2003 AAT: added check if f_maxmin before checking if missing was in
+ *          range of max, min for "readjust" check.
+ *   2/2004 AAT: Added startX / startY / stopX / stopY
+ *   5/2004 AAT: Found out that I used the opposite definition for bitmap
+ *          0 = missing, 1 = valid.
+ *  10/2026 AAT: The readjust and bitmap loops now walk the subgrid (they
+ *          used to index grib_Data as if it were the whole grid).
+ *  10/2026 AAT: For scan 0100 fields with no missing value management,
+ *          the bitmap is resolved while converting the units (one pass).
+ *  10/2026 AAT: Moved the body to ParseGridCore (shared with ParseGridFlt,
+ *          which fills in a float grid).
+ *
+ * NOTES
+ *****************************************************************************
+ */
+void ParseGrid (gridAttribType *attrib, double **Grib_Data,
+                uInt4 *grib_DataLen, uInt4 Nx, uInt4 Ny, int scan,
+                sInt4 *iain, sInt4 ibitmap, sInt4 *ib, double unitM,
+                double unitB, uChar f_txtType, uInt4 txt_dataLen,
+                uChar *txt_f_valid,
+                uChar f_subGrid, int startX, int startY, int stopX, int stopY)
+{
+   ParseGridCore (attrib, Grib_Data, NULL, 0, grib_DataLen, Nx, Ny, scan,
+                  iain, ibitmap, ib, unitM, unitB, f_txtType, txt_dataLen,
+                  txt_f_valid, f_subGrid, startX, startY, stopX, stopY);
+}
+
+void ParseGridFlt (gridAttribType *attrib, float **Flt_Data,
+                   uInt4 *flt_DataLen, uInt4 Nx, uInt4 Ny, int scan,
+                   sInt4 *iain, sInt4 ibitmap, sInt4 *ib, double unitM,
+                   double unitB, uChar f_txtType, uInt4 txt_dataLen,
+                   uChar *txt_f_valid, uChar f_subGrid, int startX,
+                   int startY, int stopX, int stopY, sChar decimal)
+{
+   if (decimal > 17)
+      decimal = 17;
+   if (decimal < 0)
+      decimal = 0;
+   ParseGridCore (attrib, NULL, Flt_Data, POWERS_ONE[decimal], flt_DataLen,
+                  Nx, Ny, scan, iain, ibitmap, ib, unitM, unitB, f_txtType,
+                  txt_dataLen, txt_f_valid, f_subGrid, startX, startY, stopX,
+                  stopY);
+}
+
 typedef struct {
    double value;
    int cnt;
@@ -15,6 +15,7 @@
  * 12/2002 Rici Yu, Fangyu Chi, Mark Armstrong, & Tim Boyer
  *         (RY,FC,MA,&TB): Code Review 2.
  * 12/2005 AAT Added myWarn routines.
+ * 10/2026 AAT Added mallocStrCat / reallocStrCat.
  *
  * NOTES
  *   See Kernighan & Ritchie C book (2nd edition) page 156.
@@ -25,6 +26,8 @@
 #include <string.h>
 #include "myassert.h"
 #include "myerror.h"
+#include "type.h"
+#include "libaat_type.h"
 #ifdef MEMWATCH
 #include "memwatch.h"
 #endif
@@ -355,6 +358,135 @@ void reallocSprintf (char **Ptr, const char *fmt, ...)
    }
 }
 
+/*****************************************************************************
+ * StrCatLen() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Adds up the lengths of a NULL terminated list of strings.
+ *
+ * ARGUMENTS
+ * ap = The list of strings. (Input)
+ *
+ * RETURNS: size_t (total length, not counting the '\0')
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static size_t StrCatLen (va_list ap)
+{
+   const char *sval;    /* The current string. */
+   size_t len = 0;      /* The total length. */
+
+   while ((sval = va_arg (ap, const char *)) != NULL) {
+      len += strlen (sval);
+   }
+   return len;
+}
+
+/*****************************************************************************
+ * StrCatCopy() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Copies a NULL terminated list of strings, one after the other, to buffer
+ * (which has room for them, see StrCatLen), and '\0' terminates it.
+ *
+ * ARGUMENTS
+ * buffer = Where to copy the strings. (Output)
+ *     ap = The list of strings. (Input)
+ *
+ * RETURNS: void
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void StrCatCopy (char *buffer, va_list ap)
+{
+   const char *sval;    /* The current string. */
+   size_t slen;         /* Length of the current string. */
+
+   while ((sval = va_arg (ap, const char *)) != NULL) {
+      slen = strlen (sval);
+      memcpy (buffer, sval, slen);
+      buffer += slen;
+   }
+   *buffer = '\0';
+}
+
+/*****************************************************************************
+ * mallocStrCat() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Joins a NULL terminated list of strings into newly allocated memory, and
+ * sets Ptr to point to it.  Same result as mallocSprintf (Ptr, "%s%s...",
+ * ...), but with one malloc rather than a realloc for each part, for strings
+ * that are built over and over (such as the element names of every message).
+ *
+ * ARGUMENTS
+ * Ptr = Place to point to new memory which contains the strings (Output)
+ * ... = The strings, followed by NULL (Input)
+ *
+ * RETURNS: void
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Don't forget the NULL at the end of the list.
+ *****************************************************************************
+ */
+void mallocStrCat (char **Ptr, ...)
+{
+   va_list ap;          /* Contains the strings. */
+   size_t len;          /* Length of the result. */
+
+   va_start (ap, Ptr);
+   len = StrCatLen (ap);
+   va_end (ap);
+   *Ptr = (char *) malloc (len + 1);
+   va_start (ap, Ptr);
+   StrCatCopy (*Ptr, ap);
+   va_end (ap);
+}
+
+/*****************************************************************************
+ * reallocStrCat() -- Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Tacks a NULL terminated list of strings onto the end of Ptr (which is
+ * either NULL or allocated memory), with one realloc.  Same result as
+ * reallocSprintf (Ptr, "%s%s...", ...).
+ *
+ * ARGUMENTS
+ * Ptr = Pointer to memory to add the strings to. (Input/Output)
+ * ... = The strings, followed by NULL (Input)
+ *
+ * RETURNS: void
+ *
+ * 10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Don't forget the NULL at the end of the list.
+ *****************************************************************************
+ */
+void reallocStrCat (char **Ptr, ...)
+{
+   va_list ap;          /* Contains the strings. */
+   size_t ipos;         /* Length of the original string. */
+   size_t len;          /* Length of the result. */
+
+   ipos = (*Ptr == NULL) ? 0 : strlen (*Ptr);
+   va_start (ap, Ptr);
+   len = ipos + StrCatLen (ap);
+   va_end (ap);
+   *Ptr = (char *) realloc ((void *) *Ptr, len + 1);
+   va_start (ap, Ptr);
+   StrCatCopy (*Ptr + ipos, ap);
+   va_end (ap);
+}
+
 /*****************************************************************************
  * errSprintf() -- Arthur Taylor / MDL (Review 12/2002)
  *
@@ -384,8 +516,11 @@ void reallocSprintf (char **Ptr, const char *fmt, ...)
  *****************************************************************************
  */
 /* Following 2 variables used in both errSprintf and preErrSprintf */
-static char *errBuffer = NULL; /* Stores the current built up message. */
-static size_t errBuff_len = 0; /* Allocated length of errBuffer. */
+/* They are per thread so that -threads workers don't mix their messages. */
+static THREAD_LOCAL char *errBuffer = NULL; /* Stores the current built up
+                                             * message. */
+static THREAD_LOCAL size_t errBuff_len = 0; /* Allocated length of
+                                             * errBuffer. */
 
 char *errSprintf (const char *fmt, ...)
 {
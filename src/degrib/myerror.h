@@ -26,6 +26,11 @@ void mallocSprintf (char **Ptr, const char *fmt, ...);
 
 void reallocSprintf (char **Ptr, const char *fmt, ...);
 
+/* The list of strings must end with NULL. */
+void mallocStrCat (char **Ptr, ...);
+
+void reallocStrCat (char **Ptr, ...);
+
 /* If fmt == NULL return buffer and reset, otherwise add. */
 /* You are responsible for free'ing the result of errSprintf(NULL). */
 char *errSprintf (const char *fmt, ...);
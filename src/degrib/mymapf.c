@@ -13,6 +13,7 @@
  * NOTES
  *****************************************************************************
  */
+#include <stdlib.h>
 #include <string.h>
 #include "mymapf.h"
 #include "myassert.h"
@@ -320,6 +321,249 @@ void SetMapParamGDS (myMaparam *map, const gdsType *gds)
    }
 }
 
+/*****************************************************************************
+ * GDSHash() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Computes a hash of the fields of a GDS that affect the map projection,
+ * so that GridPntCacheFind can quickly skip grids which don't match.
+ *
+ * ARGUMENTS
+ * gds = The grid definition section to hash. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: uInt4 (the hash)
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Hashes the fields one at a time, since the padding in gdsType is not
+ * necessarily initialized.
+ *****************************************************************************
+ */
+static uInt4 GDSHashBytes (uInt4 hash, const void *ptr, size_t len)
+{
+   const uChar *p = (const uChar *) ptr;
+
+   while (len-- > 0) {
+      hash = (hash ^ *p++) * 16777619U;
+   }
+   return hash;
+}
+
+static uInt4 GDSHash (const gdsType *gds)
+{
+   uInt4 hash = 2166136261U; /* FNV-1a offset basis. */
+
+   hash = GDSHashBytes (hash, &(gds->projType), sizeof (gds->projType));
+   hash = GDSHashBytes (hash, &(gds->scan), sizeof (gds->scan));
+   hash = GDSHashBytes (hash, &(gds->Nx), sizeof (gds->Nx));
+   hash = GDSHashBytes (hash, &(gds->Ny), sizeof (gds->Ny));
+   hash = GDSHashBytes (hash, &(gds->lat1), sizeof (gds->lat1));
+   hash = GDSHashBytes (hash, &(gds->lon1), sizeof (gds->lon1));
+   hash = GDSHashBytes (hash, &(gds->Dx), sizeof (gds->Dx));
+   hash = GDSHashBytes (hash, &(gds->Dy), sizeof (gds->Dy));
+   hash = GDSHashBytes (hash, &(gds->orientLon), sizeof (gds->orientLon));
+   hash = GDSHashBytes (hash, &(gds->majEarth), sizeof (gds->majEarth));
+   return hash;
+}
+
+/*****************************************************************************
+ * GDSEqual() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Determines if two grid definition sections describe the same grid.
+ *
+ * ARGUMENTS
+ * gds1, gds2 = The grid definition sections to compare. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *   1 if they are the same grid, 0 otherwise.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Compares every field (rather than memcmp) because of padding.
+ *****************************************************************************
+ */
+static int GDSEqual (const gdsType *gds1, const gdsType *gds2)
+{
+   return ((gds1->numPts == gds2->numPts) &&
+           (gds1->projType == gds2->projType) &&
+           (gds1->f_sphere == gds2->f_sphere) &&
+           (gds1->majEarth == gds2->majEarth) &&
+           (gds1->minEarth == gds2->minEarth) &&
+           (gds1->Nx == gds2->Nx) && (gds1->Ny == gds2->Ny) &&
+           (gds1->lat1 == gds2->lat1) && (gds1->lon1 == gds2->lon1) &&
+           (gds1->orientLon == gds2->orientLon) &&
+           (gds1->Dx == gds2->Dx) && (gds1->Dy == gds2->Dy) &&
+           (gds1->meshLat == gds2->meshLat) &&
+           (gds1->resFlag == gds2->resFlag) &&
+           (gds1->center == gds2->center) && (gds1->scan == gds2->scan) &&
+           (gds1->lat2 == gds2->lat2) && (gds1->lon2 == gds2->lon2) &&
+           (gds1->scaleLat1 == gds2->scaleLat1) &&
+           (gds1->scaleLat2 == gds2->scaleLat2) &&
+           (gds1->southLat == gds2->southLat) &&
+           (gds1->southLon == gds2->southLon) &&
+           (gds1->poleLat == gds2->poleLat) &&
+           (gds1->poleLon == gds2->poleLon) &&
+           (gds1->stretchFactor == gds2->stretchFactor) &&
+           (gds1->f_typeLatLon == gds2->f_typeLatLon) &&
+           (gds1->angleRotate == gds2->angleRotate) &&
+           (gds1->hdatum == gds2->hdatum));
+}
+
+/*****************************************************************************
+ * GridPntCacheInit() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Initializes a cache of where a set of lat/lon points fall on each of the
+ * grids they are probed on.
+ *
+ * ARGUMENTS
+ *   cache = The cache to initialize. (Output)
+ * numPnts = The number of points. (Input)
+ *    pnts = The points (X is lon, Y is lat).  Must not change (or be freed)
+ *           while the cache is in use. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+void GridPntCacheInit (gridPntCacheType *cache, size_t numPnts,
+                       const Point *pnts)
+{
+   cache->numPnts = numPnts;
+   cache->pnts = pnts;
+   cache->numGrid = 0;
+   cache->nextGrid = 0;
+}
+
+/*****************************************************************************
+ * GridPntCacheFind() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Returns the map projection of a grid, and where the cached points fall
+ * on it (in grid cell space, as myCll2xy would compute them).  The first
+ * time a grid is seen it is projected, and the points are converted.  After
+ * that, any GDS which describes the same grid reuses the results.
+ *
+ * ARGUMENTS
+ * cache = The cache to look in (and add to). (Input/Output)
+ *   gds = The grid the points are being probed on (already checked by
+ *         GDSValid). (Input)
+ *   map = The map projection of the grid (as set by SetMapParamGDS). (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: const Point *
+ *   The points in grid cell space (owned by the cache), or NULL if there
+ *   was not enough memory.  The map is set either way.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Keeps GRIDPNT_CACHE_MAX grids.  When full, the oldest is replaced.
+ *   Bi-linear corners and weights are a few integer operations from x/y, so
+ * only x/y is kept, which leaves the interpolation arithmetic unchanged.
+ *****************************************************************************
+ */
+const Point *GridPntCacheFind (gridPntCacheType *cache, const gdsType *gds,
+                               myMaparam *map)
+{
+   uInt4 hash = GDSHash (gds); /* The hash of this grid. */
+   gridPntGridType *grid; /* The cache entry for this grid. */
+   Point *xy;           /* The points on this grid. */
+   size_t i;            /* Loop counter over the points. */
+   int j;               /* Loop counter over the cached grids. */
+
+   for (j = 0; j < cache->numGrid; j++) {
+      grid = &(cache->grid[j]);
+      if ((grid->hash == hash) && GDSEqual (&(grid->gds), gds)) {
+         memcpy (map, &(grid->map), sizeof (myMaparam));
+         return grid->xy;
+      }
+   }
+
+   SetMapParamGDS (map, gds);
+   if (cache->numPnts == 0) {
+      return NULL;
+   }
+   if ((xy = (Point *) malloc (cache->numPnts * sizeof (Point))) == NULL) {
+      return NULL;
+   }
+   for (i = 0; i < cache->numPnts; i++) {
+      myCll2xy (map, cache->pnts[i].Y, cache->pnts[i].X, &(xy[i].X),
+                &(xy[i].Y));
+   }
+
+   if (cache->numGrid < GRIDPNT_CACHE_MAX) {
+      grid = &(cache->grid[cache->numGrid]);
+      cache->numGrid++;
+   } else {
+      grid = &(cache->grid[cache->nextGrid]);
+      cache->nextGrid = (cache->nextGrid + 1) % GRIDPNT_CACHE_MAX;
+      free (grid->xy);
+   }
+   grid->hash = hash;
+   memcpy (&(grid->gds), gds, sizeof (gdsType));
+   memcpy (&(grid->map), map, sizeof (myMaparam));
+   grid->xy = xy;
+   return xy;
+}
+
+/*****************************************************************************
+ * GridPntCacheFree() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Frees the grids in a point cache.
+ *
+ * ARGUMENTS
+ * cache = The cache to free. (Input/Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+void GridPntCacheFree (gridPntCacheType *cache)
+{
+   int j;               /* Loop counter over the cached grids. */
+
+   for (j = 0; j < cache->numGrid; j++) {
+      free (cache->grid[j].xy);
+   }
+   cache->numGrid = 0;
+   cache->nextGrid = 0;
+}
+
 /* 1) find lwlf coresponding x1,y1, and uprt corresponding x2,y2
  * 2) create a new gds based on old one, but shifted with lwlf in bottom
  *    left, and uprt in upper right.
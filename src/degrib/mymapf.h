@@ -28,6 +28,35 @@ int GDSValid (const gdsType * gds);
 
 void SetMapParamGDS (myMaparam * map, const gdsType *gds);
 
+/* Number of grids a gridPntCacheType keeps. */
+#define GRIDPNT_CACHE_MAX 8
+
+/* Where a set of lat/lon points fall on one grid. */
+typedef struct {
+  uInt4 hash;            /* Hash of gds (see GDSHash). */
+  gdsType gds;           /* The grid. */
+  myMaparam map;         /* SetMapParamGDS of gds. */
+  Point *xy;             /* The points in grid cell space. */
+} gridPntGridType;
+
+/* Where a set of lat/lon points fall on each of the grids they have been
+ * probed on. */
+typedef struct {
+  size_t numPnts;        /* Number of points. */
+  const Point *pnts;     /* The points (X is lon, Y is lat). */
+  int numGrid;           /* Number of grids in use. */
+  int nextGrid;          /* Which grid to replace when full. */
+  gridPntGridType grid[GRIDPNT_CACHE_MAX];
+} gridPntCacheType;
+
+void GridPntCacheInit (gridPntCacheType * cache, size_t numPnts,
+                       const Point * pnts);
+
+const Point *GridPntCacheFind (gridPntCacheType * cache, const gdsType * gds,
+                               myMaparam * map);
+
+void GridPntCacheFree (gridPntCacheType * cache);
+
 int computeSubGrid (LatLon *lwlf, int *x1, int *y1, LatLon *uprt, int *x2,
                     int *y2, gdsType *gds, gdsType *newGds);
 
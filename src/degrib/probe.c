@@ -32,6 +32,7 @@
 #include "scan.h"
 #include "mymapf.h"
 #include "myassert.h"
+#include "gidx.h"
 
 /*****************************************************************************
  * PrintProbeWx() --
@@ -196,6 +197,8 @@ static void PrintProbeHazard (FILE *out_fp, double ans, sect2_HazardType *hazard
  *       labels = Station Names for each point. (Input)
  *         meta = The meta structure for a GRIB2 message (Input)
  *          map = Used to compute the lat/lon points (Input)
+ *     gridPnts = pnts in grid cell space (see GridPntCacheFind), or NULL
+ *                to compute them with map. (Input)
  *      missing = The missing value for this grid (Input)
  *    f_surface = 0 => no surface info, 1 => short form of surface name
  *                2 => long form of surface name (In)
@@ -211,6 +214,7 @@ static void PrintProbeHazard (FILE *out_fp, double ans, sect2_HazardType *hazard
  *   3/2004 AAT: Rewrote to be more flexible.
  *   5/2004 AAT: Modified so probes that are off the grid, return missing.
  *   1/2005 AAT: Added ability to send point outputs to different files.
+ *  10/2026 AAT: Added gridPnts so the points are projected once per grid.
  *
  * NOTES
  *****************************************************************************
@@ -250,7 +254,8 @@ static void GRIB2ProbeStyle0 (FILE **pnt_fps, char *f_firstFps,
                               double *grib_Data, sInt4 grib_DataLen,
                               userType *usr, int numPnts, Point * pnts,
                               grib_MetaData *meta, myMaparam *map,
-                              double missing, sChar f_surface)
+                              const Point *gridPnts, double missing,
+                              sChar f_surface)
 {
    int i;               /* Counter for the points. */
    char format[20];     /* Format to print the data with. */
@@ -285,7 +290,12 @@ static void GRIB2ProbeStyle0 (FILE **pnt_fps, char *f_firstFps,
 
    sprintf (format, "%%.%df", usr->decimal);
    for (i = 0; i < numPnts; i++) {
-      myCll2xy (map, pnts[i].Y, pnts[i].X, &newX, &newY);
+      if (gridPnts != NULL) {
+         newX = gridPnts[i].X;
+         newY = gridPnts[i].Y;
+      } else {
+         myCll2xy (map, pnts[i].Y, pnts[i].X, &newX, &newY);
+      }
       f_missing = 0;
       /* Find the nearest grid cell. */
       if (newX < .5) {
@@ -317,10 +327,10 @@ static void GRIB2ProbeStyle0 (FILE **pnt_fps, char *f_firstFps,
          }
       } else {
          /* Figure out data value at this lat/lon */
-         ans = BiLinearCompute (grib_Data, map, pnts[i].Y, pnts[i].X,
-                                meta->gds.Nx, meta->gds.Ny,
-                                meta->gridAttrib.f_miss, missing,
-                                meta->gridAttrib.missSec, usr->f_avgInterp);
+         ans = BiLinearComputeXY (grib_Data, map, newX, newY,
+                                  meta->gds.Nx, meta->gds.Ny,
+                                  meta->gridAttrib.f_miss, missing,
+                                  meta->gridAttrib.missSec, usr->f_avgInterp);
       }
       if (strcmp (meta->element, "Wx") == 0) {
          /* Handle the weather case. */
@@ -373,6 +383,8 @@ static void GRIB2ProbeStyle0 (FILE **pnt_fps, char *f_firstFps,
  *       labels = Station Names for each point. (Input)
  *         meta = The meta structure for a GRIB2 message (Input)
  *          map = Used to compute the lat/lon points (Input)
+ *     gridPnts = pnts in grid cell space (see GridPntCacheFind), or NULL
+ *                to compute them with map. (Input)
  *      missing = The missing value for this grid (Input)
  *    f_surface = 0 => no surface info, 1 => short form of surface name
  *                2 => long form of surface name (In)
@@ -391,6 +403,7 @@ static void GRIB2ProbeStyle0 (FILE **pnt_fps, char *f_firstFps,
  *          the original Style1() is f_cells = 0, f_surface = 0
  *   5/2004 AAT: Modified so probes that are off the grid, return missing.
  *   1/2005 AAT: Added ability to send point outputs to different files.
+ *  10/2026 AAT: Added gridPnts so the points are projected once per grid.
  *
  * NOTES
  *****************************************************************************
@@ -433,7 +446,8 @@ static void GRIB2ProbeStyle1 (FILE **pnt_fps,
                               sInt4 grib_DataLen, userType *usr,
                               uInt4 numPnts, Point * pnts, char **labels,
                               grib_MetaData *meta, myMaparam *map,
-                              double missing, sChar f_surface, sChar f_comment, sChar f_cells)
+                              const Point *gridPnts, double missing,
+                              sChar f_surface, sChar f_comment, sChar f_cells)
 {
    size_t i;            /* Counter for the points. */
    char format[20];     /* Format to print the data with. */
@@ -511,7 +525,12 @@ static void GRIB2ProbeStyle1 (FILE **pnt_fps,
          lat = pnts[i].Y;
          lon = pnts[i].X;
          /* Find the nearest grid cell. */
-         myCll2xy (map, lat, lon, &newX, &newY);
+         if (gridPnts != NULL) {
+            newX = gridPnts[i].X;
+            newY = gridPnts[i].Y;
+         } else {
+            myCll2xy (map, lat, lon, &newX, &newY);
+         }
          if (newX < .5) {
             x1 = 1;
             f_missing = 1;
@@ -541,10 +560,11 @@ static void GRIB2ProbeStyle1 (FILE **pnt_fps,
             }
          } else {
             /* Figure out data value at this lat/lon */
-            ans = BiLinearCompute (grib_Data, map, pnts[i].Y, pnts[i].X,
-                                   meta->gds.Nx, meta->gds.Ny,
-                                   meta->gridAttrib.f_miss, missing,
-                                   meta->gridAttrib.missSec, usr->f_avgInterp);
+            ans = BiLinearComputeXY (grib_Data, map, newX, newY,
+                                     meta->gds.Nx, meta->gds.Ny,
+                                     meta->gridAttrib.f_miss, missing,
+                                     meta->gridAttrib.missSec,
+                                     usr->f_avgInterp);
          }
       }
 
@@ -817,6 +837,10 @@ void GRIB2ProbeCloseOutFile (userType *usr, int numPnts, FILE ** pnt_fps,
  *   3/2004 AAT: Rewrote to take some of the work out of Style0() and Style1()
  *   1/2005 AAT: Added ability to send point outputs to different files.
  *   9/2005 AAT: Fixed different behavior of -out stdout vs -stdout
+ *  10/2026 AAT: Recycle meta between messages (see MetaRecycle).
+ *  10/2026 AAT: Project the points once per grid (see GridPntCacheFind).
+ *  10/2026 AAT: Use the .gidx index (if fresh, or -gidx) to go straight to
+ *          each message, and to stop before any trailing bytes.
  *
  * NOTES
  *   Passing 'is' and 'meta' in, mainly for tcldegrib memory considerations.
@@ -834,6 +858,8 @@ int GRIB2Probe (userType *usr, int numPnts, Point * pnts, char **labels,
    sChar f_comment = 0; /* 0 use element, 1 use comment (replacing ' ' with '_') */
    sChar f_surface;     /* 0 no surface info, 1 short form of surface name */
    myMaparam map;       /* Used to compute the grid lat/lon points. */
+   gridPntCacheType pntCache; /* Where pnts fall on the grids seen so far. */
+   const Point *gridPnts; /* pnts in grid cell space, or NULL. */
    double missing = 0;  /* Missing value to use. */
    double *grib_Data;   /* Holds the grid retrieved from a GRIB2 message. */
    uInt4 grib_DataLen;  /* Current length of grib_Data. */
@@ -841,6 +867,11 @@ int GRIB2Probe (userType *usr, int numPnts, Point * pnts, char **labels,
    int subgNum = 0;     /* The subgrid in the message that we are interested
                          * in. */
    sInt4 f_endMsg = 1;  /* 1 if we read the last grid in a GRIB message */
+   inventoryType *Inv = NULL; /* The grids in the file (from its index). */
+   uInt4 LenInv = 0;    /* Number of grids in Inv. */
+   int numMsg = 0;      /* Number of messages in Inv. */
+   uInt4 curInv = 0;    /* The grid in Inv we are about to read. */
+   char *msg;           /* Used to clear the error stack. */
 #ifndef DP_ONLY
    IS_dataType is;      /* Un-parsed meta data for this GRIB2 message. As
                          * well as some memory used by the unpacker. */
@@ -894,13 +925,33 @@ int GRIB2Probe (userType *usr, int numPnts, Point * pnts, char **labels,
    /* Start loop for all messages. */
    grib_DataLen = 0;
    grib_Data = NULL;
+   GridPntCacheInit (&pntCache, numPnts, pnts);
 
 #ifndef DP_ONLY
    MetaInit (&meta);
    IS_Init (&is);
 #endif
+   /* Use the file's index if it is fresh (or -gidx made it so). */
+   if (GidxInventory (usr->inNames[0], usr->f_gidx, 0, &Inv, &LenInv,
+                      &numMsg) != 0) {
+      msg = errSprintf (NULL);
+      free (msg);
+      GidxFree (Inv, LenInv);
+      Inv = NULL;
+      LenInv = 0;
+   }
    while ((c = fgetc (grib_fp)) != EOF) {
       ungetc (c, grib_fp);
+      if (Inv != NULL) {
+         /* Stop after the last grid in the index, and go to the start of
+          * each message. */
+         if ((curInv == LenInv) ||
+             ((subgNum == 0) &&
+              (GidxSeek (grib_fp, Inv[curInv].start) != 0))) {
+            break;
+         }
+         curInv++;
+      }
       /* Read the GRIB message. */
       if (ReadGrib2Record (grib_fp, usr->f_unit, &grib_Data, &grib_DataLen,
                            &meta, &is, subgNum, usr->majEarth, usr->minEarth,
@@ -916,10 +967,12 @@ int GRIB2Probe (userType *usr, int numPnts, Point * pnts, char **labels,
          free (f_firstFps);
          fclose (grib_fp);
          free (grib_Data);
+         GridPntCacheFree (&pntCache);
 #ifndef DP_ONLY
          MetaFree (&meta);
          IS_Free (&is);
 #endif
+         GidxFree (Inv, LenInv);
          return -3;
       }
 
@@ -938,10 +991,12 @@ int GRIB2Probe (userType *usr, int numPnts, Point * pnts, char **labels,
                free (f_firstFps);
                fclose (grib_fp);
                free (grib_Data);
+               GridPntCacheFree (&pntCache);
 #ifndef DP_ONLY
                MetaFree (&meta);
                IS_Free (&is);
 #endif
+               GidxFree (Inv, LenInv);
                return -3;
             }
          }
@@ -959,10 +1014,12 @@ int GRIB2Probe (userType *usr, int numPnts, Point * pnts, char **labels,
                free (f_firstFps);
                fclose (grib_fp);
                free (grib_Data);
+               GridPntCacheFree (&pntCache);
 #ifndef DP_ONLY
                MetaFree (&meta);
                IS_Free (&is);
 #endif
+               GidxFree (Inv, LenInv);
                return -3;
             }
          }
@@ -985,14 +1042,23 @@ int GRIB2Probe (userType *usr, int numPnts, Point * pnts, char **labels,
          free (f_firstFps);
          fclose (grib_fp);
          free (grib_Data);
+         GridPntCacheFree (&pntCache);
 #ifndef DP_ONLY
          MetaFree (&meta);
          IS_Free (&is);
 #endif
+         GidxFree (Inv, LenInv);
          return -4;
       }
-      /* Set up the map projection. */
-      SetMapParamGDS (&map, &(meta.gds));
+      /* Set up the map projection, and find where the points fall on the
+       * grid, reusing both if an earlier message was on the same grid.
+       * Style0 treats the points as lat/lon even with -cells. */
+      if ((f_style == 0) || (usr->f_pntType == 0)) {
+         gridPnts = GridPntCacheFind (&pntCache, &(meta.gds), &map);
+      } else {
+         SetMapParamGDS (&map, &(meta.gds));
+         gridPnts = NULL;
+      }
 
       /* Figure out a missing value, if there isn't one, so that when we
        * interpolate and we are out of bounds, we can return something. */
@@ -1010,16 +1076,19 @@ int GRIB2Probe (userType *usr, int numPnts, Point * pnts, char **labels,
 
       if (f_style == 0) {
          GRIB2ProbeStyle0 (pnt_fps, f_firstFps, grib_Data, grib_DataLen,
-                           usr, numPnts, pnts, &meta, &map, missing, f_surface);
+                           usr, numPnts, pnts, &meta, &map, gridPnts, missing,
+                           f_surface);
       } else {
          GRIB2ProbeStyle1 (pnt_fps, f_firstFps, grib_Data, grib_DataLen,
-                           usr, numPnts, pnts, labels, &meta, &map, missing,
-                           f_surface, f_comment, usr->f_pntType);
+                           usr, numPnts, pnts, labels, &meta, &map, gridPnts,
+                           missing, f_surface, f_comment, usr->f_pntType);
       }
-      MetaFree (&meta);
+      MetaRecycle (&meta);
    }
    /* End loop for all messages. */
+   GidxFree (Inv, LenInv);
    free (grib_Data);
+   GridPntCacheFree (&pntCache);
 #ifndef DP_ONLY
    MetaFree (&meta);
    IS_Free (&is);
@@ -1064,6 +1133,7 @@ int GRIB2Probe (userType *usr, int numPnts, Point * pnts, char **labels,
  *
  * HISTORY
  *   8/2004 Arthur Taylor (MDL) + Xiaobiao Fan (OHD/RSIS): Created.
+ *  10/2026 AAT: Recycle meta between messages (see MetaRecycle).
  *
  * NOTES
  *****************************************************************************
@@ -1264,7 +1334,7 @@ int GenericProbe (char *filename, int numPnts, double *lat, double *lon,
       IS_Free (&is);
       IS_Init (&is);
 */
-      MetaFree (&meta);
+      MetaRecycle (&meta);
    }
    /* End loop for all messages. */
    free (grib_Data);
@@ -0,0 +1,594 @@
+/*****************************************************************************
+ * tdlbench.c
+ *
+ * DESCRIPTION
+ *    This file contains a timing driver for the TDLPack reader.  It writes
+ * two files of synthetic 1000 x 1000 TDLPack records, then times how long
+ * ReadGrib2Record takes to decode them.  The records come from a fixed
+ * seed, so every run (and every build) decodes the same bytes.
+ *    The headers (sections 0 to 2) come from WriteTDLPRecord.  The data
+ * section is made here with random group widths, group sizes and values,
+ * since WriteTDLPRecord doesn't write second order differences.  There is
+ * one record for each combination of:
+ *       missing values: none, primary, primary and secondary
+ *       second order differences: no, yes
+ *       largest group width: 3, 12, 20 bits
+ *    The "mixed" file has all 18 records.  The "no missing" file has the 6
+ * without missing values, and is decoded 3 times as often so both files
+ * decode the same number of records.
+ *
+ *    Usage: tdlbench [-k] [reps] [file]
+ *         -k = Keep the TDLPack files (so an older reader can be timed on
+ *              the same bytes).
+ *       reps = Number of times to decode the "mixed" file (default 5)
+ *       file = Where to write the TDLPack files (default "tdlbench"), which
+ *              gets ".1.tdl" and ".2.tdl" added.
+ *    Returns 0 if every record decoded, 1 if not.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *    Times are CPU seconds (clock ()).  The reader is single threaded.
+ *    The values are noise, so the decoded fields are not meaningful.  The
+ * sum of the max values is printed so two builds can be checked to have
+ * decoded the same thing.
+ *****************************************************************************
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "meta.h"
+#include "metaname.h"
+#include "degrib2.h"
+#include "tdlpack.h"
+#include "myerror.h"
+
+#define BENCH_NX 1000
+#define BENCH_NY 1000
+#define BENCH_SEED 7
+#define BENCH_MAXGROUP 300
+/* Scaled missing values (9999 and 9997 times 10000). */
+#define BENCH_PRIM 99990000
+#define BENCH_SEC 99970000
+
+/*****************************************************************************
+ * BenchRand() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Returns a pseudo random integer in [lo, hi].
+ *
+ * ARGUMENTS
+ * seed = The state of the generator. (Input/Output)
+ *   lo = Smallest value to return. (Input)
+ *   hi = Largest value to return. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: sInt4
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Uses its own generator (rather than rand ()) so the records are the
+ * same on every system.
+ *****************************************************************************
+ */
+static sInt4 BenchRand (uInt4 *seed, sInt4 lo, sInt4 hi)
+{
+   uInt4 val;           /* 30 random bits. */
+
+   *seed = *seed * 1103515245 + 12345;
+   val = (*seed >> 16) & 0x7fff;
+   *seed = *seed * 1103515245 + 12345;
+   val = (val << 15) | ((*seed >> 16) & 0x7fff);
+   return lo + (sInt4) (val % (uInt4) (hi - lo + 1));
+}
+
+/*****************************************************************************
+ * NumBits() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Returns the number of bits needed to hold a value.
+ *
+ * ARGUMENTS
+ * val = The value. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int NumBits (uInt4 val)
+{
+   int numBits = 0;     /* The number of bits. */
+
+   while (val != 0) {
+      numBits++;
+      val >>= 1;
+   }
+   return numBits;
+}
+
+/*****************************************************************************
+ * PutBits() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Stores the low numBits bits of val (most significant first) in a
+ * buffer.
+ *
+ * ARGUMENTS
+ *     buff = The buffer (must start out zeroed). (Output)
+ *   bitPos = Which bit of buff to write next. (Input/Output)
+ *      val = The value to store. (Input)
+ *  numBits = How many bits of val to store. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void PutBits (uChar *buff, size_t *bitPos, uInt4 val, int numBits)
+{
+   int i;               /* Loop counter over the bits. */
+
+   for (i = numBits - 1; i >= 0; i--) {
+      if ((val >> i) & 1) {
+         buff[*bitPos / 8] |= (uChar) (0x80 >> (*bitPos % 8));
+      }
+      (*bitPos)++;
+   }
+}
+
+/*****************************************************************************
+ * PutSigned() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Stores a value the way TDLPack stores its overall minimum and first
+ * difference: 5 bits for the width, a sign bit, then the magnitude.
+ *
+ * ARGUMENTS
+ *   buff = The buffer. (Output)
+ * bitPos = Which bit of buff to write next. (Input/Output)
+ *    val = The value to store. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void PutSigned (uChar *buff, size_t *bitPos, sInt4 val)
+{
+   uInt4 mag = (uInt4) ((val < 0) ? -val : val); /* Magnitude of val. */
+   int numBits = NumBits (mag); /* Width of the magnitude. */
+
+   if (numBits == 0) {
+      numBits = 1;
+   }
+   PutBits (buff, bitPos, (uInt4) numBits, 5);
+   PutBits (buff, bitPos, (val < 0) ? 1 : 0, 1);
+   PutBits (buff, bitPos, mag, numBits);
+}
+
+/*****************************************************************************
+ * MakeRecord() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Makes one TDLPack record (with its FORTRAN record lengths) out of a
+ * header and a randomly grouped data section.
+ *
+ * ARGUMENTS
+ *        hdr = Sections 0 to 2 of a TDLPack message. (Input)
+ *     hdrLen = Length of hdr. (Input)
+ *     numPts = Number of points in the grid. (Input)
+ * f_primMiss = 1 if the record should have a primary missing value. (Input)
+ *  f_secMiss = 1 if the record should have a secondary missing value. (In)
+ * f_sndOrder = 1 if the record should use second order differences. (In)
+ *     maxBit = Largest group width to use. (Input)
+ *       seed = The state of the random number generator. (Input/Output)
+ *        rec = Where to put the record (see NOTES). (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: size_t
+ *   The number of bytes in rec.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   rec needs to be zeroed and hold 12 + hdrLen + 3 * numPts +
+ * 8 * BENCH_MAXGROUP + 64 bytes (20 bit values).
+ *   A group's all ones value is its primary missing value, and all ones
+ * less 1 is its secondary missing value, so the other values stay under
+ * those in groups that can hold them.
+ *****************************************************************************
+ */
+static size_t MakeRecord (const uChar *hdr, size_t hdrLen, sInt4 numPts,
+                          int f_primMiss, int f_secMiss, int f_sndOrder,
+                          int maxBit, uInt4 *seed, uChar *rec)
+{
+   sInt4 numGroup;      /* Number of groups. */
+   sInt4 grpMin[BENCH_MAXGROUP]; /* Min value of each group. */
+   sInt4 grpBit[BENCH_MAXGROUP]; /* Width of each group. */
+   sInt4 grpNum[BENCH_MAXGROUP]; /* Number of values in each group. */
+   sInt4 left;          /* Number of values not yet given a group. */
+   int ibit, jbit, kbit; /* Widths of the group min, width, size fields. */
+   sInt4 top;           /* All ones for the current group width. */
+   sInt4 val;           /* The current value. */
+   sInt4 r;             /* A random number in [0, 99]. */
+   sInt4 i, j;          /* Loop counters. */
+   uChar *tdlp;         /* Start of the TDLPack message in rec. */
+   uChar *sect4;        /* Start of section 4 in rec. */
+   size_t bitPos;       /* Where to write in the bit stream. */
+   uInt4 tdlpLen;       /* Length of the TDLPack message. */
+   uInt4 sectLen;       /* Length of section 4. */
+   uInt4 recLen;        /* FORTRAN record length (padded message + 8). */
+
+   /* Split the grid into groups. */
+   numGroup = BenchRand (seed, 1, BENCH_MAXGROUP);
+   left = numPts;
+   for (i = 0; i < numGroup - 1; i++) {
+      grpNum[i] = BenchRand (seed, 1, 2 * numPts / numGroup);
+      if (grpNum[i] > left - (numGroup - 1 - i)) {
+         grpNum[i] = left - (numGroup - 1 - i);
+      }
+      left -= grpNum[i];
+   }
+   grpNum[numGroup - 1] = left;
+   ibit = jbit = kbit = 1;
+   for (i = 0; i < numGroup; i++) {
+      grpBit[i] = BenchRand (seed, 0, maxBit);
+      /* Most groups need room for the missing value codes. */
+      if (f_primMiss && (BenchRand (seed, 0, 99) < 80)) {
+         if (grpBit[i] < ((f_secMiss) ? 2 : 1)) {
+            grpBit[i] = (f_secMiss) ? 2 : 1;
+         }
+      }
+      grpMin[i] = BenchRand (seed, 0, 5000);
+      if (NumBits (grpMin[i]) > ibit)
+         ibit = NumBits (grpMin[i]);
+      if (NumBits (grpBit[i]) > jbit)
+         jbit = NumBits (grpBit[i]);
+      if (NumBits (grpNum[i]) > kbit)
+         kbit = NumBits (grpNum[i]);
+   }
+
+   /* rec is: 12 byte FORTRAN header, sections 0 to 2, section 4, "7777",
+    * padding to 8 bytes, 4 byte FORTRAN trailer. */
+   tdlp = rec + 12;
+   memcpy (tdlp, hdr, hdrLen);
+   sect4 = tdlp + hdrLen;
+   sect4[3] = (uChar) (8 | (f_sndOrder ? 4 : 0) | (f_primMiss ? 2 : 0) |
+                       (f_secMiss ? 1 : 0));
+   bitPos = 4 * 8;
+   PutBits (sect4, &bitPos, (uInt4) numPts, 32);
+   if (f_primMiss) {
+      PutBits (sect4, &bitPos, BENCH_PRIM, 32);
+   }
+   if (f_secMiss) {
+      PutBits (sect4, &bitPos, BENCH_SEC, 32);
+   }
+   if (f_sndOrder) {
+      val = BenchRand (seed, -100000, 100000);
+      PutBits (sect4, &bitPos, (val < 0) ? 1 : 0, 1);
+      PutBits (sect4, &bitPos, (uInt4) ((val < 0) ? -val : val), 31);
+      PutSigned (sect4, &bitPos, BenchRand (seed, -500, 500));
+   }
+   PutSigned (sect4, &bitPos, BenchRand (seed, -20000, 20000));
+   PutBits (sect4, &bitPos, (uInt4) numGroup, 16);
+   PutBits (sect4, &bitPos, (uInt4) ibit, 5);
+   PutBits (sect4, &bitPos, (uInt4) jbit, 5);
+   PutBits (sect4, &bitPos, (uInt4) kbit, 5);
+   for (i = 0; i < numGroup; i++)
+      PutBits (sect4, &bitPos, (uInt4) grpMin[i], ibit);
+   for (i = 0; i < numGroup; i++)
+      PutBits (sect4, &bitPos, (uInt4) grpBit[i], jbit);
+   for (i = 0; i < numGroup; i++)
+      PutBits (sect4, &bitPos, (uInt4) grpNum[i], kbit);
+   for (i = 0; i < numGroup; i++) {
+      if (grpBit[i] == 0) {
+         continue;
+      }
+      top = (sInt4) ((1UL << grpBit[i]) - 1);
+      for (j = 0; j < grpNum[i]; j++) {
+         r = BenchRand (seed, 0, 99);
+         if (f_primMiss && (r < 10)) {
+            val = top;
+         } else if (f_secMiss && (grpBit[i] >= 2) && (r < 15)) {
+            val = top - 1;
+         } else if (top > 2) {
+            val = BenchRand (seed, 0, top - ((f_secMiss) ? 2 :
+                                             (f_primMiss) ? 1 : 0));
+         } else {
+            val = BenchRand (seed, 0, top);
+         }
+         PutBits (sect4, &bitPos, (uInt4) val, grpBit[i]);
+      }
+   }
+   sectLen = (uInt4) ((bitPos + 7) / 8);
+   sect4[0] = (uChar) (sectLen >> 16);
+   sect4[1] = (uChar) (sectLen >> 8);
+   sect4[2] = (uChar) sectLen;
+   memcpy (sect4 + sectLen, "7777", 4);
+
+   tdlpLen = (uInt4) (hdrLen + sectLen + 4);
+   tdlp[4] = (uChar) (tdlpLen >> 16);
+   tdlp[5] = (uChar) (tdlpLen >> 8);
+   tdlp[6] = (uChar) tdlpLen;
+   tdlpLen = (tdlpLen + 7) / 8 * 8;
+   recLen = tdlpLen + 8;
+   for (i = 0; i < 4; i++) {
+      rec[i] = (uChar) (recLen >> (24 - 8 * i));
+      rec[4 + i] = 0;
+      rec[8 + i] = (uChar) ((recLen - 8) >> (24 - 8 * i));
+      tdlp[tdlpLen + i] = (uChar) (recLen >> (24 - 8 * i));
+   }
+   return 12 + tdlpLen + 4;
+}
+
+/*****************************************************************************
+ * WriteSet() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Writes one file of benchmark records.
+ *
+ * ARGUMENTS
+ * fileName = The file to write. (Input)
+ *   numRec = How many of the records (in the order given at the top of the
+ *            file) to write. (Input)
+ *
+ * FILES/DATABASES:
+ *   Creates (or truncates) fileName.
+ *
+ * RETURNS: int
+ *    0 = OK
+ *   -1 = Problems writing the file.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   A record is first written with WriteTDLPRecord so we can copy its
+ * header, then the file is started over.
+ *****************************************************************************
+ */
+static int WriteSet (const char *fileName, int numRec)
+{
+   FILE *fp;            /* The TDLPack file. */
+   gdsType gds;         /* The grid definition for every record. */
+   double *data;        /* The field for WriteTDLPRecord. */
+   uChar hdr[12 + 8 + 255 + 28]; /* FORTRAN header and sections 0 to 2. */
+   size_t hdrLen;       /* Length of sections 0 to 2. */
+   uChar *rec;          /* The current record. */
+   size_t recSize;      /* Allocated size of rec. */
+   size_t recLen;       /* Length of the current record. */
+   uInt4 seed = BENCH_SEED; /* The state of the random number generator. */
+   int prim, snd, bit;  /* Loop counters over the kinds of records. */
+   int num = 0;         /* Number of records written. */
+   static const int maxBit[] = { 3, 12, 20 };
+
+   memset (&gds, 0, sizeof (gdsType));
+   gds.projType = GS3_LAMBERT;
+   gds.Nx = BENCH_NX;
+   gds.Ny = BENCH_NY;
+   gds.numPts = BENCH_NX * BENCH_NY;
+   gds.lat1 = 20.19;
+   gds.lon1 = -121.55;
+   gds.orientLon = -95;
+   gds.Dx = 5079.406;
+   gds.meshLat = 25;
+
+   if ((fp = fopen (fileName, "w+b")) == NULL) {
+      printf ("Problems opening %s for write\n", fileName);
+      return -1;
+   }
+   data = (double *) calloc (gds.numPts, sizeof (double));
+   if (WriteTDLPRecord (fp, data, gds.numPts, 0, 0, 0, 0, 0, 0, &gds,
+                        "TDLPACK BENCH", 1714996800., 1000, 0, 0, 0, 0, 1,
+                        1, 1) != 0) {
+      printf ("Problems writing the header of %s\n", fileName);
+      free (data);
+      fclose (fp);
+      return -1;
+   }
+   free (data);
+   rewind (fp);
+   /* Section 0 is 8 bytes, section 1 starts with its length, section 2 is
+    * 28 bytes. */
+   if (fread (hdr, 1, 12 + 9, fp) != 12 + 9) {
+      printf ("Problems reading the header of %s\n", fileName);
+      fclose (fp);
+      return -1;
+   }
+   hdrLen = 8 + hdr[12 + 8] + 28;
+   if (fread (hdr + 12 + 9, 1, hdrLen - 9, fp) != hdrLen - 9) {
+      printf ("Problems reading the header of %s\n", fileName);
+      fclose (fp);
+      return -1;
+   }
+   fclose (fp);
+
+   if ((fp = fopen (fileName, "wb")) == NULL) {
+      printf ("Problems opening %s for write\n", fileName);
+      return -1;
+   }
+   recSize = 12 + hdrLen + 3 * gds.numPts + 8 * BENCH_MAXGROUP + 64;
+   rec = (uChar *) malloc (recSize);
+   for (prim = 0; prim < 3; prim++) {
+      for (snd = 0; snd < 2; snd++) {
+         for (bit = 0; bit < 3; bit++) {
+            if (num == numRec) {
+               break;
+            }
+            memset (rec, 0, recSize);
+            recLen = MakeRecord (hdr + 12, hdrLen, gds.numPts, (prim > 0),
+                                 (prim > 1), snd, maxBit[bit], &seed, rec);
+            if (fwrite (rec, 1, recLen, fp) != recLen) {
+               printf ("Problems writing %s\n", fileName);
+               free (rec);
+               fclose (fp);
+               return -1;
+            }
+            num++;
+         }
+      }
+   }
+   free (rec);
+   fclose (fp);
+   return 0;
+}
+
+/*****************************************************************************
+ * TimeSet() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Decodes every record in a TDLPack file a number of times, and prints
+ * how long it took.
+ *
+ * ARGUMENTS
+ * fileName = The file to read. (Input)
+ *     name = What to call the file in the output. (Input)
+ *     reps = How many times to decode the file. (Input)
+ *
+ * FILES/DATABASES:
+ *   Reads fileName.
+ *
+ * RETURNS: int
+ *    0 = OK
+ *   -1 = Problems reading the file.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int TimeSet (const char *fileName, const char *name, int reps)
+{
+   FILE *fp;            /* The TDLPack file. */
+   double *data = NULL; /* The values read back. */
+   uInt4 dataLen = 0;   /* Length of data. */
+   grib_MetaData meta;  /* The meta data read back. */
+   IS_dataType is;      /* Un-parsed meta data. */
+   sInt4 f_endMsg = 1;  /* 1 if we need to read the next message. */
+   LatLon lwlf;         /* Lower left of the subgrid (unused). */
+   LatLon uprt;         /* Upper right of the subgrid (unused). */
+   int rep;             /* Which pass over the file. */
+   int c;               /* Used to check for the end of the file. */
+   int numMsg = 0;      /* Number of records decoded. */
+   double sum = 0;      /* Sum of the max values. */
+   clock_t start;       /* When the decodes started. */
+   char *msg;           /* Error message. */
+
+   if ((fp = fopen (fileName, "rb")) == NULL) {
+      printf ("Problems opening %s for read\n", fileName);
+      return -1;
+   }
+   lwlf.lat = -100;
+   lwlf.lon = -100;
+   uprt.lat = -100;
+   uprt.lon = -100;
+   IS_Init (&is);
+   MetaInit (&meta);
+   start = clock ();
+   for (rep = 0; rep < reps; rep++) {
+      rewind (fp);
+      while ((c = fgetc (fp)) != EOF) {
+         ungetc (c, fp);
+         if (ReadGrib2Record (fp, 0, &data, &dataLen, &meta, &is, 0, 0, 0,
+                              0, 0, &f_endMsg, &lwlf, &uprt) != 0) {
+            msg = errSprintf (NULL);
+            printf ("Problems reading %s (%s)\n", fileName, msg);
+            free (msg);
+            MetaFree (&meta);
+            IS_Free (&is);
+            free (data);
+            fclose (fp);
+            return -1;
+         }
+         sum += meta.gridAttrib.max;
+         numMsg++;
+         MetaFree (&meta);
+         MetaInit (&meta);
+      }
+   }
+   printf ("%-12s %4d decodes %8.3f s  (check %.6g)\n", name, numMsg,
+           (clock () - start) / (double) CLOCKS_PER_SEC, sum);
+   MetaFree (&meta);
+   IS_Free (&is);
+   free (data);
+   fclose (fp);
+   return 0;
+}
+
+int main (int argc, char **argv)
+{
+   int f_keep = 0;      /* 1 if we should keep the TDLPack files. */
+   int reps;            /* Number of times to decode the "mixed" file. */
+   const char *root;    /* Where to write the TDLPack files. */
+   char *mixedName;     /* The file with all the records. */
+   char *plainName;     /* The file without missing values. */
+   int ierr = 0;        /* Non-zero if something went wrong. */
+
+   if ((argc > 1) && (strcmp (argv[1], "-k") == 0)) {
+      f_keep = 1;
+      argc--;
+      argv++;
+   }
+   reps = (argc > 1) ? atoi (argv[1]) : 5;
+   root = (argc > 2) ? argv[2] : "tdlbench";
+   if (reps < 1) {
+      printf ("Usage: tdlbench [-k] [reps] [file]\n");
+      return 1;
+   }
+   mixedName = (char *) malloc (strlen (root) + 7);
+   plainName = (char *) malloc (strlen (root) + 7);
+   sprintf (mixedName, "%s.1.tdl", root);
+   sprintf (plainName, "%s.2.tdl", root);
+
+   if ((WriteSet (mixedName, 18) != 0) || (WriteSet (plainName, 6) != 0)) {
+      ierr = 1;
+   } else if ((TimeSet (mixedName, "mixed", reps) != 0) ||
+              (TimeSet (plainName, "no missing", 3 * reps) != 0)) {
+      ierr = 1;
+   }
+   if (!f_keep) {
+      remove (mixedName);
+      remove (plainName);
+   }
+   free (mixedName);
+   free (plainName);
+   return ierr;
+}
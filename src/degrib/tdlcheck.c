@@ -0,0 +1,253 @@
+/*****************************************************************************
+ * tdlcheck.c
+ *
+ * DESCRIPTION
+ *    This file contains a round trip check of the TDLPack writer.  It packs
+ * a set of fields with WriteTDLPRecord (with both the original group search
+ * and the "-TdlPack 2" single pass packer), reads them back with
+ * ReadGrib2Record, and compares the values.  The fields are chosen so the
+ * packer has to use 0 bit groups and 0 bit group fields (constant fields,
+ * fields that are all missing in places, etc), which are easy to get wrong.
+ *
+ *    Usage: tdlcheck [file]
+ *       file = Where to write the TDLPack file (default "tdlcheck.tdl")
+ *    Returns 0 if every record reads back, 1 if not.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "meta.h"
+#include "metaname.h"
+#include "degrib2.h"
+#include "tdlpack.h"
+#include "myerror.h"
+
+#define CHECK_NX 67
+#define CHECK_NY 45
+#define CHECK_PRIM 9999
+#define CHECK_SEC 9997
+
+/* The kinds of fields to pack. */
+enum { FLD_CONST, FLD_CONST_ZERO, FLD_NOISE, FLD_ZERO_PATCH, FLD_PRIM_PATCH,
+   FLD_PRIM_CONST, FLD_SEC_PATCH, FLD_SEC_CONST, FLD_ALL_PRIM, FLD_MAX
+};
+
+static const char *FldName[] = {
+   "constant", "constant zero", "noise", "zero with patches",
+   "primary missing patches",
+   "constant with primary missing", "secondary missing patches",
+   "constant with secondary missing", "all primary missing"
+};
+
+/*****************************************************************************
+ * MakeField() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Fills in one of the check fields.
+ *
+ * ARGUMENTS
+ *       kind = Which field to make (see FLD_*). (Input)
+ *       Data = The field (CHECK_NX * CHECK_NY). (Output)
+ * f_primMiss = 1 if the field uses the primary missing value. (Output)
+ *  f_secMiss = 1 if the field uses the secondary missing value. (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void MakeField (int kind, double *Data, char *f_primMiss,
+                       char *f_secMiss)
+{
+   int x, y;            /* Loop counters over the grid. */
+   double val;          /* The current value. */
+   int f_patch;         /* If (x, y) is inside the missing value patch. */
+   unsigned int seed = 1 + kind; /* For the pseudo random values. */
+
+   *f_primMiss = 0;
+   *f_secMiss = 0;
+   for (y = 0; y < CHECK_NY; y++) {
+      for (x = 0; x < CHECK_NX; x++) {
+         seed = seed * 1103515245 + 12345;
+         f_patch = ((x > 10) && (x < 40) && (y > 5) && (y < 30));
+         switch (kind) {
+            case FLD_CONST:
+               val = 42.5;
+               break;
+            case FLD_CONST_ZERO:
+               val = 0;
+               break;
+            case FLD_NOISE:
+               val = ((seed >> 8) % 100) / 10.;
+               break;
+            case FLD_ZERO_PATCH:
+               val = (f_patch) ? 2 + 3 * sin (x / 5.) * cos (y / 4.) : 0;
+               break;
+            case FLD_PRIM_PATCH:
+               val = (f_patch) ? CHECK_PRIM : 280 + sin (x / 7.) * 10 + y;
+               break;
+            case FLD_PRIM_CONST:
+               val = (f_patch) ? CHECK_PRIM : 8056;
+               break;
+            case FLD_SEC_PATCH:
+               if (f_patch) {
+                  val = (y < 20) ? CHECK_PRIM : CHECK_SEC;
+               } else {
+                  val = 500 + ((seed >> 12) % 7);
+               }
+               break;
+            case FLD_SEC_CONST:
+               if (f_patch) {
+                  val = CHECK_PRIM;
+               } else if ((x + y) % 17 == 0) {
+                  val = CHECK_SEC;
+               } else {
+                  val = 12;
+               }
+               break;
+            case FLD_ALL_PRIM:
+            default:
+               val = CHECK_PRIM;
+               break;
+         }
+         if (val == CHECK_PRIM) {
+            *f_primMiss = 1;
+         } else if (val == CHECK_SEC) {
+            *f_secMiss = 1;
+         }
+         Data[x + y * CHECK_NX] = val;
+      }
+   }
+   /* A secondary missing value needs a primary one. */
+   if (*f_secMiss) {
+      *f_primMiss = 1;
+   }
+}
+
+int main (int argc, char **argv)
+{
+   const char *fileName = (argc > 1) ? argv[1] : "tdlcheck.tdl";
+   FILE *fp;            /* The TDLPack file. */
+   double *orig[2 * FLD_MAX]; /* The values that were packed. */
+   char f_prim[2 * FLD_MAX]; /* If the record used a primary missing. */
+   char f_sec[2 * FLD_MAX]; /* If the record used a secondary missing. */
+   gdsType gds;         /* The grid definition for every record. */
+   double *data = NULL; /* The values read back. */
+   uInt4 dataLen = 0;   /* Length of data. */
+   grib_MetaData meta;  /* The meta data read back. */
+   IS_dataType is;      /* Un-parsed meta data. */
+   sInt4 f_endMsg = 1;  /* 1 if we need to read the next message. */
+   LatLon lwlf;         /* Lower left of the subgrid (unused). */
+   LatLon uprt;         /* Upper right of the subgrid (unused). */
+   int rec;             /* Which record. */
+   int numBad = 0;      /* Number of records which didn't read back. */
+   uInt4 i;             /* Loop counter over the values. */
+   char *msg;           /* Error message. */
+
+   memset (&gds, 0, sizeof (gdsType));
+   gds.projType = GS3_LAMBERT;
+   gds.Nx = CHECK_NX;
+   gds.Ny = CHECK_NY;
+   gds.numPts = CHECK_NX * CHECK_NY;
+   gds.lat1 = 20.19;
+   gds.lon1 = -121.55;
+   gds.orientLon = -95;
+   gds.Dx = 5079.406;
+   gds.meshLat = 25;
+
+   if ((fp = fopen (fileName, "wb")) == NULL) {
+      printf ("Problems opening %s for write\n", fileName);
+      return 1;
+   }
+   /* Records 0..FLD_MAX-1 use the group search, the rest "-TdlPack 2". */
+   for (rec = 0; rec < 2 * FLD_MAX; rec++) {
+      orig[rec] = (double *) malloc (gds.numPts * sizeof (double));
+      MakeField (rec % FLD_MAX, orig[rec], &(f_prim[rec]), &(f_sec[rec]));
+      /* WriteTDLPRecord scales the data in place, so give it a copy. */
+      data = (double *) realloc (data, gds.numPts * sizeof (double));
+      memcpy (data, orig[rec], gds.numPts * sizeof (double));
+      if (WriteTDLPRecord (fp, data, gds.numPts, 1, 0, f_prim[rec],
+                           CHECK_PRIM, f_sec[rec], CHECK_SEC, &gds,
+                           "TDLPACK CHECK", 1714996800. + rec * 3600.,
+                           1000 + rec * 1000, 0, rec, 0, rec * 3600, 1,
+                           rec + 1, (char) (rec >= FLD_MAX)) != 0) {
+         printf ("Problems writing record %d\n", rec + 1);
+         fclose (fp);
+         return 1;
+      }
+   }
+   fclose (fp);
+   free (data);
+   data = NULL;
+
+   if ((fp = fopen (fileName, "rb")) == NULL) {
+      printf ("Problems opening %s for read\n", fileName);
+      return 1;
+   }
+   lwlf.lat = -100;
+   lwlf.lon = -100;
+   uprt.lat = -100;
+   uprt.lon = -100;
+   IS_Init (&is);
+   MetaInit (&meta);
+   for (rec = 0; rec < 2 * FLD_MAX; rec++) {
+      printf ("%2d %-32s %-8s ", rec + 1, FldName[rec % FLD_MAX],
+              (rec >= FLD_MAX) ? "fast" : "search");
+      if (ReadGrib2Record (fp, 0, &data, &dataLen, &meta, &is, 0, 0, 0, 0,
+                           0, &f_endMsg, &lwlf, &uprt) != 0) {
+         msg = errSprintf (NULL);
+         printf ("BAD (%s)\n", msg);
+         free (msg);
+         numBad++;
+         MetaFree (&meta);
+         MetaInit (&meta);
+         continue;
+      }
+      if (dataLen != gds.numPts) {
+         printf ("BAD (%u values)\n", dataLen);
+         numBad++;
+      } else {
+         for (i = 0; i < gds.numPts; i++) {
+            /* The data was packed with DSF = 1. */
+            if (fabs (data[i] - orig[rec][i]) > .051) {
+               break;
+            }
+         }
+         if (i != gds.numPts) {
+            printf ("BAD (value %lu is %f not %f)\n", (unsigned long int) i,
+                    data[i], orig[rec][i]);
+            numBad++;
+         } else {
+            printf ("ok\n");
+         }
+      }
+      MetaFree (&meta);
+      MetaInit (&meta);
+   }
+   MetaFree (&meta);
+   IS_Free (&is);
+   fclose (fp);
+   free (data);
+   for (rec = 0; rec < 2 * FLD_MAX; rec++) {
+      free (orig[rec]);
+   }
+   if (numBad != 0) {
+      printf ("%d records did not read back\n", numBad);
+      return 1;
+   }
+   return 0;
+}
@@ -6,6 +6,7 @@
 #include "myerror.h"
 #include "meta.h"
 #include "tendian.h"
+#include "bitstream.h"
 #include "myassert.h"
 #include "myutil.h"
 #include "clock.h"
@@ -815,6 +816,40 @@ static int ReadTDLPSect3 (uChar *bms, sInt4 tdlpLen, sInt4 *curLoc,
    return -1;
 }
 
+/*****************************************************************************
+ * TDLP_BitRead() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Reads one unsigned value of a given width from the packed stream.  Used
+ * for the header fields of section 4.
+ *
+ * ARGUMENTS
+ *      bs = The packed data stream. (Input/Output)
+ * numBits = Number of bits in the value (0..32). (Input)
+ *   f_err = Set to 1 if we ran out of data (otherwise unchanged). (Output)
+ *
+ * RETURNS: uInt4
+ *   The value read (0 if we ran out of data).
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static uInt4 TDLP_BitRead (bitStreamType *bs, uChar numBits, int *f_err)
+{
+   uInt4 val;           /* The value read. */
+
+   if (memBitReadN (bs, &val, 1, numBits) != 0) {
+      *f_err = 1;
+      return 0;
+   }
+   return val;
+}
+
 /*****************************************************************************
  * ReadTDLPSect4() --
  *
@@ -852,6 +887,11 @@ static int ReadTDLPSect3 (uChar *bms, sInt4 tdlpLen, sInt4 *curLoc,
  *          be lastData.
  *   2/2005 AAT: Added test to see if the number of bits needed matches the
  *          section length.
+ *  10/2026 AAT: Read the stream with the bulk bit reader (memBitReadN)
+ *          instead of one memBitRead call per value.
+ *  10/2026 AAT: Fused the six decode loops into one pass per group which
+ *          unpacks, undoes the second order differences, and reorders the
+ *          rows a run at a time rather than dividing by Nx for every value.
  *
  * NOTES
  * 1) See metaparse.c : ParseGrid()
@@ -870,11 +910,10 @@ static int ReadTDLPSect4 (uChar *bds, sInt4 tdlpLen, sInt4 *curLoc,
    uInt4 numPack;       /* Number of points packed. */
    sInt4 li_temp;       /* Temporary variable. */
    uInt4 uli_temp;      /* Temporary variable. */
-   uChar bufLoc;        /* Keeps track of where to start getting more data
-                         * out of the packed data stream. */
+   bitStreamType bs;    /* Used to read the packed data stream. */
+   int f_err;           /* If we ran out of data in the packed stream. */
+   uInt4 *vals;         /* The unpacked values of the current group. */
    uChar f_negative;    /* used to help with signs of numbers. */
-   size_t numUsed;      /* How many bytes were used in a given call to
-                         * memBitRead. */
    sInt4 origVal = 0;   /* Original value. */
    uChar mbit;          /* # of bits for abs (first first order difference) */
    sInt4 fstDiff = 0;   /* First first order difference. */
@@ -894,14 +933,23 @@ static int ReadTDLPSect4 (uChar *bds, sInt4 tdlpLen, sInt4 *curLoc,
                          * sectLen. */
    sInt4 maxVal;        /* The max value in a group. */
    uInt4 dataCnt;       /* How many values (miss or othewise) we have read. */
-   uInt4 lastData;      /* Index to last actual data. */
    uInt4 numVal;        /* # of actual (non-missing values) we have. */
    double scale;        /* Amount to scale values by. */
-   uInt4 dataInd;       /* Index into data for this value (used to switch
+   double *dp;          /* Where to store the next value (used to switch
                          * from a11..a1n,a2n..a21 to normal grid of
                          * a11..a1n,a21..a2n. */
-   uChar f_missing;     /* Used to help with primary missing values, and the
-                         * 0 bit possibility. */
+   int step;            /* +1 or -1 depending on the direction of the row. */
+   uInt4 col;           /* Column of dataCnt in the current row. */
+   uInt4 run;           /* # of values left in both this group and row. */
+   size_t k;            /* Loop counter. */
+   double value;        /* The current unpacked value. */
+   double lastVal = 0;  /* Last actual (non-missing) value. */
+   uInt4 maxNum;        /* Most values in any one group. */
+   sInt4 missPri;       /* Packed primary missing value in this group. */
+   sInt4 missSec;       /* Packed secondary missing value in this group. */
+   sInt4 offset;        /* Group min + overall min for this group. */
+   double dMin;         /* Min of the non-missing values. */
+   double dMax;         /* Max of the non-missing values. */
 #ifdef DEBUG
    sInt4 t_UK1 = 0;     /* Used to test theories about un defined values. */
    sInt4 t_UK2 = 0;     /* Used to test theories about un defined values. */
@@ -969,99 +1017,71 @@ static int ReadTDLPSect4 (uChar *bds, sInt4 tdlpLen, sInt4 *curLoc,
          meta->gridAttrib.f_miss = 2;
       }
    }
-   /* Init the buffer location. */
-   bufLoc = 8;
+   /* Read the rest of the section with the bulk bit reader. */
+   memBitReadInit (&bs, bds, sectLen - t_numBytes, 8);
+   f_err = 0;
    /* The origValue and fstDiff are only present if sndOrder packed. */
    if (f_sndOrder) {
-      memBitRead (&f_negative, sizeof (f_negative), bds, 1, &bufLoc,
-                  &numUsed);
-      memBitRead (&uli_temp, sizeof (sInt4), bds, 31, &bufLoc, &numUsed);
-      myAssert (numUsed == 4);
-      bds += numUsed;
-      t_numBytes += numUsed;
+      f_negative = (uChar) TDLP_BitRead (&bs, 1, &f_err);
+      uli_temp = TDLP_BitRead (&bs, 31, &f_err);
       origVal = (f_negative) ? -1 * uli_temp : uli_temp;
-      memBitRead (&mbit, sizeof (mbit), bds, 5, &bufLoc, &numUsed);
-      memBitRead (&f_negative, sizeof (f_negative), bds, 1, &bufLoc,
-                  &numUsed);
-      myAssert (numUsed == 0);
+      mbit = (uChar) TDLP_BitRead (&bs, 5, &f_err);
+      f_negative = (uChar) TDLP_BitRead (&bs, 1, &f_err);
       myAssert ((mbit > 0) && (mbit < 32));
-      memBitRead (&uli_temp, sizeof (sInt4), bds, mbit, &bufLoc, &numUsed);
-      bds += numUsed;
-      t_numBytes += numUsed;
+      uli_temp = TDLP_BitRead (&bs, mbit, &f_err);
       fstDiff = (f_negative) ? -1 * uli_temp : uli_temp;
    }
-   memBitRead (&nbit, sizeof (nbit), bds, 5, &bufLoc, &numUsed);
-   bds += numUsed;
-   t_numBytes += numUsed;
-   memBitRead (&f_negative, sizeof (f_negative), bds, 1, &bufLoc, &numUsed);
-   bds += numUsed;
-   t_numBytes += numUsed;
+   nbit = (uChar) TDLP_BitRead (&bs, 5, &f_err);
+   f_negative = (uChar) TDLP_BitRead (&bs, 1, &f_err);
    myAssert ((nbit > 0) && (nbit < 32));
-   memBitRead (&uli_temp, sizeof (sInt4), bds, nbit, &bufLoc, &numUsed);
-   bds += numUsed;
-   t_numBytes += numUsed;
+   uli_temp = TDLP_BitRead (&bs, nbit, &f_err);
    minVal = (f_negative) ? -1 * uli_temp : uli_temp;
-   memBitRead (&LX, sizeof (LX), bds, 16, &bufLoc, &numUsed);
-   bds += numUsed;
-   t_numBytes += numUsed;
-   grp = (TDLGroupType *) malloc (LX * sizeof (TDLGroupType));
-   memBitRead (&ibit, sizeof (ibit), bds, 5, &bufLoc, &numUsed);
-   bds += numUsed;
-   t_numBytes += numUsed;
-   memBitRead (&jbit, sizeof (jbit), bds, 5, &bufLoc, &numUsed);
+   LX = TDLP_BitRead (&bs, 16, &f_err);
+   ibit = (uChar) TDLP_BitRead (&bs, 5, &f_err);
+   jbit = (uChar) TDLP_BitRead (&bs, 5, &f_err);
    /* Following assert is because it is the # of bits of # of bits.  Which
     * means that # of bits of value that has a max of 64. */
    myAssert (jbit < 6);
-   bds += numUsed;
-   t_numBytes += numUsed;
-   memBitRead (&kbit, sizeof (kbit), bds, 5, &bufLoc, &numUsed);
-   bds += numUsed;
-   t_numBytes += numUsed;
+   kbit = (uChar) TDLP_BitRead (&bs, 5, &f_err);
+   if (f_err) {
+      errSprintf ("Ran out of data in BDS (TDLP Section 4)\n");
+      return -1;
+   }
+   grp = (TDLGroupType *) malloc (LX * sizeof (TDLGroupType));
+   vals = (uInt4 *) malloc (LX * sizeof (uInt4));
    myAssert (ibit < 33);
+   f_err |= memBitReadN (&bs, vals, LX, ibit);
    for (i = 0; i < LX; i++) {
-      if (ibit == 0) {
-         grp[i].min = 0;
-      } else {
-         memBitRead (&(grp[i].min), sizeof (sInt4), bds, ibit, &bufLoc,
-                     &numUsed);
-         bds += numUsed;
-         t_numBytes += numUsed;
-      }
+      grp[i].min = vals[i];
    }
    myAssert (jbit < 8);
+   f_err |= memBitReadN (&bs, vals, LX, jbit);
    for (i = 0; i < LX; i++) {
-      if (jbit == 0) {
-         grp[i].bit = 0;
-      } else {
-         myAssert (jbit <= sizeof (uChar) * 8);
-         memBitRead (&(grp[i].bit), sizeof (uChar), bds, jbit, &bufLoc,
-                     &numUsed);
-         bds += numUsed;
-         t_numBytes += numUsed;
-      }
+      grp[i].bit = (uChar) vals[i];
       myAssert (grp[i].bit < 32);
    }
    myAssert (kbit < 33);
+   f_err |= memBitReadN (&bs, vals, LX, kbit);
    t_numPack = 0;
    t_numBits = 0;
    for (i = 0; i < LX; i++) {
-      if (kbit == 0) {
-         grp[i].num = 0;
-      } else {
-         memBitRead (&(grp[i].num), sizeof (sInt4), bds, kbit, &bufLoc,
-                     &numUsed);
-         bds += numUsed;
-         t_numBytes += numUsed;
-      }
+      grp[i].num = vals[i];
       t_numPack += grp[i].num;
       t_numBits += grp[i].num * grp[i].bit;
    }
+   free (vals);
+   if (f_err) {
+      errSprintf ("Ran out of data in BDS (TDLP Section 4)\n");
+      free (grp);
+      return -1;
+   }
    if (t_numPack != numPack) {
       errSprintf ("Number packed %d != number of values in groups %d\n",
                   numPack, t_numPack);
       free (grp);
       return -1;
    }
+   t_numBytes += memBitReadTell (&bs) / 8;
    if ((t_numBytes + ceil (t_numBits / 8.)) > sectLen) {
       errSprintf ("# bytes in groups %ld (%ld + %ld / 8) > sectLen %ld\n",
                   (sInt4) (t_numBytes + ceil (t_numBits / 8.)),
@@ -1069,8 +1089,14 @@ static int ReadTDLPSect4 (uChar *bds, sInt4 tdlpLen, sInt4 *curLoc,
       free (grp);
       return -1;
    }
-   dataCnt = 0;
-   dataInd = 0;
+   /* Find the largest group, so one buffer can hold any group's values. */
+   maxNum = 0;
+   for (i = 0; i < LX; i++) {
+      if (grp[i].num > maxNum) {
+         maxNum = grp[i].num;
+      }
+   }
+   vals = (uInt4 *) malloc ((maxNum + 1) * sizeof (uInt4));
 
 #ifdef DEBUG
    printf ("nbit %d, ibit %d, jbit %d, kbit %d\n", nbit, ibit, jbit, kbit);
@@ -1084,366 +1110,146 @@ static int ReadTDLPSect4 (uChar *bds, sInt4 tdlpLen, sInt4 *curLoc,
    /* Binary scale factor in TDLP has reverse sign from GRIB definition. */
    scale = pow (10, -1 * DSF) * pow (2, -1 * BSF);
 
-   meta->gridAttrib.f_maxmin = 0;
-   /* Work with Second order complex packed data. */
+   /* *INDENT-OFF* */
+   /* For second order complex packed data, the algorithm appears to be:
+    * Data:      a1  a2 a3 a4 a5 ...
+    * 1st diff:   0  b2 b3 b4 b5 ...
+    * 2nd diff: UK1 UK2 c3 c4 c5 ...
+    * We already know a1 and b2, and unpack a stream of UK1 UK2 c3 c4
+    * The problem is that UK1, UK2 is undefined.  Originally I thought
+    * this was 0, or c3, but it appears that if b2 != 0, then
+    * UK2 = c3 + 2 b2, and UK1 = c3 + 1 * b2, otherwise it appears that
+    * UK1 == UK2, and typically UK1 == c3 (but not always). */
+   /* *INDENT-ON* */
    if (f_sndOrder) {
-      /* *INDENT-OFF* */
-      /* The algorithm appears to be:
-       * Data:      a1  a2 a3 a4 a5 ...
-       * 1st diff:   0  b2 b3 b4 b5 ...
-       * 2nd diff: UK1 UK2 c3 c4 c5 ...
-       * We already know a1 and b2, and unpack a stream of UK1 UK2 c3 c4
-       * The problem is that UK1, UK2 is undefined.  Originally I thought
-       * this was 0, or c3, but it appears that if b2 != 0, then
-       * UK2 = c3 + 2 b2, and UK1 = c3 + 1 * b2, otherwise it appears that
-       * UK1 == UK2, and typically UK1 == c3 (but not always). */
-      /* *INDENT-ON* */
       myAssert (numPack >= 2);
-      if (f_secMiss) {
-         numVal = 0;
-         lastData = 0;
-         for (i = 0; i < LX; i++) {
-            maxVal = (1 << grp[i].bit) - 1;
-            for (j = 0; j < grp[i].num; j++) {
-               /* signed int. */
-               memBitRead (&(li_temp), sizeof (sInt4), bds, grp[i].bit,
-                           &bufLoc, &numUsed);
-               bds += numUsed;
-               if (li_temp == maxVal) {
-                  data[dataInd] = meta->gridAttrib.missPri;
-               } else if (li_temp == (maxVal - 1)) {
-                  data[dataInd] = meta->gridAttrib.missSec;
-               } else {
-                  if (numVal > 1) {
-#ifdef DEBUG
-                     if (numVal == 2) {
-                        if (fstDiff != 0) {
-/*
-                           myAssert (t_UK1 == li_temp + fstDiff);
-                           myAssert (t_UK2 == li_temp + 2 * fstDiff);
-*/
-                        } else {
-                           myAssert (t_UK1 == t_UK2);
-                        }
-                     }
-#endif
-                     diff += (li_temp + grp[i].min + minVal);
-                     data[dataInd] = data[lastData] + diff * scale;
-                     lastData = dataInd;
-                  } else if (numVal == 1) {
-                     data[dataInd] = (origVal + fstDiff) * scale;
-                     lastData = dataInd;
-                     diff = fstDiff;
-#ifdef DEBUG
-                     t_UK2 = li_temp;
-#endif
-                  } else {
-                     data[dataInd] = origVal * scale;
+   }
+
+   /* Unpack a group at a time, and in the same pass handle the missing
+    * values, undo the second order differences, scale, find the max / min,
+    * and switch from a11..a1n,a2n..a21 to a11..a1n,a21..a2n.  Each group is
+    * done in runs which stop at the end of a row, so a run is stored with a
+    * fixed step of +1 or -1. */
+   if (meta->gds.Nx == 0) {
+      errSprintf ("Nx of 0 in the TDLP grid definition\n");
+      free (vals);
+      free (grp);
+      return -1;
+   }
+   numVal = 0;
+   dataCnt = 0;
+   col = 0;
+   dp = data;
+   step = 1;
+   dMin = HUGE_VAL;
+   dMax = -HUGE_VAL;
+   for (i = 0; i < LX; i++) {
+      if (memBitReadN (&bs, vals, grp[i].num, grp[i].bit) != 0) {
+         errSprintf ("Ran out of data in BDS (TDLP Section 4)\n");
+         free (vals);
+         free (grp);
+         return -1;
+      }
+      /* Values are never negative, so -1 means "no such missing value". */
+      maxVal = (1 << grp[i].bit) - 1;
+      missPri = (f_primMiss) ? maxVal : -1;
+      missSec = (f_secMiss) ? maxVal - 1 : -1;
+      if (f_primMiss && (!f_secMiss) && (grp[i].bit == 0) &&
+          (grp[i].min != 0)) {
+         /* In the case of grp[i].bit == 0, if grp[i].min == 0, then it is
+          * the missing value, otherwise regular value.  Only need to be
+          * concerned for primary missing values. */
 #ifdef DEBUG
-                     t_UK1 = li_temp;
+         printf ("This doesn't happen often.\n");
+         printf ("%d %d %ld\n", (int) i, grp[i].bit, (long) grp[i].min);
 #endif
-                  }
-                  numVal++;
-                  if (!meta->gridAttrib.f_maxmin) {
-                     meta->gridAttrib.min = data[dataInd];
-                     meta->gridAttrib.max = data[dataInd];
-                     meta->gridAttrib.f_maxmin = 1;
-                  } else {
-                     if (data[dataInd] < meta->gridAttrib.min) {
-                        meta->gridAttrib.min = data[dataInd];
-                     }
-                     if (data[dataInd] > meta->gridAttrib.max) {
-                        meta->gridAttrib.max = data[dataInd];
-                     }
-                  }
+         missPri = -1;
+      }
+      offset = grp[i].min + minVal;
+      for (j = 0; j < grp[i].num; j += run) {
+         run = meta->gds.Nx - col;
+         if (run > grp[i].num - j) {
+            run = grp[i].num - j;
+         }
+         if ((!f_sndOrder) && (missPri < 0) && (missSec < 0)) {
+            /* Simple case: no missing values, no differences. */
+            for (k = j; k < j + run; k++) {
+               value = ((sInt4) vals[k] + offset) * scale;
+               *dp = value;
+               dp += step;
+               if (value < dMin) {
+                  dMin = value;
+               }
+               if (value > dMax) {
+                  dMax = value;
                }
-               dataCnt++;
-               dataInd = ((dataCnt / meta->gds.Nx) % 2) ?
-                     (2 * (dataCnt / meta->gds.Nx) + 1) *
-                     meta->gds.Nx - dataCnt - 1 : dataCnt;
-               myAssert ((dataInd < numPack) || (dataCnt == numPack));
             }
-         }
-      } else if (f_primMiss) {
-         numVal = 0;
-         lastData = 0;
-         for (i = 0; i < LX; i++) {
-            maxVal = (1 << grp[i].bit) - 1;
-            for (j = 0; j < grp[i].num; j++) {
+            numVal += run;
+         } else {
+            for (k = j; k < j + run; k++) {
                /* signed int. */
-               memBitRead (&(li_temp), sizeof (sInt4), bds, grp[i].bit,
-                           &bufLoc, &numUsed);
-               bds += numUsed;
-               f_missing = 0;
-               if (li_temp == maxVal) {
-                  data[dataInd] = meta->gridAttrib.missPri;
-                  /* In the case of grp[i].bit == 0, if grp[i].min == 0, then 
-                   * it is the missing value, otherwise regular value. Only
-                   * need to be concerned for primary missing values. */
-                  f_missing = 1;
-                  if ((grp[i].bit == 0) && (grp[i].min != 0)) {
-#ifdef DEBUG
-                     printf ("This doesn't happen often.\n");
-                     printf ("%d %d %ld\n", i, grp[i].bit, grp[i].min);
-#endif
-                     myAssert (1 == 2);
-                     f_missing = 0;
-                  }
-               }
-               if (!f_missing) {
-                  if (numVal > 1) {
+               li_temp = vals[k];
+               if (li_temp == missPri) {
+                  *dp = meta->gridAttrib.missPri;
+               } else if (li_temp == missSec) {
+                  *dp = meta->gridAttrib.missSec;
+               } else {
+                  if (!f_sndOrder) {
+                     value = (li_temp + offset) * scale;
+                  } else if (numVal > 1) {
 #ifdef DEBUG
-                     if (numVal == 2) {
-                        if (fstDiff != 0) {
-/*
-                           myAssert (t_UK1 == li_temp + fstDiff);
-                           myAssert (t_UK2 == li_temp + 2 * fstDiff);
-*/
-                        } else {
-                           myAssert (t_UK1 == t_UK2);
-                        }
+                     if ((numVal == 2) && (fstDiff == 0)) {
+                        myAssert (t_UK1 == t_UK2);
                      }
 #endif
-                     diff += (li_temp + grp[i].min + minVal);
-                     data[dataInd] = data[lastData] + diff * scale;
-                     lastData = dataInd;
+                     diff += (li_temp + offset);
+                     value = lastVal + diff * scale;
                   } else if (numVal == 1) {
-                     data[dataInd] = (origVal + fstDiff) * scale;
-                     lastData = dataInd;
+                     value = (origVal + fstDiff) * scale;
                      diff = fstDiff;
 #ifdef DEBUG
                      t_UK2 = li_temp;
 #endif
                   } else {
-                     data[dataInd] = origVal * scale;
+                     value = origVal * scale;
 #ifdef DEBUG
                      t_UK1 = li_temp;
 #endif
                   }
-                  numVal++;
-                  if (!meta->gridAttrib.f_maxmin) {
-                     meta->gridAttrib.min = data[dataInd];
-                     meta->gridAttrib.max = data[dataInd];
-                     meta->gridAttrib.f_maxmin = 1;
-                  } else {
-                     if (data[dataInd] < meta->gridAttrib.min) {
-                        meta->gridAttrib.min = data[dataInd];
-                     }
-                     if (data[dataInd] > meta->gridAttrib.max) {
-                        meta->gridAttrib.max = data[dataInd];
-                     }
-                  }
-               }
-               dataCnt++;
-               dataInd = ((dataCnt / meta->gds.Nx) % 2) ?
-                     (2 * (dataCnt / meta->gds.Nx) + 1) *
-                     meta->gds.Nx - dataCnt - 1 : dataCnt;
-               myAssert ((dataInd < numPack) || (dataCnt == numPack));
-            }
-         }
-      } else {
-         lastData = 0;
-         for (i = 0; i < LX; i++) {
-            for (j = 0; j < grp[i].num; j++) {
-               /* signed int. */
-               memBitRead (&(li_temp), sizeof (sInt4), bds, grp[i].bit,
-                           &bufLoc, &numUsed);
-               bds += numUsed;
-               if (dataCnt > 1) {
-#ifdef DEBUG
-                  if (dataCnt == 2) {
-                     if (fstDiff != 0) {
-/*
-                        myAssert (t_UK1 == li_temp + fstDiff);
-                        myAssert (t_UK2 == li_temp + 2 * fstDiff);
-*/
-                     } else {
-                        myAssert (t_UK1 == t_UK2);
-                     }
-                  }
-#endif
-                  diff += (li_temp + grp[i].min + minVal);
-                  data[dataInd] = data[lastData] + diff * scale;
-                  lastData = dataInd;
-               } else if (dataCnt == 1) {
-                  data[dataInd] = (origVal + fstDiff) * scale;
-                  lastData = dataInd;
-                  diff = fstDiff;
-#ifdef DEBUG
-                  t_UK2 = li_temp;
-#endif
-               } else {
-                  data[dataInd] = origVal * scale;
-#ifdef DEBUG
-                  t_UK1 = li_temp;
-#endif
-               }
-#ifdef DEBUG
-/*
-               if (i >= 4153) {
-*/
-/*
-               if ((data[dataInd] > 100) || (data[dataInd] < -100)) {
-*/
-/*
-               if ((diff > 50) || (diff < -50)) {
-                  printf ("li_temp :: %ld, diff = %ld\n", li_temp, diff);
-                  printf ("data[dataInd] :: %f\n", data[dataInd]);
-                  printf ("Group # %d element %d, grp[i].min %ld, "
-                          "grp[i].bit %d, minVal %ld\n", i, j, grp[i].min,
-                          grp[i].bit, minVal);
-               }
-*/
-#endif
-               if (!meta->gridAttrib.f_maxmin) {
-                  meta->gridAttrib.min = data[dataInd];
-                  meta->gridAttrib.max = data[dataInd];
-                  meta->gridAttrib.f_maxmin = 1;
-               } else {
-                  if (data[dataInd] < meta->gridAttrib.min) {
-                     meta->gridAttrib.min = data[dataInd];
-                  }
-                  if (data[dataInd] > meta->gridAttrib.max) {
-                     meta->gridAttrib.max = data[dataInd];
+                  *dp = value;
+                  lastVal = value;
+                  if (value < dMin) {
+                     dMin = value;
                   }
-               }
-               dataCnt++;
-               dataInd = ((dataCnt / meta->gds.Nx) % 2) ?
-                     (2 * (dataCnt / meta->gds.Nx) + 1) *
-                     meta->gds.Nx - dataCnt - 1 : dataCnt;
-               myAssert ((dataInd < numPack) || (dataCnt == numPack));
-            }
-         }
-         numVal = dataCnt;
-      }
-
-      /* Work with regular complex packed data. */
-   } else {
-#ifdef DEBUG
-/*
-   printf ("Work with regular complex packed data\n");
-*/
-#endif
-      if (f_secMiss) {
-         numVal = 0;
-         for (i = 0; i < LX; i++) {
-            maxVal = (1 << grp[i].bit) - 1;
-            for (j = 0; j < grp[i].num; j++) {
-               /* signed int. */
-               memBitRead (&(li_temp), sizeof (sInt4), bds, grp[i].bit,
-                           &bufLoc, &numUsed);
-               bds += numUsed;
-               if (li_temp == maxVal) {
-                  data[dataInd] = meta->gridAttrib.missPri;
-               } else if (li_temp == (maxVal - 1)) {
-                  data[dataInd] = meta->gridAttrib.missSec;
-               } else {
-                  data[dataInd] = (li_temp + grp[i].min + minVal) * scale;
-                  numVal++;
-                  if (!meta->gridAttrib.f_maxmin) {
-                     meta->gridAttrib.min = data[dataInd];
-                     meta->gridAttrib.max = data[dataInd];
-                     meta->gridAttrib.f_maxmin = 1;
-                  } else {
-                     if (data[dataInd] < meta->gridAttrib.min) {
-                        meta->gridAttrib.min = data[dataInd];
-                     }
-                     if (data[dataInd] > meta->gridAttrib.max) {
-                        meta->gridAttrib.max = data[dataInd];
-                     }
-                  }
-               }
-               dataCnt++;
-               dataInd = ((dataCnt / meta->gds.Nx) % 2) ?
-                     (2 * (dataCnt / meta->gds.Nx) + 1) *
-                     meta->gds.Nx - dataCnt - 1 : dataCnt;
-               myAssert ((dataInd < numPack) || (dataCnt == numPack));
-            }
-         }
-      } else if (f_primMiss) {
-#ifdef DEBUG
-/*
-   printf ("Work with primary missing data\n");
-*/
-#endif
-         numVal = 0;
-         for (i = 0; i < LX; i++) {
-            maxVal = (1 << grp[i].bit) - 1;
-            for (j = 0; j < grp[i].num; j++) {
-               memBitRead (&(li_temp), sizeof (sInt4), bds, grp[i].bit,
-                           &bufLoc, &numUsed);
-               bds += numUsed;
-               f_missing = 0;
-               if (li_temp == maxVal) {
-                  data[dataInd] = meta->gridAttrib.missPri;
-                  /* In the case of grp[i].bit == 0, if grp[i].min == 0, then 
-                   * it is the missing value, otherwise regular value. Only
-                   * need to be concerned for primary missing values. */
-                  f_missing = 1;
-                  if ((grp[i].bit == 0) && (grp[i].min != 0)) {
-#ifdef DEBUG
-                     printf ("This doesn't happen often.\n");
-                     printf ("%d %d %ld\n", i, grp[i].bit, grp[i].min);
-                     myAssert (1 == 2);
-#endif
-                     f_missing = 0;
+                  if (value > dMax) {
+                     dMax = value;
                   }
-               }
-               if (!f_missing) {
-                  data[dataInd] = (li_temp + grp[i].min + minVal) * scale;
                   numVal++;
-                  if (!meta->gridAttrib.f_maxmin) {
-                     meta->gridAttrib.min = data[dataInd];
-                     meta->gridAttrib.max = data[dataInd];
-                     meta->gridAttrib.f_maxmin = 1;
-                  } else {
-                     if (data[dataInd] < meta->gridAttrib.min) {
-                        meta->gridAttrib.min = data[dataInd];
-                     }
-                     if (data[dataInd] > meta->gridAttrib.max) {
-                        meta->gridAttrib.max = data[dataInd];
-                     }
-                  }
                }
-               dataCnt++;
-               dataInd = ((dataCnt / meta->gds.Nx) % 2) ?
-                     (2 * (dataCnt / meta->gds.Nx) + 1) *
-                     meta->gds.Nx - dataCnt - 1 : dataCnt;
-               myAssert ((dataInd < numPack) || (dataCnt == numPack));
+               dp += step;
             }
          }
-      } else {
-         for (i = 0; i < LX; i++) {
-            for (j = 0; j < grp[i].num; j++) {
-               memBitRead (&(li_temp), sizeof (sInt4), bds, grp[i].bit,
-                           &bufLoc, &numUsed);
-               bds += numUsed;
-               data[dataInd] = (li_temp + grp[i].min + minVal) * scale;
-               if (!meta->gridAttrib.f_maxmin) {
-                  meta->gridAttrib.min = data[dataInd];
-                  meta->gridAttrib.max = data[dataInd];
-                  meta->gridAttrib.f_maxmin = 1;
-               } else {
-                  if (data[dataInd] < meta->gridAttrib.min) {
-                     meta->gridAttrib.min = data[dataInd];
-                  }
-                  if (data[dataInd] > meta->gridAttrib.max) {
-                     meta->gridAttrib.max = data[dataInd];
-                  }
-               }
-               dataCnt++;
-               dataInd = ((dataCnt / meta->gds.Nx) % 2) ?
-                     (2 * (dataCnt / meta->gds.Nx) + 1) *
-                     meta->gds.Nx - dataCnt - 1 : dataCnt;
-               myAssert ((dataInd < numPack) || (dataCnt == numPack));
-            }
+         dataCnt += run;
+         col += run;
+         if ((col == meta->gds.Nx) && (dataCnt < numPack)) {
+            /* Start the next row, from the opposite end. */
+            col = 0;
+            step = -step;
+            dp = (step < 0) ? data + dataCnt + meta->gds.Nx - 1 :
+                  data + dataCnt;
          }
-         numVal = dataCnt;
       }
    }
+   myAssert (dataCnt == numPack);
+   meta->gridAttrib.f_maxmin = (numVal != 0);
+   if (numVal != 0) {
+      meta->gridAttrib.min = dMin;
+      meta->gridAttrib.max = dMax;
+   }
    meta->gridAttrib.numMiss = dataCnt - numVal;
    meta->gridAttrib.refVal = minVal * scale;
 
+   free (vals);
    free (grp);
    return 0;
 }
@@ -2436,6 +2242,7 @@ static void findGroup1 (sInt4 *Data, int start, int stop,
  *
  * HISTORY
  *   1/2005 Arthur Taylor (MDL): Created
+ *  10/2026 AAT: Start the min / max at Data[start], not Data[0].
  *
  * NOTES
  *****************************************************************************
@@ -2445,7 +2252,7 @@ static void findGroup0 (sInt4 *Data, int start, int stop,
 {
    int i;               /* Loop counter. */
 
-   *max = *min = Data[0];
+   *max = *min = Data[start];
    for (i = start + 1; i < stop; i++) {
       if (*max < Data[i]) {
          if ((Data[i] - *min) > range) {
@@ -2678,6 +2485,7 @@ static void findGroupRev0 (sInt4 *Data, int start, int stop,
  *
  * HISTORY
  *   1/2005 Arthur Taylor (MDL): Created
+ *  10/2026 AAT: The range leaves room for both missing value codes.
  *
  * NOTES
  *****************************************************************************
@@ -2689,7 +2497,8 @@ static void shiftGroup2 (sInt4 *Data, int start1, int start2,
    int i;               /* Loop counter. */
    int range;           /* The range defined by bit. */
 
-   range = (int) (pow (2, bit) - 1) - 1;
+   /* Leave room for both the primary and secondary missing codes. */
+   range = (int) (pow (2, bit) - 1) - 2;
    myAssert (start2 <= start1);
    for (i = start1; i >= start2; i--) {
       if ((Data[i] != li_primMiss) && (Data[i] != li_secMiss)) {
@@ -3170,6 +2979,7 @@ static sInt4 ComputeGroupSize (TDLGroupType * group, int numGroup,
  *
  * HISTORY
  *  1/2005 Arthur Taylor (MDL): Created.
+ * 10/2026 AAT: Drop empty subgroups.
  *
  * NOTES
  *****************************************************************************
@@ -3295,8 +3105,15 @@ static int splitGroup (sInt4 *Data, int numData, TDLGroupType * group,
             } else {
                extra += numSubGroup - 1;
             }
-            memcpy ((*lclGroup) + lclIndex, subGroup,
-                    numSubGroup * sizeof (TDLGroupType));
+            /* doSplit and doSplitRight can leave an empty subgroup, which
+             * shiftGroup would not account for, so drop those. */
+            for (sub = 0; sub < numSubGroup; sub++) {
+               if (subGroup[sub].num != 0) {
+                  (*lclGroup)[lclIndex] = subGroup[sub];
+                  lclIndex++;
+               }
+            }
+            *numLclGroup = lclIndex;
             f_adjust = 1;
          } else {
             *numLclGroup = *numLclGroup + 1;
@@ -3525,6 +3342,78 @@ static void shiftGroup (sInt4 *Data, int numData, TDLGroupType ** Group,
    }
 }
 
+/*****************************************************************************
+ * SubtractMin() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Prepares the data for grouping by subtracting the overall min value from
+ * all the non-missing values.
+ *
+ * ARGUMENTS
+ *  OverallMin = The overall min value in the data. (Input)
+ *        Data = The data. (Input/Output)
+ *     numData = The number of elements in data. (Input)
+ *  f_primMiss = Flag if we have a primary missing value (Input)
+ * li_primMiss = scaled primary missing value (Input)
+ *   f_secMiss = Flag if we have a secondary missing value (Input)
+ *  li_secMiss = scaled secondary missing value (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  1/2005 Arthur Taylor (MDL): Created (as part of GroupIt).
+ * 10/2026 AAT: Moved out of GroupIt so GroupItFast could use it.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void SubtractMin (sInt4 OverallMin, sInt4 *Data, size_t numData,
+                         char f_primMiss, sInt4 li_primMiss, char f_secMiss,
+                         sInt4 li_secMiss)
+{
+   size_t i;            /* loop counter. */
+
+   if (OverallMin != 0) {
+      if (f_secMiss) {
+         for (i = 0; i < numData; i++) {
+            if ((Data[i] != li_secMiss) && (Data[i] != li_primMiss)) {
+               Data[i] -= OverallMin;
+               /* Check if we accidently adjusted to prim or sec, if so add
+                * 1. */
+               if ((Data[i] == li_secMiss) || (Data[i] == li_primMiss)) {
+                  myAssert (1 == 2);
+                  Data[i]++;
+                  if ((Data[i] == li_secMiss) || (Data[i] == li_primMiss)) {
+                     myAssert (1 == 2);
+                     Data[i]++;
+                  }
+               }
+            }
+         }
+      } else if (f_primMiss) {
+         for (i = 0; i < numData; i++) {
+            if (Data[i] != li_primMiss) {
+               Data[i] -= OverallMin;
+               /* Check if we accidently adjusted to prim or sec, if so add
+                * 1. */
+               if (Data[i] == li_primMiss) {
+                  myAssert (1 == 2);
+                  Data[i]++;
+               }
+            }
+         }
+      } else {
+         for (i = 0; i < numData; i++) {
+            Data[i] -= OverallMin;
+         }
+      }
+   }
+}
+
 /*****************************************************************************
  * GroupIt() --
  *
@@ -3572,6 +3461,8 @@ static void shiftGroup (sInt4 *Data, int numData, TDLGroupType ** Group,
  *
  * HISTORY
  *  1/2005 Arthur Taylor (MDL): Created.
+ *  10/2026 AAT: Non-missing groups exclude secondary missing values from
+ *          their min / max.
  *
  * NOTES
  *  1) Have not implemented const 0 bit groups for prim miss or no miss.
@@ -3596,41 +3487,8 @@ static void GroupIt (sInt4 OverallMin, sInt4 *Data, size_t numData,
    size_t i;            /* loop counter. */
 
    /* Subtract the Overall Min Value. */
-   if (OverallMin != 0) {
-      if (f_secMiss) {
-         for (i = 0; i < numData; i++) {
-            if ((Data[i] != li_secMiss) && (Data[i] != li_primMiss)) {
-               Data[i] -= OverallMin;
-               /* Check if we accidently adjusted to prim or sec, if so add
-                * 1. */
-               if ((Data[i] == li_secMiss) || (Data[i] == li_primMiss)) {
-                  myAssert (1 == 2);
-                  Data[i]++;
-                  if ((Data[i] == li_secMiss) || (Data[i] == li_primMiss)) {
-                     myAssert (1 == 2);
-                     Data[i]++;
-                  }
-               }
-            }
-         }
-      } else if (f_primMiss) {
-         for (i = 0; i < numData; i++) {
-            if (Data[i] != li_primMiss) {
-               Data[i] -= OverallMin;
-               /* Check if we accidently adjusted to prim or sec, if so add
-                * 1. */
-               if (Data[i] == li_primMiss) {
-                  myAssert (1 == 2);
-                  Data[i]++;
-               }
-            }
-         }
-      } else {
-         for (i = 0; i < numData; i++) {
-            Data[i] -= OverallMin;
-         }
-      }
-   }
+   SubtractMin (OverallMin, Data, numData, f_primMiss, li_primMiss,
+                f_secMiss, li_secMiss);
 
    myAssert ((f_secMiss == 0) || (f_secMiss == 1));
    myAssert ((f_primMiss == 0) || (f_primMiss == 1));
@@ -3689,6 +3547,14 @@ static void GroupIt (sInt4 OverallMin, sInt4 *Data, size_t numData,
                /* Close a non-missing group */
                G.f_trySplit = 1;
                G.f_tryShift = 1;
+               if (f_secMiss) {
+                  /* The running min / max counted secondary missing values. */
+                  if (!findMaxMin2 (Data, G.start, G.start + G.num, li_primMiss,
+                                    li_secMiss, &(G.min), &(G.max))) {
+                     G.min = 0;
+                     G.max = 0;
+                  }
+               }
                G.bit = (char) power ((uInt4) (G.max - G.min),
                                      f_secMiss + f_primMiss);
                myAssert (G.bit != 0);
@@ -3733,6 +3599,14 @@ static void GroupIt (sInt4 OverallMin, sInt4 *Data, size_t numData,
          /* Close a non-missing group */
          G.f_trySplit = 1;
          G.f_tryShift = 1;
+         if (f_secMiss) {
+            /* The running min / max counted secondary missing values. */
+            if (!findMaxMin2 (Data, G.start, G.start + G.num, li_primMiss,
+                              li_secMiss, &(G.min), &(G.max))) {
+               G.min = 0;
+               G.max = 0;
+            }
+         }
          G.bit = (char) power ((uInt4) (G.max - G.min),
                                f_secMiss + f_primMiss);
          myAssert (G.bit != 0);
@@ -3811,6 +3685,269 @@ static void GroupIt (sInt4 OverallMin, sInt4 *Data, size_t numData,
    }
 }
 
+/* Holds the statistics of a run of values while GroupItFast builds groups. */
+typedef struct {
+   sInt4 min;           /* Min non-missing value in the run. */
+   sInt4 max;           /* Max non-missing value in the run. */
+   uInt4 start;         /* index in Data where the run starts. */
+   uInt4 num;           /* number of values in the run. */
+   uChar f_val;         /* If the run has any non-missing values. */
+   uChar f_prim;        /* If the run has any primary missing values. */
+   uChar f_sec;         /* If the run has any secondary missing values. */
+} TDLRunType;
+
+/*****************************************************************************
+ * RunBit() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Computes the number of bits needed to pack a run of values as one group,
+ * leaving room for the missing value codes, and using 0 bit groups where the
+ * decoder allows them:
+ *   No missing: const values are 0 bit groups.
+ *   Primary missing: all missing is a 0 bit group (with min 0), and a const
+ * value that isn't 0 (with no missing) is a 0 bit group.
+ *   Secondary missing: all primary missing is a 0 bit group.
+ *
+ * ARGUMENTS
+ *          R = The run. (Input)
+ * f_primMiss = Flag if we have a primary missing value (Input)
+ *  f_secMiss = Flag if we have a secondary missing value (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: uChar
+ *   The number of bits for the group.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static uChar RunBit (const TDLRunType *R, char f_primMiss, char f_secMiss)
+{
+   if (!R->f_val) {
+      /* With secondary missing, bit 1 gives 1 = primary, 0 = secondary. */
+      return (uChar) ((R->f_sec) ? 1 : 0);
+   }
+   if (R->min == R->max) {
+      if ((!f_primMiss) ||
+          ((!f_secMiss) && (!R->f_prim) && (R->min != 0))) {
+         return 0;
+      }
+   }
+   return (uChar) power ((uInt4) (R->max - R->min), f_secMiss + f_primMiss);
+}
+
+/*****************************************************************************
+ * RunJoin() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Determines if two neighboring runs should be packed as one group.  They
+ * should if the bits saved by keeping them apart are fewer than the cost of
+ * another group.
+ *
+ * ARGUMENTS
+ *          A = The first run. (Input)
+ *          B = The run which follows A. (Input)
+ *     maxLen = The most values allowed in a group. (Input)
+ *    xFactor = Estimate of cost (in bits) of a group. (Input)
+ * f_primMiss = Flag if we have a primary missing value (Input)
+ *  f_secMiss = Flag if we have a secondary missing value (Input)
+ *          J = The joined run. (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *   1 if the runs should be joined (J is valid), 0 otherwise.
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static int RunJoin (const TDLRunType *A, const TDLRunType *B, uInt4 maxLen,
+                    size_t xFactor, char f_primMiss, char f_secMiss,
+                    TDLRunType *J)
+{
+   if (A->num + B->num > maxLen) {
+      return 0;
+   }
+   *J = *A;
+   J->num = A->num + B->num;
+   if (B->f_val) {
+      if (!A->f_val) {
+         J->min = B->min;
+         J->max = B->max;
+      } else {
+         if (B->min < J->min) {
+            J->min = B->min;
+         }
+         if (B->max > J->max) {
+            J->max = B->max;
+         }
+      }
+   }
+   J->f_val |= B->f_val;
+   J->f_prim |= B->f_prim;
+   J->f_sec |= B->f_sec;
+   return ((RunBit (J, f_primMiss, f_secMiss) * (size_t) J->num) <=
+           (RunBit (A, f_primMiss, f_secMiss) * (size_t) A->num +
+            RunBit (B, f_primMiss, f_secMiss) * (size_t) B->num + xFactor));
+}
+
+/*****************************************************************************
+ * GroupItFast() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Finds groups for packing the data in linear time.  This is the faster
+ * alternative to GroupIt(), which repeatedly rescans the data to split and
+ * shift the groups, at the cost of a somewhat larger message.
+ *
+ *   After removing the overall min value, it cuts the data into short runs
+ * (FAST_RUN_LEN values) noting the min / max and the kinds of missing values
+ * in each run.  It then walks the runs once, adding each run to the current
+ * group unless that costs more bits than starting a new group, and then
+ * walks the resulting groups once more joining any neighbors that are
+ * cheaper together.
+ *
+ * ARGUMENTS
+ *  OverallMin = The overall min value in the data. (Input)
+ *        Data = The data. (Input)
+ *     numData = The number of elements in data. (Input)
+ *       group = The resulting groups. (Output)
+ *    numGroup = Number of groups (Output)
+ *  f_primMiss = Flag if we have a primary missing value (Input)
+ * li_primMiss = scaled primary missing value (Input)
+ *   f_secMiss = Flag if we have a secondary missing value (Input)
+ *  li_secMiss = scaled secondary missing value (Input)
+ *   groupSize = How many bytes the groups and data will take. (Output)
+ *        ibit = # of bits for largest minimum value in groups (Output)
+ *        jbit = # of bits for largest # bits in groups (Output)
+ *        kbit = # of bits for largest # values in groups (Output)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *  1) The runs are long enough that there are never more than 65535 groups
+ *     (the number of groups is stored in 16 bits).
+ *****************************************************************************
+ */
+#define FAST_RUN_LEN 8
+static void GroupItFast (sInt4 OverallMin, sInt4 *Data, size_t numData,
+                         TDLGroupType ** group, size_t *numGroup,
+                         char f_primMiss, sInt4 li_primMiss, char f_secMiss,
+                         sInt4 li_secMiss, sInt4 *groupSize, size_t *ibit,
+                         size_t *jbit, size_t *kbit)
+{
+   TDLRunType *run;     /* The runs, and later the groups made from them. */
+   size_t numRun;       /* Number of runs. */
+   size_t runLen;       /* Number of values in a run. */
+   uInt4 maxLen;        /* The most values allowed in a group. */
+   TDLRunType R;        /* The run being filled. */
+   TDLRunType J;        /* Two runs joined together. */
+   sInt4 maxVal = 0;    /* The max (non-missing) value in the data. */
+   size_t xFactor;      /* Estimate of cost (in bits) of a group. */
+   size_t cur;          /* The group being built. */
+   size_t i;            /* loop counter. */
+   int pass;            /* loop counter. */
+
+   /* Subtract the Overall Min Value. */
+   SubtractMin (OverallMin, Data, numData, f_primMiss, li_primMiss,
+                f_secMiss, li_secMiss);
+
+   *numGroup = 0;
+   *group = NULL;
+   if (numData == 0) {
+      *groupSize = ComputeGroupSize (*group, 0, ibit, jbit, kbit);
+      return;
+   }
+   runLen = FAST_RUN_LEN;
+   if ((numData + runLen - 1) / runLen > 65535) {
+      runLen = (numData + 65534) / 65535;
+   }
+   maxLen = (runLen > MAX_GROUP_LEN) ? (uInt4) runLen : MAX_GROUP_LEN;
+
+   /* Collect the runs. */
+   numRun = (numData + runLen - 1) / runLen;
+   run = (TDLRunType *) malloc (numRun * sizeof (TDLRunType));
+   for (cur = 0; cur < numRun; cur++) {
+      R.start = (uInt4) (cur * runLen);
+      R.num = (uInt4) (((numData - R.start) < runLen) ?
+                       (numData - R.start) : runLen);
+      R.min = 0;
+      R.max = 0;
+      R.f_val = 0;
+      R.f_prim = 0;
+      R.f_sec = 0;
+      for (i = R.start; i < R.start + R.num; i++) {
+         if (f_primMiss && (Data[i] == li_primMiss)) {
+            R.f_prim = 1;
+         } else if (f_secMiss && (Data[i] == li_secMiss)) {
+            R.f_sec = 1;
+         } else if (!R.f_val) {
+            R.min = R.max = Data[i];
+            R.f_val = 1;
+         } else if (Data[i] < R.min) {
+            R.min = Data[i];
+         } else if (Data[i] > R.max) {
+            R.max = Data[i];
+         }
+      }
+      if (R.f_val && (R.max > maxVal)) {
+         maxVal = R.max;
+      }
+      run[cur] = R;
+   }
+
+   /* Estimate the cost of a group from the largest group min, # of bits
+    * and # of values it could have. */
+   xFactor = power ((uInt4) maxVal, 0) +
+         power ((uInt4) power ((uInt4) maxVal, f_primMiss + f_secMiss), 0) +
+         power (maxLen, 0);
+
+   /* Join the runs into groups, then join neighboring groups. */
+   for (pass = 0; pass < 2; pass++) {
+      cur = 0;
+      for (i = 1; i < numRun; i++) {
+         if (RunJoin (&(run[cur]), &(run[i]), maxLen, xFactor, f_primMiss,
+                      f_secMiss, &J)) {
+            run[cur] = J;
+         } else {
+            cur++;
+            run[cur] = run[i];
+         }
+      }
+      numRun = cur + 1;
+   }
+
+   *group = (TDLGroupType *) malloc (numRun * sizeof (TDLGroupType));
+   *numGroup = numRun;
+   for (i = 0; i < numRun; i++) {
+      (*group)[i].bit = RunBit (&(run[i]), f_primMiss, f_secMiss);
+      (*group)[i].min = (run[i].f_val) ? run[i].min : 0;
+      (*group)[i].max = (run[i].f_val) ? run[i].max : 0;
+      (*group)[i].num = run[i].num;
+      (*group)[i].start = run[i].start;
+      (*group)[i].f_trySplit = 0;
+      (*group)[i].f_tryShift = 0;
+   }
+   free (run);
+   *groupSize = ComputeGroupSize (*group, *numGroup, ibit, jbit, kbit);
+}
+
 /*****************************************************************************
  * GroupPack() --
  *
@@ -3843,6 +3980,7 @@ static void GroupIt (sInt4 OverallMin, sInt4 *Data, size_t numData,
  *       ibit = # of bits for largest minimum value in groups (Output)
  *       jbit = # of bits for largest # bits in groups (Output)
  *       kbit = # of bits for largest # values in groups (Output)
+ * f_fastPack = 1 if we should find the groups with GroupItFast (Input)
  *
  * FILES/DATABASES: None
  *
@@ -3853,6 +3991,7 @@ static void GroupIt (sInt4 OverallMin, sInt4 *Data, size_t numData,
  * HISTORY
  *  12/2004 Arthur Taylor (MDL): Updated from "group.c" in "C" tdlpack code.
  *   1/2005 AAT: Cleaned up.
+ *  10/2026 AAT: Added f_fastPack.
  *
  * NOTES
  *****************************************************************************
@@ -3864,7 +4003,7 @@ static int GroupPack (double *Src, sInt4 **Dst, sInt4 numData,
                       TDLGroupType ** group, size_t *numGroup,
                       sInt4 *Min, sInt4 *a1, sInt4 *b2,
                       sInt4 *groupSize, size_t *ibit, size_t *jbit,
-                      size_t *kbit)
+                      size_t *kbit, char f_fastPack)
 {
    sInt4 *SecDiff = NULL; /* Consists of the 2nd order differences if *
                            * requested. */
@@ -3955,18 +4094,30 @@ static int GroupPack (double *Src, sInt4 **Dst, sInt4 numData,
 
    /* Side affect of GroupIt2: it subtracts OverallMin from Data. */
    if (!(*f_sndOrder)) {
-      GroupIt (overallMin, Data, numData, group, numGroup, *f_primMiss,
-               li_primMiss, *f_secMiss, li_secMiss, groupSize, ibit, jbit,
-               kbit);
+      if (f_fastPack) {
+         GroupItFast (overallMin, Data, numData, group, numGroup,
+                      *f_primMiss, li_primMiss, *f_secMiss, li_secMiss,
+                      groupSize, ibit, jbit, kbit);
+      } else {
+         GroupIt (overallMin, Data, numData, group, numGroup, *f_primMiss,
+                  li_primMiss, *f_secMiss, li_secMiss, groupSize, ibit,
+                  jbit, kbit);
+      }
       *Min = overallMin;
       *a1 = 0;
       *b2 = 0;
       *Dst = Data;
       free (SecDiff);
    } else {
-      GroupIt (secMin, SecDiff, numData, group, numGroup, *f_primMiss,
-               li_primMiss, *f_secMiss, li_secMiss, groupSize, ibit, jbit,
-               kbit);
+      if (f_fastPack) {
+         GroupItFast (secMin, SecDiff, numData, group, numGroup,
+                      *f_primMiss, li_primMiss, *f_secMiss, li_secMiss,
+                      groupSize, ibit, jbit, kbit);
+      } else {
+         GroupIt (secMin, SecDiff, numData, group, numGroup, *f_primMiss,
+                  li_primMiss, *f_secMiss, li_secMiss, groupSize, ibit,
+                  jbit, kbit);
+      }
       *Min = secMin;
       *Dst = SecDiff;
       free (Data);
@@ -4002,6 +4153,8 @@ static int GroupPack (double *Src, sInt4 **Dst, sInt4 numData,
  *    projSec = The projection in seconds (Input)
  * processNum = The process number that created it (Input)
  *     seqNum = The sequence number that created it (Input)
+ * f_fastPack = 1 if we should find the groups in linear time (GroupItFast)
+ *              rather than search for the smallest message (GroupIt). (In)
  *
  * FILES/DATABASES:
  *   An already opened file pointing to the desired TDLP message.
@@ -4016,6 +4169,9 @@ static int GroupPack (double *Src, sInt4 **Dst, sInt4 numData,
  * HISTORY
  *  12/2004 Arthur Taylor (MDL): Created
  *   1/2005 AAT: Cleaned up.
+ *  10/2026 AAT: Added f_fastPack.
+ *  10/2026 AAT: Don't call fileBitWrite with 0 bits (that flushes the bit
+ *          buffer) for 0 bit group fields or values.
  *
  * NOTES
  *****************************************************************************
@@ -4025,7 +4181,8 @@ int WriteTDLPRecord (FILE *fp, double *Data, sInt4 DataLen, int DSF,
                      char f_secMiss, double secMiss, gdsType *gds,
                      char *comment, double refTime, sInt4 ID1,
                      sInt4 ID2, sInt4 ID3, sInt4 ID4,
-                     sInt4 projSec, sInt4 processNum, sInt4 seqNum)
+                     sInt4 projSec, sInt4 processNum, sInt4 seqNum,
+                     char f_fastPack)
 {
    sInt4 *Scaled;       /* The scaled data. */
    TDLGroupType *group; /* The groups used to pack the data. */
@@ -4106,7 +4263,7 @@ int WriteTDLPRecord (FILE *fp, double *Data, sInt4 DataLen, int DSF,
    if (GroupPack (Data, &Scaled, DataLen, DSF, BSF, &f_primMiss, &primMiss,
                   &f_secMiss, &secMiss, f_grid, gds->Nx, gds->Ny,
                   &f_sndOrder, &group, &numGroup, &overallMin, &a1, &b2,
-                  &groupSize, &ibit, &jbit, &kbit) != 0) {
+                  &groupSize, &ibit, &jbit, &kbit, f_fastPack) != 0) {
       return -4;
    }
 
@@ -4371,11 +4528,12 @@ int WriteTDLPRecord (FILE *fp, double *Data, sInt4 DataLen, int DSF,
    fileBitWrite (&ibit, sizeof (ibit), 5, fp, &pbuf, &pbufLoc);
    fileBitWrite (&jbit, sizeof (jbit), 5, fp, &pbuf, &pbufLoc);
    fileBitWrite (&kbit, sizeof (kbit), 5, fp, &pbuf, &pbufLoc);
-   for (i = 0; i < numGroup; i++) {
+   /* Note: fileBitWrite with 0 bits flushes pbuf, so skip 0 bit fields. */
+   for (i = 0; (i < numGroup) && (ibit != 0); i++) {
       fileBitWrite (&(group[i].min), sizeof (sInt4),
                     (unsigned short int) ibit, fp, &pbuf, &pbufLoc);
    }
-   for (i = 0; i < numGroup; i++) {
+   for (i = 0; (i < numGroup) && (jbit != 0); i++) {
       fileBitWrite (&(group[i].bit), sizeof (char),
                     (unsigned short int) jbit, fp, &pbuf, &pbufLoc);
    }
@@ -4383,8 +4541,10 @@ int WriteTDLPRecord (FILE *fp, double *Data, sInt4 DataLen, int DSF,
    li_temp = 0;
 #endif
    for (i = 0; i < numGroup; i++) {
-      fileBitWrite (&(group[i].num), sizeof (sInt4),
-                    (unsigned short int) kbit, fp, &pbuf, &pbufLoc);
+      if (kbit != 0) {
+         fileBitWrite (&(group[i].num), sizeof (sInt4),
+                       (unsigned short int) kbit, fp, &pbuf, &pbufLoc);
+      }
 #ifdef DEBUG
       li_temp += group[i].num;
 #endif
@@ -4416,8 +4576,10 @@ int WriteTDLPRecord (FILE *fp, double *Data, sInt4 DataLen, int DSF,
             } else {
                li_temp = Scaled[dataCnt] - group[i].min;
             }
-            fileBitWrite (&(li_temp), sizeof (sInt4), group[i].bit, fp,
-                          &pbuf, &pbufLoc);
+            if (group[i].bit != 0) {
+               fileBitWrite (&(li_temp), sizeof (sInt4), group[i].bit, fp,
+                             &pbuf, &pbufLoc);
+            }
             dataCnt++;
          }
       }
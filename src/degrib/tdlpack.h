@@ -30,6 +30,7 @@ int WriteTDLPRecord (FILE * fp, double *Data, sInt4 DataLen,
                      char f_secMiss, double secMiss, gdsType *gds,
                      char *comment, double refTime, sInt4 ID1,
                      sInt4 ID2, sInt4 ID3, sInt4 ID4,
-                     sInt4 projSec, sInt4 processNum, sInt4 seqNum);
+                     sInt4 projSec, sInt4 processNum, sInt4 seqNum,
+                     char f_fastPack);
 
 #endif
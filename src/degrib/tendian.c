@@ -244,24 +244,32 @@ size_t revfread (void *Dst, size_t elem_size, size_t num_elem, FILE *fp)
  *   9/2002 Arthur Taylor (MDL/RSIS): Created.
  *  11/2002 Arthur Taylor (MDL/RSIS): Updated.
  *  12/2002 (RY,FC,MA,&TB): Code Review.
+ *  10/2026 AAT: Swap into a buffer and fwrite it, rather than fputc.
  *
  * NOTES
- *   Decided to write using a bunch of fput, since this is buffered.  The
- * thought here, is that it is faster than swapping memory and then writing.
- * This is the exact opposite method as revfread.
+ *   Originally wrote using a bunch of fputc, since this is buffered.  Now
+ * swaps a block of elements at a time into a local buffer and fwrites it,
+ * since once there is more than one thread (see -threads) each fputc has
+ * to lock the stream.
  *****************************************************************************
  */
+#define REVFWRITE_BUFF 4096
 size_t revfwrite (void *Src, size_t elem_size, size_t num_elem, FILE *fp)
 {
-   char *ptr;           /* Current byte to put to file. */
+   char buff[REVFWRITE_BUFF]; /* Holds a block of swapped elements. */
+   char *ptr;           /* Current byte to put to buff (or file). */
    size_t i;            /* Byte count */
    size_t j;            /* Element count */
+   size_t k;            /* Element count in the current block. */
+   size_t num;          /* Number of elements in the current block. */
+   size_t numWrite;     /* Number of elements fwrite wrote. */
    char *src;           /* Allows us to treat Src as an array of char. */
 
    if (elem_size == 1) {
       return fwrite (Src, elem_size, num_elem, fp);
-   } else {
-      src = (char *) Src;
+   }
+   src = (char *) Src;
+   if (elem_size > REVFWRITE_BUFF) {
       ptr = src - elem_size - 1;
       for (j = 0; j < num_elem; ++j) {
          ptr += 2 * elem_size;
@@ -273,6 +281,22 @@ size_t revfwrite (void *Src, size_t elem_size, size_t num_elem, FILE *fp)
       }
       return num_elem;
    }
+   for (j = 0; j < num_elem; j += num) {
+      num = REVFWRITE_BUFF / elem_size;
+      if (num > num_elem - j) {
+         num = num_elem - j;
+      }
+      ptr = buff;
+      for (k = 0; k < num; ++k) {
+         for (i = elem_size; i > 0; --i) {
+            *(ptr++) = src[(j + k) * elem_size + i - 1];
+         }
+      }
+      if ((numWrite = fwrite (buff, elem_size, num, fp)) != num) {
+         return j + numWrite;
+      }
+   }
+   return num_elem;
 }
 
 /*****************************************************************************
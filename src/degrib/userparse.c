@@ -77,13 +77,18 @@ void UserInit (userType *usr)
    usr->f_kmlMerge = -1;
    usr->f_Csv = -1;
    usr->f_Tdl = -1;
+   usr->f_TdlPack = -1;
    usr->f_Grib2 = -1;
    usr->f_Cube = -1;
    usr->f_Append = -1;
+   usr->f_Series = -1;
    usr->f_poly = -1;
    usr->f_nMissing = -1;
    usr->msgNum = -1;
    usr->subgNum = -1;
+   usr->numThreads = -1;
+   usr->f_gidx = -1;
+   usr->f_stats = -1;
    usr->f_unit = -1;
    usr->decimal = -1;
    usr->LatLon_Decimal = -1;
@@ -418,6 +423,12 @@ int UserValidate (userType *usr)
       usr->f_verboseShp = 0;
    if (usr->subgNum == -1)
       usr->subgNum = 0;
+   if (usr->numThreads == -1)
+      usr->numThreads = 1;
+   if (usr->f_gidx == -1)
+      usr->f_gidx = 0;
+   if (usr->f_stats == -1)
+      usr->f_stats = 0;
    if (usr->f_MSB == -1)
       usr->f_MSB = 1;
    if (usr->f_Flt == -1)
@@ -434,6 +445,8 @@ int UserValidate (userType *usr)
       usr->f_Csv = 0;
    if (usr->f_Tdl == -1)
       usr->f_Tdl = 0;
+   if (usr->f_TdlPack == -1)
+      usr->f_TdlPack = 1;
    if (usr->f_Grib2 == -1)
       usr->f_Grib2 = 0;
    if (usr->f_Met == -1)
@@ -534,6 +547,8 @@ int UserValidate (userType *usr)
       usr->f_Cube = 0;
    if (usr->f_Append == -1)
       usr->f_Append = 0;
+   if (usr->f_Series == -1)
+      usr->f_Series = 0;
    if (usr->f_Print == -1)
       usr->f_Print = 0;
    if (usr->tmFormat == NULL) {
@@ -740,7 +755,8 @@ static char *UsrOpt[] = { "-cfg", "-in", "-I", "-C", "-P", "-V", "-Flt",
    "-numDays", "-ndfdVars", "-geoData", "-gribFilter", "-ndfdConven", "-Freq",
    "-Icon", "-curTime", "-rtmaDir", "-avgInterp", "-cwa", "-SimpleWWA",
    "-TxtParse", "-Kml", "-KmlIni", "-Kmz", "-kmlMerge", "-lampDir", "-Split",
-   "-StormTotal", NULL
+   "-StormTotal", "-threads", "-gidx", "-TdlPack", "-Series", "-stats",
+   NULL
 };
 
 int IsUserOpt (char *str)
@@ -764,7 +780,8 @@ static int ParseUserChoice (userType *usr, char *cur, char *next)
       MAPINIFILE, MAPINIOPTIONS, XML, MOTD, GRAPH, STARTTIME, ENDTIME,
       STARTDATE, NUMDAYS, NDFDVARS, GEODATA, GRIBFILTER, NDFDCONVEN,
       FREQUENCY, ICON, CURTIME, RTMADIR, AVGINTERP, CWA, SIMPLEWWA, TXTPARSE,
-      KML, KMLINIFILE, KMZ, KMLMERGE, LAMPDIR, SPLIT, TOTAL
+      KML, KMLINIFILE, KMZ, KMLMERGE, LAMPDIR, SPLIT, TOTAL,
+      THREADS, GIDX, TDLPACK, SERIES, STATS
    };
    int index;           /* "cur"'s index into Opt, which matches enum val. */
    double lat, lon;     /* Used to check on the -pnt option. */
@@ -982,10 +999,22 @@ static int ParseUserChoice (userType *usr, char *cur, char *next)
          if (usr->f_Append == -1)
             usr->f_Append = 1;
          return 1;
+      case SERIES:
+         if (usr->f_Series == -1)
+            usr->f_Series = 1;
+         return 1;
       case NOMISS_SHP:
          if (usr->f_nMissing == -1)
             usr->f_nMissing = 1;
          return 1;
+      case GIDX:
+         if (usr->f_gidx == -1)
+            usr->f_gidx = 1;
+         return 1;
+      case STATS:
+         if (usr->f_stats == -1)
+            usr->f_stats = 1;
+         return 1;
       case SIMPLEWX:
          if (usr->f_SimpleWx == -1)
             usr->f_SimpleWx = 1;
@@ -1625,6 +1654,25 @@ static int ParseUserChoice (userType *usr, char *cur, char *next)
             usr->decimal = (sChar) li_temp;
          }
          return 2;
+      case TDLPACK:
+         if (usr->f_TdlPack == -1) {
+            if ((myAtoI (next, &(li_temp)) != 1) || (li_temp < 1) ||
+                (li_temp > 2)) {
+               errSprintf ("Bad value to '%s' of '%s'\n", cur, next);
+               return -1;
+            }
+            usr->f_TdlPack = (sChar) li_temp;
+         }
+         return 2;
+      case THREADS:
+         if (usr->numThreads == -1) {
+            if ((myAtoI (next, &(li_temp)) != 1) || (li_temp < 1)) {
+               errSprintf ("Bad value to '%s' of '%s'\n", cur, next);
+               return -1;
+            }
+            usr->numThreads = (int) li_temp;
+         }
+         return 2;
       case LATLON_DECIMAL:
          if (usr->LatLon_Decimal == -1) {
 /*            usr->LatLon_Decimal = (sChar) atof (next); */
@@ -57,13 +57,23 @@ typedef struct {
    sChar f_verboseShp;  /* f_verboseShp = -verboseShp */
    sChar f_Csv;         /* f_Csv = -Csv */
    sChar f_Tdl;         /* f_TDL = -Tdl */
+   sChar f_TdlPack;     /* f_TdlPack = -TdlPack (1 = search for the smallest
+                         * groups, 2 = find groups in linear time). */
    sChar f_Grib2;       /* f_Grib2 = -Grib2 */
    sChar f_Cube;        /* f_Cube = -Cube */
    sChar f_Append;      /* f_Append = -Append */
+   sChar f_Series;      /* f_Series = -Series (also store the grids point
+                         * by point, for fast point forecasts). */
 	sChar f_poly;        /* Create polygon .shp or point .shp files? */
    sChar f_nMissing;    /* Don't store missing values in .shp files. */
    int msgNum;          /* msgNum = -msg (1..n) (0 means all messages). */
    int subgNum;         /* which subgrid in the message (0..m-1) */
+   int numThreads;      /* numThreads = -threads (number of threads to decode
+                         * messages with when converting all messages). */
+   sChar f_gidx;        /* f_gidx = -gidx (write a .gidx index of the input
+                         * if it is missing or stale). */
+   sChar f_stats;       /* f_stats = -stats (report how many allocations
+                         * reusing the unpacker's memory saved). */
    sChar f_unit;        /* f_unit = 0 -Unit n || 1 -Unit e || 2 -Unit m */
    sChar decimal;       /* How many decimals to round to. (default 3) */
    sChar LatLon_Decimal; /* How many decimals to round Lat/Lons (default 6) */
@@ -39,6 +39,33 @@
 #include "myerror.h"
 #endif
 
+/* The cache of parsed ugly strings is shared by all threads. */
+#if !defined(_WINDOWS_) && !defined(MS_WINDOWS)
+#define USE_PTHREAD
+#include <pthread.h>
+#endif
+
+/* Number of hash chains in the ugly string cache (a power of 2). */
+#define UGLY_CACHE_HASH 1024
+/* Most ugly strings to keep in the cache.  Beyond this they are parsed each
+ * time. */
+#define UGLY_CACHE_MAX 16384
+
+/* An ugly string that has been parsed (see ParseUglyString). */
+typedef struct UglyCacheType {
+   char *wxData;        /* The ugly string. */
+   int simpleVer;       /* The simple Wx table version it was parsed with. */
+   int ans;             /* What parsing it returned. */
+   UglyStringType ugly; /* The parsed ugly string. */
+   struct UglyCacheType *next; /* Next entry in the same hash chain. */
+} UglyCacheType;
+
+static UglyCacheType *UglyCache[UGLY_CACHE_HASH];
+static int UglyCacheLen = 0;
+#ifdef USE_PTHREAD
+static pthread_mutex_t UglyCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 typedef struct {
    char *abrev, *name;
    uChar number;
@@ -2332,7 +2359,7 @@ static void Ugly2English (UglyStringType * ugly)
 }
 
 /*****************************************************************************
- * ParseUglyString() --
+ * ParseUglyStringNoCache() --
  *
  * Arthur Taylor / MDL
  *
@@ -2354,13 +2381,16 @@ static void Ugly2English (UglyStringType * ugly)
  *
  * HISTORY
  *   5/2003 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Renamed from ParseUglyString (which now checks the cache
+ *               first).
  *
  * NOTES
  * 1) Assumes it is ok to modify the wxData ascii string.  This means that
  *    You can NOT pass in constant strings.
  *****************************************************************************
  */
-int ParseUglyString (UglyStringType * ugly, char *wxData, int simpleVer)
+static int ParseUglyStringNoCache (UglyStringType * ugly, char *wxData,
+                                   int simpleVer)
 {
    char *cur;           /* Used to help walk though the ascii string. */
    char *start;         /* Where current phrase starts. */
@@ -2547,6 +2577,192 @@ int ParseUglyString (UglyStringType * ugly, char *wxData, int simpleVer)
    return 0;
 }
 
+/*****************************************************************************
+ * CopyUglyString() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Copies a parsed ugly string, including its own copy of the english
+ * phrases and error messages (so it can be freed with FreeUglyString).
+ *
+ * ARGUMENTS
+ * dst = The copy. (Output)
+ * src = The parsed ugly string to copy. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *****************************************************************************
+ */
+static void CopyUglyString (UglyStringType * dst, const UglyStringType * src)
+{
+   int j;               /* Used to copy all the english words. */
+
+   *dst = *src;
+   for (j = 0; j < NUM_UGLY_WORD; j++) {
+      if (src->english[j] != NULL) {
+         dst->english[j] = (char *) malloc (strlen (src->english[j]) + 1);
+         strcpy (dst->english[j], src->english[j]);
+      }
+   }
+   if (src->errors != NULL) {
+      dst->errors = (char *) malloc (strlen (src->errors) + 1);
+      strcpy (dst->errors, src->errors);
+   }
+}
+
+static unsigned int UglyCacheHash (const char *wxData, int simpleVer)
+{
+   unsigned int hash = 5381 + simpleVer;
+
+   while (*wxData != '\0') {
+      hash = hash * 33 + (unsigned char) *(wxData++);
+   }
+   return hash & (UGLY_CACHE_HASH - 1);
+}
+
+/*****************************************************************************
+ * ParseUglyString() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Parse an ASCII ugly string describing weather into a data structure
+ * which is more easily manipulated.  Each distinct (ugly string, simpleVer)
+ * is only parsed once per run.  After that, the answer is copied from a
+ * process wide cache, since the NDFD Wx tables repeat almost entirely from
+ * grid to grid (and probes look up the same strings point after point).
+ *
+ * ARGUMENTS
+ *      ugly = The ugly string structure to modify. (Output)
+ *    wxData = The ugly string to parse. (Input)
+ * simpleVer = The version of the simple Wx table to use.
+ *             (1 is 6/2003 version), (2 is 1/2004 version). (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: int
+ *  0 = No problems
+ * -1 = Had difficulties parseing the Ugly string.
+ *
+ * HISTORY
+ *   5/2003 Arthur Taylor (MDL/RSIS): Created.
+ *  10/2026 AAT: Added the cache (see ParseUglyStringNoCache).
+ *
+ * NOTES
+ * 1) Assumes it is ok to modify the wxData ascii string.  This means that
+ *    You can NOT pass in constant strings.
+ * 2) Free the result with FreeUglyString as before.  The cache itself is
+ *    freed by FreeUglyStringCache.
+ *****************************************************************************
+ */
+int ParseUglyString (UglyStringType * ugly, char *wxData, int simpleVer)
+{
+   unsigned int hash;   /* Which hash chain wxData belongs to. */
+   UglyCacheType *entry; /* An entry in the cache. */
+   UglyCacheType *other; /* Used to check if another thread added it. */
+   int ans;             /* What parsing wxData returned. */
+
+   hash = UglyCacheHash (wxData, simpleVer);
+#ifdef USE_PTHREAD
+   pthread_mutex_lock (&UglyCacheMutex);
+#endif
+   for (entry = UglyCache[hash]; entry != NULL; entry = entry->next) {
+      if ((entry->simpleVer == simpleVer) &&
+          (strcmp (entry->wxData, wxData) == 0)) {
+         CopyUglyString (ugly, &(entry->ugly));
+         ans = entry->ans;
+#ifdef USE_PTHREAD
+         pthread_mutex_unlock (&UglyCacheMutex);
+#endif
+         return ans;
+      }
+   }
+#ifdef USE_PTHREAD
+   pthread_mutex_unlock (&UglyCacheMutex);
+#endif
+
+   /* Copy wxData before parsing it, since the parse edits it as it goes. */
+   entry = (UglyCacheType *) malloc (sizeof (UglyCacheType));
+   entry->wxData = (char *) malloc (strlen (wxData) + 1);
+   strcpy (entry->wxData, wxData);
+   entry->simpleVer = simpleVer;
+   ans = ParseUglyStringNoCache (ugly, wxData, simpleVer);
+   entry->ans = ans;
+   CopyUglyString (&(entry->ugly), ugly);
+
+#ifdef USE_PTHREAD
+   pthread_mutex_lock (&UglyCacheMutex);
+#endif
+   if (UglyCacheLen < UGLY_CACHE_MAX) {
+      for (other = UglyCache[hash]; other != NULL; other = other->next) {
+         if ((other->simpleVer == simpleVer) &&
+             (strcmp (other->wxData, entry->wxData) == 0)) {
+            break;
+         }
+      }
+      if (other == NULL) {
+         entry->next = UglyCache[hash];
+         UglyCache[hash] = entry;
+         UglyCacheLen++;
+         entry = NULL;
+      }
+   }
+#ifdef USE_PTHREAD
+   pthread_mutex_unlock (&UglyCacheMutex);
+#endif
+   if (entry != NULL) {
+      FreeUglyString (&(entry->ugly));
+      free (entry->wxData);
+      free (entry);
+   }
+   return ans;
+}
+
+/*****************************************************************************
+ * FreeUglyStringCache() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Frees the cache of parsed ugly strings that ParseUglyString keeps.
+ *
+ * ARGUMENTS
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created.
+ *
+ * NOTES
+ *   Only call when no other thread is parsing ugly strings.
+ *****************************************************************************
+ */
+void FreeUglyStringCache (void)
+{
+   int i;               /* Loop counter over the hash chains. */
+   UglyCacheType *entry; /* The entry to free. */
+
+   for (i = 0; i < UGLY_CACHE_HASH; i++) {
+      while (UglyCache[i] != NULL) {
+         entry = UglyCache[i];
+         UglyCache[i] = entry->next;
+         FreeUglyString (&(entry->ugly));
+         free (entry->wxData);
+         free (entry);
+      }
+   }
+   UglyCacheLen = 0;
+}
+
 /*****************************************************************************
  * PrintUglyString() --
  *
@@ -7,6 +7,8 @@ void FreeUglyString (UglyStringType * ugly);
 
 int ParseUglyString (UglyStringType * ugly, char *wxData, int simpleVer);
 
+void FreeUglyStringCache (void);
+
 void PrintUglyString (UglyStringType *ugly);
 
 #endif
@@ -48,6 +48,11 @@ int gribWriteFloat (const char *Filename, double *grib_Data,
                     uChar scan, sChar f_MSB, sChar decimal, sChar f_GrADS,
                     sChar f_SimpleWx, sChar f_ESRIAsc);
 
+int gribWriteFloatFlt (const char *Filename, float *flt_Data,
+                       grib_MetaData * meta, gridAttribType * attrib,
+                       uChar scan, sChar f_MSB, sChar decimal, sChar f_GrADS,
+                       sChar f_SimpleWx, sChar f_ESRIAsc);
+
 /* Possible error messages left in errSprintf() */
 int gribWriteShp (const char *Filename, double *grib_Data,
                   grib_MetaData * meta, sChar f_poly, sChar f_nMissing,
@@ -67,6 +72,9 @@ int gribWriteCsv (FILE * out_fp, double *grib_Data, grib_MetaData * meta,
 int gribWriteNetCDF (char *filename, double *grib_Data, grib_MetaData * meta,
                      sChar f_NetCDF, sChar decimal, sChar LatLon_Decimal);
 
+int gribWriteNetCDFFlt (char *filename, float *flt_Data, grib_MetaData * meta,
+                        sChar f_NetCDF, sChar decimal, sChar LatLon_Decimal);
+
 /* Possible error messages left in errSprintf() */
 int gribInterpFloat (const char *Filename, double *grib_Data,
                      grib_MetaData * meta, gridAttribType * attrib,
@@ -477,73 +477,36 @@ int gribWriteEsriAve (char *filename, gdsType *gds, double orient)
 }
 
 /*****************************************************************************
- * gribWriteFloat() -- Review 12/2002
+ * WriteFloatCore() --
  *
  * Arthur Taylor / MDL
  *
  * PURPOSE
- *   This creates a .flt file.  The .flt file happens to match the one that
- * Esri ArcView Spatial analyst uses, and extra support is created for using
- * it in Esri, but at the same time, anyone could write a program to read
- * the meta file along with the .flt file, and display the data.
+ *   The body of gribWriteFloat and gribWriteFloatFlt.  Writes either a
+ * double grid (grib_Data) or a float grid (flt_Data) to a .flt file set.
  *
  * ARGUMENTS
- *   Filename = Name of file to save to. (Output)
- *  grib_Data = The grib2 data to write. (Input)
- *       meta = The meta file structure to generate the .flt for. (Input)
- *     attrib = Sect 5 from the parsed grib message to write. (Input)
- *       scan = Either 0 or (0100)<< 4 = 64 (How to write file.) (Input)
- *              if scan is 0 create a .flt file (For input to Esri S.A.)
- *              if scan is 64 create a .tlf file (For input to NDFD Gd)
- *      f_MSB = True if we should create MSB file, false for LSB (Input)
- *    decimal = How many decimals to round to. (Input)
- *    f_GrADS = True if you want to create a GrADS .ctl file. (Input)
- * f_SimpleWx = True if you want to simplify the weather via NDFD method,
- *              before output. (Input)
- *  f_AscGrid = True if we want ESRI Ascii grids (instead of binary flt) (In)
+ *  See gribWriteFloat, plus:
+ * flt_Data = If not NULL, the float grid to write instead of grib_Data.
+ *            (Input)
  *
  * FILES/DATABASES:
- *   Calls gribWriteEsriHdr to create an Esri ascii .hdr file.
- *   Calls gribWriteEsriPrj to create an Esri ascii .prj file.
- *   Calls gribWriteEsriAve to create an Esri ascii .ave file.
- *   Creates a .flt file, which is a binary file (Big Endian) consisting of
- *   NxM floats, starting at the upper left corner of the grid, traversing
- *   to the upper right, and then starting on the next row on the left.
+ *   See gribWriteFloat.
  *
  * RETURNS: int (could use errSprintf())
- *  0 = OK
- * -3 = invalid calling parameters.
- * -2 = Problems opening the files.
- * -1 = illegal declaration of the grid size.
- *  1 = un-supported map projection for cmapf
- *  2 = invalid parameters for gribWriteEsriHdr.
- *  3 = invalid parameters for gribWriteEsriPrj.
- *  4 = invalid parameters for gribWriteEsriAve.
+ *   See gribWriteFloat.
  *
  * HISTORY
- *   9/2002 Arthur Taylor (MDL/RSIS): Created.
- *  12/2002 (RY,FC,MA,&TB): Code Review.
- *   5/2003 AAT: removed call to .prj write.
- *   5/2003 AAT: Added rounding to decimal.
- *   5/2003 AAT: Enabled other spherical earths.
- *   6/2003 AAT: Switched to a Warning and then averaging if Dx != Dy.
- *   6/2003 AAT: Added GrADS .ctl file creation support.
- *   7/2003 AAT: Added f_SimpleWx.
- *   7/2003 AAT: Proper handling of Dx != Dy.
- *   7/2003 AAT: switched to checking against element name for Wx instead
- *          of pds2.sect2.ptrType == GS2_WXTYPE
- *   7/2003 AAT: If index is not in range of colortable, set as undef.
- *   9/2005 AAT: Added ability to choose ESRI ASCII grids
+ *  10/2026 Arthur Taylor (MDL): Created (from gribWriteFloat).
  *
  * NOTES
- *   Order is .flt first so if .prj stuff doesn't work, they have something.
- *   Then .hdr, .prj, then .ave (in order of importance.)
  *****************************************************************************
  */
-int gribWriteFloat (const char *Filename, double *grib_Data,
-                    grib_MetaData *meta, gridAttribType *attrib,
-                    uChar scan, sChar f_MSB, sChar decimal, sChar f_GrADS,
-                    sChar f_SimpleWx, sChar f_AscGrid)
+static int WriteFloatCore (const char *Filename, const double *grib_Data,
+                           const float *flt_Data, grib_MetaData *meta,
+                           gridAttribType *attrib, uChar scan, sChar f_MSB,
+                           sChar decimal, sChar f_GrADS, sChar f_SimpleWx,
+                           sChar f_AscGrid)
 {
    FILE *fp;            /* The current open file pointer. */
    float *floatPtr;     /* Temporary storage to convert double data to float
@@ -554,7 +517,10 @@ int gribWriteFloat (const char *Filename, double *grib_Data,
    uInt4 x, y;          /* Current grid cell location. */
    double orient;       /* Orientation longitude of projection (where N is
                          * up.) (between -180 and 180) */
-   double *curData;     /* Pointer to current data in grib_Data. */
+   const double *curData = NULL; /* Current row of grib_Data. */
+   const float *curFlt = NULL; /* Current row of flt_Data. */
+   double value;        /* The current cell. */
+   double missSec;      /* attrib->missSec as it is stored in the grid. */
    double shift;        /* power of 10 used in rounding. */
    char *filename2;     /* Holds name of data file in call to CTL creation */
    double unDef;        /* Holds the missing value, if there is one. */
@@ -656,20 +622,32 @@ int gribWriteFloat (const char *Filename, double *grib_Data,
          }
       }
    }
+   /* A float grid holds the missing value rounded to a float. */
+   if (flt_Data != NULL) {
+      missSec = (float) attrib->missSec;
+   } else {
+      missSec = attrib->missSec;
+   }
    for (y = 0; y < meta->gds.Ny; y++) {
       /* Index manipulation see previous note... */
       if (scan == 0) {
-         curData = grib_Data + ((meta->gds.Ny - 1) - y) * meta->gds.Nx;
+         index = ((meta->gds.Ny - 1) - y) * meta->gds.Nx;
       } else {
-         curData = grib_Data + y * meta->gds.Nx;
+         index = y * meta->gds.Nx;
+      }
+      if (flt_Data != NULL) {
+         curFlt = flt_Data + index;
+      } else {
+         curData = grib_Data + index;
       }
       for (x = 0; x < meta->gds.Nx; x++) {
+         value = (curFlt != NULL) ? curFlt[x] : curData[x];
          /* Only allowed 1 missing value in .flt format. */
-         if ((attrib->f_miss == 2) && (*curData == attrib->missSec)) {
+         if ((attrib->f_miss == 2) && (value == missSec)) {
             floatPtr[x] = (float) unDef;
          } else {
             if (f_SimpleWx && (strcmp (meta->element, "Wx") == 0)) {
-               index = (uInt4) *curData;
+               index = (uInt4) value;
                if (index < meta->pds2.sect2.wx.dataLen) {
                   floatPtr[x] = (float)
                         meta->pds2.sect2.wx.ugly[index].SimpleCode;
@@ -677,7 +655,7 @@ int gribWriteFloat (const char *Filename, double *grib_Data,
                   floatPtr[x] = (float) unDef;
                }
             } else if (f_SimpleWx && (strcmp (meta->element, "WWA") == 0)) {
-               index = (uInt4) *curData;
+               index = (uInt4) value;
                if (index < meta->pds2.sect2.hazard.dataLen) {
                   floatPtr[x] = (float)
                         meta->pds2.sect2.hazard.haz[index].SimpleCode;
@@ -685,11 +663,10 @@ int gribWriteFloat (const char *Filename, double *grib_Data,
                   floatPtr[x] = (float) unDef;
                }
             } else {
-               floatPtr[x] = (float) ((floor (*curData * shift + .5)) /
+               floatPtr[x] = (float) ((floor (value * shift + .5)) /
                                       shift);
             }
          }
-         curData++;
       }
       if (f_AscGrid) {
          fprintf (fp, "%f", floatPtr[0]);
@@ -750,6 +727,92 @@ int gribWriteFloat (const char *Filename, double *grib_Data,
    return 0;
 }
 
+/*****************************************************************************
+ * gribWriteFloat() -- Review 12/2002
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   This creates a .flt file.  The .flt file happens to match the one that
+ * Esri ArcView Spatial analyst uses, and extra support is created for using
+ * it in Esri, but at the same time, anyone could write a program to read
+ * the meta file along with the .flt file, and display the data.
+ *
+ * ARGUMENTS
+ *   Filename = Name of file to save to. (Output)
+ *  grib_Data = The grib2 data to write. (Input)
+ *              (gribWriteFloatFlt: flt_Data, a float grid)
+ *       meta = The meta file structure to generate the .flt for. (Input)
+ *     attrib = Sect 5 from the parsed grib message to write. (Input)
+ *       scan = Either 0 or (0100)<< 4 = 64 (How to write file.) (Input)
+ *              if scan is 0 create a .flt file (For input to Esri S.A.)
+ *              if scan is 64 create a .tlf file (For input to NDFD Gd)
+ *      f_MSB = True if we should create MSB file, false for LSB (Input)
+ *    decimal = How many decimals to round to. (Input)
+ *    f_GrADS = True if you want to create a GrADS .ctl file. (Input)
+ * f_SimpleWx = True if you want to simplify the weather via NDFD method,
+ *              before output. (Input)
+ *  f_AscGrid = True if we want ESRI Ascii grids (instead of binary flt) (In)
+ *
+ * FILES/DATABASES:
+ *   Calls gribWriteEsriHdr to create an Esri ascii .hdr file.
+ *   Calls gribWriteEsriPrj to create an Esri ascii .prj file.
+ *   Calls gribWriteEsriAve to create an Esri ascii .ave file.
+ *   Creates a .flt file, which is a binary file (Big Endian) consisting of
+ *   NxM floats, starting at the upper left corner of the grid, traversing
+ *   to the upper right, and then starting on the next row on the left.
+ *
+ * RETURNS: int (could use errSprintf())
+ *  0 = OK
+ * -3 = invalid calling parameters.
+ * -2 = Problems opening the files.
+ * -1 = illegal declaration of the grid size.
+ *  1 = un-supported map projection for cmapf
+ *  2 = invalid parameters for gribWriteEsriHdr.
+ *  3 = invalid parameters for gribWriteEsriPrj.
+ *  4 = invalid parameters for gribWriteEsriAve.
+ *
+ * HISTORY
+ *   9/2002 Arthur Taylor (MDL/RSIS): Created.
+ *  12/2002 (RY,FC,MA,&TB): Code Review.
+ *   5/2003 AAT: removed call to .prj write.
+ *   5/2003 AAT: Added rounding to decimal.
+ *   5/2003 AAT: Enabled other spherical earths.
+ *   6/2003 AAT: Switched to a Warning and then averaging if Dx != Dy.
+ *   6/2003 AAT: Added GrADS .ctl file creation support.
+ *   7/2003 AAT: Added f_SimpleWx.
+ *   7/2003 AAT: Proper handling of Dx != Dy.
+ *   7/2003 AAT: switched to checking against element name for Wx instead
+ *          of pds2.sect2.ptrType == GS2_WXTYPE
+ *   7/2003 AAT: If index is not in range of colortable, set as undef.
+ *   9/2005 AAT: Added ability to choose ESRI ASCII grids
+ *  10/2026 AAT: Moved the body to WriteFloatCore (shared with
+ *          gribWriteFloatFlt, which writes a float grid from
+ *          ReadGrib2RecordFlt).
+ *
+ * NOTES
+ *   Order is .flt first so if .prj stuff doesn't work, they have something.
+ *   Then .hdr, .prj, then .ave (in order of importance.)
+ *****************************************************************************
+ */
+int gribWriteFloat (const char *Filename, double *grib_Data,
+                    grib_MetaData *meta, gridAttribType *attrib,
+                    uChar scan, sChar f_MSB, sChar decimal, sChar f_GrADS,
+                    sChar f_SimpleWx, sChar f_AscGrid)
+{
+   return WriteFloatCore (Filename, grib_Data, NULL, meta, attrib, scan,
+                          f_MSB, decimal, f_GrADS, f_SimpleWx, f_AscGrid);
+}
+
+int gribWriteFloatFlt (const char *Filename, float *flt_Data,
+                       grib_MetaData *meta, gridAttribType *attrib,
+                       uChar scan, sChar f_MSB, sChar decimal, sChar f_GrADS,
+                       sChar f_SimpleWx, sChar f_AscGrid)
+{
+   return WriteFloatCore (Filename, NULL, flt_Data, meta, attrib, scan,
+                          f_MSB, decimal, f_GrADS, f_SimpleWx, f_AscGrid);
+}
+
 /*****************************************************************************
  * IndexNearest() --
  *
@@ -1440,6 +1440,67 @@ static int StoreWeatherInfo (int ncid, sect2_WxType *wx, int wx_id,
    return 0;
 }
 
+/*****************************************************************************
+ * nc_FillData() --
+ *
+ * Arthur Taylor / MDL
+ *
+ * PURPOSE
+ *   Rounds the grid to decimal places, and replaces its missing values
+ * with unDef, storing the result in the float array that gets written to
+ * the NetCDF file.  The grid is either a double grid (grib_Data) or a float
+ * grid (flt_Data).
+ *
+ * ARGUMENTS
+ *      data = Where to store the grid (Nx * Ny floats). (Output)
+ * grib_Data = The double grid (or NULL). (Input)
+ *  flt_Data = The float grid (or NULL). (Input)
+ *      meta = meta data for the grid (Nx, Ny and the missing values) (In)
+ *     unDef = The missing value to write. (Input)
+ *   decimal = How many decimals to store the data with. (Input)
+ *
+ * FILES/DATABASES: None
+ *
+ * RETURNS: void
+ *
+ * HISTORY
+ *  10/2026 Arthur Taylor (MDL): Created (from netCDF_V1 and netCDF_V2).
+ *
+ * NOTES
+ *   A float grid holds the missing values rounded to floats, so that is
+ * what we compare against.
+ *****************************************************************************
+ */
+static void nc_FillData (float *data, const double *grib_Data,
+                         const float *flt_Data, grib_MetaData *meta,
+                         float unDef, sChar decimal)
+{
+   size_t i;            /* Counter over the data. */
+   size_t numPts;       /* Number of cells in the grid. */
+   double value;        /* The current cell. */
+   double missPri;      /* The missing values as they are stored in the */
+   double missSec;      /* grid. */
+
+   if (flt_Data != NULL) {
+      missPri = (float) meta->gridAttrib.missPri;
+      missSec = (float) meta->gridAttrib.missSec;
+   } else {
+      missPri = meta->gridAttrib.missPri;
+      missSec = meta->gridAttrib.missSec;
+   }
+   numPts = (size_t) meta->gds.Nx * meta->gds.Ny;
+   for (i = 0; i < numPts; i++) {
+      value = (flt_Data != NULL) ? flt_Data[i] : grib_Data[i];
+      if ((meta->gridAttrib.f_miss == 2) && (value == missSec)) {
+         data[i] = (float) unDef;
+      } else if ((meta->gridAttrib.f_miss != 0) && (value == missPri)) {
+         data[i] = (float) unDef;
+      } else {
+         data[i] = myRound (value, decimal);
+      }
+   }
+}
+
 /*****************************************************************************
  * netCDF_V1() --
  *
@@ -1453,6 +1514,7 @@ static int StoreWeatherInfo (int ncid, sect2_WxType *wx, int wx_id,
  * ARGUMENTS
  *       filename = The file to write the data to. (Input)
  *      grib_data = The decoded Grid of data to write to file. (Input)
+ *       flt_Data = If not NULL, the float grid to write instead. (Input)
  *           meta = meta data for the GRIB data to be stored in NetCDF (In)
  *       f_NetCDF = Version of degrib-NetCDF to use (1, or 2) (In)
  *        decimal = How many decimals to store the data with. (Input)
@@ -1467,6 +1529,7 @@ static int StoreWeatherInfo (int ncid, sect2_WxType *wx, int wx_id,
  * HISTORY
  *   5/2004 Arthur Taylor (MDL/RSIS): Created.
  *   1/2005 AAT: Updated for pdsTdlp type
+ *  10/2026 AAT: Added flt_Data (see nc_FillData).
  *
  * NOTES
  *   See: http://www.cgd.ucar.edu/cms/eaton/cf-metadata/CF-1.0.html#gmap
@@ -1474,8 +1537,8 @@ static int StoreWeatherInfo (int ncid, sect2_WxType *wx, int wx_id,
  *****************************************************************************
  */
 static int netCDF_V1 (char *filename, double *grib_Data,
-                      grib_MetaData *meta, sChar f_NetCDF, sChar decimal,
-                      sChar LatLon_Decimal)
+                      float *flt_Data, grib_MetaData *meta,
+                      sChar f_NetCDF, sChar decimal, sChar LatLon_Decimal)
 {
    int ncid;            /* netCDF file id */
    int stat;            /* Return value from NetCDF call */
@@ -1503,7 +1566,6 @@ static int netCDF_V1 (char *filename, double *grib_Data,
    float f_temp;        /* Temporary variable holding floats. */
    float unDef;         /* Aids with missing values. */
    char *ptr2;          /* Used to help with the original GRIB units. */
-   uInt4 i;             /* Counter over the data. */
    float *data;         /* The data converted to a float. */
    myMaparam map;       /* Used to compute the grid lat/lon points. */
 
@@ -1944,17 +2006,7 @@ static int netCDF_V1 (char *filename, double *grib_Data,
    }
 
    data = (float *) malloc (meta->gds.Nx * meta->gds.Ny * sizeof (float));
-   for (i = 0; i < meta->gds.Nx * meta->gds.Ny; i++) {
-      if ((meta->gridAttrib.f_miss == 2) &&
-          (grib_Data[i] == meta->gridAttrib.missSec)) {
-         data[i] = (float) unDef;
-      } else if ((meta->gridAttrib.f_miss != 0) &&
-                 (grib_Data[i] == meta->gridAttrib.missPri)) {
-         data[i] = (float) unDef;
-      } else {
-         data[i] = myRound (grib_Data[i], decimal);
-      }
-   }
+   nc_FillData (data, grib_Data, flt_Data, meta, unDef, decimal);
    if (nc_PutFloatVar (ncid, grid_id, data, __LINE__, __FILE__) != 0) {
       free (data);
       goto error;
@@ -1983,6 +2035,7 @@ static int netCDF_V1 (char *filename, double *grib_Data,
  * ARGUMENTS
  *       filename = The file to write the data to. (Input)
  *      grib_data = The decoded Grid of data to write to file. (Input)
+ *       flt_Data = If not NULL, the float grid to write instead. (Input)
  *           meta = meta data for the GRIB data to be stored in NetCDF (In)
  *       f_NetCDF = Version of degrib-NetCDF to use (1, or 2) (In)
  *        decimal = How many decimals to store the data with. (Input)
@@ -2003,6 +2056,7 @@ static int netCDF_V1 (char *filename, double *grib_Data,
  *   9/2005 AAT: Modified to handle version 3 which should be more CF
  *          compliant
  *   3/2007 AAT: Realized that msgNum is not actually used anymore (removed).
+ *  10/2026 AAT: Added flt_Data (see nc_FillData).
  *
  * NOTES
  *   See: http://www.cgd.ucar.edu/cms/eaton/cf-metadata/CF-1.0.html#gmap
@@ -2010,8 +2064,8 @@ static int netCDF_V1 (char *filename, double *grib_Data,
  *****************************************************************************
  */
 static int netCDF_V2 (char *filename, double *grib_Data,
-                      grib_MetaData *meta, sChar f_NetCDF, sChar decimal,
-                      sChar LatLon_Decimal)
+                      float *flt_Data, grib_MetaData *meta,
+                      sChar f_NetCDF, sChar decimal, sChar LatLon_Decimal)
 {
    int ncid;            /* netCDF file id */
    int stat;            /* Return value from NetCDF call */
@@ -2896,17 +2950,7 @@ static int netCDF_V2 (char *filename, double *grib_Data,
    start[0] = insertIndex;
 
    /* Store the Grib data */
-   for (i = 0; i < meta->gds.Nx * meta->gds.Ny; i++) {
-      if ((meta->gridAttrib.f_miss == 2) &&
-          (grib_Data[i] == meta->gridAttrib.missSec)) {
-         data[i] = (float) unDef;
-      } else if ((meta->gridAttrib.f_miss != 0) &&
-                 (grib_Data[i] == meta->gridAttrib.missPri)) {
-         data[i] = (float) unDef;
-      } else {
-         data[i] = myRound (grib_Data[i], decimal);
-      }
-   }
+   nc_FillData (data, grib_Data, flt_Data, meta, unDef, decimal);
    if (nc_PutFloatVara (ncid, grid_id, start, count, data, __LINE__,
                         __FILE__) != 0) {
       free (data);
@@ -2963,25 +3007,43 @@ static int netCDF_V2 (char *filename, double *grib_Data,
  *  12/2004 Arthur Taylor (MDL): Modified to toggle between netCDF_V1 and
  *          netCDF_V2.
  *   3/2007 AAT: Realized that msgNum is not actually used anymore (removed).
+ *  10/2026 AAT: Added gribWriteNetCDFFlt, which writes a float grid (from
+ *          ReadGrib2RecordFlt).
  *
  * NOTES
  *   See: http://www.cgd.ucar.edu/cms/eaton/cf-metadata/CF-1.0.html#gmap
  * for a convention on grid specifications.
  *****************************************************************************
  */
-int gribWriteNetCDF (char *filename, double *grib_Data, grib_MetaData *meta,
-                     sChar f_NetCDF, sChar decimal, sChar LatLon_Decimal)
+static int WriteNetCDFCore (char *filename, double *grib_Data,
+                            float *flt_Data, grib_MetaData *meta,
+                            sChar f_NetCDF, sChar decimal,
+                            sChar LatLon_Decimal)
 {
    if (f_NetCDF == 1) {
-      return (netCDF_V1 (filename, grib_Data, meta, f_NetCDF, decimal,
-                         LatLon_Decimal));
+      return (netCDF_V1 (filename, grib_Data, flt_Data, meta, f_NetCDF,
+                         decimal, LatLon_Decimal));
    } else if ((f_NetCDF == 2) || (f_NetCDF == 3)) {
-      return (netCDF_V2 (filename, grib_Data, meta, f_NetCDF, decimal,
-                         LatLon_Decimal));
+      return (netCDF_V2 (filename, grib_Data, flt_Data, meta, f_NetCDF,
+                         decimal, LatLon_Decimal));
    } else {
       errSprintf ("Warning: Only 2 versions of NetCDF currently available\n"
                   "Using the default one");
-      return (netCDF_V2 (filename, grib_Data, meta, f_NetCDF, decimal,
-                         LatLon_Decimal));
+      return (netCDF_V2 (filename, grib_Data, flt_Data, meta, f_NetCDF,
+                         decimal, LatLon_Decimal));
    }
 }
+
+int gribWriteNetCDF (char *filename, double *grib_Data, grib_MetaData *meta,
+                     sChar f_NetCDF, sChar decimal, sChar LatLon_Decimal)
+{
+   return WriteNetCDFCore (filename, grib_Data, NULL, meta, f_NetCDF,
+                           decimal, LatLon_Decimal);
+}
+
+int gribWriteNetCDFFlt (char *filename, float *flt_Data, grib_MetaData *meta,
+                        sChar f_NetCDF, sChar decimal, sChar LatLon_Decimal)
+{
+   return WriteNetCDFCore (filename, NULL, flt_Data, meta, f_NetCDF,
+                           decimal, LatLon_Decimal);
+}
@@ -336,13 +336,15 @@ error:
 typedef enum {
 	OPT_MAXLYRS,
 	OPT_MAXPKTS,
-	OPT_DEBUG
+	OPT_DEBUG,
+	OPT_NUMTHREADS
 } optid_t;
 
 jas_taginfo_t decopts[] = {
 	{OPT_MAXLYRS, "maxlyrs"},
 	{OPT_MAXPKTS, "maxpkts"},
 	{OPT_DEBUG, "debug"},
+	{OPT_NUMTHREADS, "numthreads"},
 	{-1, 0}
 };
 
@@ -353,6 +355,7 @@ static int jpc_dec_parseopts(char *optstr, jpc_dec_importopts_t *opts)
 	opts->debug = 0;
 	opts->maxlyrs = JPC_MAXLYRS;
 	opts->maxpkts = -1;
+	opts->numthreads = 1;
 
 	if (!(tvp = jas_tvparser_create(optstr ? optstr : ""))) {
 		return -1;
@@ -370,6 +373,12 @@ static int jpc_dec_parseopts(char *optstr, jpc_dec_importopts_t *opts)
 		case OPT_MAXPKTS:
 			opts->maxpkts = atoi(jas_tvparser_getval(tvp));
 			break;
+		case OPT_NUMTHREADS:
+			opts->numthreads = atoi(jas_tvparser_getval(tvp));
+			if (opts->numthreads < 1) {
+				opts->numthreads = 1;
+			}
+			break;
 		default:
 			fprintf(stderr, "warning: ignoring invalid option %s\n",
 			  jas_tvparser_gettag(tvp));
@@ -1920,6 +1929,7 @@ static jpc_dec_t *jpc_dec_create(jpc_dec_importopts_t *impopts, jas_stream_t *in
 	dec->cp = 0;
 	dec->maxlyrs = impopts->maxlyrs;
 	dec->maxpkts = impopts->maxpkts;
+	dec->numthreads = impopts->numthreads;
 dec->numpkts = 0;
 	dec->ppmseqno = 0;
 	dec->state = 0;
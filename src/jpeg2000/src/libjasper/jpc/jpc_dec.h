@@ -705,6 +705,9 @@ typedef struct {
 	/* This is required by the tier-2 decoder. */
 	jpc_cstate_t *cstate;
 
+	/* The number of threads to use for tier-1 (code block) decoding. */
+	int numthreads;
+
 } jpc_dec_t;
 
 /* Decoder options. */
@@ -720,6 +723,9 @@ typedef struct {
 	/* The maximum number of packets to decode. */
 	int maxpkts;
 
+	/* The number of threads to use for tier-1 (code block) decoding. */
+	int numthreads;
+
 } jpc_dec_importopts_t;
 
 /******************************************************************************\
@@ -124,6 +124,7 @@
 #include "jasper/jas_fix.h"
 #include "jasper/jas_stream.h"
 #include "jasper/jas_math.h"
+#include "jasper/jas_malloc.h"
 
 #include "jpc_bs.h"
 #include "jpc_mqdec.h"
@@ -131,10 +132,39 @@
 #include "jpc_t1cod.h"
 #include "jpc_dec.h"
 
+/* Tier-1 decoding of the code blocks in a tile may be split among several
+  threads (see the "numthreads" decoder option). */
+#if !defined(HAVE_WINDOWS_H)
+#define	JPC_T1D_THREADS
+#include <pthread.h>
+#endif
+
 /******************************************************************************\
 *
 \******************************************************************************/
 
+/* A code block waiting to be decoded. */
+typedef struct {
+	jpc_dec_tcomp_t *tcomp;
+	jpc_dec_band_t *band;
+	jpc_dec_cblk_t *cblk;
+} jpc_dec_cblkjob_t;
+
+#if defined(JPC_T1D_THREADS)
+/* The code blocks shared by the threads decoding a tile. */
+typedef struct {
+	jpc_dec_t *dec;
+	jpc_dec_tile_t *tile;
+	jpc_dec_cblkjob_t *jobs;
+	int numjobs;
+	/* The next job to hand out. */
+	int nextjob;
+	/* Nonzero if decoding any code block failed. */
+	int ret;
+	pthread_mutex_t mutex;
+} jpc_dec_cblkpool_t;
+#endif
+
 static int jpc_dec_decodecblk(jpc_dec_t *dec, jpc_dec_tile_t *tile, jpc_dec_tcomp_t *tcomp, jpc_dec_band_t *band,
   jpc_dec_cblk_t *cblk, int dopartial, int maxlyrs);
 static int dec_sigpass(jpc_dec_t *dec, jpc_mqdec_t *mqdec, int bitpos, int orient,
@@ -186,6 +216,73 @@ static long t1dec_cnt = 0;
 * Code.
 \******************************************************************************/
 
+#if defined(JPC_T1D_THREADS)
+static void *jpc_dec_cblkworker(void *arg)
+{
+	jpc_dec_cblkpool_t *pool = (jpc_dec_cblkpool_t *) arg;
+	jpc_dec_cblkjob_t *job;
+	int jobno;
+
+	for (;;) {
+		pthread_mutex_lock(&pool->mutex);
+		jobno = (pool->ret) ? pool->numjobs : pool->nextjob++;
+		pthread_mutex_unlock(&pool->mutex);
+		if (jobno >= pool->numjobs) {
+			break;
+		}
+		job = &pool->jobs[jobno];
+		if (jpc_dec_decodecblk(pool->dec, pool->tile, job->tcomp,
+		  job->band, job->cblk, 1, JPC_MAXLYRS)) {
+			pthread_mutex_lock(&pool->mutex);
+			pool->ret = -1;
+			pthread_mutex_unlock(&pool->mutex);
+			break;
+		}
+	}
+	return 0;
+}
+
+/* Decode the code blocks in jobs using dec->numthreads threads.  Each code
+  block has its own MQ decoder, flags, and (disjoint) part of the band data,
+  so they can be decoded in any order. */
+static int jpc_dec_decodecblkjobs(jpc_dec_t *dec, jpc_dec_tile_t *tile,
+  jpc_dec_cblkjob_t *jobs, int numjobs)
+{
+	jpc_dec_cblkpool_t pool;
+	pthread_t *threads;
+	int numthreads;
+	int i;
+
+	numthreads = JAS_MIN(dec->numthreads, numjobs);
+	if (!(threads = jas_malloc(numthreads * sizeof(pthread_t)))) {
+		numthreads = 1;
+	}
+	pool.dec = dec;
+	pool.tile = tile;
+	pool.jobs = jobs;
+	pool.numjobs = numjobs;
+	pool.nextjob = 0;
+	pool.ret = 0;
+	pthread_mutex_init(&pool.mutex, 0);
+	/* The calling thread is worker 0. */
+	for (i = 1; i < numthreads; ++i) {
+		if (pthread_create(&threads[i], 0, jpc_dec_cblkworker, &pool)) {
+			break;
+		}
+	}
+	numthreads = i;
+	jpc_dec_cblkworker(&pool);
+	for (i = 1; i < numthreads; ++i) {
+		pthread_join(threads[i], 0);
+	}
+	pthread_mutex_destroy(&pool.mutex);
+	if (threads) {
+		jas_free(threads);
+	}
+	return pool.ret;
+}
+#endif
+
 int jpc_dec_decodecblks(jpc_dec_t *dec, jpc_dec_tile_t *tile)
 {
 	jpc_dec_tcomp_t *tcomp;
@@ -198,7 +295,16 @@ int jpc_dec_decodecblks(jpc_dec_t *dec, jpc_dec_tile_t *tile)
 	int prccnt;
 	jpc_dec_cblk_t *cblk;
 	int cblkcnt;
+	jpc_dec_cblkjob_t *jobs;
+	jpc_dec_cblkjob_t *newjobs;
+	int numjobs;
+	int maxjobs;
+	int ret;
 
+	/* Make a list of the code blocks in the tile. */
+	jobs = 0;
+	numjobs = 0;
+	maxjobs = 0;
 	for (compcnt = dec->numcomps, tcomp = tile->tcomps; compcnt > 0;
 	  --compcnt, ++tcomp) {
 		for (rlvlcnt = tcomp->numrlvls, rlvl = tcomp->rlvls;
@@ -219,10 +325,21 @@ int jpc_dec_decodecblks(jpc_dec_t *dec, jpc_dec_tile_t *tile)
 					for (cblkcnt = prc->numcblks,
 					  cblk = prc->cblks; cblkcnt > 0;
 					  --cblkcnt, ++cblk) {
-						if (jpc_dec_decodecblk(dec, tile, tcomp,
-						  band, cblk, 1, JPC_MAXLYRS)) {
-							return -1;
+						if (numjobs >= maxjobs) {
+							maxjobs = (maxjobs) ? (2 * maxjobs) : 64;
+							if (!(newjobs = jas_realloc(jobs, maxjobs *
+							  sizeof(jpc_dec_cblkjob_t)))) {
+								if (jobs) {
+									jas_free(jobs);
+								}
+								return -1;
+							}
+							jobs = newjobs;
 						}
+						jobs[numjobs].tcomp = tcomp;
+						jobs[numjobs].band = band;
+						jobs[numjobs].cblk = cblk;
+						++numjobs;
 					}
 				}
 
@@ -230,7 +347,26 @@ int jpc_dec_decodecblks(jpc_dec_t *dec, jpc_dec_tile_t *tile)
 		}
 	}
 
-	return 0;
+	ret = 0;
+#if defined(JPC_T1D_THREADS)
+	if (dec->numthreads > 1 && numjobs > 1) {
+		ret = jpc_dec_decodecblkjobs(dec, tile, jobs, numjobs);
+		jas_free(jobs);
+		return ret;
+	}
+#endif
+	for (cblkcnt = 0; cblkcnt < numjobs; ++cblkcnt) {
+		if (jpc_dec_decodecblk(dec, tile, jobs[cblkcnt].tcomp,
+		  jobs[cblkcnt].band, jobs[cblkcnt].cblk, 1, JPC_MAXLYRS)) {
+			ret = -1;
+			break;
+		}
+	}
+	if (jobs) {
+		jas_free(jobs);
+	}
+
+	return ret;
 }
 
 static int jpc_dec_decodecblk(jpc_dec_t *dec, jpc_dec_tile_t *tile, jpc_dec_tcomp_t *tcomp, jpc_dec_band_t *band,